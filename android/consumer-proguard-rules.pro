@@ -1 +1,7 @@
--keep class com.mikoloy.device_trust.DeviceTrustNative { *; }
\ No newline at end of file
+-keep class com.mikoloy.device_trust.DeviceTrustNative { *; }
+
+# Called from native code through IDs cached in JNI_OnLoad
+-keep interface com.mikoloy.device_trust.NativeStageListener { *; }
+-keep class com.mikoloy.device_trust.DeviceTrustMonitor {
+    public static void onNativeChange(java.lang.String);
+}
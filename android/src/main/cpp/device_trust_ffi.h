@@ -0,0 +1,107 @@
+// [DeviceTrust/Android] C ABI for dart:ffi
+// Stable entry points exported by libdevice_trust_native.so next to
+// JNI_OnLoad. Mirrored by lib/device_trust_ffi.dart; bump DT_ABI_VERSION
+// whenever a layout or entry point below changes.
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DT_ABI_VERSION 6
+
+// Status codes returned by dt_collect
+#define DT_OK 0
+#define DT_ERROR_ARGUMENT -1
+
+// Bytes available for the packed string lists in dt_result
+#define DT_LISTS_CAPACITY 2048
+
+// Timed native stages (TimedStage): maps, fd, libc, integrity, memory,
+// tracerPid, rwx
+#define DT_STAGE_COUNT 7
+
+/**
+ * One scan request; same semantics as collectNativeSignalsInto
+ *
+ * struct_size must be sizeof(dt_request) as compiled by the caller.
+ */
+typedef struct dt_request {
+    uint32_t struct_size;
+    int32_t level;          // ScanLevel (0 = fast, 1 = standard, 2 = deep)
+    int32_t signal_mask;    // SignalGroup bits
+    int32_t verdicts_only;  // non-zero: stop hook stages once settled
+    int64_t budget_ns;      // latency budget for the native stages
+} dt_request;
+
+/**
+ * Result of one scan; fields match the packed binary result (version 4)
+ *
+ * lists holds lists_length bytes of u16 count + (u16 length + UTF-8 bytes)*
+ * lists: libcGetpidSo (count 0/1), memorySignature (count 0/1),
+ * memoryRegionPath (count 0/1), gotMismatch, textMismatch,
+ * suspiciousModules. Lists that do not fit set RESULT_FLAG_TRUNCATED; flags
+ * carry every signal regardless.
+ */
+typedef struct dt_result {
+    uint32_t struct_size;
+    uint32_t flags;                  // RESULT_FLAG_* bits
+    int32_t level;
+    int32_t signal_mask;
+    int32_t tracer_pid;
+    int32_t rwx_segments;
+    int32_t libc_symbols_checked;
+    uint32_t skipped_stages;         // bit per HookStage
+    uint32_t demoted_stages;         // bit per HookStage
+    uint32_t lists_length;
+    int64_t native_time_ns;
+    uint32_t stages_ran;             // bit per timed stage
+    uint32_t reserved;
+    int64_t stage_ns[DT_STAGE_COUNT];
+    int32_t stage_items[DT_STAGE_COUNT];  // work counter per timed stage
+    uint32_t reserved2;
+    uint64_t memory_region_start;    // region holding the memory signature; 0 if none
+    uint64_t memory_match_address;   // first byte of the match
+    uint8_t lists[DT_LISTS_CAPACITY];
+} dt_result;
+
+/**
+ * @return DT_ABI_VERSION of the loaded library
+ */
+int32_t dt_abi_version(void);
+
+/**
+ * Runs the native stages for [request] on the calling thread
+ *
+ * Safe to call from any thread, without a JNIEnv; the library does not need
+ * to have been loaded by System.loadLibrary first.
+ *
+ * @return DT_OK, or DT_ERROR_ARGUMENT if a pointer is null, a struct_size
+ *   does not match this library or the level is not 0..2 (result is left
+ *   untouched)
+ */
+int32_t dt_collect(const dt_request* request, dt_result* result);
+
+/**
+ * Latest published verdict word (layout: core/verdict.h); 0 if nothing was
+ * published yet. One atomic load; meant for leaf calls.
+ */
+uint64_t dt_verdict_load(void);
+
+/**
+ * Publishes the VERDICT_* [flags] of a report of scan level [level] that
+ * completely evaluated [groups] (SignalGroup bits); see VerdictBlock::publish.
+ */
+void dt_verdict_publish(uint32_t groups, uint32_t flags, int32_t level);
+
+/**
+ * Clock of the verdict timestamps (CLOCK_BOOTTIME, ms)
+ */
+int64_t dt_clock_ms(void);
+
+#ifdef __cplusplus
+}
+#endif
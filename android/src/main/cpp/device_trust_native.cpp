@@ -6,254 +6,1484 @@
 #include <jni.h>
 #include <string>
 #include <vector>
-#include <fstream>
 #include <sstream>
 #include <chrono>
-#include <cctype>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <link.h>
 #include <unistd.h>
 #include <dirent.h>
 #include <limits.h>
 #include <android/log.h>
 
+#include "device_trust_ffi.h"
+#include "core/arena.h"
+#include "core/check_breaker.h"
+#include "core/json.h"
+#include "core/keywords.h"
+#include "core/packed_writer.h"
+#include "core/perf_counters.h"
+#include "core/scanners.h"
+#include "core/signature_pack.h"
+#include "core/snapshot.h"
+#include "core/stage_timing.h"
+#include "core/telemetry.h"
+#include "core/trace.h"
+#include "core/verdict.h"
+#include "core/work_pool.h"
+#include "platform/procfs_backend.h"
+#include "platform/procfs_snapshot.h"
+
 #define LOG_TAG "DeviceTrust/Native"
 #define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
 
 using namespace std;
+using namespace device_trust;
 
 /**
- * [DeviceTrust/Android] Helper functions for collecting native security signals
+ * [DeviceTrust/Android] JNI shim over the shared detection core (src/)
  * 
+ * Core scanners on the procfs backend:
  * - /proc/self/maps analysis (RWX segments, Frida modules)
  * - /proc/self/fd checks (Frida file descriptors)
  * - libc symbol analysis via dladdr (libc getpid hooking detection)
+ * - /proc/self/status TracerPid
+ *
+ * Android-only, kept here:
+ * - libc .text prologue vs on-disk ELF, GOT vs dlsym (deep tier)
+ * - check stats store / circuit breaker, stage planner, background monitor
  */
 
+// /proc/self; immutable, shared by scans and the monitor thread
+static ProcfsBackend g_procfs;
+
 /**
- * Scans /proc/self/maps file to detect RWX segments and suspicious modules
+ * Scan tiers (values shared with ScanLevel in DeviceTrust.kt)
+ *
+ * FAST:     TracerPid + RWX count with Frida module paths (one maps pass)
+ * STANDARD: FAST + maps keywords, fd scan, libc getpid dladdr
+ * DEEP:     STANDARD + libc ELF integrity and GOT checks, byte signatures in
+ *           anonymous / memfd memory
  */
-struct MapsAnalysis {
-    int rwxSegments = 0;
-    bool hasRwx = false;
-    bool fridaLibLoaded = false;
-    vector<string> suspiciousModules;
+enum ScanLevel {
+    SCAN_FAST = 0,
+    SCAN_STANDARD = 1,
+    SCAN_DEEP = 2
+};
+
+/**
+ * Signal groups (bit values shared with SignalGroup in DeviceTrust.kt)
+ *
+ * Only HOOK and DEBUGGER have native stages; other bits are ignored here.
+ */
+enum SignalGroup {
+    SIGNAL_ROOT = 1,
+    SIGNAL_EMULATOR = 2,
+    SIGNAL_DEVELOPER = 4,
+    SIGNAL_HOOK = 8,
+    SIGNAL_DEBUGGER = 16
+};
+
+/**
+ * Read TracerPid from /proc/self/status (0 if not traced or unreadable)
+ */
+int readTracerPid() {
+    return readProcStatus(g_procfs.source()).tracerPid;
+}
+
+/**
+ * [DeviceTrust/Android] Deep tier: libc integrity
+ *
+ * For a fixed set of libc functions:
+ * - GOT check: the address our own GOT holds must equal dlsym() in libc
+ * - ELF check: the first bytes of the function in memory must equal the
+ *   bytes at the matching file offset of the libc on disk (inline hooks
+ *   rewrite prologues with trampolines)
+ */
+struct LibcIntegrity {
+    int checkedSymbols = 0;
+    StringList gotMismatch;   // static symbol names, stored in the scan arena
+    StringList textMismatch;
+    bool truncated = false;
 };
 
-MapsAnalysis analyzeProcMaps() {
-    MapsAnalysis result;
-    ifstream maps("/proc/self/maps");
-    
-    if (!maps.is_open()) {
+// Number of prologue bytes compared against the on-disk image
+static const size_t PROLOGUE_BYTES = 16;
+
+/**
+ * Map a loaded address to its file offset using the in-memory program headers
+ */
+static bool fileOffsetForAddress(const Dl_info& info, const void* addr, off_t* outOffset) {
+    auto base = reinterpret_cast<uintptr_t>(info.dli_fbase);
+    auto ehdr = reinterpret_cast<const ElfW(Ehdr)*>(base);
+    if (memcmp(ehdr->e_ident, ELFMAG, SELFMAG) != 0) {
+        return false;
+    }
+
+    auto phdrs = reinterpret_cast<const ElfW(Phdr)*>(base + ehdr->e_phoff);
+
+    // Load bias: dli_fbase corresponds to the lowest PT_LOAD vaddr (page-aligned)
+    uintptr_t minVaddr = UINTPTR_MAX;
+    for (int i = 0; i < ehdr->e_phnum; i++) {
+        if (phdrs[i].p_type == PT_LOAD && phdrs[i].p_vaddr < minVaddr) {
+            minVaddr = phdrs[i].p_vaddr;
+        }
+    }
+    if (minVaddr == UINTPTR_MAX) {
+        return false;
+    }
+    minVaddr &= ~(static_cast<uintptr_t>(sysconf(_SC_PAGESIZE)) - 1);
+
+    uintptr_t vaddr = reinterpret_cast<uintptr_t>(addr) - base + minVaddr;
+    for (int i = 0; i < ehdr->e_phnum; i++) {
+        const ElfW(Phdr)& ph = phdrs[i];
+        if (ph.p_type == PT_LOAD && vaddr >= ph.p_vaddr && vaddr + PROLOGUE_BYTES <= ph.p_vaddr + ph.p_filesz) {
+            *outOffset = static_cast<off_t>(ph.p_offset + (vaddr - ph.p_vaddr));
+            return true;
+        }
+    }
+    return false;
+}
+
+LibcIntegrity checkLibcIntegrity(Deadline& deadline, ScanArena& arena) {
+    LibcIntegrity result;
+
+    // Address as seen through our own GOT (resolved by the linker at load time)
+    struct Probe {
+        const char* name;
+        void* gotAddress;
+    };
+    const Probe probes[] = {
+        {"getpid", reinterpret_cast<void*>(getpid)},
+        {"open", reinterpret_cast<void*>(open)},
+        {"read", reinterpret_cast<void*>(read)},
+        {"readlink", reinterpret_cast<void*>(readlink)},
+        {"opendir", reinterpret_cast<void*>(opendir)},
+        {"strstr", reinterpret_cast<void*>(static_cast<const char* (*)(const char*, const char*)>(strstr))},
+        {"dladdr", reinterpret_cast<void*>(dladdr)},
+    };
+
+    Dl_info libcInfo;
+    if (dladdr(reinterpret_cast<void*>(getpid), &libcInfo) == 0 || libcInfo.dli_fname == nullptr) {
         return result;
     }
 
-    string line;
-    int lineCount = 0;
-    const int MAX_LINES = 10000; // Performance guardrail
+    void* libc = dlopen(libcInfo.dli_fname, RTLD_NOW | RTLD_NOLOAD);
+    if (libc == nullptr) {
+        return result;
+    }
+
+    int fileFd = open(libcInfo.dli_fname, O_RDONLY | O_CLOEXEC);
 
-    while (getline(maps, line) && lineCount < MAX_LINES) {
-        lineCount++;
-        
-        // Check for rwx segments
-        if (line.find(" rwxp") != string::npos || line.find(" rwx") != string::npos) {
-            result.rwxSegments++;
-            result.hasRwx = true;
+    for (const auto& probe : probes) {
+        if (deadline.expired()) {
+            result.truncated = true;
+            break;
         }
 
-        // Suspicious module keywords (lowercase comparison)
-        string lowerLine = line;
-        for (auto& c : lowerLine) c = tolower(static_cast<unsigned char>(c));
+        void* resolved = dlsym(libc, probe.name);
+        if (resolved == nullptr) {
+            continue;
+        }
+        result.checkedSymbols++;
 
-        vector<string> keywords = {
-            "frida", "gum-js", "gum_js", "gadget",
-            "substrate", "xposed", "lsposed", "edxposed"
-        };
+        if (resolved != probe.gotAddress) {
+            result.gotMismatch.push(arena, StringRef{probe.name, strlen(probe.name)});
+        }
 
-        for (const auto& keyword : keywords) {
-            if (lowerLine.find(keyword) != string::npos) {
-                if (keyword.find("frida") != string::npos || keyword.find("gum") != string::npos) {
-                    result.fridaLibLoaded = true;
-                }
-                
-                // Extract module path (basename typically .so file)
-                size_t lastSlash = line.rfind('/');
-                if (lastSlash != string::npos) {
-                    string module = line.substr(lastSlash + 1);
-                    // Extract up to first space
-                    size_t space = module.find(' ');
-                    if (space != string::npos) {
-                        module = module.substr(0, space);
-                    }
-                    
-                    // Ensure uniqueness before adding
-                    bool exists = false;
-                    for (const auto& m : result.suspiciousModules) {
-                        if (m == module) {
-                            exists = true;
-                            break;
-                        }
-                    }
-                    if (!exists && !module.empty()) {
-                        result.suspiciousModules.push_back(module);
-                    }
-                }
-                break;
-            }
+        // Only compare prologues of functions that really live in this libc
+        Dl_info symInfo;
+        if (fileFd < 0 || dladdr(resolved, &symInfo) == 0 || symInfo.dli_fbase != libcInfo.dli_fbase) {
+            continue;
+        }
+
+        off_t offset = 0;
+        if (!fileOffsetForAddress(libcInfo, resolved, &offset)) {
+            continue;
+        }
+
+        unsigned char onDisk[PROLOGUE_BYTES];
+        if (pread(fileFd, onDisk, sizeof(onDisk), offset) != static_cast<ssize_t>(sizeof(onDisk))) {
+            continue;
+        }
+        if (memcmp(onDisk, resolved, sizeof(onDisk)) != 0) {
+            result.textMismatch.push(arena, StringRef{probe.name, strlen(probe.name)});
         }
     }
 
-    maps.close();
+    if (fileFd >= 0) {
+        close(fileFd);
+    }
+    dlclose(libc);
     return result;
 }
 
 /**
- * Scan /proc/self/fd symlinks for frida/gadget hints
+ * [DeviceTrust/Android] Check breakers (see core/check_breaker.h)
+ *
+ * Used by the native hook stages and, through JNI, by EvaluationPlanner in
+ * Kotlin. Breaker times are wall-clock so Kotlin can persist the export
+ * across launches.
  */
-bool checkFdForFrida() {
-    DIR* dir = opendir("/proc/self/fd");
-    if (!dir) {
-        return false;
-    }
+static long long wallClockMs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return ts.tv_sec * 1000LL + ts.tv_nsec / 1000000;
+}
 
-    bool found = false;
-    struct dirent* entry;
-    int count = 0;
-    const int MAX_FD_CHECK = 100; // Performance cap
+/**
+ * [DeviceTrust/Android] Hook stage planner
+ *
+ * Orders the standard/deep hook stages by expected cost per hit (see
+ * CheckBreakers::score). With verdictsOnly the loop stops once the 2-signal
+ * hook threshold is met or can no longer be met; the remaining stages are
+ * reported in "skipped". Stages with an open breaker are left out of
+ * STANDARD scans and reported in "demoted".
+ */
+enum HookStage {
+    STAGE_MAPS = 0,
+    STAGE_FD,
+    STAGE_LIBC,
+    STAGE_INTEGRITY,
+    STAGE_MEMORY,
+    STAGE_COUNT
+};
 
-    while ((entry = readdir(dir)) != nullptr && count < MAX_FD_CHECK) {
-        count++;
-        
-        if (entry->d_name[0] == '.') {
-            continue;
-        }
+struct StagePlan {
+    const char* name;
+    const char* statsKey;  // same key as the details entry in DeviceTrust.kt
+    int maxSignals;        // signals the stage can contribute
+    double priorNs;        // cost estimate until measured
+    double budgetNs;       // runs above this count towards the breaker
+};
 
-        string fdPath = "/proc/self/fd/" + string(entry->d_name);
-        char linkTarget[PATH_MAX];
-        ssize_t len = readlink(fdPath.c_str(), linkTarget, sizeof(linkTarget) - 1);
-        
-        if (len > 0) {
-            linkTarget[len] = '\0';
-            string target = linkTarget;
-            
-            // Convert to lowercase
-            for (auto& c : target) c = tolower(static_cast<unsigned char>(c));
-            
-            if (target.find("frida") != string::npos || 
-                target.find("gadget") != string::npos ||
-                target.find("gum-js") != string::npos) {
-                found = true;
-                break;
-            }
+// Same rule as applyNativeResult in DeviceTrust.kt
+static const int HOOK_SIGNAL_THRESHOLD = 2;
+
+static const StagePlan STAGE_PLANS[STAGE_COUNT] = {
+    {"maps", "nativeMaps", 2, 2000000.0, 50000000.0},             // fridaLibLoaded, hasRwx
+    {"fd", "nativeFd", 1, 300000.0, 20000000.0},                  // fdFrida
+    {"libc", "nativeLibc", 1, 5000.0, 1000000.0},                 // libcGetpidUnexpected
+    {"integrity", "nativeIntegrity", 2, 200000.0, 50000000.0},    // gotMismatch, textMismatch
+    {"memory", "nativeMemory", 1, 2000000.0, 50000000.0},         // memorySignature
+};
+
+// Deep-only stages
+static bool isDeepStage(int stage) {
+    return stage == STAGE_INTEGRITY || stage == STAGE_MEMORY;
+}
+
+/**
+ * Bytes the memory stage reads per scan; larger candidate sets are sampled
+ * (see scanMemorySignatures), with a seed advanced on every scan so repeated
+ * deep scans cover different windows
+ */
+static const size_t MEMORY_SCAN_BYTE_BUDGET = 1024 * 1024;
+static atomic<uint32_t> g_memorySampleSeed(0);
+
+/**
+ * [DeviceTrust/Android] Class refs and method IDs resolved once in JNI_OnLoad
+ *
+ * Resolved on the loading thread, which has the app class loader; the
+ * monitor thread could not FindClass app classes itself. A null entry only
+ * disables its feature (stage streaming, monitor callbacks).
+ */
+struct JniCache {
+    JavaVM* vm = nullptr;
+    jclass stageListenerClass = nullptr;
+    jmethodID stageListenerOnStage = nullptr;
+    jclass monitorClass = nullptr;
+    jmethodID monitorOnNativeChange = nullptr;
+};
+
+static JniCache g_jni;
+
+/**
+ * Publishes each stage to a Kotlin NativeStageListener as soon as it
+ * finishes (streaming reports); no-op without a listener
+ */
+struct StageListener {
+    JNIEnv* env;
+    jobject listener;
+
+    StageListener(JNIEnv* env, jobject listener) : env(env), listener(listener) {}
+
+    void publish(const char* id, int signals, long long elapsedNs) {
+        if (listener == nullptr || g_jni.stageListenerOnStage == nullptr) {
+            return;
         }
+        jstring stageId = env->NewStringUTF(id);
+        env->CallVoidMethod(listener, g_jni.stageListenerOnStage, stageId, (jint)signals, (jlong)elapsedNs);
+        if (env->ExceptionCheck()) {
+            // Fail-soft: a throwing listener must not abort the scan
+            env->ExceptionClear();
+        }
+        env->DeleteLocalRef(stageId);
     }
+};
 
-    closedir(dir);
-    return found;
-}
+/**
+ * Every timed native stage: the hook stages (HookStage order) plus TracerPid
+ * and the FAST RWX count
+ *
+ * Work counters: maps lines (maps), fd entries (fd), resolved symbols
+ * (libc), symbols compared (integrity), bytes searched (memory), regions
+ * visited (rwx); none for tracerPid.
+ */
+enum TimedStage {
+    TIMED_MAPS = STAGE_MAPS,
+    TIMED_FD = STAGE_FD,
+    TIMED_LIBC = STAGE_LIBC,
+    TIMED_INTEGRITY = STAGE_INTEGRITY,
+    TIMED_MEMORY = STAGE_MEMORY,
+    TIMED_TRACER_PID = STAGE_COUNT,
+    TIMED_RWX,
+    TIMED_STAGE_COUNT
+};
+
+// Stage ids as published to the stage listener and in details['nativeStages']
+static const char* const TIMED_STAGE_IDS[TIMED_STAGE_COUNT] = {
+    "nativeMaps", "nativeFd", "nativeLibc", "nativeIntegrity", "nativeMemory", "nativeTracerPid", "nativeRwx",
+};
+static_assert(TIMED_STAGE_COUNT == DT_STAGE_COUNT, "dt_result stage arrays");
 
 /**
- * Check if a libc symbol resolves to the expected library using dladdr
- * May indicate hook/GOT manipulation
+ * Everything one collectNativeSignalsInto call found; rendered either as the
+ * packed binary result or, for debugging, as JSON
+ *
+ * Strings live in the calling thread's scan arena and stay valid until that
+ * thread's next scan.
  */
-struct LibcCheck {
-    string soPath;
-    bool unexpected = false;
+struct NativeSignals {
+    int level = SCAN_STANDARD;
+    int signalMask = 0;
+    int tracerPid = 0;
+    RegionAnalysis maps;
+    bool fdFrida = false;
+    SymbolImageCheck libc;
+    LibcIntegrity integrity;
+    MemorySignatureScan memory;
+    uint32_t skippedStages = 0;   // bit per HookStage
+    uint32_t demotedStages = 0;   // bit per HookStage
+    bool budgetExceeded = false;
+    long long nativeTimeNs = 0;
+    StageTiming stages[TIMED_STAGE_COUNT];
 };
 
-LibcCheck checkLibcSymbol() {
-    LibcCheck result;
-    
-    // Check getpid symbol
-    void* symbol = reinterpret_cast<void*>(getpid);
-    Dl_info info;
-    
-    if (dladdr(symbol, &info) != 0) {
-        if (info.dli_fname != nullptr) {
-            result.soPath = info.dli_fname;
-            
-            // Unexpected path (expected: /system/lib64/libc.so or /apex/.../libc.so)
-            string path = result.soPath;
-            if (path.find("/system/lib") == string::npos && 
-                path.find("/apex/") == string::npos &&
-                path.find("libc.so") == string::npos) {
-                result.unexpected = true;
+/**
+ * Per-thread scan arena, reset at the start of every scan; once warmed up a
+ * scan does not touch the heap
+ */
+static thread_local ScanArena t_scanArena;
+
+/**
+ * Hardware counters for each timed stage in debug builds, on devices where
+ * perf events are permitted (reported in the logged signals JSON); nullptr
+ * otherwise
+ */
+static PerfCounters* stagePerfCounters() {
+#ifdef DEBUG
+    static thread_local PerfCounters counters;
+    return counters.available() ? &counters : nullptr;
+#else
+    return nullptr;
+#endif
+}
+
+/**
+ * Runs the native stages for one scan
+ *
+ * @param verdictsOnly stop once the hook verdict is settled (see stage planner)
+ * @param budgetNs     latency budget; stages stop early once it is spent
+ * @param cancel       optional flag set by another thread; stages stop early
+ *                     once it is set, like an expired budget
+ */
+static NativeSignals collectSignals(int level, int signalMask, bool verdictsOnly, long long budgetNs,
+                                    StageListener& stageListener, const atomic<bool>* cancel = nullptr) {
+    TraceSection scanTrace("nativeScan");
+    long long startNs = monotonicNs();
+    Deadline deadline(budgetNs, cancel);
+    ScanArena& arena = t_scanArena;
+    arena.reset();
+    PerfCounters* perf = stagePerfCounters();
+    // Held for the whole scan: a pack loaded meanwhile applies to the next one
+    shared_ptr<const SignaturePack> signatures = activeSignaturePack();
+    NativeSignals result;
+    result.level = level;
+    result.signalMask = signalMask;
+
+    // 0. TracerPid (all tiers; debugger group)
+    if (signalMask & (SIGNAL_HOOK | SIGNAL_DEBUGGER)) {
+        TraceSection trace(TIMED_STAGE_IDS[TIMED_TRACER_PID]);
+        StageTimer timer(result.stages[TIMED_TRACER_PID], perf);
+        result.tracerPid = readTracerPid();
+        long long stageNs = timer.stop(0);
+        telemetry().record("nativeTracerPid", TELEMETRY_CALL, stageNs);
+        stageListener.publish("nativeTracerPid", result.tracerPid > 0, stageNs);
+    }
+
+    bool hookRequested = (signalMask & SIGNAL_HOOK) != 0;
+
+    if (hookRequested && level == SCAN_FAST) {
+        // 1. Quick RWX count; Frida module paths are matched in the same
+        // pass so the hook verdict has two hook signals to go on
+        TraceSection trace(TIMED_STAGE_IDS[TIMED_RWX]);
+        StageTimer timer(result.stages[TIMED_RWX], perf);
+        RwxCount rwx = countRwxRegions(g_procfs, deadline, signatures->keywords(SIGNATURE_MODULE_KEYWORDS));
+        result.maps.rwxSegments = rwx.rwxSegments;
+        result.maps.hasRwx = rwx.rwxSegments > 0;
+        result.maps.fridaLibLoaded = rwx.fridaLibLoaded;
+        result.maps.truncated = rwx.truncated;
+        long long stageNs = timer.stop(rwx.visited);
+        telemetry().record("nativeRwx", TELEMETRY_CALL, stageNs);
+        stageListener.publish("nativeRwx", result.maps.hasRwx + result.maps.fridaLibLoaded, stageNs);
+    } else if (hookRequested) {
+        // Stages for this tier, in planned order; open breakers only run in DEEP
+        int order[STAGE_COUNT];
+        double score[STAGE_COUNT];
+        int stageCount = 0;
+        for (int stage = 0; stage < STAGE_COUNT; stage++) {
+            if (isDeepStage(stage) && level < SCAN_DEEP) {
+                continue;
+            }
+            const StagePlan& plan = STAGE_PLANS[stage];
+            if (checkBreakers().admit(plan.statsKey, wallClockMs()) == BREAKER_OPEN && level < SCAN_DEEP) {
+                result.demotedStages |= 1u << stage;
+                continue;
             }
+            score[stage] = checkBreakers().score(plan.statsKey, plan.priorNs);
+            order[stageCount++] = stage;
+        }
+        sort(order, order + stageCount, [&score](int a, int b) {
+            return score[a] < score[b];
+        });
+
+        int signals = 0;
+        for (int i = 0; i < stageCount; i++) {
+            int stage = order[i];
+
+            if (verdictsOnly) {
+                int reachable = signals;
+                for (int j = i; j < stageCount; j++) {
+                    reachable += STAGE_PLANS[order[j]].maxSignals;
+                }
+                if (signals >= HOOK_SIGNAL_THRESHOLD || reachable < HOOK_SIGNAL_THRESHOLD) {
+                    result.skippedStages |= 1u << stage;
+                    telemetry().record(STAGE_PLANS[stage].statsKey, TELEMETRY_CANCELLATION);
+                    continue;
+                }
+            }
+            if (deadline.expired()) {
+                // Budget spent or scan cancelled: this and the remaining planned stages do not run
+                TelemetryEvent event = deadline.cancelled() ? TELEMETRY_CANCELLATION : TELEMETRY_TIMEOUT;
+                for (int j = i; j < stageCount; j++) {
+                    telemetry().record(STAGE_PLANS[order[j]].statsKey, event);
+                }
+                break;
+            }
+
+            TraceSection trace(TIMED_STAGE_IDS[stage]);
+            StageTimer timer(result.stages[stage], perf);
+            int stageSignals = 0;
+            int items = 0;
+            switch (stage) {
+                case STAGE_MAPS:
+                    // /proc/self/maps analysis
+                    result.maps = analyzeRegions(g_procfs, deadline, arena,
+                                                 signatures->keywords(SIGNATURE_MODULE_KEYWORDS));
+                    stageSignals = result.maps.fridaLibLoaded + result.maps.hasRwx;
+                    items = result.maps.visited;
+                    break;
+                case STAGE_FD: {
+                    // /proc/self/fd check
+                    OpenFileMatch fd = scanOpenFiles(g_procfs, deadline, signatures->keywords(SIGNATURE_FD_KEYWORDS));
+                    result.fdFrida = fd.found;
+                    stageSignals = result.fdFrida;
+                    items = fd.visited;
+                    break;
+                }
+                case STAGE_LIBC:
+                    // libc symbol check
+                    result.libc = checkSymbolImage(g_procfs, arena, reinterpret_cast<void*>(getpid), LIBC_IMAGE_FRAGMENTS_LINUX);
+                    stageSignals = result.libc.unexpected;
+                    items = !result.libc.imagePath.empty();
+                    break;
+                case STAGE_INTEGRITY:
+                    // libc ELF/GOT integrity (deep only)
+                    result.integrity = checkLibcIntegrity(deadline, arena);
+                    stageSignals = !result.integrity.gotMismatch.empty() + !result.integrity.textMismatch.empty();
+                    items = result.integrity.checkedSymbols;
+                    break;
+                case STAGE_MEMORY:
+                    // Frida byte signatures in anonymous / memfd memory (deep only),
+                    // windows split across the big cores
+                    result.memory = scanMemorySignatures(g_procfs, deadline, arena,
+                                                         signatures->list(SIGNATURE_MEMORY_SIGNATURES),
+                                                         MEMORY_SCAN_BYTE_BUDGET, g_memorySampleSeed.fetch_add(1),
+                                                         256, &deepScanPool());
+                    stageSignals = result.memory.found;
+                    items = (int)result.memory.bytesScanned;
+                    break;
+            }
+            long long stageNs = timer.stop(items);
+            const StagePlan& plan = STAGE_PLANS[stage];
+            checkBreakers().record(plan.statsKey, (double)stageNs, stageSignals > 0, stageNs > plan.budgetNs, wallClockMs());
+            telemetry().record(plan.statsKey, TELEMETRY_CALL, stageNs);
+            if (stageNs > plan.budgetNs) {
+                telemetry().record(plan.statsKey, TELEMETRY_TIMEOUT);
+            }
+            stageListener.publish(plan.statsKey, stageSignals, stageNs);
+            signals += stageSignals;
         }
     }
-    
+
+    // A cancelled scan is cut short too: the groups it left out must not be cleared
+    result.budgetExceeded = deadline.hit;
+    result.nativeTimeNs = monotonicNs() - startNs;
     return result;
 }
 
-string escapeJsonString(const string& str) {
-    string escaped;
-    for (char c : str) {
-        if (c == '"' || c == '\\') {
-            escaped += '\\';
+#ifdef DEBUG
+static vector<string> stageNames(uint32_t stageMask) {
+    vector<string> names;
+    for (int stage = 0; stage < STAGE_COUNT; stage++) {
+        if (stageMask & (1u << stage)) {
+            names.push_back(STAGE_PLANS[stage].name);
         }
-        escaped += c;
     }
-    return escaped;
+    return names;
 }
 
-string vectorToJsonArray(const vector<string>& vec) {
-    if (vec.empty()) {
-        return "[]";
+/**
+ * [DeviceTrust/Android] JSON rendering (debug builds only, logged per scan)
+ * Same fields as the binary result; see NativeResult (DeviceTrustNativeResult.kt).
+ */
+static string renderSignalsJson(const NativeSignals& signals) {
+    ostringstream json;
+    json << "{";
+    json << "\"scanLevel\":" << signals.level << ",";
+    json << "\"signalMask\":" << signals.signalMask << ",";
+    json << "\"tracerPid\":" << signals.tracerPid << ",";
+    json << "\"rwxSegments\":" << signals.maps.rwxSegments << ",";
+    json << "\"hasRwx\":" << (signals.maps.hasRwx ? "true" : "false") << ",";
+    json << "\"fridaLibLoaded\":" << (signals.maps.fridaLibLoaded ? "true" : "false") << ",";
+    json << "\"fdFrida\":" << (signals.fdFrida ? "true" : "false") << ",";
+    json << "\"libcGetpidSo\":\"" << escapeJsonString(signals.libc.imagePath) << "\",";
+    json << "\"libcGetpidUnexpected\":" << (signals.libc.unexpected ? "true" : "false") << ",";
+    if (signals.level >= SCAN_DEEP) {
+        json << "\"libcSymbolsChecked\":" << signals.integrity.checkedSymbols << ",";
+        json << "\"gotMismatch\":" << vectorToJsonArray(signals.integrity.gotMismatch) << ",";
+        json << "\"textMismatch\":" << vectorToJsonArray(signals.integrity.textMismatch) << ",";
+        json << "\"memorySignature\":\"" << escapeJsonString(signals.memory.found ? signals.memory.signature : "")
+             << "\",";
+        json << "\"memoryRegion\":\"" << escapeJsonString(signals.memory.regionPath) << "\",";
+        json << "\"memoryRegionStart\":" << signals.memory.regionStart << ",";
+        json << "\"memoryMatchAddress\":" << signals.memory.address << ",";
+        json << "\"memoryCandidateBytes\":" << signals.memory.candidateBytes << ",";
+        json << "\"memorySampled\":" << (signals.memory.sampled ? "true" : "false") << ",";
     }
-    
-    string json = "[";
-    for (size_t i = 0; i < vec.size(); i++) {
-        json += "\"" + escapeJsonString(vec[i]) + "\"";
-        if (i < vec.size() - 1) {
-            json += ",";
+    json << "\"skipped\":" << vectorToJsonArray(stageNames(signals.skippedStages)) << ",";
+    json << "\"demoted\":" << vectorToJsonArray(stageNames(signals.demotedStages)) << ",";
+    json << "\"budgetExceeded\":" << (signals.budgetExceeded ? "true" : "false") << ",";
+    json << "\"nativeTimeMs\":" << signals.nativeTimeNs / 1e6 << ",";
+    json << "\"nativeTimeNs\":" << signals.nativeTimeNs << ",";
+    json << "\"stages\":{";
+    bool firstStage = true;
+    for (int stage = 0; stage < TIMED_STAGE_COUNT; stage++) {
+        const StageTiming& timing = signals.stages[stage];
+        if (!timing.ran) {
+            continue;
+        }
+        json << (firstStage ? "" : ",") << "\"" << TIMED_STAGE_IDS[stage] << "\":{\"ns\":" << timing.ns
+             << ",\"items\":" << timing.items;
+        if (timing.perf.valid != 0) {
+            json << ",\"perf\":{";
+            bool firstCounter = true;
+            for (int counter = 0; counter < PERF_COUNTER_COUNT; counter++) {
+                if (!timing.perf.has(static_cast<PerfCounter>(counter))) {
+                    continue;
+                }
+                json << (firstCounter ? "" : ",") << "\"" << PERF_COUNTER_NAMES[counter]
+                     << "\":" << timing.perf.values[counter];
+                firstCounter = false;
+            }
+            json << "}";
         }
+        json << "}";
+        firstStage = false;
+    }
+    json << "},";
+    json << "\"suspiciousModules\":" << vectorToJsonArray(signals.maps.suspiciousModules);
+    json << "}";
+    return json.str();
+}
+#endif
+
+/**
+ * [DeviceTrust/Android] Packed binary result (version 4)
+ *
+ * Native byte order; decoded with absolute reads by DeviceTrustNativeResult.kt.
+ * Offsets must stay in sync with that file; bump RESULT_VERSION on change.
+ *
+ *   0  u32  magic 'DTN1'
+ *   4  u16  version
+ *   6  u16  bytes written
+ *   8  u32  flags (RESULT_FLAG_*)
+ *  12  i32  scanLevel
+ *  16  i32  signalMask
+ *  20  i32  tracerPid
+ *  24  i32  rwxSegments
+ *  28  i32  libcSymbolsChecked
+ *  32  u32  skipped stage bits (HookStage)
+ *  36  u32  demoted stage bits (HookStage)
+ *  40  i64  nativeTimeNs
+ *  48  u32  timed stages that ran (bit per TimedStage)
+ *  52  u32  reserved (0)
+ *  56  i64  stage ns, TIMED_STAGE_COUNT entries in TimedStage order
+ * 112  i32  stage work counters, same order
+ * 140  u32  reserved (0)
+ * 144  u64  memoryRegionStart (region holding the memory signature; 0 if none)
+ * 152  u64  memoryMatchAddress
+ * 160  ...  string lists, each u16 count + (u16 length + UTF-8 bytes)*:
+ *           libcGetpidSo (count 0/1), memorySignature (count 0/1),
+ *           memoryRegionPath (count 0/1; empty for anonymous regions),
+ *           gotMismatch, textMismatch, suspiciousModules
+ *
+ * The single-entry lists come first so unbounded ones cannot crowd them out.
+ * Lists that do not fit are cut short and RESULT_FLAG_TRUNCATED is set; every
+ * later list is still written (possibly empty). Signals never depend on list
+ * space: each has a header flag.
+ */
+static const uint32_t RESULT_MAGIC = 0x314E5444;  // "DTN1" little-endian
+static const uint16_t RESULT_VERSION = 4;
+static const size_t RESULT_STAGE_NS_OFFSET = 56;
+static const size_t RESULT_STAGE_ITEMS_OFFSET = RESULT_STAGE_NS_OFFSET + 8 * TIMED_STAGE_COUNT;
+static const size_t RESULT_MEMORY_OFFSET = RESULT_STAGE_ITEMS_OFFSET + 4 * TIMED_STAGE_COUNT + 4;
+static const size_t RESULT_HEADER_SIZE = RESULT_MEMORY_OFFSET + 16;
+static_assert(RESULT_MEMORY_OFFSET % 8 == 0, "u64 fields stay aligned");
+
+enum ResultFlag {
+    RESULT_FLAG_HAS_RWX = 1 << 0,
+    RESULT_FLAG_FRIDA_LIB = 1 << 1,
+    RESULT_FLAG_FD_FRIDA = 1 << 2,
+    RESULT_FLAG_LIBC_UNEXPECTED = 1 << 3,
+    RESULT_FLAG_BUDGET_EXCEEDED = 1 << 4,
+    RESULT_FLAG_TRUNCATED = 1 << 5,
+    RESULT_FLAG_MEMORY_SAMPLED = 1 << 6,  // memory stage read sampled windows only
+    RESULT_FLAG_MEMORY_SIGNATURE = 1 << 7
+};
+
+/**
+ * String lists of the packed result, in layout order (shared with dt_result);
+ * a list that is cut short sets writer.truncated
+ */
+static void writeSignalLists(const NativeSignals& signals, PackedWriter& writer) {
+    const StringRef& libcSo = signals.libc.imagePath;
+    const MemorySignatureScan& memory = signals.memory;
+    StringRef signature;
+    if (memory.found) {
+        signature = StringRef{memory.signature, strlen(memory.signature)};
+    }
+    writer.putList(&libcSo, libcSo.empty() ? 0 : 1);
+    writer.putList(&signature, memory.found ? 1 : 0);
+    writer.putList(&memory.regionPath, memory.found ? 1 : 0);
+    writer.putList(signals.integrity.gotMismatch);
+    writer.putList(signals.integrity.textMismatch);
+    writer.putList(signals.maps.suspiciousModules);
+}
+
+static uint32_t stagesRan(const NativeSignals& signals) {
+    uint32_t bits = 0;
+    for (int stage = 0; stage < TIMED_STAGE_COUNT; stage++) {
+        bits |= signals.stages[stage].ran ? 1u << stage : 0;
+    }
+    return bits;
+}
+
+static uint32_t resultFlags(const NativeSignals& signals, bool truncated) {
+    uint32_t flags = 0;
+    flags |= signals.maps.hasRwx ? RESULT_FLAG_HAS_RWX : 0;
+    flags |= signals.maps.fridaLibLoaded ? RESULT_FLAG_FRIDA_LIB : 0;
+    flags |= signals.fdFrida ? RESULT_FLAG_FD_FRIDA : 0;
+    flags |= signals.libc.unexpected ? RESULT_FLAG_LIBC_UNEXPECTED : 0;
+    flags |= signals.budgetExceeded ? RESULT_FLAG_BUDGET_EXCEEDED : 0;
+    flags |= truncated ? RESULT_FLAG_TRUNCATED : 0;
+    flags |= signals.memory.sampled ? RESULT_FLAG_MEMORY_SAMPLED : 0;
+    flags |= signals.memory.found ? RESULT_FLAG_MEMORY_SIGNATURE : 0;
+    return flags;
+}
+
+/**
+ * @return bytes written, or -1 if [capacity] cannot hold the header
+ */
+static int writeSignalsBinary(const NativeSignals& signals, uint8_t* buf, size_t capacity) {
+    if (buf == nullptr || capacity < RESULT_HEADER_SIZE + 8) {
+        return -1;
+    }
+    capacity = min(capacity, (size_t)UINT16_MAX);
+    PackedWriter writer{buf, capacity, RESULT_HEADER_SIZE};
+    writeSignalLists(signals, writer);
+
+    writer.putAt<uint32_t>(0, RESULT_MAGIC);
+    writer.putAt<uint16_t>(4, RESULT_VERSION);
+    writer.putAt<uint16_t>(6, (uint16_t)writer.pos);
+    writer.putAt<uint32_t>(8, resultFlags(signals, writer.truncated));
+    writer.putAt<int32_t>(12, signals.level);
+    writer.putAt<int32_t>(16, signals.signalMask);
+    writer.putAt<int32_t>(20, signals.tracerPid);
+    writer.putAt<int32_t>(24, signals.maps.rwxSegments);
+    writer.putAt<int32_t>(28, signals.integrity.checkedSymbols);
+    writer.putAt<uint32_t>(32, signals.skippedStages);
+    writer.putAt<uint32_t>(36, signals.demotedStages);
+    writer.putAt<int64_t>(40, signals.nativeTimeNs);
+    writer.putAt<uint32_t>(48, stagesRan(signals));
+    writer.putAt<uint32_t>(52, 0);
+    for (int stage = 0; stage < TIMED_STAGE_COUNT; stage++) {
+        writer.putAt<int64_t>(RESULT_STAGE_NS_OFFSET + 8 * stage, signals.stages[stage].ns);
+        writer.putAt<int32_t>(RESULT_STAGE_ITEMS_OFFSET + 4 * stage, signals.stages[stage].items);
+    }
+    writer.putAt<uint32_t>(RESULT_MEMORY_OFFSET - 4, 0);
+    writer.putAt<uint64_t>(RESULT_MEMORY_OFFSET, signals.memory.regionStart);
+    writer.putAt<uint64_t>(RESULT_MEMORY_OFFSET + 8, signals.memory.address);
+    return (int)writer.pos;
+}
+
+/**
+ * JNI method: collects native signals into a caller-provided direct ByteBuffer
+ *
+ * @param level        ScanLevel (0 = fast, 1 = standard, 2 = deep)
+ * @param signalMask   SignalGroup bits; unrequested stages are never run
+ * @param verdictsOnly stop once the hook verdict is settled (see stage planner)
+ * @param budgetNs     latency budget; stages stop early once it is spent
+ * @param listener     optional NativeStageListener, called after each stage
+ * @param cancelFlag   optional 1-byte direct ByteBuffer (ScanCancel); the
+ *                     stages and the deep scan workers stop once it is non-zero
+ * @param buffer       direct ByteBuffer receiving the packed result
+ * @return bytes written; -1 if the buffer is not direct or too small
+ */
+static jint JNICALL
+nativeCollectSignalsInto(
+    JNIEnv* env,
+    jobject /* this */,
+    jint level,
+    jint signalMask,
+    jboolean verdictsOnly,
+    jlong budgetNs,
+    jobject listener,
+    jobject cancelFlag,
+    jobject buffer) {
+    uint8_t* buf = static_cast<uint8_t*>(env->GetDirectBufferAddress(buffer));
+    jlong capacity = env->GetDirectBufferCapacity(buffer);
+    if (buf == nullptr || capacity <= 0) {
+        return -1;
+    }
+    // The buffer stays reachable (a local ref) for the whole call; Kotlin
+    // stores 1 into its only byte
+    static_assert(sizeof(atomic<bool>) == 1 && ATOMIC_BOOL_LOCK_FREE == 2, "flag byte is an atomic<bool>");
+    const atomic<bool>* cancel = nullptr;
+    if (cancelFlag != nullptr && env->GetDirectBufferCapacity(cancelFlag) >= 1) {
+        cancel = static_cast<const atomic<bool>*>(env->GetDirectBufferAddress(cancelFlag));
+    }
+
+    StageListener stageListener(env, listener);
+    NativeSignals signals = collectSignals(level, signalMask, verdictsOnly, budgetNs, stageListener, cancel);
+
+    #ifdef DEBUG
+    LOGD("Native signals: %s", renderSignalsJson(signals).c_str());
+    #endif
+
+    return writeSignalsBinary(signals, buf, (size_t)capacity);
+}
+
+/**
+ * JNI method: captures every input of the native checks (maps, status, task
+ * comms, fd targets, images, getpid image) as a snapshot bundle for offline
+ * replay (src/core/snapshot.h, src/tools/snapshot_tool.cpp)
+ *
+ * @return compressed bundle; null if /proc/self/maps is unreadable
+ */
+static jbyteArray JNICALL
+nativeCaptureSnapshot(
+    JNIEnv* env,
+    jobject /* this */) {
+    Snapshot snapshot;
+    string bundle;
+    if (!captureSnapshot(g_procfs, reinterpret_cast<void*>(getpid), &snapshot) ||
+        !encodeSnapshot(snapshot, &bundle)) {
+        return nullptr;
+    }
+    jbyteArray array = env->NewByteArray((jsize)bundle.size());
+    if (array != nullptr) {
+        env->SetByteArrayRegion(array, 0, (jsize)bundle.size(), reinterpret_cast<const jbyte*>(bundle.data()));
+    }
+    return array;
+}
+
+/**
+ * JNI methods: check breakers (see CheckBreakers)
+ *
+ * Ids are the Kotlin check ids (details keys); native stages use the
+ * statsKey of their StagePlan.
+ */
+static jint JNICALL
+nativeAdmitCheck(
+    JNIEnv* env,
+    jobject /* this */,
+    jstring id) {
+    const char* name = env->GetStringUTFChars(id, nullptr);
+    if (name == nullptr) {
+        return BREAKER_CLOSED;
+    }
+    int state = checkBreakers().admit(name, wallClockMs());
+    env->ReleaseStringUTFChars(id, name);
+    return state;
+}
+
+static void JNICALL
+nativeRecordCheck(
+    JNIEnv* env,
+    jobject /* this */,
+    jstring id,
+    jlong elapsedNs,
+    jboolean hit,
+    jboolean overBudget) {
+    const char* name = env->GetStringUTFChars(id, nullptr);
+    if (name == nullptr) {
+        return;
+    }
+    checkBreakers().record(name, (double)elapsedNs, hit, overBudget, wallClockMs());
+    telemetry().record(name, TELEMETRY_CALL, elapsedNs > 0 ? (uint64_t)elapsedNs : 0);
+    if (overBudget) {
+        telemetry().record(name, TELEMETRY_TIMEOUT);
+    }
+    env->ReleaseStringUTFChars(id, name);
+}
+
+/**
+ * [DeviceTrust/Android] Cumulative telemetry (see core/telemetry.h)
+ *
+ * Calls and over-budget runs of Kotlin checks arrive through recordCheck;
+ * recordEvent carries their cache hits, timeouts and cancellations.
+ */
+static void JNICALL
+nativeRecordEvent(
+    JNIEnv* env,
+    jobject /* this */,
+    jstring id,
+    jint event,
+    jlong elapsedNs) {
+    if (event < 0 || event >= TELEMETRY_EVENT_COUNT) {
+        return;
+    }
+    const char* name = env->GetStringUTFChars(id, nullptr);
+    if (name == nullptr) {
+        return;
+    }
+    telemetry().record(name, static_cast<TelemetryEvent>(event), elapsedNs > 0 ? (uint64_t)elapsedNs : 0);
+    env->ReleaseStringUTFChars(id, name);
+}
+
+/**
+ * [DeviceTrust/Android] Trace ring (see core/trace.h)
+ *
+ * Kotlin checks trace themselves with android.os.Trace and add their
+ * System.nanoTime() interval here, so the Chrome trace export shows both
+ * layers on one timeline.
+ */
+static void JNICALL
+nativeRecordTrace(
+    JNIEnv* env,
+    jobject /* this */,
+    jstring name,
+    jlong beginNs,
+    jlong durationNs) {
+    const char* chars = env->GetStringUTFChars(name, nullptr);
+    if (chars == nullptr) {
+        return;
+    }
+    recordTraceSection(chars, beginNs, durationNs);
+    env->ReleaseStringUTFChars(name, chars);
+}
+
+static jstring JNICALL
+nativeDumpTrace(
+    JNIEnv* env,
+    jobject /* this */) {
+    return env->NewStringUTF(traceRing().toChromeJson().c_str());
+}
+
+static jstring JNICALL
+nativeStatsSnapshot(
+    JNIEnv* env,
+    jobject /* this */) {
+    TelemetrySnapshot snapshot;
+    telemetry().snapshot(&snapshot);
+    return env->NewStringUTF(telemetryToJson(snapshot).c_str());
+}
+
+static jdouble JNICALL
+nativeCheckScore(
+    JNIEnv* env,
+    jobject /* this */,
+    jstring id,
+    jdouble priorNs) {
+    const char* name = env->GetStringUTFChars(id, nullptr);
+    if (name == nullptr) {
+        return priorNs * 2;
+    }
+    double score = checkBreakers().score(name, priorNs);
+    env->ReleaseStringUTFChars(id, name);
+    return score;
+}
+
+static jstring JNICALL
+nativeDemotedChecks(
+    JNIEnv* env,
+    jobject /* this */) {
+    TelemetrySnapshot snapshot;
+    telemetry().snapshot(&snapshot);
+    return env->NewStringUTF(checkBreakers().demotedJson(snapshot).c_str());
+}
+
+static jstring JNICALL
+nativeExportStats(
+    JNIEnv* env,
+    jobject /* this */) {
+    return env->NewStringUTF(checkBreakers().exportText().c_str());
+}
+
+static jint JNICALL
+nativeImportStats(
+    JNIEnv* env,
+    jobject /* this */,
+    jstring text) {
+    const char* chars = env->GetStringUTFChars(text, nullptr);
+    if (chars == nullptr) {
+        return 0;
     }
-    json += "]";
-    return json;
+    int restored = checkBreakers().importText(chars);
+    env->ReleaseStringUTFChars(text, chars);
+    return restored;
 }
 
 /**
- * JNI method: collects native signals and returns JSON string
+ * [DeviceTrust/Android] Signature packs (see core/signature_pack.h)
+ *
+ * loadSignaturePack maps, validates and installs a pack; scans started
+ * afterwards use it. The list getters serve the Kotlin-side checks (su
+ * paths, root packages, ...) and return null for sections the active pack
+ * leaves to the built-in Kotlin lists.
  */
-extern "C" JNIEXPORT jstring JNICALL
-Java_com_mikoloy_device_1trust_DeviceTrustNative_collectNativeSignals(
+static jint JNICALL
+nativeLoadSignaturePack(
+    JNIEnv* env,
+    jobject /* this */,
+    jstring path) {
+    const char* chars = env->GetStringUTFChars(path, nullptr);
+    if (chars == nullptr) {
+        return SIGNATURE_PACK_IO_ERROR;
+    }
+    SignaturePackStatus status;
+    shared_ptr<const SignaturePack> pack = SignaturePack::open(chars, &status);
+    env->ReleaseStringUTFChars(path, chars);
+    if (pack == nullptr) {
+        return status;
+    }
+    status = installSignaturePack(pack);
+    return status == SIGNATURE_PACK_OK ? (jint)pack->version() : status;
+}
+
+/**
+ * Text sections only: parse checked their entries to be valid modified
+ * UTF-8 for NewStringUTF; byte signatures are never handed to Java
+ */
+static jobjectArray JNICALL
+nativeSignatureList(
+    JNIEnv* env,
+    jobject /* this */,
+    jint section) {
+    if (!isTextSection(section)) {
+        return nullptr;
+    }
+    shared_ptr<const SignaturePack> pack = activeSignaturePack();
+    const char* const* list = pack->list(static_cast<SignatureSection>(section));
+    if (list == nullptr) {
+        return nullptr;
+    }
+    jsize count = 0;
+    while (list[count] != nullptr) {
+        count++;
+    }
+    jclass stringClass = env->FindClass("java/lang/String");
+    if (stringClass == nullptr) {
+        env->ExceptionClear();
+        return nullptr;
+    }
+    jobjectArray array = env->NewObjectArray(count, stringClass, nullptr);
+    env->DeleteLocalRef(stringClass);
+    if (array == nullptr) {
+        env->ExceptionClear();
+        return nullptr;
+    }
+    for (jsize i = 0; i < count; i++) {
+        jstring entry = env->NewStringUTF(list[i]);
+        if (entry == nullptr) {
+            env->ExceptionClear();
+            env->DeleteLocalRef(array);
+            return nullptr;
+        }
+        env->SetObjectArrayElement(array, i, entry);
+        env->DeleteLocalRef(entry);
+    }
+    return array;
+}
+
+static jintArray JNICALL
+nativeSignaturePorts(
     JNIEnv* env,
     jobject /* this */) {
-    
-    auto startTime = chrono::high_resolution_clock::now();
+    shared_ptr<const SignaturePack> pack = activeSignaturePack();
+    if (!pack->hasPorts()) {
+        return nullptr;
+    }
+    const vector<uint16_t>& ports = pack->fridaPorts();
+    jintArray array = env->NewIntArray((jsize)ports.size());
+    if (array == nullptr) {
+        env->ExceptionClear();
+        return nullptr;
+    }
+    vector<jint> values(ports.begin(), ports.end());
+    env->SetIntArrayRegion(array, 0, (jsize)values.size(), values.data());
+    return array;
+}
+
+/**
+ * [DeviceTrust/Android] Published verdict (see core/verdict.h)
+ *
+ * Kotlin publishes the flags of every report it builds (or Dart, when the
+ * native signals came through dart:ffi); the monitor marks the word pending
+ * as soon as a detector changes. Readers on any thread get the latest
+ * verdict with one atomic load through verdictWord() or dt_verdict_load().
+ */
+static VerdictBlock g_verdict;
+
+// Same clock as SystemClock.elapsedRealtime(), so Kotlin can compute the age itself
+static long long bootTimeMs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_BOOTTIME, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static jlong JNICALL
+nativeVerdictWord(
+    JNIEnv* /* env */,
+    jobject /* this */) {
+    return (jlong)g_verdict.load();
+}
+
+/**
+ * @param groups SignalGroup bits the report evaluated completely
+ * @param flags  VERDICT_* bits of the report
+ * @param level  scan level of the report (hook tier)
+ */
+static void JNICALL
+nativePublishVerdict(
+    JNIEnv* /* env */,
+    jobject /* this */,
+    jint groups,
+    jint flags,
+    jint level) {
+    g_verdict.publish((uint32_t)groups, (uint32_t)flags, (uint32_t)level, (uint64_t)bootTimeMs());
+}
+
+/**
+ * [DeviceTrust/Android] Background monitor
+ *
+ * Polls cheap dynamic detectors on a native thread and calls
+ * DeviceTrustMonitor.onNativeChange(json) when one of them changes:
+ * - dl_iterate_phdr load/unload counters (dlpi_adds/dlpi_subs)
+ * - thread count (jumps of MONITOR_THREAD_JUMP or more)
+ * - TracerPid
+ * - RWX segment count
+ *
+ * The interval starts at minIntervalMs after a change and doubles up to
+ * maxIntervalMs while nothing changes. It never drops below the last
+ * tick's CPU time / MONITOR_CPU_BUDGET, so the thread stays under 0.1% of
+ * one core regardless of how expensive the maps scan is on the device.
+ */
+static const double MONITOR_CPU_BUDGET = 0.001;
+static const int MONITOR_THREAD_JUMP = 3;
+static const long long MONITOR_RWX_SCAN_BUDGET_NS = 50000000LL;
+
+struct MonitorSnapshot {
+    unsigned long long libAdds = 0;
+    unsigned long long libSubs = 0;
+    int threads = 0;
+    int tracerPid = 0;
+    int rwxSegments = 0;
+};
+
+
+static thread g_monitorThread;
+static mutex g_monitorMutex;
+static condition_variable g_monitorWake;
+static bool g_monitorStop = false;
+static atomic<bool> g_monitorRunning(false);
+
+// Stats since the last start (read by monitorStats)
+static atomic<long long> g_monitorTicks(0);
+static atomic<long long> g_monitorChanges(0);
+static atomic<long long> g_monitorCpuNs(0);
+static atomic<long long> g_monitorStartNs(0);
+static atomic<long long> g_monitorIntervalMs(0);
 
-    // 1. /proc/self/maps analysis
-    MapsAnalysis mapsResult = analyzeProcMaps();
+static long long threadCpuNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
 
-    // 2. /proc/self/fd check
-    bool fdFrida = checkFdForFrida();
+static int libCountersCallback(struct dl_phdr_info* info, size_t size, void* data) {
+    MonitorSnapshot* snapshot = static_cast<MonitorSnapshot*>(data);
+    if (size >= offsetof(struct dl_phdr_info, dlpi_subs) + sizeof(info->dlpi_subs)) {
+        // Counters are process-wide; the first entry is enough
+        snapshot->libAdds = info->dlpi_adds;
+        snapshot->libSubs = info->dlpi_subs;
+        return 1;
+    }
+    // Older linkers without counters: count loaded objects instead
+    snapshot->libAdds++;
+    return 0;
+}
 
-    // 3. libc symbol check
-    LibcCheck libcResult = checkLibcSymbol();
+static MonitorSnapshot takeMonitorSnapshot() {
+    MonitorSnapshot snapshot;
+    dl_iterate_phdr(libCountersCallback, &snapshot);
+    ProcStatus status = readProcStatus(g_procfs.source());
+    snapshot.threads = status.threads;
+    snapshot.tracerPid = status.tracerPid;
+    Deadline deadline(MONITOR_RWX_SCAN_BUDGET_NS);
+    snapshot.rwxSegments = countRwxRegions(g_procfs, deadline).rwxSegments;
+    return snapshot;
+}
 
-    auto endTime = chrono::high_resolution_clock::now();
-    chrono::duration<double, milli> elapsed = endTime - startTime;
+static vector<string> monitorTriggers(const MonitorSnapshot& base, const MonitorSnapshot& now) {
+    vector<string> triggers;
+    if (now.libAdds != base.libAdds || now.libSubs != base.libSubs) {
+        triggers.push_back("libraries");
+    }
+    if (abs(now.threads - base.threads) >= MONITOR_THREAD_JUMP) {
+        triggers.push_back("threads");
+    }
+    if (now.tracerPid != base.tracerPid) {
+        triggers.push_back("tracerPid");
+    }
+    if (now.rwxSegments != base.rwxSegments) {
+        triggers.push_back("rwxSegments");
+    }
+    return triggers;
+}
 
-    // [DeviceTrust/Android] Build JSON response
-    // Native signal report returned to Kotlin layer.
-    // Format compatible with parseNativeSignals in DeviceTrust.kt.
+static string monitorStatsJson() {
+    long long wallNs = g_monitorStartNs.load() > 0 ? monotonicNs() - g_monitorStartNs.load() : 0;
+    long long cpuNs = g_monitorCpuNs.load();
     ostringstream json;
     json << "{";
-    json << "\"rwxSegments\":" << mapsResult.rwxSegments << ",";
-    json << "\"hasRwx\":" << (mapsResult.hasRwx ? "true" : "false") << ",";
-    json << "\"fridaLibLoaded\":" << (mapsResult.fridaLibLoaded ? "true" : "false") << ",";
-    json << "\"fdFrida\":" << (fdFrida ? "true" : "false") << ",";
-    json << "\"libcGetpidSo\":\"" << escapeJsonString(libcResult.soPath) << "\",";
-    json << "\"libcGetpidUnexpected\":" << (libcResult.unexpected ? "true" : "false") << ",";
-    json << "\"nativeTimeMs\":" << elapsed.count() << ",";
-    json << "\"suspiciousModules\":" << vectorToJsonArray(mapsResult.suspiciousModules);
+    json << "\"running\":" << (g_monitorRunning.load() ? "true" : "false") << ",";
+    json << "\"ticks\":" << g_monitorTicks.load() << ",";
+    json << "\"changes\":" << g_monitorChanges.load() << ",";
+    json << "\"intervalMs\":" << g_monitorIntervalMs.load() << ",";
+    json << "\"cpuMs\":" << cpuNs / 1e6 << ",";
+    json << "\"cpuPercent\":" << (wallNs > 0 ? 100.0 * cpuNs / wallNs : 0.0);
     json << "}";
-    // [DeviceTrust/Android] JSON build complete
+    return json.str();
+}
 
-    string result = json.str();
-    
-    #ifdef DEBUG
-    LOGD("Native signals: %s", result.c_str());
-    #endif
+static void notifyMonitorChange(JNIEnv* env, const MonitorSnapshot& snapshot, const vector<string>& triggers) {
+    ostringstream json;
+    json << "{";
+    json << "\"triggers\":" << vectorToJsonArray(triggers) << ",";
+    json << "\"libAdds\":" << snapshot.libAdds << ",";
+    json << "\"libSubs\":" << snapshot.libSubs << ",";
+    json << "\"threads\":" << snapshot.threads << ",";
+    json << "\"tracerPid\":" << snapshot.tracerPid << ",";
+    json << "\"rwxSegments\":" << snapshot.rwxSegments << ",";
+    json << "\"stats\":" << monitorStatsJson();
+    json << "}";
+
+    jstring payload = env->NewStringUTF(json.str().c_str());
+    env->CallStaticVoidMethod(g_jni.monitorClass, g_jni.monitorOnNativeChange, payload);
+    if (env->ExceptionCheck()) {
+        // Fail-soft: a throwing listener must not kill the monitor thread
+        env->ExceptionClear();
+    }
+    env->DeleteLocalRef(payload);
+}
+
+static void monitorLoop(long long minIntervalMs, long long maxIntervalMs) {
+    JNIEnv* env = nullptr;
+    if (g_jni.vm->AttachCurrentThread(&env, nullptr) != JNI_OK) {
+        g_monitorRunning = false;
+        return;
+    }
+
+    long long cpuStart = threadCpuNs();
+    MonitorSnapshot base = takeMonitorSnapshot();
+    long long intervalMs = minIntervalMs;
+    g_monitorCpuNs += threadCpuNs() - cpuStart;
+
+    unique_lock<mutex> lock(g_monitorMutex);
+    while (!g_monitorStop) {
+        g_monitorIntervalMs = intervalMs;
+        g_monitorWake.wait_for(lock, chrono::milliseconds(intervalMs), [] { return g_monitorStop; });
+        if (g_monitorStop) {
+            break;
+        }
+        lock.unlock();
+
+        long long tickStart = threadCpuNs();
+        MonitorSnapshot now = takeMonitorSnapshot();
+        vector<string> triggers = monitorTriggers(base, now);
+        long long tickCpuNs = threadCpuNs() - tickStart;
+        g_monitorCpuNs += tickCpuNs;
+        g_monitorTicks++;
+
+        if (!triggers.empty()) {
+            g_monitorChanges++;
+            g_verdict.markPending();
+            notifyMonitorChange(env, now, triggers);
+            base = now;
+            intervalMs = minIntervalMs;
+        } else {
+            intervalMs = min(intervalMs * 2, maxIntervalMs);
+        }
+        // CPU bound: tick cost / interval <= MONITOR_CPU_BUDGET
+        intervalMs = max(intervalMs, (long long)(tickCpuNs / MONITOR_CPU_BUDGET / 1e6));
+
+        lock.lock();
+    }
+    lock.unlock();
+
+    g_jni.vm->DetachCurrentThread();
+}
+
+/**
+ * JNI methods: background monitor (see monitorLoop)
+ *
+ * @return false if already running or the callback cannot be resolved
+ */
+static jboolean JNICALL
+nativeStartMonitor(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong minIntervalMs,
+    jlong maxIntervalMs) {
+    lock_guard<mutex> lock(g_monitorMutex);
+    if (g_monitorRunning) {
+        return JNI_FALSE;
+    }
+    if (g_jni.vm == nullptr || g_jni.monitorOnNativeChange == nullptr) {
+        return JNI_FALSE;
+    }
+
+    if (g_monitorThread.joinable()) {
+        g_monitorThread.join();
+    }
+    g_monitorStop = false;
+    g_monitorRunning = true;
+    g_monitorTicks = 0;
+    g_monitorChanges = 0;
+    g_monitorCpuNs = 0;
+    g_monitorStartNs = monotonicNs();
+    g_monitorThread = thread(monitorLoop, (long long)max<jlong>(minIntervalMs, 1),
+                             (long long)max(maxIntervalMs, minIntervalMs));
+    return JNI_TRUE;
+}
+
+static void JNICALL
+nativeStopMonitor(
+    JNIEnv* /* env */,
+    jobject /* this */) {
+    {
+        lock_guard<mutex> lock(g_monitorMutex);
+        if (!g_monitorRunning) {
+            return;
+        }
+        g_monitorStop = true;
+    }
+    g_monitorWake.notify_all();
+    if (g_monitorThread.joinable() && g_monitorThread.get_id() != this_thread::get_id()) {
+        g_monitorThread.join();
+    }
+    g_monitorRunning = false;
+}
+
+static jstring JNICALL
+nativeMonitorStats(
+    JNIEnv* env,
+    jobject /* this */) {
+    return env->NewStringUTF(monitorStatsJson().c_str());
+}
+
+/**
+ * [DeviceTrust/Android] C ABI for dart:ffi (see device_trust_ffi.h)
+ *
+ * Same scan as collectNativeSignalsInto, without a JNIEnv: the Dart FFI
+ * platform calls it from a background isolate, so native signals skip the
+ * method channel, the platform thread hop and Kotlin map building. Stages are
+ * not streamed on this path.
+ */
+extern "C" __attribute__((visibility("default"))) int32_t dt_abi_version(void) {
+    return DT_ABI_VERSION;
+}
+
+extern "C" __attribute__((visibility("default"))) int32_t dt_collect(const dt_request* request, dt_result* result) {
+    if (request == nullptr || result == nullptr || request->struct_size != sizeof(dt_request) ||
+        result->struct_size != sizeof(dt_result)) {
+        return DT_ERROR_ARGUMENT;
+    }
+    if (request->level < SCAN_FAST || request->level > SCAN_DEEP) {
+        return DT_ERROR_ARGUMENT;
+    }
+    memset(result, 0, sizeof(dt_result));
+    result->struct_size = sizeof(dt_result);
+
+    StageListener noListener(nullptr, nullptr);
+    NativeSignals signals = collectSignals(request->level, request->signal_mask, request->verdicts_only != 0,
+                                           request->budget_ns, noListener);
+
+    PackedWriter writer{result->lists, sizeof(result->lists)};
+    writeSignalLists(signals, writer);
+
+    result->flags = resultFlags(signals, writer.truncated);
+    result->level = signals.level;
+    result->signal_mask = signals.signalMask;
+    result->tracer_pid = signals.tracerPid;
+    result->rwx_segments = signals.maps.rwxSegments;
+    result->libc_symbols_checked = signals.integrity.checkedSymbols;
+    result->skipped_stages = signals.skippedStages;
+    result->demoted_stages = signals.demotedStages;
+    result->lists_length = (uint32_t)writer.pos;
+    result->native_time_ns = signals.nativeTimeNs;
+    result->stages_ran = stagesRan(signals);
+    for (int stage = 0; stage < TIMED_STAGE_COUNT; stage++) {
+        result->stage_ns[stage] = signals.stages[stage].ns;
+        result->stage_items[stage] = signals.stages[stage].items;
+    }
+    result->memory_region_start = signals.memory.regionStart;
+    result->memory_match_address = signals.memory.address;
+    return DT_OK;
+}
+
+extern "C" __attribute__((visibility("default"))) uint64_t dt_verdict_load(void) {
+    return g_verdict.load();
+}
+
+extern "C" __attribute__((visibility("default"))) void dt_verdict_publish(uint32_t groups, uint32_t flags,
+                                                                          int32_t level) {
+    g_verdict.publish(groups, flags, (uint32_t)level, (uint64_t)bootTimeMs());
+}
+
+extern "C" __attribute__((visibility("default"))) int64_t dt_clock_ms(void) {
+    return bootTimeMs();
+}
+
+/**
+ * [DeviceTrust/Android] Native method table
+ *
+ * Bound explicitly in JNI_OnLoad instead of through exported
+ * Java_com_mikoloy_... symbols: the first call skips ART's dlsym lookup of
+ * the mangled names and the library exports only JNI_OnLoad.
+ * Signatures must match the external funs in DeviceTrustNative.kt.
+ */
+static const JNINativeMethod NATIVE_METHODS[] = {
+    {"collectNativeSignalsInto",
+     "(IIZJLcom/mikoloy/device_trust/NativeStageListener;Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;)I",
+     reinterpret_cast<void*>(nativeCollectSignalsInto)},
+    {"captureSnapshot", "()[B", reinterpret_cast<void*>(nativeCaptureSnapshot)},
+    {"admitCheck", "(Ljava/lang/String;)I", reinterpret_cast<void*>(nativeAdmitCheck)},
+    {"recordCheck", "(Ljava/lang/String;JZZ)V", reinterpret_cast<void*>(nativeRecordCheck)},
+    {"recordEvent", "(Ljava/lang/String;IJ)V", reinterpret_cast<void*>(nativeRecordEvent)},
+    {"statsSnapshot", "()Ljava/lang/String;", reinterpret_cast<void*>(nativeStatsSnapshot)},
+    {"recordTrace", "(Ljava/lang/String;JJ)V", reinterpret_cast<void*>(nativeRecordTrace)},
+    {"dumpTrace", "()Ljava/lang/String;", reinterpret_cast<void*>(nativeDumpTrace)},
+    {"checkScore", "(Ljava/lang/String;D)D", reinterpret_cast<void*>(nativeCheckScore)},
+    {"demotedChecks", "()Ljava/lang/String;", reinterpret_cast<void*>(nativeDemotedChecks)},
+    {"exportStats", "()Ljava/lang/String;", reinterpret_cast<void*>(nativeExportStats)},
+    {"importStats", "(Ljava/lang/String;)I", reinterpret_cast<void*>(nativeImportStats)},
+    {"startMonitor", "(JJ)Z", reinterpret_cast<void*>(nativeStartMonitor)},
+    {"stopMonitor", "()V", reinterpret_cast<void*>(nativeStopMonitor)},
+    {"monitorStats", "()Ljava/lang/String;", reinterpret_cast<void*>(nativeMonitorStats)},
+    {"loadSignaturePack", "(Ljava/lang/String;)I", reinterpret_cast<void*>(nativeLoadSignaturePack)},
+    {"signatureList", "(I)[Ljava/lang/String;", reinterpret_cast<void*>(nativeSignatureList)},
+    {"signaturePorts", "()[I", reinterpret_cast<void*>(nativeSignaturePorts)},
+    {"verdictWord", "()J", reinterpret_cast<void*>(nativeVerdictWord)},
+    {"publishVerdict", "(III)V", reinterpret_cast<void*>(nativePublishVerdict)},
+};
+
+/**
+ * Resolves [className].[method] into a global class ref and method ID
+ *
+ * @return false (exception cleared) if the class or method is missing
+ */
+static bool cacheMethod(JNIEnv* env, const char* className, const char* method, const char* signature,
+                        bool isStatic, jclass* classOut, jmethodID* methodOut) {
+    jclass cls = env->FindClass(className);
+    if (cls == nullptr) {
+        env->ExceptionClear();
+        return false;
+    }
+    jmethodID id = isStatic ? env->GetStaticMethodID(cls, method, signature)
+                            : env->GetMethodID(cls, method, signature);
+    if (id == nullptr) {
+        env->ExceptionClear();
+        env->DeleteLocalRef(cls);
+        return false;
+    }
+    *classOut = static_cast<jclass>(env->NewGlobalRef(cls));
+    *methodOut = id;
+    env->DeleteLocalRef(cls);
+    return true;
+}
+
+/**
+ * JNI entry point: registers NATIVE_METHODS and fills g_jni
+ *
+ * Returning JNI_ERR makes System.loadLibrary throw UnsatisfiedLinkError,
+ * which DeviceTrustNative treats as "native lib not loaded" (fail-soft).
+ */
+extern "C" JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void* /* reserved */) {
+    JNIEnv* env = nullptr;
+    if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) != JNI_OK) {
+        return JNI_ERR;
+    }
+
+    jclass nativeClass = env->FindClass("com/mikoloy/device_trust/DeviceTrustNative");
+    if (nativeClass == nullptr) {
+        env->ExceptionClear();
+        return JNI_ERR;
+    }
+    jint registered = env->RegisterNatives(nativeClass, NATIVE_METHODS,
+                                           sizeof(NATIVE_METHODS) / sizeof(NATIVE_METHODS[0]));
+    env->DeleteLocalRef(nativeClass);
+    if (registered != JNI_OK) {
+        env->ExceptionClear();
+        return JNI_ERR;
+    }
 
-    return env->NewStringUTF(result.c_str());
+    g_jni.vm = vm;
+    cacheMethod(env, "com/mikoloy/device_trust/NativeStageListener", "onStage", "(Ljava/lang/String;IJ)V",
+                false, &g_jni.stageListenerClass, &g_jni.stageListenerOnStage);
+    cacheMethod(env, "com/mikoloy/device_trust/DeviceTrustMonitor", "onNativeChange", "(Ljava/lang/String;)V",
+                true, &g_jni.monitorClass, &g_jni.monitorOnNativeChange);
+    return JNI_VERSION_1_6;
 }
@@ -11,12 +11,13 @@ import android.os.Build
 import android.os.Debug
 import android.provider.Settings
 import com.mikoloy.device_trust.DeviceTrustLog
-import org.json.JSONObject
+import org.json.JSONArray
 import java.io.BufferedReader
 import java.io.File
 import java.io.InputStreamReader
 import java.net.InetSocketAddress
 import java.net.Socket
+import java.nio.ByteBuffer
 import java.util.concurrent.TimeUnit
 
 /**
@@ -34,6 +35,148 @@ data class DeviceTrustReport(
     val details: Map<String, Any?>
 )
 
+/**
+ * [DeviceTrust/Android] Scan tier
+ *
+ * Each tier has a latency budget that ScanDeadline enforces; checks that do
+ * not fit are reported as "skipped:budget" instead of running.
+ * - FAST (1 ms): native TracerPid + quick RWX count with Frida module paths, cached static tier
+ * - STANDARD (500 ms): all root/emulator/hook checks (default)
+ * - DEEP (1200 ms): STANDARD + native libc ELF prologue and GOT checks,
+ *   Frida byte signatures in anonymous / memfd memory
+ */
+enum class ScanLevel(val wireName: String, val nativeValue: Int, val budgetMs: Long) {
+    FAST("fast", 0, 1),
+    STANDARD("standard", 1, 500),
+    DEEP("deep", 2, 1200);
+
+    companion object {
+        fun fromWireName(name: String?): ScanLevel =
+            values().firstOrNull { it.wireName == name } ?: STANDARD
+    }
+}
+
+/**
+ * [DeviceTrust/Android] Signal groups requested by the caller
+ *
+ * Bit values are shared with SignalGroup in Dart and SIGNAL_* in the native
+ * layer. Checks of unrequested groups are never executed.
+ */
+object SignalGroup {
+    const val ROOT = 1
+    const val EMULATOR = 2
+    const val DEVELOPER = 4  // Developer mode + ADB
+    const val HOOK = 8
+    const val DEBUGGER = 16
+    const val ALL = ROOT or EMULATOR or DEVELOPER or HOOK or DEBUGGER
+
+    // Groups covered by the cached static tier
+    const val STATIC = ROOT or EMULATOR or DEVELOPER
+
+    private val NAMES = listOf(
+        ROOT to "root",
+        EMULATOR to "emulator",
+        DEVELOPER to "developer",
+        HOOK to "hook",
+        DEBUGGER to "debugger"
+    )
+
+    fun names(mask: Int): List<String> = NAMES.filter { (bit, _) -> mask and bit != 0 }.map { it.second }
+}
+
+/**
+ * One completed check, published while a streaming report runs
+ *
+ * @param result the check's details value (signal count for native stages)
+ */
+data class CheckEvent(val id: String, val result: Any?, val hit: Boolean, val elapsedNs: Long)
+
+/**
+ * [DeviceTrust/Android] Cancels a running buildReport call from another thread
+ *
+ * Used by cancelled report streams, by DeviceTrustMonitor.stop() and by a
+ * timed-out warm-up claim. The flag is a 1-byte direct buffer that the
+ * native stages poll with their deadline, so a native stage already under
+ * way (the deep memory scan and its pool workers) stops too. Kotlin checks
+ * not started yet are skipped as if the budget were spent.
+ */
+class ScanCancel {
+    val flag: ByteBuffer = ByteBuffer.allocateDirect(1)
+
+    val cancelled: Boolean get() = flag.get(0).toInt() != 0
+
+    fun cancel() {
+        flag.put(0, 1)
+    }
+}
+
+/**
+ * [DeviceTrust/Android] Latency budget for one buildReport call
+ *
+ * [runDemoted] is set for DEEP: checks demoted by their circuit breaker
+ * still run (see EvaluationPlanner). [onCheck] receives each check as it
+ * completes (streaming reports). Every published check's duration is kept
+ * in [checkTimesNs] for the report's time breakdown. Once [cancel] is set
+ * the deadline counts as expired; it is also handed to the native stages.
+ */
+class ScanDeadline(
+    val budgetMs: Long,
+    val runDemoted: Boolean = false,
+    private val onCheck: ((CheckEvent) -> Unit)? = null,
+    val cancel: ScanCancel? = null
+) {
+    private val startNs = System.nanoTime()
+    val skipped = mutableListOf<String>()
+    val demoted = mutableListOf<String>()
+    val checkTimesNs = linkedMapOf<String, Long>()
+
+    val streaming: Boolean get() = onCheck != null
+
+    fun publish(id: String, result: Any?, hit: Boolean, elapsedNs: Long) {
+        record(id, elapsedNs)
+        onCheck?.invoke(CheckEvent(id, result, hit, elapsedNs))
+    }
+
+    /**
+     * Records a check's duration without publishing it (native stages of a
+     * non-streaming scan)
+     */
+    fun record(id: String, elapsedNs: Long) {
+        checkTimesNs[id] = elapsedNs
+    }
+
+    /**
+     * Checks skipped for the budget or demoted so far; a group whose checks
+     * raised this count was not evaluated completely
+     */
+    fun checksLeftOut(): Int = skipped.size + demoted.size
+
+    fun remainingNs(): Long = budgetMs * 1_000_000 - (System.nanoTime() - startNs)
+
+    fun expired(): Boolean = cancel?.cancelled == true || remainingNs() <= 0
+
+    /**
+     * Timeout for a blocking call: [capMs] clipped to the remaining budget (min 1 ms)
+     */
+    fun timeoutMs(capMs: Long): Long = maxOf(1L, minOf(capMs, remainingNs() / 1_000_000))
+
+    /**
+     * Returns false and marks [key] as skipped once the budget is spent
+     */
+    fun allow(key: String, details: MutableMap<String, Any?>): Boolean {
+        if (!expired()) return true
+        details[key] = SKIPPED_BUDGET
+        skipped.add(key)
+        val event = if (cancel?.cancelled == true) DeviceTrustNative.EVENT_CANCELLATION else DeviceTrustNative.EVENT_TIMEOUT
+        DeviceTrustNative.recordEventOrIgnore(key, event)
+        return false
+    }
+
+    companion object {
+        const val SKIPPED_BUDGET = "skipped:budget"
+    }
+}
+
 /**
  * DeviceTrust - Detects device security posture without third-party libraries
  * 
@@ -42,89 +185,244 @@ data class DeviceTrustReport(
  */
 object DeviceTrust {
 
-    private val KNOWN_ROOT_PACKAGES = listOf(
-        "com.topjohnwu.magisk",
-        "eu.chainfire.supersu",
-        "com.koushikdutta.superuser",
-        "com.noshufou.android.su",
-        "com.devadvance.rootcloak",
-        "com.devadvance.rootcloakplus"
+    // Built-in lists, generated from src/signatures/signatures.txt
+    private val KNOWN_ROOT_PACKAGES = DeviceTrustSignatures.ROOT_PACKAGES
+    private val SU_PATHS = DeviceTrustSignatures.SU_PATHS
+    private val FRIDA_PORTS = DeviceTrustSignatures.FRIDA_PORTS
+    private val QEMU_FILES = DeviceTrustSignatures.QEMU_FILES
+    private val MODULE_KEYWORDS = DeviceTrustSignatures.MODULE_KEYWORDS
+
+    // Lists in use: the built-in ones above until a signature pack replaces them
+    @Volatile
+    private var suPaths = SU_PATHS
+    @Volatile
+    private var knownRootPackages = KNOWN_ROOT_PACKAGES
+    @Volatile
+    private var fridaPorts = FRIDA_PORTS
+    @Volatile
+    private var qemuFiles = QEMU_FILES
+    @Volatile
+    private var moduleKeywords = MODULE_KEYWORDS
+
+    // Details keys for native hook stages (see HookStage in device_trust_native.cpp)
+    private val NATIVE_STAGE_KEYS = mapOf(
+        "maps" to "nativeMaps",
+        "fd" to "nativeFd",
+        "libc" to "nativeLibc",
+        "integrity" to "nativeIntegrity",
+        "memory" to "nativeMemory"
     )
 
-    private val SU_PATHS = listOf(
-        "/system/bin/su",
-        "/system/xbin/su",
-        "/sbin/su",
-        "/su/bin/su",
-        "/system/sd/xbin/su",
-        "/system/bin/failsafe/su",
-        "/data/local/xbin/su",
-        "/data/local/bin/su",
-        "/data/local/su"
+    // Verdict thresholds (signals per group)
+    private const val ROOT_SIGNAL_THRESHOLD = 1
+    private const val EMULATOR_SIGNAL_THRESHOLD = 2
+    private const val HOOK_SIGNAL_THRESHOLD = 2
+
+    // Upper bound for each getprop / which exec
+    private const val EXEC_TIMEOUT_MS = 200L
+
+    // Upper bound for each Frida port connect
+    private const val PORT_TIMEOUT_MS = 15L
+
+    // Breaker budgets: a getprop/which exec near its timeout, or any Frida port
+    // connect timing out (closed ports normally refuse immediately)
+    private const val EXEC_BUDGET_US = 150_000.0
+    private const val PORTS_BUDGET_US = 12_000.0
+
+    /**
+     * Root, emulator, developer mode and ADB results; rarely change at runtime
+     */
+    private data class StaticTier(
+        val rootedOrJailbroken: Boolean,
+        val emulator: Boolean,
+        val devModeEnabled: Boolean,
+        val adbEnabled: Boolean,
+        val details: Map<String, Any?>,
+        val capturedAtMs: Long,
+        // SignalGroup bits with checks skipped for the budget or demoted
+        val incompleteGroups: Int = 0
     )
 
-    private val FRIDA_PORTS = listOf(27042, 27043)
+    // Last complete static tier (STANDARD/DEEP); served to FAST scans
+    @Volatile
+    private var staticTier: StaticTier? = null
+
+    /**
+     * [DeviceTrust/Android] Installs a signature pack (see DeviceTrustNative)
+     *
+     * Native scans pick the pack up on their own; the Kotlin checks switch to
+     * its su path, root package, QEMU file, module keyword and Frida port
+     * sections, and the cached static tier is dropped so the next FAST scan
+     * does not serve results from the old lists.
+     *
+     * @return installed version, negative status, or null without the native lib
+     */
+    fun loadSignaturePack(path: String): Int? {
+        val version = DeviceTrustNative.loadSignaturePackOrNull(path) ?: return null
+        if (version > 0) {
+            suPaths = DeviceTrustNative.signatureListOrNull(DeviceTrustNative.SIGNATURE_SU_PATHS) ?: SU_PATHS
+            knownRootPackages = DeviceTrustNative.signatureListOrNull(DeviceTrustNative.SIGNATURE_ROOT_PACKAGES)
+                ?: KNOWN_ROOT_PACKAGES
+            qemuFiles = DeviceTrustNative.signatureListOrNull(DeviceTrustNative.SIGNATURE_QEMU_FILES) ?: QEMU_FILES
+            moduleKeywords = DeviceTrustNative.signatureListOrNull(DeviceTrustNative.SIGNATURE_MODULE_KEYWORDS)
+                ?: MODULE_KEYWORDS
+            fridaPorts = DeviceTrustNative.signaturePortsOrNull() ?: FRIDA_PORTS
+            staticTier = null
+        }
+        return version
+    }
 
     /**
      * [DeviceTrust/Android] Main report building function
      * 
-     * Runs all security checks and returns consolidated report:
+     * Runs all security checks for the requested tier and returns consolidated report:
      * - Root/jailbreak signals (6 checks)
      * - Emulator detection (6+ checks)
      * - Developer mode and ADB
      * - Hook/Frida detection (Kotlin + Native C++)
      * - Debugger detection
+     *
+     * FAST reuses the static tier (root/emulator/devMode/ADB) cached by the last
+     * complete STANDARD/DEEP scan and only runs the native fast checks.
+     *
+     * [signalMask] (SignalGroup bits) limits the scan to the requested groups;
+     * verdicts of unrequested groups are false and their checks never run.
+     *
+     * With [verdictsOnly], each group stops once its verdict is settled (see
+     * EvaluationPlanner); checks that did not run are "skipped:decided".
+     *
+     * With [nativeViaFfi], the native stages are left to the Dart FFI platform
+     * (dt_collect), which runs them concurrently and merges the result; only
+     * the Kotlin and framework checks run here.
+     *
+     * [onCheck] receives every check on the calling thread as soon as it
+     * completes, before the report is returned (streaming reports).
+     *
+     * [cancel] stops the scan early once cancelled; the report is still
+     * built, with the cut checks and stages marked like an exceeded budget.
+     *
+     * The scan and each of its checks are trace sections (DeviceTrustTrace).
      */
-    fun buildReport(context: Context): DeviceTrustReport {
+    fun buildReport(
+        context: Context,
+        level: ScanLevel = ScanLevel.STANDARD,
+        signalMask: Int = SignalGroup.ALL,
+        verdictsOnly: Boolean = false,
+        nativeViaFfi: Boolean = false,
+        cancel: ScanCancel? = null,
+        onCheck: ((CheckEvent) -> Unit)? = null
+    ): DeviceTrustReport = DeviceTrustTrace.section("deviceTrustScan") {
+        runScan(context, level, signalMask, verdictsOnly, nativeViaFfi, onCheck, cancel)
+    }
+
+    private fun runScan(
+        context: Context,
+        level: ScanLevel,
+        signalMask: Int,
+        verdictsOnly: Boolean,
+        nativeViaFfi: Boolean,
+        onCheck: ((CheckEvent) -> Unit)?,
+        cancel: ScanCancel?
+    ): DeviceTrustReport {
         DeviceTrustLog.init(context)
-        val startTime = System.currentTimeMillis()
+        DeviceTrustStats.load(context)
+        val startNs = System.nanoTime()
+        val deadline = ScanDeadline(level.budgetMs, runDemoted = level == ScanLevel.DEEP, onCheck = onCheck, cancel = cancel)
         val details = mutableMapOf<String, Any?>()
+        details["scanLevel"] = level.wireName
+        details["budgetMs"] = level.budgetMs
+        details["signalMask"] = signalMask
+        details["requestedSignals"] = SignalGroup.names(signalMask)
+        details["verdictsOnly"] = verdictsOnly
+        details["nativeTransport"] = if (nativeViaFfi) "ffi" else "jni"
 
-        // Root checks
-        val rootSignals = checkRootSignals(context, details)
-        val rootedOrJailbroken = rootSignals >= 1 // At least 1 strong root signal
-        DeviceTrustLog.d("Root", "signals=${details["rootSignals"]} testKeys=${details["buildTestKeys"]} su=${details["suExists"]}")
-
-        // Emulator detection
-        val emulatorSignals = checkEmulatorSignals(details)
-        val emulatorStrong = (details["emulatorStrong"] as? Boolean) == true
-        val emulator = emulatorStrong || emulatorSignals >= 2 // Strong indicator or at least 2 signals
-
-        // Developer mode / ADB
-        val devModeEnabled = checkDeveloperMode(context, details)
-        val adbEnabled = checkAdbEnabled(context, details)
+        // Static tier: root, emulator, developer mode, ADB
+        var tier: StaticTier? = null
+        if (signalMask and SignalGroup.STATIC != 0) {
+            tier = if (level == ScanLevel.FAST) staticTier else collectStaticTier(context, deadline, signalMask, verdictsOnly)
+            details["staticTier"] = when {
+                tier == null -> "cold"
+                level == ScanLevel.FAST -> "cached"
+                else -> "fresh"
+            }
+            tier?.let { details.putAll(it.details) }
+            if (tier != null && level == ScanLevel.FAST) {
+                DeviceTrustNative.recordEventOrIgnore("staticTier", DeviceTrustNative.EVENT_CACHE_HIT)
+            }
+        }
+        val rootedOrJailbroken = signalMask and SignalGroup.ROOT != 0 && tier?.rootedOrJailbroken == true
+        val emulator = signalMask and SignalGroup.EMULATOR != 0 && tier?.emulator == true
+        val devModeEnabled = signalMask and SignalGroup.DEVELOPER != 0 && tier?.devModeEnabled == true
+        val adbEnabled = signalMask and SignalGroup.DEVELOPER != 0 && tier?.adbEnabled == true
 
-        // Hook/Frida detection (Kotlin layer)
-        val kotlinHookSignals = checkHookSignals(details)
-        
-        // Native signals
+        // Hook/Frida detection: native stages + Kotlin layer (Kotlin not part of FAST)
+        val hookRequested = signalMask and SignalGroup.HOOK != 0
+        val leftOutBeforeHook = deadline.checksLeftOut()
+        var kotlinHookSignals = false
         var nativeFrida = false
-        try {
-            val nativeJson = DeviceTrustNative.collectNativeSignalsOrEmpty()
-            details["nativeSignalsRaw"] = nativeJson
-            nativeFrida = parseNativeSignals(nativeJson, details)
-        } catch (e: Throwable) {
-            details["nativeError"] = e.message ?: "Unknown error"
-            // Fail-soft: continue if native lib fails to load
+        if (hookRequested && level != ScanLevel.FAST) {
+            // Either layer alone settles the hook verdict; layers are never
+            // demoted themselves, their checks/stages have their own breakers
+            val hookLayers = listOfNotNull(
+                if (nativeViaFfi) null else PlannedCheck("nativeHook", 3_000.0, budgetUs = Double.MAX_VALUE) {
+                    nativeFrida = collectNativeSignals(level, signalMask, verdictsOnly, deadline, details)
+                    CheckOutcome.of(nativeFrida)
+                },
+                PlannedCheck("kotlinHook", 30_000.0, budgetUs = Double.MAX_VALUE) {
+                    kotlinHookSignals = checkHookSignals(details, deadline, verdictsOnly)
+                    CheckOutcome.of(kotlinHookSignals)
+                }
+            )
+            EvaluationPlanner.evaluate(hookLayers, 1, verdictsOnly, deadline, details)
+        } else if (!nativeViaFfi && signalMask and (SignalGroup.HOOK or SignalGroup.DEBUGGER) != 0) {
+            // FAST hook stage (RWX count + Frida module paths) and/or TracerPid;
+            // hook evidence only, so a hit needs both RWX and a Frida module
+            // (applyNativeResult's 2-signal rule). TracerPid stays with the debugger.
+            nativeFrida = collectNativeSignals(level, signalMask, verdictsOnly, deadline, details) && hookRequested
         }
 
         val fridaSuspected = kotlinHookSignals || nativeFrida
+
+        // Groups this scan did not evaluate completely: their hits are published, their clears are not
+        var incompleteGroups = tier?.incompleteGroups ?: 0
+        val nativeCut = details["nativeBudgetExceeded"] == true
+        if (deadline.checksLeftOut() != leftOutBeforeHook || nativeCut ||
+            (details["nativeDemoted"] as? List<*>)?.isNotEmpty() == true) {
+            incompleteGroups = incompleteGroups or SignalGroup.HOOK
+        }
+        if (nativeCut) {
+            incompleteGroups = incompleteGroups or SignalGroup.DEBUGGER  // native TracerPid may not have run
+        }
+        details["incompleteSignals"] = SignalGroup.names(incompleteGroups and signalMask)
         DeviceTrustLog.d("Hook", "kotlinSignals=${details["kotlinHookSignals"]} suspiciousMapsCount=${(details["suspiciousMaps"] as? List<*>)?.size ?: 0}")
 
         // Debugger
-        val debuggerAttached = checkDebugger(details)
+        var debuggerAttached = false
+        if (signalMask and SignalGroup.DEBUGGER != 0) {
+            val start = System.nanoTime()
+            debuggerAttached = DeviceTrustTrace.section("debuggerConnected") { checkDebugger(details) }
+            val elapsedNs = System.nanoTime() - start
+            deadline.publish("debuggerConnected", debuggerAttached, debuggerAttached, elapsedNs)
+            DeviceTrustNative.recordEventOrIgnore("debuggerConnected", DeviceTrustNative.EVENT_CALL, elapsedNs)
+        }
 
-        val totalTime = System.currentTimeMillis() - startTime
-        details["totalTimeMs"] = totalTime
+        details["totalTimeMs"] = (System.nanoTime() - startNs) / 1_000_000
+        // Per-check share of totalTimeMs; hook layers (nativeHook, kotlinHook) include their checks
+        details["timeBreakdownMs"] = deadline.checkTimesNs.mapValues { it.value / 1_000_000.0 }
+        details["skippedChecks"] = deadline.skipped.toList()
+        details["budgetExceeded"] = deadline.skipped.isNotEmpty() || details["nativeBudgetExceeded"] == true
+        details["demotedSkipped"] = deadline.demoted.toList() + ((details["nativeDemoted"] as? List<*>) ?: emptyList<Any>())
+        details["demotedChecks"] = parseDemotedChecks(DeviceTrustNative.demotedChecksOrEmpty())
+        DeviceTrustStats.saveIfDue(context)
 
         // Debug logging (debug-only via DeviceTrustLog)
         DeviceTrustLog.d("Decision",
-            "root=$rootedOrJailbroken emu=$emulator(dev=${details["emulatorSignals"]}, strong=${details["emulatorStrong"]==true}) " +
+            "level=${level.wireName} root=$rootedOrJailbroken emu=$emulator(dev=${details["emulatorSignals"]}, strong=${details["emulatorStrong"]==true}) " +
             "hook=$fridaSuspected dbg=$debuggerAttached devMode=$devModeEnabled adb=$adbEnabled"
         )
         DeviceTrustLog.d("Indicators", "emuIndicators=${details["emulatorIndicators"]}")
 
-        return DeviceTrustReport(
+        val report = DeviceTrustReport(
             rootedOrJailbroken = rootedOrJailbroken,
             emulator = emulator,
             devModeEnabled = devModeEnabled,
@@ -133,6 +431,142 @@ object DeviceTrust {
             debuggerAttached = debuggerAttached,
             details = details
         )
+
+        // Published verdict; FFI reports are only final after the Dart merge, which publishes them.
+        // A cold FAST static tier evaluated nothing for its groups; incomplete groups only add hits.
+        if (!nativeViaFfi) {
+            val evaluated = if (signalMask and SignalGroup.STATIC != 0 && tier == null) {
+                signalMask and SignalGroup.STATIC.inv()
+            } else {
+                signalMask
+            }
+            DeviceTrustNative.publishVerdictOrIgnore(
+                evaluated and incompleteGroups.inv(),
+                DeviceTrustVerdict.flagsOf(report),
+                level.nativeValue
+            )
+        }
+        return report
+    }
+
+    /**
+     * [DeviceTrust/Android] Latest published verdict, without running a scan
+     *
+     * Every buildReport publishes its flags natively; the background monitor
+     * marks the verdict pending when a detector changes. Costs one JNI call
+     * and one atomic load, so it can run on every network request.
+     *
+     * @return null if no report was built yet or the native lib is unavailable
+     */
+    fun currentVerdict(): DeviceTrustVerdict? =
+        DeviceTrustVerdict.decode(DeviceTrustNative.verdictWordOrZero())
+
+    /**
+     * Native signals (hook stages and/or TracerPid)
+     *
+     * @return true = native hook suspicion (at least 2 native signals)
+     */
+    private fun collectNativeSignals(
+        level: ScanLevel,
+        signalMask: Int,
+        verdictsOnly: Boolean,
+        deadline: ScanDeadline,
+        details: MutableMap<String, Any?>
+    ): Boolean {
+        return try {
+            val result = DeviceTrustNative.collectNativeResultOrNull(
+                level.nativeValue,
+                signalMask,
+                verdictsOnly,
+                maxOf(0L, deadline.remainingNs()),
+                if (deadline.streaming) NativeStageListener { id, signals, elapsedNs ->
+                    deadline.publish(id, signals, signals > 0, elapsedNs)
+                } else null,
+                deadline.cancel?.flag
+            )
+            if (DeviceTrustLog.isEnabled()) {
+                details["nativeSignalsRaw"] = result?.toString() ?: "{}"
+            }
+            result?.stages?.forEach { deadline.record(it.id, it.ns) }
+            applyNativeResult(result, details)
+        } catch (e: Throwable) {
+            details["nativeError"] = e.message ?: "Unknown error"
+            // Fail-soft: continue if native lib fails to load
+            false
+        }
+    }
+
+    /**
+     * [DeviceTrust/Android] Root, emulator, developer mode and ADB checks
+     *
+     * Only groups in [signalMask] are evaluated. The result is cached for FAST
+     * scans when all static groups ran and every check ran within the budget
+     * (verdictsOnly scans leave details incomplete and are not cached).
+     */
+    private fun collectStaticTier(
+        context: Context,
+        deadline: ScanDeadline,
+        signalMask: Int,
+        verdictsOnly: Boolean
+    ): StaticTier {
+        val details = mutableMapOf<String, Any?>()
+        val skippedBefore = deadline.skipped.size
+        var incompleteGroups = 0
+        var leftOut = deadline.checksLeftOut()
+        fun groupDone(group: Int) {
+            if (deadline.checksLeftOut() != leftOut) incompleteGroups = incompleteGroups or group
+            leftOut = deadline.checksLeftOut()
+        }
+
+        // Root checks
+        var rootedOrJailbroken = false
+        if (signalMask and SignalGroup.ROOT != 0) {
+            val rootSignals = checkRootSignals(context, details, deadline, verdictsOnly)
+            rootedOrJailbroken = rootSignals >= ROOT_SIGNAL_THRESHOLD // At least 1 strong root signal
+            DeviceTrustLog.d("Root", "signals=${details["rootSignals"]} testKeys=${details["buildTestKeys"]} su=${details["suExists"]}")
+            groupDone(SignalGroup.ROOT)
+        }
+
+        // Emulator detection
+        var emulator = false
+        if (signalMask and SignalGroup.EMULATOR != 0) {
+            val emulatorSignals = checkEmulatorSignals(details, deadline, verdictsOnly)
+            val emulatorStrong = (details["emulatorStrong"] as? Boolean) == true
+            emulator = emulatorStrong || emulatorSignals >= EMULATOR_SIGNAL_THRESHOLD // Strong indicator or at least 2 signals
+            groupDone(SignalGroup.EMULATOR)
+        }
+
+        // Developer mode / ADB
+        var devModeEnabled = false
+        var adbEnabled = false
+        if (signalMask and SignalGroup.DEVELOPER != 0) {
+            var start = System.nanoTime()
+            devModeEnabled = DeviceTrustTrace.section("devSettingsEnabled") { checkDeveloperMode(context, details) }
+            var elapsedNs = System.nanoTime() - start
+            deadline.publish("devSettingsEnabled", devModeEnabled, devModeEnabled, elapsedNs)
+            DeviceTrustNative.recordEventOrIgnore("devSettingsEnabled", DeviceTrustNative.EVENT_CALL, elapsedNs)
+            start = System.nanoTime()
+            adbEnabled = DeviceTrustTrace.section("adbEnabled") { checkAdbEnabled(context, details) }
+            elapsedNs = System.nanoTime() - start
+            deadline.publish("adbEnabled", adbEnabled, adbEnabled, elapsedNs)
+            DeviceTrustNative.recordEventOrIgnore("adbEnabled", DeviceTrustNative.EVENT_CALL, elapsedNs)
+            groupDone(SignalGroup.DEVELOPER)
+        }
+
+        val tier = StaticTier(
+            rootedOrJailbroken = rootedOrJailbroken,
+            emulator = emulator,
+            devModeEnabled = devModeEnabled,
+            adbEnabled = adbEnabled,
+            details = details,
+            capturedAtMs = System.currentTimeMillis(),
+            incompleteGroups = incompleteGroups
+        )
+        if (signalMask and SignalGroup.STATIC == SignalGroup.STATIC && !verdictsOnly &&
+            deadline.skipped.size == skippedBefore) {
+            staticTier = tier
+        }
+        return tier
     }
 
     /**
@@ -148,48 +582,61 @@ object DeviceTrust {
      * 
      * @return Number of positive strong signals
      */
-    private fun checkRootSignals(context: Context, details: MutableMap<String, Any?>): Int {
-        var signals = 0
+    private fun checkRootSignals(
+        context: Context,
+        details: MutableMap<String, Any?>,
+        deadline: ScanDeadline,
+        verdictsOnly: Boolean
+    ): Int {
+        val checks = listOf(
+            // 1. Build.TAGS check
+            PlannedCheck("buildTestKeys", 1.0) {
+                val hasTestKeys = Build.TAGS?.contains("test-keys") == true
+                details["buildTestKeys"] = hasTestKeys
+                CheckOutcome.of(hasTestKeys)
+            },
+            // 2. su binary existence
+            PlannedCheck("suExists", 50.0) {
+                val suExists = checkSuBinary()
+                details["suExists"] = suExists
+                CheckOutcome.of(suExists)
+            },
+            // 3. "which su" attempt
+            PlannedCheck("whichSu", 20_000.0, budgetUs = EXEC_BUDGET_US) {
+                val whichSuResult = executeWhichSu(deadline.timeoutMs(EXEC_TIMEOUT_MS))
+                details["whichSu"] = whichSuResult
+                CheckOutcome.of(whichSuResult != null && whichSuResult.isNotEmpty())
+            },
+            // 4. Dangerous system properties
+            PlannedCheck("dangerousProps", 40_000.0, budgetUs = 2 * EXEC_BUDGET_US) {
+                val dangerousProps = checkDangerousProps(deadline)
+                details["dangerousProps"] = dangerousProps
+                CheckOutcome.of(dangerousProps.isNotEmpty())
+            },
+            // 5. RW mounts check
+            PlannedCheck("rwMounts", 500.0) {
+                val rwMounts = checkRwMounts()
+                details["rwMounts"] = rwMounts
+                CheckOutcome.of(rwMounts)
+            },
+            // 6. Known root packages
+            PlannedCheck("knownRootPackages", 3_000.0) {
+                val rootPackages = checkKnownRootPackages(context)
+                details["knownRootPackages"] = rootPackages
+                CheckOutcome.of(rootPackages.isNotEmpty())
+            }
+        )
 
-        // 1. Build.TAGS check
-        val hasTestKeys = Build.TAGS?.contains("test-keys") == true
-        details["buildTestKeys"] = hasTestKeys
-        if (hasTestKeys) signals++
-
-        // 2. su binary existence
-        val suExists = checkSuBinary()
-        details["suExists"] = suExists
-        if (suExists) signals++
-
-        // 3. "which su" attempt
-        val whichSuResult = executeWhichSu()
-        details["whichSu"] = whichSuResult
-        if (whichSuResult != null && whichSuResult.isNotEmpty()) signals++
-
-        // 4. Dangerous system properties
-        val dangerousProps = checkDangerousProps()
-        details["dangerousProps"] = dangerousProps
-        if (dangerousProps.isNotEmpty()) signals++
-
-        // 5. RW mounts check
-        val rwMounts = checkRwMounts()
-        details["rwMounts"] = rwMounts
-        if (rwMounts) signals++
-
-        // 6. Known root packages
-        val rootPackages = checkKnownRootPackages(context)
-        details["knownRootPackages"] = rootPackages
-        if (rootPackages.isNotEmpty()) signals++
-
-        details["rootSignals"] = signals
-        return signals
+        val result = EvaluationPlanner.evaluate(checks, ROOT_SIGNAL_THRESHOLD, verdictsOnly, deadline, details)
+        details["rootSignals"] = result.signals
+        return result.signals
     }
 
     /**
      * su binary check
      */
     private fun checkSuBinary(): Boolean {
-        return SU_PATHS.any { path ->
+        return suPaths.any { path ->
             try {
                 val file = File(path)
                 file.exists() && file.canExecute()
@@ -202,11 +649,11 @@ object DeviceTrust {
     /**
      * Attempt "which su" command (short timeout)
      */
-    private fun executeWhichSu(): String? {
+    private fun executeWhichSu(timeoutMs: Long): String? {
         return try {
             val process = Runtime.getRuntime().exec("which su")
             val reader = BufferedReader(InputStreamReader(process.inputStream))
-            val completed = process.waitFor(200, TimeUnit.MILLISECONDS)
+            val completed = process.waitFor(timeoutMs, TimeUnit.MILLISECONDS)
             if (completed) {
                 reader.readLine()
             } else {
@@ -221,15 +668,17 @@ object DeviceTrust {
     /**
      * Dangerous system properties check
      */
-    private fun checkDangerousProps(): Map<String, String> {
+    private fun checkDangerousProps(deadline: ScanDeadline): Map<String, String> {
         val props = mutableMapOf<String, String>()
         
-        val debuggable = getSystemProperty("ro.debuggable")
+        val debuggable = getSystemProperty("ro.debuggable", deadline.timeoutMs(EXEC_TIMEOUT_MS))
         if (debuggable == "1") {
             props["ro.debuggable"] = debuggable
         }
 
-        val secure = getSystemProperty("ro.secure")
+        if (deadline.expired()) return props
+
+        val secure = getSystemProperty("ro.secure", deadline.timeoutMs(EXEC_TIMEOUT_MS))
         if (secure == "0") {
             props["ro.secure"] = secure
         }
@@ -240,11 +689,11 @@ object DeviceTrust {
     /**
      * Read system property (short timeout)
      */
-    private fun getSystemProperty(key: String): String {
+    private fun getSystemProperty(key: String, timeoutMs: Long): String {
         return try {
             val process = Runtime.getRuntime().exec("getprop $key")
             val reader = BufferedReader(InputStreamReader(process.inputStream))
-            val completed = process.waitFor(200, TimeUnit.MILLISECONDS)
+            val completed = process.waitFor(timeoutMs, TimeUnit.MILLISECONDS)
             if (completed) {
                 reader.readLine()?.trim() ?: ""
             } else {
@@ -282,7 +731,7 @@ object DeviceTrust {
         val installed = mutableListOf<String>()
         val pm = context.packageManager
         
-        KNOWN_ROOT_PACKAGES.forEach { pkg ->
+        knownRootPackages.forEach { pkg ->
             try {
                 if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.TIRAMISU) {
                     pm.getPackageInfo(pkg, PackageManager.PackageInfoFlags.of(0))
@@ -311,35 +760,47 @@ object DeviceTrust {
      * 
      * @return Number of positive signals
      */
-    private fun checkEmulatorSignals(details: MutableMap<String, Any?>): Int {
-        var signals = 0
+    private fun checkEmulatorSignals(
+        details: MutableMap<String, Any?>,
+        deadline: ScanDeadline,
+        verdictsOnly: Boolean
+    ): Int {
         val indicators = mutableListOf<String>()
-        var strongIndicator = false
 
-        // Strong indicator 1: QEMU property
-        val qemu = getSystemProperty("ro.kernel.qemu")
-        if (qemu == "1") {
-            indicators.add("strong:qemu=1")
-            signals++
-            strongIndicator = true
-        }
-
-        // Strong indicator 2: QEMU files
-        val qemuFiles = listOf(
-            "/init.goldfish.rc",
-            "/sys/qemu_trace",
-            "/dev/qemu_pipe",
-            "/dev/socket/qemud"
-        )
-        qemuFiles.forEach { path ->
-            if (File(path).exists()) {
-                indicators.add("strong:file:$path")
-                signals++
-                strongIndicator = true
+        val checks = listOf(
+            // Strong indicator 1: QEMU property
+            PlannedCheck("emulatorQemuProp", 20_000.0, canBeStrong = true, budgetUs = EXEC_BUDGET_US) {
+                val qemu = getSystemProperty("ro.kernel.qemu", deadline.timeoutMs(EXEC_TIMEOUT_MS))
+                if (qemu == "1") indicators.add("strong:qemu=1")
+                CheckOutcome.of(qemu == "1", strong = true)
+            },
+            // Strong indicator 2: QEMU files
+            PlannedCheck("emulatorQemuFiles", 200.0, maxSignals = qemuFiles.size, canBeStrong = true) {
+                val found = qemuFiles.filter { File(it).exists() }
+                found.forEach { indicators.add("strong:file:$it") }
+                CheckOutcome(found.size, strong = found.isNotEmpty())
+            },
+            // Regular indicators - Build properties
+            PlannedCheck("emulatorBuildProps", 5.0, maxSignals = 8) {
+                CheckOutcome(checkEmulatorBuildProps(indicators))
             }
-        }
+        )
+
+        val result = EvaluationPlanner.evaluate(checks, EMULATOR_SIGNAL_THRESHOLD, verdictsOnly, deadline, details)
+        details["emulatorIndicators"] = indicators
+        details["emulatorSignals"] = result.signals
+        details["emulatorStrong"] = result.strong
+        return result.signals
+    }
+
+    /**
+     * Emulator Build property indicators
+     *
+     * @return Number of matching properties (0-8)
+     */
+    private fun checkEmulatorBuildProps(indicators: MutableList<String>): Int {
+        var signals = 0
 
-        // Regular indicators - Build properties
         if (Build.FINGERPRINT.contains("generic", ignoreCase = true) || 
             Build.FINGERPRINT.contains("sdk_gphone", ignoreCase = true) ||
             Build.FINGERPRINT.contains("emulator", ignoreCase = true)) {
@@ -394,9 +855,6 @@ object DeviceTrust {
             signals++
         }
 
-        details["emulatorIndicators"] = indicators
-        details["emulatorSignals"] = signals
-        details["emulatorStrong"] = strongIndicator
         return signals
     }
 
@@ -450,38 +908,48 @@ object DeviceTrust {
      * 
      * @return true = hook suspicion (at least 2 signals total)
      */
-    private fun checkHookSignals(details: MutableMap<String, Any?>): Boolean {
-        var signals = 0
-
-        // 1. Frida port scan
-        val openPorts = scanFridaPorts()
-        details["fridaPortsOpen"] = openPorts
-        if (openPorts.isNotEmpty()) signals++
-
-        // 2. /proc/self/maps scan
-        val suspiciousMaps = scanProcSelfMaps()
-        details["suspiciousMaps"] = suspiciousMaps
-        if (suspiciousMaps.isNotEmpty()) signals++
-
-        // 3. TracerPid check
-        val tracerPid = checkTracerPid()
-        details["tracerPid"] = tracerPid
-        if (tracerPid > 0) signals++
+    private fun checkHookSignals(
+        details: MutableMap<String, Any?>,
+        deadline: ScanDeadline,
+        verdictsOnly: Boolean
+    ): Boolean {
+        val checks = listOf(
+            // 1. Frida port scan
+            PlannedCheck("fridaPortsOpen", 30_000.0, budgetUs = PORTS_BUDGET_US) {
+                val openPorts = scanFridaPorts(deadline)
+                details["fridaPortsOpen"] = openPorts
+                CheckOutcome.of(openPorts.isNotEmpty())
+            },
+            // 2. /proc/self/maps scan
+            PlannedCheck("suspiciousMaps", 5_000.0) {
+                val suspiciousMaps = scanProcSelfMaps()
+                details["suspiciousMaps"] = suspiciousMaps
+                CheckOutcome.of(suspiciousMaps.isNotEmpty())
+            },
+            // 3. TracerPid check
+            PlannedCheck("tracerPid", 300.0) {
+                val tracerPid = checkTracerPid()
+                details["tracerPid"] = tracerPid
+                CheckOutcome.of(tracerPid > 0)
+            }
+        )
 
-        details["kotlinHookSignals"] = signals
-        return signals >= 2
+        val result = EvaluationPlanner.evaluate(checks, HOOK_SIGNAL_THRESHOLD, verdictsOnly, deadline, details)
+        details["kotlinHookSignals"] = result.signals
+        return result.signals >= HOOK_SIGNAL_THRESHOLD
     }
 
     /**
      * Scan Frida ports (short timeout)
      */
-    private fun scanFridaPorts(): List<Int> {
+    private fun scanFridaPorts(deadline: ScanDeadline): List<Int> {
         val openPorts = mutableListOf<Int>()
         
-        FRIDA_PORTS.forEach { port ->
+        fridaPorts.forEach { port ->
+            if (deadline.expired()) return openPorts
             try {
                 val socket = Socket()
-                socket.connect(InetSocketAddress("127.0.0.1", port), 15)
+                socket.connect(InetSocketAddress("127.0.0.1", port), deadline.timeoutMs(PORT_TIMEOUT_MS).toInt())
                 socket.close()
                 openPorts.add(port)
             } catch (e: Exception) {
@@ -497,8 +965,8 @@ object DeviceTrust {
      */
     private fun scanProcSelfMaps(): List<String> {
         val suspicious = mutableListOf<String>()
-        val keywords = listOf("frida", "gum-js-loop", "substrate", "xposed", "lsposed")
-        
+        val keywords = moduleKeywords
+
         try {
             val mapsFile = File("/proc/self/maps")
             if (!mapsFile.exists()) return suspicious
@@ -506,10 +974,9 @@ object DeviceTrust {
             mapsFile.useLines { lines ->
                 lines.forEach { line ->
                     val lowerLine = line.lowercase()
-                    keywords.forEach { keyword ->
-                        if (lowerLine.contains(keyword)) {
-                            suspicious.add(line.trim())
-                        }
+                    // Once per line; "xposed" is also part of "lsposed"
+                    if (keywords.any { lowerLine.contains(it) }) {
+                        suspicious.add(line.trim())
                     }
                 }
             }
@@ -554,38 +1021,89 @@ object DeviceTrust {
     }
 
     /**
-     * Parse native signals (using JSONObject)
+     * Native signals into details (decoded from the packed native result)
      */
-    private fun parseNativeSignals(json: String, details: MutableMap<String, Any?>): Boolean {
-        return try {
-            // Empty JSON check
-            if (json.isEmpty() || json == "{}") {
-                details["nativeSignals"] = emptyList<String>()
-                return false
-            }
+    private fun applyNativeResult(result: NativeResult?, details: MutableMap<String, Any?>): Boolean {
+        if (result == null) {
+            details["nativeSignals"] = emptyList<String>()
+            return false
+        }
 
-            val jsonObj = JSONObject(json)
-            val signals = mutableListOf<String>()
-            
-            // Check boolean fields
-            if (jsonObj.optBoolean("fridaLibLoaded", false)) {
-                signals.add("fridaLibLoaded")
-            }
-            if (jsonObj.optBoolean("fdFrida", false)) {
-                signals.add("fdFrida")
-            }
-            if (jsonObj.optBoolean("libcGetpidUnexpected", false)) {
-                signals.add("libcGetpidUnexpected")
-            }
-            if (jsonObj.optBoolean("hasRwx", false)) {
-                signals.add("hasRwx")
-            }
+        val signals = mutableListOf<String>()
 
-            details["nativeSignals"] = signals
-            signals.size >= 2
-        } catch (e: Throwable) {
-            details["nativeParseError"] = e.message
-            false
+        details["nativeTracerPid"] = result.tracerPid
+        details["nativeBudgetExceeded"] = result.budgetExceeded
+        details["nativeScanTimeMs"] = result.nativeTimeNs / 1_000_000.0
+        details["nativeStages"] = result.stages.associate { it.id to mapOf("ns" to it.ns, "items" to it.items) }
+
+        // Stages the native planner left out because their breaker is open
+        if (result.demotedStages != 0) {
+            val demoted = NativeResult.stageNames(result.demotedStages).map { NATIVE_STAGE_KEYS[it] ?: it }
+            demoted.forEach { key -> details[key] = EvaluationPlanner.SKIPPED_DEMOTED }
+            details["nativeDemoted"] = demoted
+        }
+
+        // Stages the native planner skipped once the verdict was settled
+        if (result.skippedStages != 0) {
+            val skipped = NativeResult.stageNames(result.skippedStages)
+            skipped.forEach { stage -> details[NATIVE_STAGE_KEYS[stage] ?: "native_$stage"] = EvaluationPlanner.SKIPPED_DECIDED }
+            details["nativeSkipped"] = skipped
+        }
+
+        if (result.fridaLibLoaded) {
+            signals.add("fridaLibLoaded")
+        }
+        if (result.fdFrida) {
+            signals.add("fdFrida")
+        }
+        if (result.libcGetpidUnexpected) {
+            signals.add("libcGetpidUnexpected")
+        }
+        if (result.hasRwx) {
+            signals.add("hasRwx")
+        }
+        // Deep tier: libc GOT / .text prologue mismatches
+        if (result.gotMismatch.isNotEmpty()) {
+            signals.add("gotMismatch")
+        }
+        if (result.textMismatch.isNotEmpty()) {
+            signals.add("textMismatch")
+        }
+        // Deep tier: Frida byte signature in anonymous / memfd memory (the
+        // signature text may have been cut from a full buffer; the flag stays)
+        if (result.memorySignatureFound) {
+            signals.add("memorySignature")
+            details["memorySignature"] = mapOf(
+                "signature" to result.memorySignature,
+                "regionStart" to result.memoryRegionStart,
+                "regionPath" to result.memoryRegionPath,
+                "address" to result.memoryMatchAddress,
+                "sampled" to result.memorySampled
+            )
+        }
+
+        details["nativeSignals"] = signals
+        return signals.size >= 2
+    }
+
+    /**
+     * Parse the native demoted check list (id, state, trips, ewmaMs, p99Ms)
+     */
+    private fun parseDemotedChecks(json: String): List<Map<String, Any?>> {
+        return try {
+            val array = JSONArray(json)
+            (0 until array.length()).map { i ->
+                val entry = array.getJSONObject(i)
+                mapOf(
+                    "id" to entry.optString("id"),
+                    "state" to entry.optString("state"),
+                    "trips" to entry.optInt("trips"),
+                    "ewmaMs" to entry.optDouble("ewmaMs"),
+                    "p99Ms" to entry.optDouble("p99Ms")
+                )
+            }
+        } catch (e: Exception) {
+            emptyList()
         }
     }
 }
@@ -15,6 +15,8 @@ object DeviceTrustLog {
         enabledFlag.set(debuggable)
     }
 
+    fun isEnabled(): Boolean = enabledFlag.get()
+
     fun d(scope: String, msg: String) {
         if (enabledFlag.get()) {
             Log.d("DeviceTrust/$scope", msg)
@@ -0,0 +1,169 @@
+// [DeviceTrust/Android] Background monitor
+// Native thread polls cheap dynamic detectors; a change escalates to a full scan
+// and only verdicts that changed are pushed to the listener.
+
+package com.mikoloy.device_trust
+
+import android.content.Context
+import org.json.JSONObject
+import java.util.concurrent.ExecutorService
+import java.util.concurrent.Executors
+import java.util.concurrent.atomic.AtomicLong
+
+/**
+ * [DeviceTrust/Android] DeviceTrustMonitor
+ *
+ * Event maps (sent through the "device_trust/watch" EventChannel):
+ * {
+ *   "type": "baseline" | "change",
+ *   "seq": <long>,
+ *   "triggers": [<string>, ...],         (libraries, threads, tracerPid, rwxSegments)
+ *   "changed": {<flag>: <bool>, ...},    (baseline: all six flags)
+ *   "scanMs": <double>,
+ *   "monitor": {ticks, changes, intervalMs, cpuMs, cpuPercent}
+ * }
+ *
+ * One listener at a time (a single EventChannel stream). Fail-soft: without
+ * the native lib only the baseline event is sent.
+ */
+object DeviceTrustMonitor {
+
+    // Interval right after a change; doubles up to MAX_INTERVAL_MS while idle
+    private const val MIN_INTERVAL_MS = 250L
+    private const val MAX_INTERVAL_MS = 5_000L
+
+    private val seq = AtomicLong(0)
+    private val lock = Any()
+
+    private var listener: ((Map<String, Any?>) -> Unit)? = null
+    private var appContext: Context? = null
+    private var lastReport: DeviceTrustReport? = null
+    private var executor: ExecutorService? = null
+
+    // Escalation scan under way; stop() cancels its native stages
+    private var runningScan: ScanCancel? = null
+
+    // Triggers collected while an escalation scan is queued (coalesced)
+    private val pendingTriggers = linkedSetOf<String>()
+    private var scanQueued = false
+
+    /**
+     * Sends the baseline event, then starts the native monitor
+     */
+    fun start(context: Context, onEvent: (Map<String, Any?>) -> Unit) {
+        stop()
+        synchronized(lock) {
+            listener = onEvent
+            appContext = context.applicationContext
+            lastReport = null
+            pendingTriggers.clear()
+            scanQueued = false
+            executor = Executors.newSingleThreadExecutor { runnable ->
+                Thread(runnable, "DeviceTrust-Monitor").apply { isDaemon = true }
+            }
+        }
+        submitScan()
+        DeviceTrustNative.startMonitorOrFalse(MIN_INTERVAL_MS, MAX_INTERVAL_MS)
+    }
+
+    fun stop() {
+        // Outside the lock: joining the monitor thread while it waits in onNativeChange would deadlock
+        DeviceTrustNative.stopMonitorOrIgnore()
+        synchronized(lock) {
+            executor?.shutdownNow()
+            executor = null
+            listener = null
+            runningScan?.cancel()
+            runningScan = null
+        }
+    }
+
+    /**
+     * Called by the native monitor thread when a detector changed
+     */
+    @JvmStatic
+    fun onNativeChange(json: String) {
+        try {
+            val triggers = JSONObject(json).optJSONArray("triggers")
+            synchronized(lock) {
+                if (triggers != null) {
+                    for (i in 0 until triggers.length()) pendingTriggers.add(triggers.getString(i))
+                }
+            }
+            submitScan()
+        } catch (e: Exception) {
+            // Fail-soft: malformed payload, wait for the next change
+        }
+    }
+
+    private fun submitScan() {
+        synchronized(lock) {
+            val exec = executor ?: return
+            if (scanQueued) return
+            scanQueued = true
+            try {
+                exec.execute { runScan() }
+            } catch (e: Exception) {
+                scanQueued = false
+            }
+        }
+    }
+
+    private fun runScan() {
+        val cancel = ScanCancel()
+        val (context, triggers) = synchronized(lock) {
+            val context = appContext ?: return
+            if (listener == null) return  // stopped while queued
+            val triggers = pendingTriggers.toList()
+            pendingTriggers.clear()
+            scanQueued = false
+            runningScan = cancel
+            context to triggers
+        }
+
+        val scanStart = System.nanoTime()
+        val report = try {
+            DeviceTrust.buildReport(context, cancel = cancel)
+        } catch (e: Exception) {
+            return
+        } finally {
+            synchronized(lock) { if (runningScan === cancel) runningScan = null }
+        }
+        val scanMs = (System.nanoTime() - scanStart) / 1_000_000.0
+
+        val (sink, event) = synchronized(lock) {
+            val sink = listener ?: return
+            val previous = lastReport
+            lastReport = report
+            val changed = flagsOf(report).filter { (flag, value) -> previous == null || flagsOf(previous)[flag] != value }
+            if (previous != null && changed.isEmpty()) return
+            sink to mapOf(
+                "type" to if (previous == null) "baseline" else "change",
+                "seq" to seq.incrementAndGet(),
+                "triggers" to triggers,
+                "changed" to changed,
+                "scanMs" to scanMs,
+                "monitor" to monitorStats()
+            )
+        }
+        sink(event)
+    }
+
+    private fun flagsOf(report: DeviceTrustReport): Map<String, Boolean> = mapOf(
+        "rootedOrJailbroken" to report.rootedOrJailbroken,
+        "emulator" to report.emulator,
+        "devModeEnabled" to report.devModeEnabled,
+        "adbEnabled" to report.adbEnabled,
+        "fridaSuspected" to report.fridaSuspected,
+        "debuggerAttached" to report.debuggerAttached
+    )
+
+    private fun monitorStats(): Map<String, Any?> {
+        return try {
+            val json = JSONObject(DeviceTrustNative.monitorStatsOrEmpty())
+            json.keys().asSequence().associateWith { json.get(it) }
+        } catch (e: Exception) {
+            emptyMap()
+        }
+    }
+}
@@ -1,9 +1,21 @@
 // [DeviceTrust/Android] DeviceTrustNative - JNI Bridge
 // Collects security signals from native C++ layer.
-// Fail-soft design: App won't crash if native lib fails to load, returns empty JSON.
+// Fail-soft design: App won't crash if native lib fails to load, returns no result.
 
 package com.mikoloy.device_trust
 
+import java.nio.ByteBuffer
+
+/**
+ * Receives each native stage as soon as it finishes
+ *
+ * Stage ids: nativeTracerPid, nativeRwx (FAST), nativeMaps, nativeFd,
+ * nativeLibc, nativeIntegrity and nativeMemory (DEEP).
+ */
+fun interface NativeStageListener {
+    fun onStage(id: String, signals: Int, elapsedNs: Long)
+}
+
 /**
  * [DeviceTrust/Android] DeviceTrustNative - JNI bridge
  * 
@@ -13,13 +25,23 @@ package com.mikoloy.device_trust
  * - dladdr symbol check (libc getpid)
  * - Suspicious module list
  * 
+ * External funs are bound by RegisterNatives in JNI_OnLoad (NATIVE_METHODS in
+ * device_trust_native.cpp); keep their signatures in sync with that table.
+ *
  * Fail-soft: if lib fails to load, loaded=false; app won't crash
  */
 object DeviceTrustNative {
 
     private var loaded: Boolean = false
 
+    /**
+     * Time spent in System.loadLibrary (ms); measured once on first touch of this object
+     */
+    var libraryLoadTimeMs: Double = 0.0
+        private set
+
     init {
+        val loadStart = System.nanoTime()
         try {
             System.loadLibrary("device_trust_native")
             loaded = true
@@ -30,49 +52,375 @@ object DeviceTrustNative {
             // Unexpected error - fail-soft
             loaded = false
         }
+        libraryLoadTimeMs = (System.nanoTime() - loadStart) / 1_000_000.0
     }
 
     /**
-     * Collects native signals and returns JSON string (private)
-     * 
-     * JSON format:
-     * {
-     *   "rwxSegments": <int>,
-     *   "hasRwx": <bool>,
-     *   "fridaLibLoaded": <bool>,
-     *   "fdFrida": <bool>,
-     *   "libcGetpidSo": "<string>",
-     *   "libcGetpidUnexpected": <bool>,
-     *   "nativeTimeMs": <double>,
-     *   "suspiciousModules": [<string>, ...]
-     * }
+     * Forces class initialization (library load) without running a scan.
+     *
+     * @return true if the native library is available
      */
-    private external fun collectNativeSignals(): String
+    fun isLoaded(): Boolean = loaded
+
+    // Packed results stay well under 1 KiB; lists that do not fit are truncated
+    private const val RESULT_BUFFER_SIZE = 4096
+
+    // One direct buffer per scanning thread, reused across scans
+    // (subclass rather than ThreadLocal.withInitial, which needs API 26)
+    private val resultBuffer = object : ThreadLocal<ByteBuffer>() {
+        override fun initialValue(): ByteBuffer = ByteBuffer.allocateDirect(RESULT_BUFFER_SIZE)
+    }
+
+    /**
+     * Collects native signals into [buffer] as a packed binary result (private)
+     *
+     * Layout: see writeSignalsBinary in device_trust_native.cpp; decoded by
+     * NativeResult.decode.
+     *
+     * @param level ScanLevel.nativeValue
+     * @param signalMask SignalGroup bits; HOOK runs the maps/fd/libc stages, DEBUGGER reads TracerPid
+     * @param verdictsOnly stop the hook stages once the 2-signal verdict is settled
+     * @param budgetNs remaining latency budget; native stages stop once spent
+     * @param listener called on the calling thread after each native stage (streaming reports)
+     * @param cancelFlag 1-byte direct ByteBuffer (ScanCancel.flag); the stages stop once it is non-zero
+     * @param buffer direct ByteBuffer receiving the result
+     * @return bytes written; negative if the buffer is not direct or too small
+     */
+    private external fun collectNativeSignalsInto(
+        level: Int,
+        signalMask: Int,
+        verdictsOnly: Boolean,
+        budgetNs: Long,
+        listener: NativeStageListener?,
+        cancelFlag: ByteBuffer?,
+        buffer: ByteBuffer
+    ): Int
 
     /**
      * [DeviceTrust/Android] Collects native signals (fail-soft)
-     * 
-     * Calls collectNativeSignals() if native lib is loaded.
-     * Returns empty JSON on any error.
-     * 
+     *
+     * Calls collectNativeSignalsInto() if native lib is loaded and decodes
+     * the packed result; no JSON is built or parsed on this path.
+     *
      * Fail-soft behavior:
-     * - If native lib not loaded → "{}"
-     * - If JNI call fails → "{}"
+     * - If native lib not loaded → null
+     * - If JNI call fails or the result does not decode → null
      * - App never crashes
-     * 
-     * @return JSON string; "{}" if native lib not loaded or error occurs
+     *
+     * @return decoded result; null if native lib not loaded or error occurs
      */
-    fun collectNativeSignalsOrEmpty(): String {
+    fun collectNativeResultOrNull(
+        level: Int,
+        signalMask: Int,
+        verdictsOnly: Boolean,
+        budgetNs: Long,
+        listener: NativeStageListener? = null,
+        cancelFlag: ByteBuffer? = null
+    ): NativeResult? {
         if (!loaded) {
-            return "{}"
+            return null
         }
 
         return try {
-            collectNativeSignals()
+            val buffer = resultBuffer.get()!!
+            val length = collectNativeSignalsInto(level, signalMask, verdictsOnly, budgetNs, listener, cancelFlag, buffer)
+            if (length < 0) null else NativeResult.decode(buffer, length)
         } catch (e: UnsatisfiedLinkError) {
-            "{}"
+            null
         } catch (e: Exception) {
+            null
+        }
+    }
+
+    private external fun captureSnapshot(): ByteArray?
+
+    /**
+     * [DeviceTrust/Android] Snapshot bundle of every native check input (fail-soft)
+     *
+     * Format: src/core/snapshot.h; replayed offline with device_trust_snapshot.
+     *
+     * @return bundle bytes; null if the native lib is not loaded or capture fails
+     */
+    fun captureSnapshotOrNull(): ByteArray? {
+        if (!loaded) return null
+        return try {
+            captureSnapshot()
+        } catch (e: Throwable) {
+            null
+        }
+    }
+
+    // Breaker states (values shared with BreakerState in device_trust_native.cpp)
+    const val BREAKER_CLOSED = 0
+    const val BREAKER_OPEN = 1
+    const val BREAKER_HALF_OPEN = 2
+
+    private external fun admitCheck(id: String): Int
+    private external fun recordCheck(id: String, elapsedNs: Long, hit: Boolean, overBudget: Boolean)
+    private external fun recordEvent(id: String, event: Int, elapsedNs: Long)
+    private external fun statsSnapshot(): String
+    private external fun recordTrace(name: String, beginNs: Long, durationNs: Long)
+    private external fun dumpTrace(): String
+    private external fun checkScore(id: String, priorNs: Double): Double
+    private external fun demotedChecks(): String
+    private external fun exportStats(): String
+    private external fun importStats(text: String): Int
+
+    /**
+     * [DeviceTrust/Android] Check stats store (fail-soft)
+     *
+     * Per-check cost EWMA, hit counts and circuit breaker live in the native
+     * store (p99 comes from the telemetry histograms). Without the native lib every check stays closed and is
+     * ordered by its prior cost.
+     *
+     * @return breaker state for the next run of [id]; BREAKER_CLOSED on error
+     */
+    fun admitCheckOrClosed(id: String): Int {
+        if (!loaded) return BREAKER_CLOSED
+        return try {
+            admitCheck(id)
+        } catch (e: Throwable) {
+            BREAKER_CLOSED
+        }
+    }
+
+    fun recordCheckOrIgnore(id: String, elapsedNs: Long, hit: Boolean, overBudget: Boolean) {
+        if (!loaded) return
+        try {
+            recordCheck(id, elapsedNs, hit, overBudget)
+        } catch (e: Throwable) {
+            // Fail-soft: stats are best effort
+        }
+    }
+
+    // Telemetry events (values shared with TelemetryEvent in core/telemetry.h);
+    // recordCheckOrIgnore already counts the calls of planned checks
+    const val EVENT_CALL = 0
+    const val EVENT_CACHE_HIT = 1
+    const val EVENT_TIMEOUT = 2
+    const val EVENT_CANCELLATION = 3
+
+    /**
+     * [DeviceTrust/Android] Cumulative telemetry (fail-soft)
+     *
+     * Counts [event] for check [id] in the native telemetry store, kept
+     * since process start next to the per-check latency histograms.
+     */
+    fun recordEventOrIgnore(id: String, event: Int, elapsedNs: Long = 0) {
+        if (!loaded) return
+        try {
+            recordEvent(id, event, elapsedNs)
+        } catch (e: Throwable) {
+            // Fail-soft: telemetry is best effort
+        }
+    }
+
+    /**
+     * @return compact JSON snapshot of the telemetry store (see
+     *   telemetryToJson); null if the native lib is not loaded
+     */
+    fun statsSnapshotOrNull(): String? {
+        if (!loaded) return null
+        return try {
+            statsSnapshot()
+        } catch (e: Throwable) {
+            null
+        }
+    }
+
+    /**
+     * [DeviceTrust/Android] Trace ring (fail-soft)
+     *
+     * Adds a Kotlin section ([beginNs] from System.nanoTime(), the native
+     * clock) to the ring the native stages record into.
+     */
+    fun recordTraceOrIgnore(name: String, beginNs: Long, durationNs: Long) {
+        if (!loaded) return
+        try {
+            recordTrace(name, beginNs, durationNs)
+        } catch (e: Throwable) {
+            // Fail-soft: tracing is best effort
+        }
+    }
+
+    /**
+     * @return the last sections as Chrome trace JSON; null if the native lib
+     *   is not loaded
+     */
+    fun dumpTraceOrNull(): String? {
+        if (!loaded) return null
+        return try {
+            dumpTrace()
+        } catch (e: Throwable) {
+            null
+        }
+    }
+
+    /**
+     * Expected cost per hit (ns); [priorNs] / 0.5 until measured or on error
+     */
+    fun checkScoreOrPrior(id: String, priorNs: Double): Double {
+        if (!loaded) return priorNs * 2
+        return try {
+            checkScore(id, priorNs)
+        } catch (e: Throwable) {
+            priorNs * 2
+        }
+    }
+
+    /**
+     * @return JSON array of {id, state, trips, ewmaMs, p99Ms}; "[]" on error
+     */
+    fun demotedChecksOrEmpty(): String {
+        if (!loaded) return "[]"
+        return try {
+            demotedChecks()
+        } catch (e: Throwable) {
+            "[]"
+        }
+    }
+
+    fun exportStatsOrEmpty(): String {
+        if (!loaded) return ""
+        return try {
+            exportStats()
+        } catch (e: Throwable) {
+            ""
+        }
+    }
+
+    /**
+     * @return number of checks restored
+     */
+    fun importStatsOrIgnore(text: String): Int {
+        if (!loaded) return 0
+        return try {
+            importStats(text)
+        } catch (e: Throwable) {
+            0
+        }
+    }
+
+    // Signature pack sections (see core/signature_pack.h)
+    const val SIGNATURE_MODULE_KEYWORDS = 1
+    const val SIGNATURE_SU_PATHS = 5
+    const val SIGNATURE_ROOT_PACKAGES = 6
+    const val SIGNATURE_QEMU_FILES = 7
+
+    private external fun loadSignaturePack(path: String): Int
+    private external fun signatureList(section: Int): Array<String>?
+    private external fun signaturePorts(): IntArray?
+
+    /**
+     * [DeviceTrust/Android] Signature packs (fail-soft)
+     *
+     * Maps, validates and installs the pack at [path]; native scans started
+     * afterwards use its keyword and memory signature sections.
+     *
+     * @return the installed pack version, a negative status (-1 unreadable,
+     *   -2 malformed, -3 checksum mismatch, -4 over the limits, -5 not newer
+     *   than the active pack), or null if the native lib is not loaded
+     */
+    fun loadSignaturePackOrNull(path: String): Int? {
+        if (!loaded) return null
+        return try {
+            loadSignaturePack(path)
+        } catch (e: Throwable) {
+            null
+        }
+    }
+
+    /**
+     * @return the active pack's list for [section]; null when the pack leaves
+     *   it to the built-in Kotlin list or the native lib is not loaded
+     */
+    fun signatureListOrNull(section: Int): List<String>? {
+        if (!loaded) return null
+        return try {
+            signatureList(section)?.toList()
+        } catch (e: Throwable) {
+            null
+        }
+    }
+
+    fun signaturePortsOrNull(): List<Int>? {
+        if (!loaded) return null
+        return try {
+            signaturePorts()?.toList()
+        } catch (e: Throwable) {
+            null
+        }
+    }
+
+    private external fun startMonitor(minIntervalMs: Long, maxIntervalMs: Long): Boolean
+    private external fun stopMonitor()
+    private external fun monitorStats(): String
+
+    /**
+     * [DeviceTrust/Android] Background monitor (fail-soft)
+     *
+     * Starts the native monitor thread; changes are delivered to
+     * DeviceTrustMonitor.onNativeChange on that thread.
+     *
+     * @return false if the native lib is not loaded, the monitor is already
+     *   running, or the call fails
+     */
+    fun startMonitorOrFalse(minIntervalMs: Long, maxIntervalMs: Long): Boolean {
+        if (!loaded) return false
+        return try {
+            startMonitor(minIntervalMs, maxIntervalMs)
+        } catch (e: Throwable) {
+            false
+        }
+    }
+
+    fun stopMonitorOrIgnore() {
+        if (!loaded) return
+        try {
+            stopMonitor()
+        } catch (e: Throwable) {
+            // Fail-soft
+        }
+    }
+
+    /**
+     * @return JSON {running, ticks, changes, intervalMs, cpuMs, cpuPercent}; "{}" on error
+     */
+    fun monitorStatsOrEmpty(): String {
+        if (!loaded) return "{}"
+        return try {
+            monitorStats()
+        } catch (e: Throwable) {
             "{}"
         }
     }
+
+    private external fun verdictWord(): Long
+    private external fun publishVerdict(groups: Int, flags: Int, level: Int)
+
+    /**
+     * [DeviceTrust/Android] Published verdict word (fail-soft)
+     *
+     * One atomic load in native code; layout in src/core/verdict.h, decoded
+     * by DeviceTrustVerdict.
+     *
+     * @return 0 if nothing was published, the native lib is not loaded or the call fails
+     */
+    fun verdictWordOrZero(): Long {
+        if (!loaded) return 0L
+        return try {
+            verdictWord()
+        } catch (e: Throwable) {
+            0L
+        }
+    }
+
+    fun publishVerdictOrIgnore(groups: Int, flags: Int, level: Int) {
+        if (!loaded) return
+        try {
+            publishVerdict(groups, flags, level)
+        } catch (e: Throwable) {
+            // Fail-soft: readers keep the previous verdict
+        }
+    }
 }
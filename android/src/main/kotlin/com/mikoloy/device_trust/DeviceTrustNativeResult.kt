@@ -0,0 +1,172 @@
+// [DeviceTrust/Android] Packed native result
+// Decodes the fixed-layout binary result written by collectNativeSignalsInto.
+// Layout is documented next to writeSignalsBinary in device_trust_native.cpp.
+
+package com.mikoloy.device_trust
+
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * One timed native stage: duration and work counter (maps lines, fd entries,
+ * regions or symbols visited; see TimedStage in device_trust_native.cpp)
+ */
+data class NativeStageTiming(val id: String, val ns: Long, val items: Int)
+
+/**
+ * [DeviceTrust/Android] NativeResult
+ *
+ * Stage bit masks use the HookStage order: maps, fd, libc, integrity, memory.
+ * memoryRegionStart / memoryMatchAddress are 0 unless a memory signature was
+ * found.
+ */
+data class NativeResult(
+    val scanLevel: Int,
+    val signalMask: Int,
+    val tracerPid: Int,
+    val rwxSegments: Int,
+    val hasRwx: Boolean,
+    val fridaLibLoaded: Boolean,
+    val fdFrida: Boolean,
+    val libcGetpidSo: String,
+    val libcGetpidUnexpected: Boolean,
+    val libcSymbolsChecked: Int,
+    val gotMismatch: List<String>,
+    val textMismatch: List<String>,
+    val memorySignatureFound: Boolean,
+    val memorySignature: String,
+    val memoryRegionPath: String,
+    val memoryRegionStart: Long,
+    val memoryMatchAddress: Long,
+    val memorySampled: Boolean,
+    val skippedStages: Int,
+    val demotedStages: Int,
+    val budgetExceeded: Boolean,
+    val truncated: Boolean,
+    val nativeTimeNs: Long,
+    val stages: List<NativeStageTiming>,
+    val suspiciousModules: List<String>
+) {
+    companion object {
+        // Stage names by HookStage index
+        val STAGE_NAMES = listOf("maps", "fd", "libc", "integrity", "memory")
+
+        // Stage ids by TimedStage index (hook stages first, same order as above)
+        val TIMED_STAGE_IDS = listOf(
+            "nativeMaps", "nativeFd", "nativeLibc", "nativeIntegrity", "nativeMemory", "nativeTracerPid", "nativeRwx"
+        )
+
+        // Must match RESULT_* in device_trust_native.cpp
+        private const val MAGIC = 0x314E5444
+        private const val VERSION = 4
+        private const val STAGE_NS_OFFSET = 56
+        private const val STAGE_ITEMS_OFFSET = 112
+        private const val MEMORY_OFFSET = 144
+        private const val HEADER_SIZE = 160
+
+        private const val FLAG_HAS_RWX = 1 shl 0
+        private const val FLAG_FRIDA_LIB = 1 shl 1
+        private const val FLAG_FD_FRIDA = 1 shl 2
+        private const val FLAG_LIBC_UNEXPECTED = 1 shl 3
+        private const val FLAG_BUDGET_EXCEEDED = 1 shl 4
+        private const val FLAG_TRUNCATED = 1 shl 5
+        private const val FLAG_MEMORY_SAMPLED = 1 shl 6
+        private const val FLAG_MEMORY_SIGNATURE = 1 shl 7
+
+        /**
+         * Decodes [length] bytes at the start of [buffer] using absolute reads
+         * (the buffer's position and limit are left untouched)
+         *
+         * @return null if the magic, version or size does not match
+         */
+        fun decode(buffer: ByteBuffer, length: Int): NativeResult? {
+            if (length < HEADER_SIZE || length > buffer.capacity()) return null
+            val buf = buffer.duplicate().order(ByteOrder.nativeOrder())
+            if (buf.getInt(0) != MAGIC) return null
+            if ((buf.getShort(4).toInt() and 0xFFFF) != VERSION) return null
+            if ((buf.getShort(6).toInt() and 0xFFFF) != length) return null
+
+            val flags = buf.getInt(8)
+            val reader = ListReader(buf, HEADER_SIZE, length)
+            val libcSo = reader.next()
+            val memorySignature = reader.next()
+            val memoryRegionPath = reader.next()
+            val gotMismatch = reader.next()
+            val textMismatch = reader.next()
+            val suspiciousModules = reader.next()
+
+            val stagesRan = buf.getInt(48)
+            val stages = TIMED_STAGE_IDS.indices
+                .filter { (stagesRan and (1 shl it)) != 0 }
+                .map { NativeStageTiming(TIMED_STAGE_IDS[it], buf.getLong(STAGE_NS_OFFSET + 8 * it), buf.getInt(STAGE_ITEMS_OFFSET + 4 * it)) }
+
+            return NativeResult(
+                scanLevel = buf.getInt(12),
+                signalMask = buf.getInt(16),
+                tracerPid = buf.getInt(20),
+                rwxSegments = buf.getInt(24),
+                hasRwx = (flags and FLAG_HAS_RWX) != 0,
+                fridaLibLoaded = (flags and FLAG_FRIDA_LIB) != 0,
+                fdFrida = (flags and FLAG_FD_FRIDA) != 0,
+                libcGetpidSo = libcSo.firstOrNull() ?: "",
+                libcGetpidUnexpected = (flags and FLAG_LIBC_UNEXPECTED) != 0,
+                libcSymbolsChecked = buf.getInt(28),
+                gotMismatch = gotMismatch,
+                textMismatch = textMismatch,
+                memorySignatureFound = (flags and FLAG_MEMORY_SIGNATURE) != 0,
+                memorySignature = memorySignature.firstOrNull() ?: "",
+                memoryRegionPath = memoryRegionPath.firstOrNull() ?: "",
+                memoryRegionStart = buf.getLong(MEMORY_OFFSET),
+                memoryMatchAddress = buf.getLong(MEMORY_OFFSET + 8),
+                memorySampled = (flags and FLAG_MEMORY_SAMPLED) != 0,
+                skippedStages = buf.getInt(32),
+                demotedStages = buf.getInt(36),
+                budgetExceeded = (flags and FLAG_BUDGET_EXCEEDED) != 0,
+                truncated = (flags and FLAG_TRUNCATED) != 0 || reader.overrun,
+                nativeTimeNs = buf.getLong(40),
+                stages = stages,
+                suspiciousModules = suspiciousModules
+            )
+        }
+
+        /**
+         * Stage names for a HookStage bit mask
+         */
+        fun stageNames(mask: Int): List<String> =
+            STAGE_NAMES.filterIndexed { index, _ -> (mask and (1 shl index)) != 0 }
+    }
+
+    /**
+     * Reads u16 count + (u16 length + UTF-8 bytes)* lists; stops at [end]
+     */
+    private class ListReader(private val buf: ByteBuffer, private var pos: Int, private val end: Int) {
+        var overrun = false
+            private set
+
+        fun next(): List<String> {
+            if (pos + 2 > end) {
+                overrun = true
+                return emptyList()
+            }
+            val count = buf.getShort(pos).toInt() and 0xFFFF
+            pos += 2
+            val items = ArrayList<String>(count)
+            repeat(count) {
+                if (pos + 2 > end) {
+                    overrun = true
+                    return items
+                }
+                val length = buf.getShort(pos).toInt() and 0xFFFF
+                if (pos + 2 + length > end) {
+                    overrun = true
+                    return items
+                }
+                val bytes = ByteArray(length)
+                for (i in 0 until length) bytes[i] = buf.get(pos + 2 + i)
+                items.add(String(bytes, Charsets.UTF_8))
+                pos += 2 + length
+            }
+            return items
+        }
+    }
+}
@@ -0,0 +1,125 @@
+// [DeviceTrust/Android] Evaluation planner
+// Orders checks by measured cost and hit rate; stops a verdict group once it is settled.
+// Checks that keep exceeding their budget are demoted to DEEP (circuit breaker).
+
+package com.mikoloy.device_trust
+
+/**
+ * Result of one check: positive signal count and whether a hit is strong
+ * (settles its group alone, e.g. ro.kernel.qemu=1)
+ */
+data class CheckOutcome(val signals: Int, val strong: Boolean = false) {
+    companion object {
+        val NONE = CheckOutcome(0)
+
+        fun of(hit: Boolean, strong: Boolean = false): CheckOutcome =
+            if (hit) CheckOutcome(1, strong) else NONE
+    }
+}
+
+/**
+ * One check of a verdict group
+ *
+ * @param id stats key; also the details key marked "skipped:decided" / "skipped:budget" / "skipped:demoted"
+ * @param priorCostUs cost estimate used until the check has been measured
+ * @param maxSignals upper bound of signals the check can contribute
+ * @param canBeStrong whether a hit can settle the group alone
+ * @param budgetUs runs slower than this count towards the check's circuit breaker
+ */
+class PlannedCheck(
+    val id: String,
+    val priorCostUs: Double,
+    val maxSignals: Int = 1,
+    val canBeStrong: Boolean = false,
+    val budgetUs: Double = EvaluationPlanner.DEFAULT_BUDGET_US,
+    val run: () -> CheckOutcome
+)
+
+/**
+ * Total signals of an evaluated group
+ */
+data class GroupResult(val signals: Int, val strong: Boolean)
+
+/**
+ * [DeviceTrust/Android] EvaluationPlanner
+ *
+ * Checks are ordered by expected cost per hit: cost EWMA divided by the
+ * Laplace-smoothed historical hit rate, so cheap, frequently positive
+ * checks run first. With verdictsOnly, a group stops as soon as its verdict
+ * is settled (threshold reached, or no longer reachable by the remaining
+ * checks) and the rest are marked "skipped:decided".
+ *
+ * Cost, hit rate and breaker state come from the native check stats store
+ * (persisted by DeviceTrustStats). A check with an open breaker is left out
+ * of STANDARD scans and marked "skipped:demoted"; DEEP scans still run it.
+ * Once the cooldown has elapsed the next run is a half-open probe.
+ */
+object EvaluationPlanner {
+
+    const val SKIPPED_DECIDED = "skipped:decided"
+    const val SKIPPED_DEMOTED = "skipped:demoted"
+
+    const val DEFAULT_BUDGET_US = 50_000.0
+
+    /**
+     * Runs [checks] in planned order
+     *
+     * The group is positive with a strong hit or at least [threshold] signals.
+     */
+    fun evaluate(
+        checks: List<PlannedCheck>,
+        threshold: Int,
+        verdictsOnly: Boolean,
+        deadline: ScanDeadline,
+        details: MutableMap<String, Any?>
+    ): GroupResult {
+        val ordered = order(checks.filter { admit(it, deadline, details) })
+        var signals = 0
+        var strong = false
+
+        ordered.forEachIndexed { index, check ->
+            if (verdictsOnly && isDecided(signals, strong, threshold, ordered.subList(index, ordered.size))) {
+                details[check.id] = SKIPPED_DECIDED
+                DeviceTrustNative.recordEventOrIgnore(check.id, DeviceTrustNative.EVENT_CANCELLATION)
+                return@forEachIndexed
+            }
+            if (!deadline.allow(check.id, details)) return@forEachIndexed
+
+            val start = System.nanoTime()
+            val outcome = DeviceTrustTrace.section(check.id, check.run)
+            val elapsedNs = System.nanoTime() - start
+            deadline.publish(check.id, details[check.id] ?: outcome.signals, outcome.signals > 0, elapsedNs)
+            DeviceTrustNative.recordCheckOrIgnore(
+                check.id,
+                elapsedNs,
+                outcome.signals > 0,
+                elapsedNs / 1_000.0 > check.budgetUs
+            )
+
+            signals += outcome.signals
+            strong = strong || outcome.strong
+        }
+        return GroupResult(signals, strong)
+    }
+
+    private fun isDecided(signals: Int, strong: Boolean, threshold: Int, remaining: List<PlannedCheck>): Boolean {
+        if (strong || signals >= threshold) return true
+        val reachable = signals + remaining.sumOf { it.maxSignals }
+        return reachable < threshold && remaining.none { it.canBeStrong }
+    }
+
+    /**
+     * Returns false and marks the check "skipped:demoted" if its breaker is open
+     */
+    private fun admit(check: PlannedCheck, deadline: ScanDeadline, details: MutableMap<String, Any?>): Boolean {
+        val state = DeviceTrustNative.admitCheckOrClosed(check.id)
+        if (state != DeviceTrustNative.BREAKER_OPEN || deadline.runDemoted) return true
+        details[check.id] = SKIPPED_DEMOTED
+        deadline.demoted.add(check.id)
+        return false
+    }
+
+    private fun order(checks: List<PlannedCheck>): List<PlannedCheck> {
+        return checks.sortedBy { DeviceTrustNative.checkScoreOrPrior(it.id, it.priorCostUs * 1_000.0) }
+    }
+}
@@ -1,45 +1,195 @@
 package com.mikoloy.device_trust
 
 import android.content.Context
+import android.os.Handler
+import android.os.Looper
 import io.flutter.embedding.engine.plugins.FlutterPlugin
+import io.flutter.plugin.common.EventChannel
 import io.flutter.plugin.common.MethodCall
 import io.flutter.plugin.common.MethodChannel
+import java.util.concurrent.ExecutorService
+import java.util.concurrent.Executors
 
 /** DeviceTrustPlugin */
-class DeviceTrustPlugin : FlutterPlugin, MethodChannel.MethodCallHandler {
+class DeviceTrustPlugin : FlutterPlugin, MethodChannel.MethodCallHandler, EventChannel.StreamHandler {
   private lateinit var channel: MethodChannel
+  private lateinit var watchChannel: EventChannel
+  private lateinit var reportChannel: EventChannel
   private lateinit var appContext: Context
+  private val mainHandler = Handler(Looper.getMainLooper())
+  // getDeviceTrustReport scans, one at a time
+  private val reportExecutor: ExecutorService = Executors.newSingleThreadExecutor { runnable ->
+    Thread(runnable, "DeviceTrust-Report").apply { isDaemon = true }
+  }
 
   override fun onAttachedToEngine(binding: FlutterPlugin.FlutterPluginBinding) {
     appContext = binding.applicationContext
     channel = MethodChannel(binding.binaryMessenger, "device_trust")
     channel.setMethodCallHandler(this)
+    watchChannel = EventChannel(binding.binaryMessenger, "device_trust/watch")
+    watchChannel.setStreamHandler(this)
+    reportChannel = EventChannel(binding.binaryMessenger, "device_trust/report")
+    reportChannel.setStreamHandler(ReportStreamHandler())
+
+    // Opt-in warm-up (manifest meta-data): load native lib + first scan in background
+    if (DeviceTrustWarmUp.isEnabled(appContext)) {
+      DeviceTrustWarmUp.start(appContext)
+    }
   }
 
   override fun onMethodCall(call: MethodCall, result: MethodChannel.Result) {
     when (call.method) {
       "getDeviceTrustReport" -> {
+        val level = ScanLevel.fromWireName(call.argument<String>("level"))
+        val signalMask = call.argument<Int>("signalMask") ?: SignalGroup.ALL
+        val verdictsOnly = call.argument<Boolean>("verdictsOnly") ?: false
+        // Set by the Dart FFI platform, which collects the native signals itself
+        val nativeViaFfi = call.argument<String>("nativeTransport") == "ffi"
+
+        // Waiting for the warm-up and the scan itself stay off the platform main thread
+        reportExecutor.execute {
+          try {
+            // First full standard call may be served by the warm-up scan (pre-computed or in-flight);
+            // its complete report also answers a verdictsOnly request. The warm-up collects the
+            // native signals over JNI, so an FFI caller (which collects them again) never claims it.
+            val claim = if (level == ScanLevel.STANDARD && signalMask == SignalGroup.ALL && !nativeViaFfi) {
+              DeviceTrustWarmUp.claim(WARM_UP_WAIT_MS)
+            } else {
+              null
+            }
+            if (claim?.report != null) {
+              DeviceTrustNative.recordEventOrIgnore("warmUp", DeviceTrustNative.EVENT_CACHE_HIT)
+            }
+            val report = claim?.report
+              ?: DeviceTrust.buildReport(appContext, level, signalMask, verdictsOnly, nativeViaFfi)
+            // Warm-up timing only goes to the call that claimed it
+            val details = if (claim == null) report.details else report.details + ("warmUp" to claim.stats)
+            val map = reportToMap(report, details)
+            mainHandler.post { result.success(map) }
+          } catch (e: Exception) {
+            mainHandler.post { result.error("DEVICE_TRUST_ERROR", e.message, null) }
+          }
+        }
+      }
+      "captureSnapshot" -> {
+        // null (not an error) when the native library is unavailable
+        result.success(DeviceTrustNative.captureSnapshotOrNull())
+      }
+      "getStats" -> {
+        // Compact JSON snapshot of the native telemetry; null without the native library
+        result.success(DeviceTrustNative.statsSnapshotOrNull())
+      }
+      "dumpTrace" -> {
+        // Chrome trace JSON of the recent scans; null without the native library
+        result.success(DeviceTrustNative.dumpTraceOrNull())
+      }
+      "loadSignaturePack" -> {
+        val path = call.argument<String>("path")
+        val version = if (path == null) null else DeviceTrust.loadSignaturePack(path)
+        when {
+          path == null -> result.error("SIGNATURE_PACK_INVALID", "path is required", null)
+          // null (not an error) when the native library is unavailable
+          version == null || version > 0 -> result.success(version)
+          else -> result.error("SIGNATURE_PACK_INVALID", "signature pack rejected", version)
+        }
+      }
+      else -> result.notImplemented()
+    }
+  }
+
+  /**
+   * DeviceTrust.getReportStream(): one scan per listen, run off the main thread.
+   * Emits {type: "check", seq, id, result, hit, elapsedUs} as each check completes,
+   * then {type: "summary", seq, report} and closes the stream.
+   */
+  private inner class ReportStreamHandler : EventChannel.StreamHandler {
+    // Identifies the active listen; events of a cancelled or replaced scan are dropped
+    @Volatile private var active: ScanCancel? = null
+
+    override fun onListen(arguments: Any?, events: EventChannel.EventSink) {
+      // A replaced listen stops its scan like a cancelled one
+      active?.cancel()
+      val token = ScanCancel()
+      active = token
+      val isActive = { active === token }
+      val options = arguments as? Map<*, *>
+      val level = ScanLevel.fromWireName(options?.get("level") as? String)
+      val signalMask = options?.get("signalMask") as? Int ?: SignalGroup.ALL
+      val verdictsOnly = options?.get("verdictsOnly") as? Boolean ?: false
+
+      Thread({
+        // Single producer thread: seq follows completion order
+        var seq = 0L
+        fun emit(event: Map<String, Any?>) {
+          if (isActive()) mainHandler.post { if (isActive()) events.success(event) }
+        }
         try {
-          val report = DeviceTrust.buildReport(appContext)
-          val map = mapOf(
-            "rootedOrJailbroken" to report.rootedOrJailbroken,
-            "emulator" to report.emulator,
-            "devModeEnabled" to report.devModeEnabled,
-            "adbEnabled" to report.adbEnabled,
-            "fridaSuspected" to report.fridaSuspected,
-            "debuggerAttached" to report.debuggerAttached,
-            "details" to report.details
-          )
-          result.success(map)
+          val report = DeviceTrust.buildReport(appContext, level, signalMask, verdictsOnly, cancel = token) { check ->
+            emit(mapOf(
+              "type" to "check",
+              "seq" to ++seq,
+              "id" to check.id,
+              "result" to check.result,
+              "hit" to check.hit,
+              "elapsedUs" to check.elapsedNs / 1_000
+            ))
+          }
+          emit(mapOf("type" to "summary", "seq" to ++seq, "report" to reportToMap(report, report.details)))
+          mainHandler.post { if (isActive()) { active = null; events.endOfStream() } }
         } catch (e: Exception) {
-          result.error("DEVICE_TRUST_ERROR", e.message, null)
+          mainHandler.post { if (isActive()) { active = null; events.error("DEVICE_TRUST_ERROR", e.message, null) } }
         }
+      }, "DeviceTrust-ReportStream").apply {
+        isDaemon = true
+        start()
       }
-      else -> result.notImplemented()
     }
+
+    override fun onCancel(arguments: Any?) {
+      // Native stages stop at their next deadline poll; Kotlin checks run to
+      // their budget and the remaining events are dropped. active is cleared
+      // once the stream ended, so only early cancels count
+      active?.let {
+        it.cancel()
+        DeviceTrustNative.recordEventOrIgnore("reportStream", DeviceTrustNative.EVENT_CANCELLATION)
+      }
+      active = null
+    }
+  }
+
+  private fun reportToMap(report: DeviceTrustReport, details: Map<String, Any?>): Map<String, Any?> = mapOf(
+    "rootedOrJailbroken" to report.rootedOrJailbroken,
+    "emulator" to report.emulator,
+    "devModeEnabled" to report.devModeEnabled,
+    "adbEnabled" to report.adbEnabled,
+    "fridaSuspected" to report.fridaSuspected,
+    "debuggerAttached" to report.debuggerAttached,
+    "details" to details
+  )
+
+  companion object {
+    // Upper bound for attaching to an in-flight warm-up scan; well below the
+    // STANDARD budget, so a timed-out wait (which cancels the warm-up scan)
+    // plus the fresh scan stays short
+    private const val WARM_UP_WAIT_MS = 250L
+  }
+
+  // DeviceTrust.watch(): monitor events are produced off the main thread
+  override fun onListen(arguments: Any?, events: EventChannel.EventSink) {
+    DeviceTrustMonitor.start(appContext) { event ->
+      mainHandler.post { events.success(event) }
+    }
+  }
+
+  override fun onCancel(arguments: Any?) {
+    DeviceTrustMonitor.stop()
   }
 
   override fun onDetachedFromEngine(binding: FlutterPlugin.FlutterPluginBinding) {
     channel.setMethodCallHandler(null)
+    watchChannel.setStreamHandler(null)
+    reportChannel.setStreamHandler(null)
+    DeviceTrustMonitor.stop()
+    reportExecutor.shutdown()
   }
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+// [DeviceTrust/Android] Built-in signature lists
+// Generated by device_trust_signature_gen from src/signatures/signatures.txt;
+// do not edit. Regenerate with
+//   cmake --build <build dir> --target device_trust_signatures
+
+package com.mikoloy.device_trust
+
+/**
+ * Defaults of the Kotlin checks; a loaded signature pack replaces them
+ * section by section (see DeviceTrust.loadSignaturePack)
+ */
+internal object DeviceTrustSignatures {
+    const val VERSION = 1
+
+    val SU_PATHS: List<String> = listOf(
+        "/system/bin/su",
+        "/system/xbin/su",
+        "/sbin/su",
+        "/su/bin/su",
+        "/system/sd/xbin/su",
+        "/system/bin/failsafe/su",
+        "/data/local/xbin/su",
+        "/data/local/bin/su",
+        "/data/local/su"
+    )
+
+    val ROOT_PACKAGES: List<String> = listOf(
+        "com.topjohnwu.magisk",
+        "eu.chainfire.supersu",
+        "com.koushikdutta.superuser",
+        "com.noshufou.android.su",
+        "com.devadvance.rootcloak",
+        "com.devadvance.rootcloakplus"
+    )
+
+    val QEMU_FILES: List<String> = listOf(
+        "/init.goldfish.rc",
+        "/sys/qemu_trace",
+        "/dev/qemu_pipe",
+        "/dev/socket/qemud"
+    )
+
+    val MODULE_KEYWORDS: List<String> = listOf(
+        "frida",
+        "gum-js",
+        "gum_js",
+        "gadget",
+        "substrate",
+        "xposed",
+        "lsposed",
+        "edxposed"
+    )
+
+    val FRIDA_PORTS: List<Int> = listOf(27042, 27043)
+}
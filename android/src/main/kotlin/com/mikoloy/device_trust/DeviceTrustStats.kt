@@ -0,0 +1,62 @@
+// [DeviceTrust/Android] Check stats persistence
+// Saves the native check stats store (cost EWMA, hit counts, breakers)
+// so check ordering and demotions survive process restarts.
+
+package com.mikoloy.device_trust
+
+import android.content.Context
+import java.io.File
+import java.util.concurrent.atomic.AtomicBoolean
+
+/**
+ * [DeviceTrust/Android] DeviceTrustStats
+ *
+ * Loaded once per process before the first scan; saved after scans at most
+ * every SAVE_INTERVAL_MS. Stored in noBackupFilesDir: the data describes this
+ * device and must not be restored onto another one. Fail-soft: a missing or
+ * corrupt file only means checks start from their priors.
+ */
+object DeviceTrustStats {
+
+    private const val FILE_NAME = "device_trust_check_stats.v1"
+
+    private const val SAVE_INTERVAL_MS = 60_000L
+
+    private val loaded = AtomicBoolean(false)
+
+    @Volatile private var lastSavedAtMs: Long = 0
+
+    fun load(context: Context) {
+        if (!loaded.compareAndSet(false, true)) return
+        try {
+            val file = statsFile(context)
+            if (file.exists()) {
+                DeviceTrustNative.importStatsOrIgnore(file.readText())
+            }
+        } catch (e: Exception) {
+            // Fail-soft: start from priors
+        }
+    }
+
+    fun saveIfDue(context: Context) {
+        val now = System.currentTimeMillis()
+        if (now - lastSavedAtMs < SAVE_INTERVAL_MS) return
+
+        synchronized(this) {
+            if (now - lastSavedAtMs < SAVE_INTERVAL_MS) return
+            lastSavedAtMs = now
+            try {
+                val text = DeviceTrustNative.exportStatsOrEmpty()
+                if (text.isEmpty()) return
+                val file = statsFile(context)
+                val tmp = File(file.parentFile, "$FILE_NAME.tmp")
+                tmp.writeText(text)
+                tmp.renameTo(file)
+            } catch (e: Exception) {
+                // Fail-soft: stats are best effort
+            }
+        }
+    }
+
+    private fun statsFile(context: Context): File = File(context.noBackupFilesDir, FILE_NAME)
+}
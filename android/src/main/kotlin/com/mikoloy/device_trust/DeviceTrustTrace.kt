@@ -0,0 +1,28 @@
+// [DeviceTrust/Android] Trace sections
+// Every check runs inside an android.os.Trace section, so scans show up on
+// Perfetto / systrace startup traces instead of as one opaque call. Sections
+// are also added to the native trace ring exported by DeviceTrust.dumpTrace().
+
+package com.mikoloy.device_trust
+
+import android.os.Trace
+
+object DeviceTrustTrace {
+
+    /**
+     * Runs [block] inside a section named [name] (a check id or scan phase)
+     *
+     * Trace.beginSection is a no-op unless a tracer is attached; the ring
+     * entry costs one JNI call.
+     */
+    inline fun <T> section(name: String, block: () -> T): T {
+        Trace.beginSection(name)
+        val startNs = System.nanoTime()
+        try {
+            return block()
+        } finally {
+            Trace.endSection()
+            DeviceTrustNative.recordTraceOrIgnore(name, startNs, System.nanoTime() - startNs)
+        }
+    }
+}
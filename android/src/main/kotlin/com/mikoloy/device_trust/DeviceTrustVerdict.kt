@@ -0,0 +1,96 @@
+// [DeviceTrust/Android] Published verdict
+// Decodes the verdict word published by the native layer (src/core/verdict.h).
+// Reading it is one JNI call and one atomic load: no locks, no channel, no scan.
+
+package com.mikoloy.device_trust
+
+import android.os.SystemClock
+
+/**
+ * [DeviceTrust/Android] Latest published verdict
+ *
+ * Flags of groups that were never evaluated completely (see [covers]) only
+ * reflect hits of scans that skipped some of their checks. A hook flag set by
+ * a DEEP scan is only cleared by the next DEEP scan, not by FAST or STANDARD.
+ *
+ * @param seq publish sequence number (1..4095, wraps); changes on every publish
+ * @param publishedAtMs SystemClock.elapsedRealtime() at publish
+ * @param pending a monitor detector changed and the rescan is not published yet
+ */
+data class DeviceTrustVerdict(
+    val rootedOrJailbroken: Boolean,
+    val emulator: Boolean,
+    val devModeEnabled: Boolean,
+    val adbEnabled: Boolean,
+    val fridaSuspected: Boolean,
+    val debuggerAttached: Boolean,
+    val groups: Int,
+    val pending: Boolean,
+    val seq: Int,
+    val publishedAtMs: Long
+) {
+    /**
+     * Whether a report evaluated [group] (SignalGroup bit) completely since process start
+     */
+    fun covers(group: Int): Boolean = (groups and group) == group
+
+    fun ageMs(nowMs: Long = SystemClock.elapsedRealtime()): Long = nowMs - publishedAtMs
+
+    /**
+     * True if the verdict is older than [maxAgeMs] or a rescan is pending
+     */
+    fun isStale(maxAgeMs: Long, nowMs: Long = SystemClock.elapsedRealtime()): Boolean =
+        pending || ageMs(nowMs) > maxAgeMs
+
+    companion object {
+        // Must match VerdictFlag / VERDICT_* in src/core/verdict.h
+        const val FLAG_ROOTED = 1 shl 0
+        const val FLAG_EMULATOR = 1 shl 1
+        const val FLAG_DEV_MODE = 1 shl 2
+        const val FLAG_ADB = 1 shl 3
+        const val FLAG_FRIDA = 1 shl 4
+        const val FLAG_DEBUGGER = 1 shl 5
+
+        private const val GROUPS_SHIFT = 6
+        private const val GROUPS_MASK = 0x1F
+        private const val PENDING = 1L shl 11
+        private const val SEQ_SHIFT = 12
+        private const val SEQ_MASK = 0xFFF
+        private const val TIME_SHIFT = 26
+
+        /**
+         * @return null if nothing was published yet
+         */
+        fun decode(word: Long): DeviceTrustVerdict? {
+            val seq = ((word ushr SEQ_SHIFT) and SEQ_MASK.toLong()).toInt()
+            if (seq == 0) return null
+            val flags = word.toInt()
+            return DeviceTrustVerdict(
+                rootedOrJailbroken = (flags and FLAG_ROOTED) != 0,
+                emulator = (flags and FLAG_EMULATOR) != 0,
+                devModeEnabled = (flags and FLAG_DEV_MODE) != 0,
+                adbEnabled = (flags and FLAG_ADB) != 0,
+                fridaSuspected = (flags and FLAG_FRIDA) != 0,
+                debuggerAttached = (flags and FLAG_DEBUGGER) != 0,
+                groups = (flags ushr GROUPS_SHIFT) and GROUPS_MASK,
+                pending = (word and PENDING) != 0L,
+                seq = seq,
+                publishedAtMs = word ushr TIME_SHIFT
+            )
+        }
+
+        /**
+         * VERDICT_* bits of [report]
+         */
+        fun flagsOf(report: DeviceTrustReport): Int {
+            var flags = 0
+            if (report.rootedOrJailbroken) flags = flags or FLAG_ROOTED
+            if (report.emulator) flags = flags or FLAG_EMULATOR
+            if (report.devModeEnabled) flags = flags or FLAG_DEV_MODE
+            if (report.adbEnabled) flags = flags or FLAG_ADB
+            if (report.fridaSuspected) flags = flags or FLAG_FRIDA
+            if (report.debuggerAttached) flags = flags or FLAG_DEBUGGER
+            return flags
+        }
+    }
+}
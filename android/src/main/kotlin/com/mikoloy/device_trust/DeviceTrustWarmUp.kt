@@ -0,0 +1,153 @@
+// [DeviceTrust/Android] Warm-up scan
+// Opt-in background scan started at plugin attach.
+// Loads the native library and pre-computes the first report off the main thread.
+
+package com.mikoloy.device_trust
+
+import android.content.Context
+import android.content.pm.PackageManager
+import android.os.Build
+import android.os.Process
+import java.util.concurrent.FutureTask
+import java.util.concurrent.TimeUnit
+import java.util.concurrent.TimeoutException
+import java.util.concurrent.atomic.AtomicBoolean
+import java.util.concurrent.atomic.AtomicReference
+
+/**
+ * [DeviceTrust/Android] DeviceTrustWarmUp
+ *
+ * Enabled by the host app with an <application> meta-data entry:
+ *
+ *   <meta-data android:name="com.mikoloy.device_trust.WARM_UP" android:value="true" />
+ *
+ * The first getDeviceTrustReport call either receives the pre-computed report
+ * (if it is still fresh) or waits for the in-flight scan instead of starting a
+ * second one. A wait that times out cancels the warm-up scan, so it does not
+ * run alongside the caller's own scan. Later calls always run a fresh scan.
+ */
+object DeviceTrustWarmUp {
+
+    private const val META_DATA_KEY = "com.mikoloy.device_trust.WARM_UP"
+
+    // A warm-up report older than this is discarded and a fresh scan is run
+    private const val MAX_AGE_MS = 30_000L
+
+    private val started = AtomicBoolean(false)
+    private val pending = AtomicReference<FutureTask<DeviceTrustReport>?>(null)
+    private val cancel = ScanCancel()
+
+    @Volatile private var startedAtMs: Long = 0
+    @Volatile private var finishedAtMs: Long = 0
+    @Volatile private var libLoadMs: Double = 0.0
+    @Volatile private var scanMs: Double = 0.0
+    @Volatile private var served: String = "none"
+    @Volatile private var waitMs: Double = 0.0
+
+    /**
+     * Reads the opt-in flag from the host app's manifest meta-data
+     */
+    fun isEnabled(context: Context): Boolean {
+        return try {
+            val pm = context.packageManager
+            val info = if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.TIRAMISU) {
+                pm.getApplicationInfo(
+                    context.packageName,
+                    PackageManager.ApplicationInfoFlags.of(PackageManager.GET_META_DATA.toLong())
+                )
+            } else {
+                @Suppress("DEPRECATION")
+                pm.getApplicationInfo(context.packageName, PackageManager.GET_META_DATA)
+            }
+            info.metaData?.getBoolean(META_DATA_KEY, false) == true
+        } catch (e: Exception) {
+            false
+        }
+    }
+
+    /**
+     * Starts the warm-up scan on a low-priority background thread (once per process)
+     */
+    fun start(context: Context) {
+        if (!started.compareAndSet(false, true)) return
+
+        val appContext = context.applicationContext
+        val task = FutureTask {
+            Process.setThreadPriority(Process.THREAD_PRIORITY_BACKGROUND)
+
+            // Touching DeviceTrustNative triggers System.loadLibrary
+            DeviceTrustNative.isLoaded()
+            libLoadMs = DeviceTrustNative.libraryLoadTimeMs
+
+            val scanStart = System.nanoTime()
+            try {
+                DeviceTrust.buildReport(appContext, cancel = cancel)
+            } finally {
+                scanMs = (System.nanoTime() - scanStart) / 1_000_000.0
+                finishedAtMs = System.currentTimeMillis()
+            }
+        }
+        pending.set(task)
+        startedAtMs = System.currentTimeMillis()
+
+        Thread(task, "DeviceTrust-WarmUp").apply {
+            isDaemon = true
+            start()
+        }
+    }
+
+    /**
+     * Outcome of the one claim: the warm-up [report] (null if the caller has
+     * to scan itself) and the timing [stats] for that caller's details
+     */
+    class Claim(val report: DeviceTrustReport?, val stats: Map<String, Any?>)
+
+    /**
+     * Claims the warm-up scan for the first caller; null when warm-up is
+     * disabled or already claimed.
+     *
+     * Blocks up to [timeoutMs] if the scan is still in flight; on timeout the
+     * scan is cancelled. The claim carries no report when the scan timed
+     * out, failed, or is too old.
+     */
+    fun claim(timeoutMs: Long): Claim? {
+        val task = pending.getAndSet(null) ?: return null
+        val inFlight = !task.isDone
+        val waitStart = System.nanoTime()
+
+        val report = try {
+            task.get(timeoutMs, TimeUnit.MILLISECONDS)
+        } catch (e: TimeoutException) {
+            // Caller falls back to a fresh scan; stop this one so they do not overlap
+            cancel.cancel()
+            served = "cancelled"
+            null
+        } catch (e: Exception) {
+            served = "failed"
+            null
+        }
+        waitMs = (System.nanoTime() - waitStart) / 1_000_000.0
+        if (report == null) {
+            return Claim(null, stats())
+        }
+
+        if (!inFlight && System.currentTimeMillis() - finishedAtMs > MAX_AGE_MS) {
+            served = "expired"
+            return Claim(null, stats())
+        }
+
+        served = if (inFlight) "inflight" else "precomputed"
+        return Claim(report, stats())
+    }
+
+    // Warm-up timing snapshot
+    private fun stats(): Map<String, Any?> {
+        return mapOf(
+            "startedAtMs" to startedAtMs,
+            "libLoadMs" to libLoadMs,
+            "scanMs" to scanMs,
+            "served" to served,
+            "waitMs" to waitMs
+        )
+    }
+}
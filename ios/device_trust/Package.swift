@@ -31,5 +31,6 @@ let package = Package(
                 .headerSearchPath("include/device_trust_native")
             ]
         )
-    ]
+    ],
+    cxxLanguageStandard: .gnucxx17
 )
@@ -33,6 +33,45 @@ struct DeviceTrustReport {
     }
 }
 
+// MARK: - ScanLevel
+
+/// Scan tier with its latency budget (same values as Android)
+enum ScanLevel: String {
+    case fast
+    case standard
+    case deep
+
+    var nativeValue: Int32 {
+        switch self {
+        case .fast: return 0
+        case .standard: return 1
+        case .deep: return 2
+        }
+    }
+
+    var budgetMs: Int64 {
+        switch self {
+        case .fast: return 1
+        case .standard: return 500
+        case .deep: return 1200
+        }
+    }
+}
+
+// MARK: - SignalGroup
+
+/// Signal groups requested by the caller (bit values shared with Dart/Android)
+struct SignalGroup: OptionSet {
+    let rawValue: Int
+
+    static let root = SignalGroup(rawValue: 1)
+    static let emulator = SignalGroup(rawValue: 2)
+    static let developer = SignalGroup(rawValue: 4)
+    static let hook = SignalGroup(rawValue: 8)
+    static let debugger = SignalGroup(rawValue: 16)
+    static let all: SignalGroup = [.root, .emulator, .developer, .hook, .debugger]
+}
+
 // MARK: - DeviceTrust
 
 class DeviceTrust {
@@ -43,46 +82,72 @@ class DeviceTrust {
     }
     #endif
     
-    // Known jailbreak paths and files
-    private static let jailbreakPaths = [
-        "/Applications/Cydia.app",
-        "/Applications/Sileo.app",
-        "/Applications/Zebra.app",
-        "/Library/MobileSubstrate/MobileSubstrate.dylib",
-        "/Library/MobileSubstrate/DynamicLibraries",
-        "/usr/sbin/sshd",
-        "/usr/bin/sshd",
-        "/usr/libexec/sftp-server",
-        "/etc/apt",
-        "/etc/apt/sources.list.d",
-        "/private/var/lib/apt",
-        "/private/var/lib/cydia",
-        "/private/var/mobile/Library/SBSettings/Themes",
-        "/private/var/tmp/cydia.log",
-        "/var/jb",
-        "/var/lib/cydia",
-        "/bin/bash",
-        "/bin/sh",
-        "/usr/bin/ssh",
-        "/.installed_unc0ver",
-        "/.bootstrapped_electra",
-        "/usr/share/jailbreak/injectme.plist" // Jailbreak marker file
-    ]
+    // Known jailbreak paths and files; generated from src/signatures/signatures.txt
+    private static let jailbreakPaths = DeviceTrustSignatures.jailbreakPaths
     
     // URL Schemes (must be declared in Info.plist)
-    private static let jailbreakSchemes = [ // Jailbreak tool URL schemes
-        "cydia://",
-        "sileo://",
-        "zbra://",
-        "filza://",
-        "undecimus://",
-        "activator://"
-    ]
+    private static let jailbreakSchemes = DeviceTrustSignatures.jailbreakSchemes
+    
+    // MARK: - Static tier cache
+    
+    /// Jailbreak file/sandbox/URL scheme results; reused by FAST scans
+    private struct StaticTier {
+        let jbPathHits: [String]
+        let jbWriteTest: Bool
+        let urlSchemeHits: [String]
+    }
+    
+    private static let staticTierLock = NSLock()
+    private static var cachedStaticTier: StaticTier?
+
+    // MARK: - Signature packs
+
+    /// Lists in use: the built-in ones above until a signature pack replaces them
+    private static var activeJailbreakPaths = jailbreakPaths
+    private static var activeJailbreakSchemes = jailbreakSchemes
+
+    /// Installs a signature pack (see src/core/signature_pack.h)
+    ///
+    /// The native dyld scan picks the pack up on its own; the file and URL
+    /// scheme checks switch to its jailbreak sections, and the cached static
+    /// tier is dropped so FAST scans stop serving results from the old lists.
+    ///
+    /// - Returns: installed version, or a negative status
+    static func loadSignaturePack(path: String) -> Int {
+        let version = Int(DTNLoadSignaturePack(path))
+        if version > 0 {
+            let paths = DTNSignatureList(.jailbreakPaths) ?? jailbreakPaths
+            let schemes = DTNSignatureList(.jailbreakSchemes) ?? jailbreakSchemes
+            staticTierLock.lock()
+            activeJailbreakPaths = paths
+            activeJailbreakSchemes = schemes
+            cachedStaticTier = nil
+            staticTierLock.unlock()
+        }
+        return version
+    }
+
+    private static func signatureLists() -> (paths: [String], schemes: [String]) {
+        staticTierLock.lock()
+        defer { staticTierLock.unlock() }
+        return (activeJailbreakPaths, activeJailbreakSchemes)
+    }
     
     // MARK: - buildReport (Main function)
     
-    static func buildReport() -> DeviceTrustReport {
+    static func buildReport(
+        level: ScanLevel = .standard,
+        signals: SignalGroup = .all,
+        verdictsOnly: Bool = false
+    ) -> DeviceTrustReport {
         var details: [String: Any] = [:]
+        var decided: [String] = [] // checks skipped once the verdict was settled
+        let startNs = DispatchTime.now().uptimeNanoseconds
+        let budgetNs = UInt64(level.budgetMs) * 1_000_000
+        details["scanLevel"] = level.rawValue
+        details["budgetMs"] = level.budgetMs
+        details["signalMask"] = signals.rawValue
+        details["verdictsOnly"] = verdictsOnly
         
         // 1. Simulator detection
         let isEmulator: Bool
@@ -93,17 +158,54 @@ class DeviceTrust {
         #endif
         details["simulator"] = isEmulator
         
-        // 2. Jailbreak detection
-        let jbPathHits = checkJailbreakPaths() // Check for jailbreak files
-        let jbWriteTest = checkSandboxEscape() // Test sandbox restrictions
-        let urlSchemeHits = checkURLSchemes() // Check for jailbreak URL schemes
+        // 2. Jailbreak detection (FAST: last cached result)
+        let staticTier: StaticTier
+        if !signals.contains(.root) {
+            staticTier = StaticTier(jbPathHits: [], jbWriteTest: false, urlSchemeHits: [])
+        } else if level == .fast {
+            staticTierLock.lock()
+            let cached = cachedStaticTier
+            staticTierLock.unlock()
+            details["staticTier"] = cached == nil ? "cold" : "cached"
+            staticTier = cached ?? StaticTier(jbPathHits: [], jbWriteTest: false, urlSchemeHits: [])
+        } else if verdictsOnly {
+            // Simulator verdicts ignore jailbreak signals; otherwise stop at the first hit
+            // (cheapest first: file stats, URL schemes, sandbox write)
+            let pathHits = isEmulator ? [] : checkJailbreakPaths()
+            let urlHits = isEmulator || !pathHits.isEmpty ? [] : checkURLSchemes()
+            let writeTest = isEmulator || !pathHits.isEmpty || !urlHits.isEmpty ? false : checkSandboxEscape()
+            if isEmulator { decided.append("jbPathHits") }
+            if isEmulator || !pathHits.isEmpty { decided.append("urlSchemeHits") }
+            if isEmulator || !pathHits.isEmpty || !urlHits.isEmpty { decided.append("jbWriteTest") }
+            staticTier = StaticTier(jbPathHits: pathHits, jbWriteTest: writeTest, urlSchemeHits: urlHits)
+            details["staticTier"] = "fresh"
+        } else {
+            staticTier = StaticTier(
+                jbPathHits: checkJailbreakPaths(), // Check for jailbreak files
+                jbWriteTest: checkSandboxEscape(), // Test sandbox restrictions
+                urlSchemeHits: checkURLSchemes() // Check for jailbreak URL schemes
+            )
+            staticTierLock.lock()
+            cachedStaticTier = staticTier
+            staticTierLock.unlock()
+            details["staticTier"] = "fresh"
+        }
+        let jbPathHits = staticTier.jbPathHits
+        let jbWriteTest = staticTier.jbWriteTest
+        let urlSchemeHits = staticTier.urlSchemeHits
         
         details["jbPathHits"] = jbPathHits
         details["jbWriteTest"] = jbWriteTest
         details["urlSchemeHits"] = urlSchemeHits
         
-        // 3. Native signals (Hook/Frida)
-        let nativeSignals = collectNativeSignals()
+        // 3. Native signals (Hook/Frida) with the remaining budget
+        let elapsedNs = DispatchTime.now().uptimeNanoseconds - startNs
+        let remainingNs = budgetNs > elapsedNs ? budgetNs - elapsedNs : 0
+        let skipNative = verdictsOnly && isEmulator // simulator verdict ignores hook signals
+        if skipNative && signals.contains(.hook) { decided.append("nativeSignals") }
+        let nativeSignals = signals.contains(.hook) && !skipNative
+            ? collectNativeSignals(level: level, budgetNs: Int64(remainingNs))
+            : NativeSignals.empty
         
         // Append native details to details map
         details["nativeDyldSuspicious"] = nativeSignals.dyldSuspicious
@@ -113,9 +215,15 @@ class DeviceTrust {
         details["nativeLibcGetpidUnexpected"] = nativeSignals.libcGetpidUnexpected
         details["nativeLibcGetpidImage"] = nativeSignals.libcGetpidImage
         details["nativeTimeMs"] = nativeSignals.nativeTimeMs
+        details["nativeScanTimeMs"] = nativeSignals.nativeTimeMs
+        details["nativeStages"] = nativeSignals.stages
+        details["budgetExceeded"] = nativeSignals.budgetExceeded
+        for key in decided {
+            details[key] = "skipped:decided"
+        }
         
         // 4. Debugger detection
-        let debuggerAttached = isDebuggerAttached()
+        let debuggerAttached = signals.contains(.debugger) && isDebuggerAttached()
         details["debuggerViaSysctl"] = debuggerAttached
         
         // 5. Frida/Hook decision (raw calculation)
@@ -136,6 +244,7 @@ class DeviceTrust {
         // --- Simulator cleanups ---
         let rootedFinal = isEmulator ? false : rootedRaw
         let fridaFinal  = isEmulator ? false : fridaRaw
+        let emulatorFinal = signals.contains(.emulator) && isEmulator
         details["simAdjusted"] = isEmulator
         if isEmulator {
             details["simIgnored"] = ["rooted": rootedRaw, "frida": fridaRaw]
@@ -158,7 +267,7 @@ class DeviceTrust {
         
         return DeviceTrustReport(
             rootedOrJailbroken: rootedFinal,
-            emulator: isEmulator,
+            emulator: emulatorFinal,
             devModeEnabled: devModeEnabled,
             adbEnabled: adbEnabled,
             fridaSuspected: fridaFinal,
@@ -174,7 +283,7 @@ class DeviceTrust {
         var hits: [String] = []
         let fileManager = FileManager.default
         
-        for path in jailbreakPaths { // Iterate known jailbreak file paths
+        for path in signatureLists().paths { // Iterate known jailbreak file paths
             // Check both file existence and symbolic links
             if fileManager.fileExists(atPath: path) {
                 hits.append(path)
@@ -220,7 +329,7 @@ class DeviceTrust {
             }
         }()
         
-        for scheme in jailbreakSchemes { // Check if jailbreak URL schemes are available
+        for scheme in signatureLists().schemes { // Check if jailbreak URL schemes are available
             if let url = URL(string: scheme), app.canOpenURL(url) {
                 hits.append(scheme)
             }
@@ -238,26 +347,33 @@ class DeviceTrust {
         let envDYLD: String
         let libcGetpidImage: String
         let libcGetpidUnexpected: Bool
-        let nativeTimeMs: Int // ms
+        let nativeTimeMs: Double // ms, ns resolution
+        let stages: [String: Any] // stage id -> {ns, items}
+        let budgetExceeded: Bool
+
+        // Safe defaults (parse error or hook group not requested)
+        static let empty = NativeSignals(
+            rwxSegments: 0,
+            hasRwx: false,
+            dyldSuspicious: [],
+            envDYLD: "",
+            libcGetpidImage: "",
+            libcGetpidUnexpected: false,
+            nativeTimeMs: 0, // ms
+            stages: [:],
+            budgetExceeded: false
+        )
     }
     
     /// Collect and parse signals from native C++ layer
-    private static func collectNativeSignals() -> NativeSignals {
-        // DTNCollectNativeSignalsJSON is bridged as non-optional String (see _Nonnull in header)
-        let jsonString = DTNCollectNativeSignalsJSON()
+    private static func collectNativeSignals(level: ScanLevel, budgetNs: Int64) -> NativeSignals {
+        // DTNCollectNativeSignalsJSONForLevel is bridged as non-optional String (see _Nonnull in header)
+        let jsonString = DTNCollectNativeSignalsJSONForLevel(level.nativeValue, budgetNs)
 
         guard let jsonData = jsonString.data(using: .utf8),
               let json = (try? JSONSerialization.jsonObject(with: jsonData)) as? [String: Any] else {
             // Parse error → safe defaults
-            return NativeSignals(
-                rwxSegments: 0,
-                hasRwx: false,
-                dyldSuspicious: [],
-                envDYLD: "",
-                libcGetpidImage: "",
-                libcGetpidUnexpected: false,
-                nativeTimeMs: 0 // ms
-            )
+            return NativeSignals.empty
         }
 
         return NativeSignals(
@@ -267,7 +383,9 @@ class DeviceTrust {
             envDYLD: json["envDYLD"] as? String ?? "",
             libcGetpidImage: json["libcGetpidImage"] as? String ?? "",
             libcGetpidUnexpected: json["libcGetpidUnexpected"] as? Bool ?? false,
-            nativeTimeMs: json["nativeTimeMs"] as? Int ?? 0
+            nativeTimeMs: (json["nativeTimeMs"] as? NSNumber)?.doubleValue ?? 0,
+            stages: json["stages"] as? [String: Any] ?? [:],
+            budgetExceeded: json["budgetExceeded"] as? Bool ?? false
         )
     }
     
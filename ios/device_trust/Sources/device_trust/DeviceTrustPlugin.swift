@@ -6,16 +6,71 @@ public class DeviceTrustPlugin: NSObject, FlutterPlugin {
     let channel = FlutterMethodChannel(name: "device_trust", binaryMessenger: registrar.messenger())
     let instance = DeviceTrustPlugin()
     registrar.addMethodCallDelegate(instance, channel: channel)
+
+    let watchChannel = FlutterEventChannel(name: "device_trust/watch", binaryMessenger: registrar.messenger())
+    watchChannel.setStreamHandler(WatchStreamHandler())
+
+    let reportChannel = FlutterEventChannel(name: "device_trust/report", binaryMessenger: registrar.messenger())
+    reportChannel.setStreamHandler(ReportStreamHandler())
   }
 
   public func handle(_ call: FlutterMethodCall, result: @escaping FlutterResult) {
     switch call.method {
     case "getDeviceTrustReport":
       // Call DeviceTrust.buildReport() defined in DeviceTrust.swift
-      let report = DeviceTrust.buildReport()
+      let args = call.arguments as? [String: Any]
+      let level = ScanLevel(rawValue: args?["level"] as? String ?? "") ?? .standard
+      let signals = SignalGroup(rawValue: args?["signalMask"] as? Int ?? SignalGroup.all.rawValue)
+      let verdictsOnly = args?["verdictsOnly"] as? Bool ?? false
+      let report = DeviceTrust.buildReport(level: level, signals: signals, verdictsOnly: verdictsOnly)
       result(report.toMap())
+    case "loadSignaturePack":
+      guard let path = (call.arguments as? [String: Any])?["path"] as? String else {
+        result(FlutterError(code: "SIGNATURE_PACK_INVALID", message: "path is required", details: nil))
+        return
+      }
+      let version = DeviceTrust.loadSignaturePack(path: path)
+      if version > 0 {
+        result(version)
+      } else {
+        result(FlutterError(code: "SIGNATURE_PACK_INVALID", message: "signature pack rejected", details: version))
+      }
     default:
       result(FlutterMethodNotImplemented)
     }
   }
-}
\ No newline at end of file
+}
+
+/// DeviceTrust.getReportStream(): iOS runs the scan in one piece and emits only the summary event.
+private class ReportStreamHandler: NSObject, FlutterStreamHandler {
+  func onListen(withArguments arguments: Any?, eventSink events: @escaping FlutterEventSink) -> FlutterError? {
+    let args = arguments as? [String: Any]
+    let level = ScanLevel(rawValue: args?["level"] as? String ?? "") ?? .standard
+    let signals = SignalGroup(rawValue: args?["signalMask"] as? Int ?? SignalGroup.all.rawValue)
+    let verdictsOnly = args?["verdictsOnly"] as? Bool ?? false
+
+    DispatchQueue.global(qos: .userInitiated).async {
+      let report = DeviceTrust.buildReport(level: level, signals: signals, verdictsOnly: verdictsOnly)
+      DispatchQueue.main.async {
+        events(["type": "summary", "seq": 1, "report": report.toMap()])
+        events(FlutterEndOfEventStream)
+      }
+    }
+    return nil
+  }
+
+  func onCancel(withArguments arguments: Any?) -> FlutterError? {
+    return nil
+  }
+}
+
+/// DeviceTrust.watch() is Android-only for now; the stream fails with UNSUPPORTED.
+private class WatchStreamHandler: NSObject, FlutterStreamHandler {
+  func onListen(withArguments arguments: Any?, eventSink events: @escaping FlutterEventSink) -> FlutterError? {
+    return FlutterError(code: "UNSUPPORTED", message: "device_trust: watch() is not supported on iOS", details: nil)
+  }
+
+  func onCancel(withArguments arguments: Any?) -> FlutterError? {
+    return nil
+  }
+}
@@ -0,0 +1,44 @@
+// [DeviceTrust/iOS] Built-in signature lists
+// Generated by device_trust_signature_gen from src/signatures/signatures.txt;
+// do not edit. Regenerate with
+//   cmake --build <build dir> --target device_trust_signatures
+
+/// Defaults of the Swift checks; a loaded signature pack replaces them
+/// section by section (see DeviceTrust.loadSignaturePack)
+enum DeviceTrustSignatures {
+    static let version = 1
+
+    static let jailbreakPaths: [String] = [
+        "/Applications/Cydia.app",
+        "/Applications/Sileo.app",
+        "/Applications/Zebra.app",
+        "/Library/MobileSubstrate/MobileSubstrate.dylib",
+        "/Library/MobileSubstrate/DynamicLibraries",
+        "/usr/sbin/sshd",
+        "/usr/bin/sshd",
+        "/usr/libexec/sftp-server",
+        "/etc/apt",
+        "/etc/apt/sources.list.d",
+        "/private/var/lib/apt",
+        "/private/var/lib/cydia",
+        "/private/var/mobile/Library/SBSettings/Themes",
+        "/private/var/tmp/cydia.log",
+        "/var/jb",
+        "/var/lib/cydia",
+        "/bin/bash",
+        "/bin/sh",
+        "/usr/bin/ssh",
+        "/.installed_unc0ver",
+        "/.bootstrapped_electra",
+        "/usr/share/jailbreak/injectme.plist"
+    ]
+
+    static let jailbreakSchemes: [String] = [
+        "cydia://",
+        "sileo://",
+        "zbra://",
+        "filza://",
+        "undecimus://",
+        "activator://"
+    ]
+}
@@ -0,0 +1,19 @@
+// [DeviceTrust/iOS][Native] DeviceTrustCore.cpp
+// Compiles the shared detection core (src/ at the plugin root) into this
+// target. SPM and CocoaPods only build sources inside the target directory,
+// so the core is pulled in by relative include, as Flutter FFI plugins do.
+
+#include "../../../../src/core/arena.cpp"
+#include "../../../../src/core/check_breaker.cpp"
+#include "../../../../src/core/json.cpp"
+#include "../../../../src/core/keyword_automaton.cpp"
+#include "../../../../src/core/keywords.cpp"
+#include "../../../../src/core/obfuscated_string.cpp"
+#include "../../../../src/core/pattern_search.cpp"
+#include "../../../../src/core/perf_counters.cpp"
+#include "../../../../src/core/scanners.cpp"
+#include "../../../../src/core/signature_pack.cpp"
+#include "../../../../src/core/telemetry.cpp"
+#include "../../../../src/core/trace.cpp"
+#include "../../../../src/core/work_pool.cpp"
+#include "../../../../src/platform/mach_backend.cpp"
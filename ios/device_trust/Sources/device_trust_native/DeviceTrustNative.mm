@@ -1,5 +1,5 @@
 // [DeviceTrust/iOS][Native] DeviceTrustNative.mm
-// Objective-C++ implementation — Mach VM, dyld, dladdr checks
+// Objective-C++ shim over the shared detection core — Mach VM, dyld, dladdr checks
 
 #if __has_include(<device_trust/device_trust-umbrella.h>)
 #import <device_trust/DeviceTrustNative.h>
@@ -7,10 +7,7 @@
 #import "./include/device_trust_native/DeviceTrustNative.h"
 #endif
 #import <TargetConditionals.h>
-#import <mach/mach.h>
-#import <mach-o/dyld.h>
-#import <dlfcn.h>
-#import <sys/time.h>
+#include <time.h>
 #if !TARGET_IPHONE_SIMULATOR
   #if __has_include(<sys/ptrace.h>)
     #include <sys/ptrace.h>
@@ -24,176 +21,170 @@
     #endif
   #endif
 #endif
-#include <ctype.h>
-#include <string.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+
+// Shared detection core (src/ at the plugin root; compiled via DeviceTrustCore.cpp)
+#include "../../../../src/core/json.h"
+#include "../../../../src/core/keywords.h"
+#include "../../../../src/core/scanners.h"
+#include "../../../../src/core/signature_pack.h"
+#include "../../../../src/core/stage_timing.h"
+#include "../../../../src/platform/mach_backend.h"
+
+using namespace device_trust;
+
+// Infinite-loop guard for the vm_region walk
+static const int MAX_VM_REGIONS = 1000;
+
+// 4+ RWX segments are suspicious; stop counting there
+static const int RWX_EARLY_EXIT = 4;
 
-// Suspicious library names (for lowercase comparison)
-static const char* suspiciousNames[] = {
-    "frida",
-    "fridagadget",
-    "substrate",
-    "substitute",
-    "tweakinject",
-    "cynject",
-    "libhooker",
-    "xcon",
-    "sslkillswitch",
-    NULL
+static const size_t MAX_DYLD_SUSPICIOUS = 8;
+
+/**
+ * Timed stages, in run order; work counters are regions (rwx), images
+ * (dyld), resolved symbols (libc) and none (env)
+ */
+enum TimedStage {
+    TIMED_RWX = 0,
+    TIMED_DYLD,
+    TIMED_LIBC,
+    TIMED_ENV,
+    TIMED_STAGE_COUNT
 };
 
-// Fast lowercase substring search
-static bool containsSuspicious(const char* path) {
-    if (!path) return false;
-    
-    // Convert path to lowercase (stack buffer)
-    char lowerPath[1024];
-    size_t len = strlen(path);
-    if (len >= sizeof(lowerPath)) len = sizeof(lowerPath) - 1;
-    
-    for (size_t i = 0; i < len; i++) {
-        lowerPath[i] = tolower((unsigned char)path[i]);
-    }
-    lowerPath[len] = '\0';
-    
-    // Search for suspicious names
-    for (int i = 0; suspiciousNames[i] != NULL; i++) {
-        if (strstr(lowerPath, suspiciousNames[i]) != NULL) {
-            return true;
-        }
-    }
-    return false;
-}
+static const char* const TIMED_STAGE_IDS[TIMED_STAGE_COUNT] = {
+    "nativeRwx", "nativeDyld", "nativeLibc", "nativeEnv",
+};
 
-// JSON escape helper (simple)
-static NSString* escapeJSON(const char* str) {
-    if (!str) return @"";
-    NSString* ns = [NSString stringWithUTF8String:str];
-    if (!ns) return @"";
-    
-    // Simple escape: ", \, newline
-    ns = [ns stringByReplacingOccurrencesOfString:@"\\" withString:@"\\\\"];
-    ns = [ns stringByReplacingOccurrencesOfString:@"\"" withString:@"\\\""];
-    ns = [ns stringByReplacingOccurrencesOfString:@"\n" withString:@"\\n"];
-    ns = [ns stringByReplacingOccurrencesOfString:@"\r" withString:@"\\r"];
-    return ns;
+NSString* DTNCollectNativeSignalsJSON(void) {
+    return DTNCollectNativeSignalsJSONForLevel(1, INT64_MAX);
 }
 
-NSString* DTNCollectNativeSignalsJSON(void) {
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
-    
-    int rwxSegments = 0;
-    bool hasRwx = false;
-    NSMutableArray* dyldSuspicious = [NSMutableArray array];
-    NSString* envDYLD = @"";
-    NSString* libcGetpidImage = @"";
-    bool libcGetpidUnexpected = false;
-    
-    // 1. Mach VM - RWX segment scan
-    @try {
-        mach_port_t task = mach_task_self();
-        vm_address_t address = 0;
-        vm_size_t size = 0;
-        
-        for (int limit = 0; limit < 1000; limit++) { // Infinite-loop guard
-            vm_region_basic_info_data_64_t info;
-            mach_msg_type_number_t count = VM_REGION_BASIC_INFO_COUNT_64;
-            mach_port_t objectName = MACH_PORT_NULL;
-            
-            kern_return_t kr = vm_region_64(task, &address, &size, VM_REGION_BASIC_INFO_64,
-                                           (vm_region_info_t)&info, &count, &objectName);
-            
-            if (kr != KERN_SUCCESS) break;
-            
-            // Check WRITE and EXECUTE bits
-            if ((info.protection & VM_PROT_WRITE) && (info.protection & VM_PROT_EXECUTE)) {
-                rwxSegments++;
-                hasRwx = true;
-                if (rwxSegments >= 4) break; // Early exit (4+ RWX segments suspicious)
-            }
-            
-            address += size;
+NSString* DTNCollectNativeSignalsJSONForLevel(int level, int64_t budgetNs) {
+    long long startNs = monotonicNs();
+    StageTiming stages[TIMED_STAGE_COUNT];
+
+    MachBackend backend;
+    Deadline deadline(budgetNs);
+    ScanArena arena;  // owns the result strings until the JSON is built
+    std::shared_ptr<const SignaturePack> signatures = activeSignaturePack();
+
+    RwxCount rwx;
+    ImageAnalysis dyld;
+    SymbolImageCheck libcGetpid;
+    std::string envDYLD;
+
+    // FAST tier stops after the RWX count
+    bool runStandard = level >= 1;
+
+    try {
+        // 1. Mach VM - RWX segment scan
+        StageTimer rwxTimer(stages[TIMED_RWX]);
+        rwx = countRwxRegions(backend, deadline, RWX_EARLY_EXIT, MAX_VM_REGIONS);
+        rwxTimer.stop(rwx.visited);
+
+        // 2. DYLD image list - scan for suspicious libraries
+        if (runStandard && !deadline.expired()) {
+            StageTimer timer(stages[TIMED_DYLD]);
+            dyld = analyzeImages(backend, deadline, arena, signatures->keywords(SIGNATURE_IMAGE_KEYWORDS),
+                                 MAX_DYLD_SUSPICIOUS);
+            timer.stop(dyld.visited);
         }
-    } @catch (NSException* e) {
-        // Silent fail-soft
-    }
-    
-    // 2. DYLD image list - scan for suspicious libraries
-    @try {
-        uint32_t imageCount = _dyld_image_count();
-        int foundCount = 0;
-        
-        for (uint32_t i = 0; i < imageCount && foundCount < 8; i++) {
-            const char* imageName = _dyld_get_image_name(i);
-            if (imageName && containsSuspicious(imageName)) {
-                [dyldSuspicious addObject:escapeJSON(imageName)];
-                foundCount++;
-            }
+
+        // 3. getpid symbol check via dladdr
+        if (runStandard && !deadline.expired()) {
+            StageTimer timer(stages[TIMED_LIBC]);
+            libcGetpid = checkSymbolImage(backend, arena, (void*)getpid, LIBC_IMAGE_FRAGMENTS_DARWIN);
+            timer.stop(!libcGetpid.imagePath.empty());
         }
-    } @catch (NSException* e) {
-        // Silent fail-soft
-    }
-    
-    // 3. getpid symbol check via dladdr
-    @try {
-        Dl_info info;
-        if (dladdr((void*)getpid, &info) != 0 && info.dli_fname) {
-            libcGetpidImage = escapeJSON(info.dli_fname);
-            
-            // Expected paths: /usr/lib/libSystem*, /usr/lib/system/*
-            const char* fname = info.dli_fname;
-            if (!(strstr(fname, "/usr/lib/libsystem") || 
-                  strstr(fname, "/usr/lib/system/") ||
-                  strstr(fname, "/usr/lib/libSystem"))) {
-                libcGetpidUnexpected = true;
+
+        // 4. DYLD_INSERT_LIBRARIES environment variable
+        if (runStandard) {
+            StageTimer timer(stages[TIMED_ENV]);
+            const char* dyldInsert = getenv("DYLD_INSERT_LIBRARIES");
+            if (dyldInsert && strlen(dyldInsert) > 0) {
+                envDYLD = dyldInsert;
             }
+            deadline.expired();
+            timer.stop(0);
         }
-    } @catch (NSException* e) {
+    } catch (...) {
         // Silent fail-soft
     }
-    
-    // 4. DYLD_INSERT_LIBRARIES environment variable
-    @try {
-        const char* dyldInsert = getenv("DYLD_INSERT_LIBRARIES");
-        if (dyldInsert && strlen(dyldInsert) > 0) {
-            envDYLD = escapeJSON(dyldInsert);
-        }
-    } @catch (NSException* e) {
-        // Silent fail-soft
-    }
-    
-    // Duration calculation
-    gettimeofday(&end, NULL);
-    long timeMs = (end.tv_sec - start.tv_sec) * 1000 + (end.tv_usec - start.tv_usec) / 1000;
-    
+
+    long long timeNs = monotonicNs() - startNs;
+
     // Build JSON (manual, single line)
-    NSMutableString* json = [NSMutableString stringWithString:@"{"];
-    [json appendFormat:@"\"rwxSegments\":%d,", rwxSegments];
-    [json appendFormat:@"\"hasRwx\":%@,", hasRwx ? @"true" : @"false"];
-    
-    // dyldSuspicious array
-    [json appendString:@"\"dyldSuspicious\":["];
-    for (NSUInteger i = 0; i < dyldSuspicious.count; i++) {
-        [json appendFormat:@"\"%@\"%@", dyldSuspicious[i], (i < dyldSuspicious.count - 1) ? @"," : @""];
+    std::string json = "{";
+    json += "\"scanLevel\":" + std::to_string(level) + ",";
+    json += std::string("\"budgetExceeded\":") + (deadline.hit ? "true" : "false") + ",";
+    json += "\"rwxSegments\":" + std::to_string(rwx.rwxSegments) + ",";
+    json += std::string("\"hasRwx\":") + (rwx.rwxSegments > 0 ? "true" : "false") + ",";
+    json += "\"dyldSuspicious\":" + vectorToJsonArray(dyld.suspiciousImages) + ",";
+    json += "\"envDYLD\":\"" + escapeJsonString(envDYLD) + "\",";
+    json += "\"libcGetpidImage\":\"" + escapeJsonString(libcGetpid.imagePath) + "\",";
+    json += std::string("\"libcGetpidUnexpected\":") + (libcGetpid.unexpected ? "true" : "false") + ",";
+    json += "\"nativeTimeMs\":" + std::to_string(timeNs / 1e6) + ",";
+    json += "\"nativeTimeNs\":" + std::to_string(timeNs) + ",";
+    json += "\"stages\":{";
+    bool firstStage = true;
+    for (int stage = 0; stage < TIMED_STAGE_COUNT; stage++) {
+        if (!stages[stage].ran) {
+            continue;
+        }
+        json += std::string(firstStage ? "" : ",") + "\"" + TIMED_STAGE_IDS[stage] + "\":{\"ns\":" +
+            std::to_string(stages[stage].ns) + ",\"items\":" + std::to_string(stages[stage].items) + "}";
+        firstStage = false;
     }
-    [json appendString:@"],"];
-    
-    [json appendFormat:@"\"envDYLD\":\"%@\",", envDYLD];
-    [json appendFormat:@"\"libcGetpidImage\":\"%@\",", libcGetpidImage];
-    [json appendFormat:@"\"libcGetpidUnexpected\":%@,", libcGetpidUnexpected ? @"true" : @"false"];
-    [json appendFormat:@"\"nativeTimeMs\":%ld", timeMs];
-    [json appendString:@"}"];
-    
+    json += "}";
+    json += "}";
+
     #if DEBUG
-    NSLog(@"[DeviceTrust/Native] JSON: rwx=%d dyld=%lu env=%@ pid=%@ time=%ldms",
-          rwxSegments, (unsigned long)dyldSuspicious.count,
-          envDYLD.length > 0 ? @"YES" : @"NO",
-          libcGetpidUnexpected ? @"UNEXPECTED" : @"OK",
-          timeMs);
+    NSLog(@"[DeviceTrust/Native] JSON: rwx=%d dyld=%lu env=%@ pid=%@ time=%lldns",
+          rwx.rwxSegments, (unsigned long)dyld.suspiciousImages.size(),
+          envDYLD.empty() ? @"NO" : @"YES",
+          libcGetpid.unexpected ? @"UNEXPECTED" : @"OK",
+          timeNs);
     #endif
-    
-    return json;
+
+    return [NSString stringWithUTF8String:json.c_str()] ?: @"{}";
+}
+
+/// Load and install a signature pack (see src/core/signature_pack.h)
+int DTNLoadSignaturePack(NSString* path) {
+    SignaturePackStatus status;
+    std::shared_ptr<const SignaturePack> pack = SignaturePack::open(path.fileSystemRepresentation, &status);
+    if (pack == nullptr) {
+        return status;
+    }
+    status = installSignaturePack(pack);
+    return status == SIGNATURE_PACK_OK ? (int)pack->version() : status;
+}
+
+static_assert(DTNSignatureSectionJailbreakPaths == SIGNATURE_JAILBREAK_PATHS, "bridge section numbering");
+static_assert(DTNSignatureSectionJailbreakSchemes == SIGNATURE_JAILBREAK_SCHEMES, "bridge section numbering");
+
+NSArray<NSString*>* DTNSignatureList(DTNSignatureSection section) {
+    if (section <= 0 || section >= SIGNATURE_SECTION_LIMIT) {
+        return nil;
+    }
+    std::shared_ptr<const SignaturePack> pack = activeSignaturePack();
+    const char* const* list = pack->list(static_cast<SignatureSection>(section));
+    if (list == nullptr) {
+        return nil;
+    }
+    NSMutableArray<NSString*>* entries = [NSMutableArray array];
+    for (size_t i = 0; list[i] != nullptr; i++) {
+        NSString* entry = [NSString stringWithUTF8String:list[i]];
+        if (entry != nil) {
+            [entries addObject:entry];
+        }
+    }
+    return entries;
 }
 
 /// Deny debugger attach (Release + real device; called from Swift)
@@ -6,5 +6,25 @@
 // Collect native security signals – returns a JSON string
 FOUNDATION_EXPORT NSString * _Nonnull DTNCollectNativeSignalsJSON(void);
 
+// Tiered variant: level 0 = fast (RWX count only), 1 = standard, 2 = deep.
+// Stages stop early once budgetNs is spent ("budgetExceeded" in the JSON).
+FOUNDATION_EXPORT NSString * _Nonnull DTNCollectNativeSignalsJSONForLevel(int level, int64_t budgetNs);
+
 // Anti-debug wrapper (Release + physical devices, called by Swift)
 FOUNDATION_EXPORT void DTNDenyDebuggerAttach(void);
+
+// Signature packs: maps, validates and installs the pack at path.
+// Returns the installed version, or a negative status (-1 unreadable,
+// -2 malformed, -3 checksum mismatch, -4 over the limits, -5 not newer).
+FOUNDATION_EXPORT int DTNLoadSignaturePack(NSString * _Nonnull path);
+
+// Signature pack sections read by Swift; same values as SignatureSection in
+// src/core/signature_pack.h (checked at compile time in DeviceTrustNative.mm)
+typedef NS_ENUM(int, DTNSignatureSection) {
+    DTNSignatureSectionJailbreakPaths = 8,
+    DTNSignatureSectionJailbreakSchemes = 9,
+};
+
+// Active pack's list for a section; nil when the pack leaves it to the
+// built-in Swift list.
+FOUNDATION_EXPORT NSArray<NSString *> * _Nullable DTNSignatureList(DTNSignatureSection section);
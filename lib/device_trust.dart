@@ -1,7 +1,13 @@
 // Public Dart API for device_trust: typed model + convenience methods.
 import 'dart:async';
+import 'dart:typed_data';
+
 import 'device_trust_platform_interface.dart';
 
+export 'device_trust_ffi.dart' show FfiDeviceTrust;
+export 'device_trust_platform_interface.dart'
+    show DeviceTrustVerdict, ScanLevel, SignalGroup;
+
 /// Device trust report containing security signals from the native platform.
 ///
 /// This model aggregates heuristic detection results for compromised devices:
@@ -55,6 +61,29 @@ class DeviceTrustReport {
   /// - `nativeDyldSuspicious` (iOS): List of suspicious DYLD images
   /// - `rwxSegmentCount` (iOS/Android): Number of RWX memory segments
   /// - `nativeScanTimeMs` (both): Native scan duration in milliseconds
+  ///   (nanosecond resolution)
+  /// - `nativeStages` (both): Per native stage (e.g. `nativeMaps`, `nativeFd`,
+  ///   `nativeLibc`, `nativeRwx`) its duration `ns` and work counter `items`
+  ///   (maps lines, fd entries, regions, images or symbols visited)
+  /// - `totalTimeMs` / `timeBreakdownMs` (Android): Report duration and the
+  ///   milliseconds spent in each check that ran, native stages included
+  /// - `scanLevel` (both): Tier used for this report (`fast`/`standard`/`deep`)
+  /// - `signalMask` (both): Requested [SignalGroup] bits
+  /// - `skippedChecks` (Android) / `budgetExceeded` (both): Checks dropped to
+  ///   stay within the tier's latency budget
+  /// - `incompleteSignals` (Android): Requested groups with checks skipped
+  ///   for the budget or demoted; their hits are published to
+  ///   [DeviceTrust.currentVerdict], their negative results are not
+  /// - `verdictsOnly` (both): Whether evaluation stopped once verdicts were
+  ///   settled; checks that did not run are marked `skipped:decided`
+  /// - `demotedChecks` (Android): Checks whose circuit breaker is open after
+  ///   repeatedly exceeding their latency budget (`id`, `state`, `trips`,
+  ///   `ewmaMs`, `p99Ms`); they only run in [ScanLevel.deep] scans
+  /// - `nativeTransport` (Android): `ffi` when the native signals were
+  ///   collected through `dart:ffi` ([FfiDeviceTrust]), `jni` otherwise
+  /// - `warmUp` (Android): Warm-up timing (`libLoadMs`, `scanMs`, `served`,
+  ///   `waitMs`) on the first full `standard` report when the opt-in warm-up
+  ///   scan is enabled
   final Map<String, dynamic> details;
 
   /// Creates a [DeviceTrustReport] with the given fields.
@@ -84,6 +113,17 @@ class DeviceTrustReport {
     );
   }
 
+  /// Scan tier recorded by the platform in `details['scanLevel']`.
+  ///
+  /// `null` if the platform did not report one.
+  ScanLevel? get scanLevel {
+    final name = details['scanLevel'];
+    for (final level in ScanLevel.values) {
+      if (level.name == name) return level;
+    }
+    return null;
+  }
+
   /// Converts this report to a raw map for serialization.
   Map<String, Object?> toMap() => {
     'rootedOrJailbroken': rootedOrJailbroken,
@@ -104,6 +144,272 @@ class DeviceTrustReport {
   }
 }
 
+/// Event emitted by [DeviceTrust.getReportStream].
+///
+/// Check events arrive as each check completes, in completion order; the
+/// last event is the summary carrying the full [report].
+class DeviceTrustReportEvent {
+  /// Monotonic sequence number within one stream, starting at 1.
+  final int seq;
+
+  /// Check id (e.g. `suExists`, `nativeMaps`); `null` for the summary.
+  final String? checkId;
+
+  /// Check result as recorded in [DeviceTrustReport.details] (signal count
+  /// for native stages); `null` for the summary.
+  final Object? result;
+
+  /// Whether the check produced a positive signal.
+  final bool hit;
+
+  /// Time spent in the check.
+  final Duration elapsed;
+
+  /// Final report; non-null only for the summary event.
+  final DeviceTrustReport? report;
+
+  /// Creates a [DeviceTrustReportEvent] with the given fields.
+  const DeviceTrustReportEvent({
+    required this.seq,
+    this.checkId,
+    this.result,
+    this.hit = false,
+    this.elapsed = Duration.zero,
+    this.report,
+  });
+
+  /// Constructs a [DeviceTrustReportEvent] from a raw platform event map.
+  factory DeviceTrustReportEvent.fromMap(Map<String, Object?> map) {
+    final report = map['report'] as Map?;
+    return DeviceTrustReportEvent(
+      seq: (map['seq'] as num?)?.toInt() ?? 0,
+      checkId: map['id'] as String?,
+      result: map['result'],
+      hit: (map['hit'] as bool?) ?? false,
+      elapsed: Duration(microseconds: (map['elapsedUs'] as num?)?.toInt() ?? 0),
+      report: report == null
+          ? null
+          : DeviceTrustReport.fromMap(
+              report.map((key, value) => MapEntry(key.toString(), value)),
+            ),
+    );
+  }
+
+  /// Whether this is the final summary event.
+  bool get isSummary => report != null;
+
+  @override
+  String toString() => isSummary
+      ? 'DeviceTrustReportEvent{seq=$seq, summary=$report}'
+      : 'DeviceTrustReportEvent{seq=$seq, check=$checkId, hit=$hit, '
+            'elapsed=$elapsed}';
+}
+
+/// Event emitted by [DeviceTrust.watch].
+///
+/// The first event is a baseline with all six flags in [changed]. Later
+/// events are sent only when a cheap detector changed, the resulting full
+/// scan was run, and at least one flag differs from the previous scan.
+class DeviceTrustEvent {
+  /// Monotonic sequence number (per process).
+  final int seq;
+
+  /// `true` for the first event of a stream.
+  final bool isBaseline;
+
+  /// Detectors that triggered the scan: `libraries`, `threads`, `tracerPid`,
+  /// `rwxSegments`. Empty for the baseline.
+  final List<String> triggers;
+
+  /// Flags that changed, keyed like [DeviceTrustReport.toMap]
+  /// (e.g. `fridaSuspected`), with their new values.
+  final Map<String, bool> changed;
+
+  /// Monitor cost so far (`ticks`, `changes`, `intervalMs`, `cpuMs`,
+  /// `cpuPercent` of one core).
+  final Map<String, dynamic> monitor;
+
+  /// Creates a [DeviceTrustEvent] with the given fields.
+  const DeviceTrustEvent({
+    required this.seq,
+    required this.isBaseline,
+    required this.triggers,
+    required this.changed,
+    required this.monitor,
+  });
+
+  /// Constructs a [DeviceTrustEvent] from a raw platform event map.
+  factory DeviceTrustEvent.fromMap(Map<String, Object?> map) {
+    return DeviceTrustEvent(
+      seq: (map['seq'] as num?)?.toInt() ?? 0,
+      isBaseline: map['type'] == 'baseline',
+      triggers: List<String>.from((map['triggers'] as List?) ?? const []),
+      changed: Map<String, bool>.from((map['changed'] as Map?) ?? const {}),
+      monitor: Map<String, dynamic>.from((map['monitor'] as Map?) ?? const {}),
+    );
+  }
+
+  @override
+  String toString() =>
+      'DeviceTrustEvent{seq=$seq, baseline=$isBaseline, '
+      'triggers=$triggers, changed=$changed}';
+}
+
+/// Cumulative native telemetry since process start (Android).
+///
+/// Counters never reset, so consecutive snapshots can be diffed; [toMap]
+/// returns the compact wire form, suitable for batching into telemetry
+/// uploads as-is.
+class DeviceTrustStats {
+  /// Bytes read from procfs by the native checks.
+  final int procfsBytes;
+
+  /// Syscalls issued by the native procfs readers (open, read, readlink,
+  /// opendir, close).
+  final int syscalls;
+
+  /// Events dropped because the per-check table was full.
+  final int droppedEvents;
+
+  /// Per-check counters and latency, keyed by check id (the
+  /// [DeviceTrustReport.details] key, e.g. `nativeMaps`, `suExists`).
+  final Map<String, DeviceTrustCheckStats> checks;
+
+  final Map<String, Object?> _raw;
+
+  /// Creates a [DeviceTrustStats] with the given fields.
+  const DeviceTrustStats({
+    this.procfsBytes = 0,
+    this.syscalls = 0,
+    this.droppedEvents = 0,
+    this.checks = const {},
+  }) : _raw = const {};
+
+  DeviceTrustStats._fromRaw(
+    Map<String, Object?> raw, {
+    required this.procfsBytes,
+    required this.syscalls,
+    required this.droppedEvents,
+    required this.checks,
+  }) : _raw = raw;
+
+  /// Constructs a [DeviceTrustStats] from the decoded platform snapshot.
+  factory DeviceTrustStats.fromMap(Map<String, Object?> map) {
+    final io = (map['io'] as Map?) ?? const {};
+    final checks = (map['checks'] as Map?) ?? const {};
+    return DeviceTrustStats._fromRaw(
+      map,
+      procfsBytes: (io['procfsBytes'] as num?)?.toInt() ?? 0,
+      syscalls: (io['syscalls'] as num?)?.toInt() ?? 0,
+      droppedEvents: (map['dropped'] as num?)?.toInt() ?? 0,
+      checks: checks.map(
+        (id, value) => MapEntry(
+          id.toString(),
+          DeviceTrustCheckStats.fromMap(
+            (value as Map).cast<String, Object?>(),
+          ),
+        ),
+      ),
+    );
+  }
+
+  /// The snapshot as received from the platform (compact JSON form).
+  Map<String, Object?> toMap() => _raw;
+
+  @override
+  String toString() =>
+      'DeviceTrustStats{procfsBytes=$procfsBytes, syscalls=$syscalls, '
+      'checks=${checks.keys.toList()}}';
+}
+
+/// Counters and latency histogram of one check in [DeviceTrustStats].
+///
+/// The histogram is log-linear: 1 ns buckets below 16 ns, then 8 buckets per
+/// power of two (at most 12.5% wide), so histograms of many devices can be
+/// merged bucket by bucket.
+class DeviceTrustCheckStats {
+  /// Completed runs; only these feed the latency histogram.
+  final int calls;
+
+  /// Results served from a cache instead of running (FAST static tier,
+  /// warm-up scan).
+  final int cacheHits;
+
+  /// Runs over their budget, or not run because the scan budget was spent.
+  final int timeouts;
+
+  /// Runs skipped once the verdict was settled, or cancelled streams.
+  final int cancellations;
+
+  /// Total time of all [calls], in ns.
+  final int sumNs;
+
+  /// Slowest call, in ns.
+  final int maxNs;
+
+  /// Median latency in ns (upper bound of its histogram bucket).
+  final int p50Ns;
+
+  /// 90th percentile latency in ns (bucket upper bound).
+  final int p90Ns;
+
+  /// 99th percentile latency in ns (bucket upper bound).
+  final int p99Ns;
+
+  /// Non-empty histogram buckets: bucket index to count.
+  final Map<int, int> buckets;
+
+  /// Creates a [DeviceTrustCheckStats] with the given fields.
+  const DeviceTrustCheckStats({
+    this.calls = 0,
+    this.cacheHits = 0,
+    this.timeouts = 0,
+    this.cancellations = 0,
+    this.sumNs = 0,
+    this.maxNs = 0,
+    this.p50Ns = 0,
+    this.p90Ns = 0,
+    this.p99Ns = 0,
+    this.buckets = const {},
+  });
+
+  /// Constructs a [DeviceTrustCheckStats] from one entry of the snapshot's
+  /// `checks` map.
+  factory DeviceTrustCheckStats.fromMap(Map<String, Object?> map) {
+    int read(String key) => (map[key] as num?)?.toInt() ?? 0;
+    final buckets = <int, int>{};
+    for (final pair in (map['buckets'] as List?) ?? const []) {
+      final entry = pair as List;
+      buckets[(entry[0] as num).toInt()] = (entry[1] as num).toInt();
+    }
+    return DeviceTrustCheckStats(
+      calls: read('calls'),
+      cacheHits: read('cacheHits'),
+      timeouts: read('timeouts'),
+      cancellations: read('cancellations'),
+      sumNs: read('sumNs'),
+      maxNs: read('maxNs'),
+      p50Ns: read('p50Ns'),
+      p90Ns: read('p90Ns'),
+      p99Ns: read('p99Ns'),
+      buckets: buckets,
+    );
+  }
+
+  /// Lower bound (ns) of histogram bucket [index].
+  static int bucketLowerNs(int index) {
+    if (index < 16) return index;
+    final shift = (index - 16) ~/ 8 + 1;
+    return ((index - 16) % 8 + 8) << shift;
+  }
+
+  @override
+  String toString() =>
+      'DeviceTrustCheckStats{calls=$calls, cacheHits=$cacheHits, '
+      'timeouts=$timeouts, cancellations=$cancellations, p50Ns=$p50Ns, '
+      'p99Ns=$p99Ns}';
+}
+
 /// High-level API for collecting device trust signals.
 ///
 /// This class provides static methods to fetch security-related signals
@@ -125,23 +431,190 @@ class DeviceTrust {
   /// The [timeout] parameter sets the maximum wait time (default: 1.5s).
   /// Throws [TimeoutException] if the native call exceeds this duration.
   ///
+  /// The [level] selects the scan tier (default: [ScanLevel.standard]).
+  /// Use [ScanLevel.fast] before sensitive calls and [ScanLevel.deep] at
+  /// login; the tier used is available as [DeviceTrustReport.scanLevel].
+  ///
+  /// The [signals] set limits the scan to the requested [SignalGroup]s
+  /// (default: all). Checks of other groups are never executed and their
+  /// flags are `false`, so latency matches the requested subset.
+  ///
+  /// With [verdictsOnly], each group stops as soon as its flag is settled
+  /// (cheapest and most likely positive checks first); the flags are the
+  /// same, but [DeviceTrustReport.details] only covers the checks that ran.
+  ///
   /// Example:
   /// ```dart
   /// final report = await DeviceTrust.getReport();
   /// print('Rooted: ${report.rootedOrJailbroken}');
+  ///
+  /// final quick = await DeviceTrust.getReport(level: ScanLevel.fast);
+  ///
+  /// final payment = await DeviceTrust.getReport(
+  ///   signals: {SignalGroup.hook, SignalGroup.debugger},
+  /// );
   /// ```
   static Future<DeviceTrustReport> getReport({
     Duration timeout = const Duration(milliseconds: 1500),
+    ScanLevel level = ScanLevel.standard,
+    Set<SignalGroup> signals = SignalGroup.all,
+    bool verdictsOnly = false,
   }) async {
-    final raw = await DeviceTrustPlatform.instance.getReportRaw().timeout(
-      timeout,
-      onTimeout: () =>
-          throw TimeoutException('device_trust: getReport timeout'),
-    );
+    final raw = await DeviceTrustPlatform.instance
+        .getReportRawWithOptions({
+          'level': level.name,
+          'signalMask': SignalGroup.maskOf(signals),
+          'verdictsOnly': verdictsOnly,
+        })
+        .timeout(
+          timeout,
+          onTimeout: () =>
+              throw TimeoutException('device_trust: getReport timeout'),
+        );
 
     return DeviceTrustReport.fromMap(raw);
   }
 
+  /// Runs one scan and emits each check result as soon as it completes.
+  ///
+  /// Accepts the same [level], [signals] and [verdictsOnly] options as
+  /// [getReport]. Check events come first, each with a monotonic
+  /// [DeviceTrustReportEvent.seq], its id, result and timing; the stream
+  /// ends with a summary event carrying the full report. Platforms without
+  /// streaming support emit only the summary. On Android, cancelling the
+  /// subscription skips the remaining checks and stops the native stages
+  /// of the scan early.
+  ///
+  /// Example:
+  /// ```dart
+  /// await for (final event in DeviceTrust.getReportStream()) {
+  ///   if (event.checkId == 'nativeTracerPid' && !event.hit) enableBrowse();
+  ///   if (event.isSummary) applyPolicy(event.report!);
+  /// }
+  /// ```
+  static Stream<DeviceTrustReportEvent> getReportStream({
+    ScanLevel level = ScanLevel.standard,
+    Set<SignalGroup> signals = SignalGroup.all,
+    bool verdictsOnly = false,
+  }) => DeviceTrustPlatform.instance
+      .getReportStreamRaw({
+        'level': level.name,
+        'signalMask': SignalGroup.maskOf(signals),
+        'verdictsOnly': verdictsOnly,
+      })
+      .map(DeviceTrustReportEvent.fromMap);
+
+  /// Watches for changes in the device trust flags (Android).
+  ///
+  /// Listening starts a native monitor thread that polls cheap detectors
+  /// (library load counters, thread count, TracerPid, RWX segments) on an
+  /// adaptive interval and runs a full scan only when one of them changes.
+  /// Events carry only the flags that changed; see [DeviceTrustEvent].
+  /// Cancelling the subscription stops the monitor.
+  ///
+  /// Example:
+  /// ```dart
+  /// final sub = DeviceTrust.watch().listen((event) {
+  ///   if (event.changed['fridaSuspected'] == true) logout();
+  /// });
+  /// ```
+  static Stream<DeviceTrustEvent> watch() =>
+      DeviceTrustPlatform.instance.watchRaw().map(DeviceTrustEvent.fromMap);
+
+  /// Returns the latest published verdict synchronously (Android).
+  ///
+  /// Every report (from [getReport], [getReportStream], [watch] rescans or
+  /// the warm-up scan) publishes its flags into a native word that is read
+  /// here with one atomic load: no channel call, no scan, no `await`, so it is
+  /// cheap enough for every network request. Use
+  /// [DeviceTrustVerdict.isStale] to decide when to fall back to a fresh
+  /// [getReport]; the verdict is also stale while [watch]'s monitor has seen
+  /// a change that is still being rescanned.
+  ///
+  /// Returns `null` before the first report, on iOS and if the native
+  /// library is unavailable.
+  ///
+  /// Example:
+  /// ```dart
+  /// final verdict = DeviceTrust.currentVerdict();
+  /// if (verdict == null || verdict.isStale(const Duration(minutes: 5))) {
+  ///   unawaited(DeviceTrust.getReport(level: ScanLevel.fast));
+  /// } else if (verdict.fridaSuspected) {
+  ///   throw const SessionCompromised();
+  /// }
+  /// ```
+  static DeviceTrustVerdict? currentVerdict() =>
+      DeviceTrustPlatform.instance.currentVerdict();
+
+  /// Captures everything the native hook checks read (Android).
+  ///
+  /// The bundle holds `/proc/self/maps`, `status`, thread names, open file
+  /// targets, loaded images and the image `getpid` resolves to, zlib
+  /// compressed (typically a few KiB). Upload it when a device is flagged and
+  /// replay it offline with `device_trust_snapshot replay` (see
+  /// CONTRIBUTING.md) to reproduce the verdict or evaluate rule changes.
+  ///
+  /// The bundle lists file paths and thread names of the app process; treat
+  /// it as diagnostic data under your privacy policy.
+  ///
+  /// Returns `null` on iOS and if the native library is unavailable.
+  static Future<Uint8List?> captureSnapshot() =>
+      DeviceTrustPlatform.instance.captureSnapshot();
+
+  /// Returns cumulative native telemetry since process start (Android).
+  ///
+  /// Per check: calls, cache hits, timeouts, cancellations and an HDR-style
+  /// latency histogram with p50/p90/p99; process-wide: procfs bytes read and
+  /// syscalls issued. Reading it merges lock-free per-thread shards and runs
+  /// no scan, so it is cheap enough to poll alongside other telemetry.
+  ///
+  /// Returns `null` on iOS and if the native library is unavailable.
+  ///
+  /// Example:
+  /// ```dart
+  /// final stats = await DeviceTrust.getStats();
+  /// if (stats != null) analytics.log('device_trust_stats', stats.toMap());
+  /// ```
+  static Future<DeviceTrustStats?> getStats() async {
+    final raw = await DeviceTrustPlatform.instance.getStatsRaw();
+    return raw == null ? null : DeviceTrustStats.fromMap(raw);
+  }
+
+  /// Returns the most recent scan sections as Chrome trace JSON (Android).
+  ///
+  /// Every scan, Kotlin check and native stage is also an `android.os.Trace`
+  /// / `ATrace` section, so it shows up on Perfetto startup traces. The
+  /// native library keeps the last 1024 sections in a ring buffer; open the
+  /// returned JSON in `ui.perfetto.dev` or `chrome://tracing`. Timestamps
+  /// are `CLOCK_MONOTONIC` microseconds.
+  ///
+  /// Returns `null` on iOS and if the native library is unavailable.
+  static Future<String?> dumpTrace() =>
+      DeviceTrustPlatform.instance.dumpTrace();
+
+  /// Installs an updated signature pack and returns its version.
+  ///
+  /// A pack (built with `device_trust_pack build` from a file in the format
+  /// of `src/signatures/signatures.txt`) replaces the detection keyword
+  /// lists, Frida memory signatures, su paths, root packages, QEMU files,
+  /// Frida ports and jailbreak paths/URL schemes without an app release.
+  /// The file is memory-mapped and validated (magic, CRC-32, limits) before
+  /// anything changes; scans already running finish with the previous pack.
+  /// Sections a pack leaves out keep the built-in lists.
+  ///
+  /// Throws a `PlatformException` with code `SIGNATURE_PACK_INVALID` (the
+  /// native status in `details`) when the pack is unreadable, corrupt, over
+  /// the limits, or not newer than the active one. Returns `null` if the
+  /// platform or native library does not support packs.
+  ///
+  /// Example:
+  /// ```dart
+  /// final file = await downloadSignatures(); // your own signed delivery
+  /// await DeviceTrust.loadSignaturePack(file.path);
+  /// ```
+  static Future<int?> loadSignaturePack(String path) =>
+      DeviceTrustPlatform.instance.loadSignaturePack(path);
+
   /// Returns `true` if the current platform supports this plugin.
   ///
   /// Checks whether the native implementation responds to method calls.
@@ -0,0 +1,741 @@
+// dart:ffi fast path for the Android native signals.
+import 'dart:convert';
+import 'dart:ffi';
+import 'dart:io';
+import 'dart:isolate';
+
+import 'package:ffi/ffi.dart';
+import 'package:flutter/foundation.dart';
+
+import 'device_trust_method_channel.dart';
+import 'device_trust_platform_interface.dart';
+
+/// `DT_ABI_VERSION` in `device_trust_ffi.h`.
+const int dtAbiVersion = 6;
+
+/// `DT_LISTS_CAPACITY` in `device_trust_ffi.h`.
+const int dtListsCapacity = 2048;
+
+/// `DT_STAGE_COUNT` in `device_trust_ffi.h`.
+const int dtStageCount = 7;
+
+const int _dtOk = 0;
+
+/// Mirror of `dt_request` in `android/src/main/cpp/device_trust_ffi.h`.
+final class DtRequest extends Struct {
+  /// `sizeOf<DtRequest>()`; checked by the native side.
+  @Uint32()
+  external int structSize;
+
+  /// Scan tier (0 = fast, 1 = standard, 2 = deep).
+  @Int32()
+  external int level;
+
+  /// [SignalGroup] bits.
+  @Int32()
+  external int signalMask;
+
+  /// Non-zero to stop the hook stages once the verdict is settled.
+  @Int32()
+  external int verdictsOnly;
+
+  /// Latency budget for the native stages.
+  @Int64()
+  external int budgetNs;
+}
+
+/// Mirror of `dt_result` in `android/src/main/cpp/device_trust_ffi.h`.
+final class DtResult extends Struct {
+  /// `sizeOf<DtResult>()`; checked by the native side.
+  @Uint32()
+  external int structSize;
+
+  /// `RESULT_FLAG_*` bits.
+  @Uint32()
+  external int flags;
+
+  /// Scan tier that ran.
+  @Int32()
+  external int level;
+
+  /// Requested [SignalGroup] bits.
+  @Int32()
+  external int signalMask;
+
+  /// TracerPid from `/proc/self/status`.
+  @Int32()
+  external int tracerPid;
+
+  /// Writable and executable regions found.
+  @Int32()
+  external int rwxSegments;
+
+  /// libc symbols compared by the deep integrity stage.
+  @Int32()
+  external int libcSymbolsChecked;
+
+  /// Hook stages skipped once the verdict was settled (bit per stage).
+  @Uint32()
+  external int skippedStages;
+
+  /// Hook stages left out because their breaker is open (bit per stage).
+  @Uint32()
+  external int demotedStages;
+
+  /// Bytes used in [lists].
+  @Uint32()
+  external int listsLength;
+
+  /// Time spent in the native stages.
+  @Int64()
+  external int nativeTimeNs;
+
+  /// Timed stages that ran (bit per [FfiNativeResult.timedStageIds] index).
+  @Uint32()
+  external int stagesRan;
+
+  /// Always 0.
+  @Uint32()
+  external int reserved;
+
+  /// Duration of each timed stage.
+  @Array(dtStageCount)
+  external Array<Int64> stageNs;
+
+  /// Work counter of each timed stage (lines, fds, regions, symbols or
+  /// bytes).
+  @Array(dtStageCount)
+  external Array<Int32> stageItems;
+
+  /// Always 0.
+  @Uint32()
+  external int reserved2;
+
+  /// Start of the region holding the memory signature; 0 if none.
+  @Uint64()
+  external int memoryRegionStart;
+
+  /// First byte of the memory signature match.
+  @Uint64()
+  external int memoryMatchAddress;
+
+  /// Packed string lists: libcGetpidSo, memorySignature, memoryRegionPath,
+  /// gotMismatch, textMismatch, suspiciousModules.
+  @Array(dtListsCapacity)
+  external Array<Uint8> lists;
+}
+
+typedef _DtAbiVersionNative = Int32 Function();
+typedef _DtAbiVersion = int Function();
+typedef _DtCollectNative =
+    Int32 Function(Pointer<DtRequest>, Pointer<DtResult>);
+typedef _DtCollect = int Function(Pointer<DtRequest>, Pointer<DtResult>);
+typedef _DtVerdictLoadNative = Uint64 Function();
+typedef _DtVerdictLoad = int Function();
+typedef _DtVerdictPublishNative = Void Function(Uint32, Uint32, Int32);
+typedef _DtVerdictPublish = void Function(int, int, int);
+typedef _DtClockMsNative = Int64 Function();
+typedef _DtClockMs = int Function();
+
+/// Native signals decoded from a [DtResult].
+///
+/// Field names follow `NativeResult` in `DeviceTrustNativeResult.kt`.
+@immutable
+class FfiNativeResult {
+  /// Stage names by hook stage index.
+  static const List<String> stageNames = [
+    'maps',
+    'fd',
+    'libc',
+    'integrity',
+    'memory',
+  ];
+
+  /// Stage ids by timed stage index (`TIMED_STAGE_IDS` in the native layer).
+  static const List<String> timedStageIds = [
+    'nativeMaps',
+    'nativeFd',
+    'nativeLibc',
+    'nativeIntegrity',
+    'nativeMemory',
+    'nativeTracerPid',
+    'nativeRwx',
+  ];
+
+  // Must match RESULT_FLAG_* in device_trust_native.cpp
+  static const int _flagHasRwx = 1 << 0;
+  static const int _flagFridaLib = 1 << 1;
+  static const int _flagFdFrida = 1 << 2;
+  static const int _flagLibcUnexpected = 1 << 3;
+  static const int _flagBudgetExceeded = 1 << 4;
+  static const int _flagTruncated = 1 << 5;
+  static const int _flagMemorySampled = 1 << 6;
+  static const int _flagMemorySignature = 1 << 7;
+
+  // Details keys of the hook stages (NATIVE_STAGE_KEYS in DeviceTrust.kt)
+  static const Map<String, String> _stageKeys = {
+    'maps': 'nativeMaps',
+    'fd': 'nativeFd',
+    'libc': 'nativeLibc',
+    'integrity': 'nativeIntegrity',
+    'memory': 'nativeMemory',
+  };
+
+  /// Scan tier that ran.
+  final int scanLevel;
+
+  /// TracerPid from `/proc/self/status`.
+  final int tracerPid;
+
+  /// Writable and executable regions found.
+  final int rwxSegments;
+
+  /// `RESULT_FLAG_*` bits.
+  final int flags;
+
+  /// Hook stages skipped once the verdict was settled (bit per stage).
+  final int skippedStages;
+
+  /// Hook stages left out because their breaker is open (bit per stage).
+  final int demotedStages;
+
+  /// Time spent in the native stages.
+  final int nativeTimeNs;
+
+  /// Duration and work counter of each stage that ran, by stage id.
+  final Map<String, ({int ns, int items})> stages;
+
+  /// Image that `getpid` resolves to (empty if the stage did not run).
+  final String libcGetpidSo;
+
+  /// libc symbols whose GOT entry differs from `dlsym` (deep).
+  final List<String> gotMismatch;
+
+  /// libc symbols whose prologue differs from the on-disk image (deep).
+  final List<String> textMismatch;
+
+  /// Suspicious modules found in `/proc/self/maps`.
+  final List<String> suspiciousModules;
+
+  /// Frida byte signature found in anonymous or memfd memory (deep); empty
+  /// if none, or if the lists were cut short (see [memorySignatureFound]).
+  final String memorySignature;
+
+  /// Path of the region holding [memorySignature]; empty if anonymous.
+  final String memoryRegionPath;
+
+  /// Start of the region holding [memorySignature].
+  final int memoryRegionStart;
+
+  /// Address of the [memorySignature] match.
+  final int memoryMatchAddress;
+
+  /// Creates a [FfiNativeResult] with the given fields.
+  const FfiNativeResult({
+    required this.scanLevel,
+    required this.tracerPid,
+    required this.rwxSegments,
+    required this.flags,
+    required this.skippedStages,
+    required this.demotedStages,
+    required this.nativeTimeNs,
+    this.stages = const {},
+    required this.libcGetpidSo,
+    required this.gotMismatch,
+    required this.textMismatch,
+    required this.suspiciousModules,
+    this.memorySignature = '',
+    this.memoryRegionPath = '',
+    this.memoryRegionStart = 0,
+    this.memoryMatchAddress = 0,
+  });
+
+  /// Decodes [result]; list entries that overrun [DtResult.listsLength] are
+  /// dropped and reported through [truncated].
+  factory FfiNativeResult.fromStruct(DtResult result) {
+    final reader = _ListReader(result.lists, result.listsLength);
+    final libcSo = reader.next();
+    final memorySignature = reader.next();
+    final memoryRegionPath = reader.next();
+    final gotMismatch = reader.next();
+    final textMismatch = reader.next();
+    final suspiciousModules = reader.next();
+    return FfiNativeResult(
+      scanLevel: result.level,
+      tracerPid: result.tracerPid,
+      rwxSegments: result.rwxSegments,
+      flags: result.flags | (reader.overrun ? _flagTruncated : 0),
+      skippedStages: result.skippedStages,
+      demotedStages: result.demotedStages,
+      nativeTimeNs: result.nativeTimeNs,
+      stages: {
+        for (var i = 0; i < dtStageCount; i++)
+          if (result.stagesRan & (1 << i) != 0)
+            timedStageIds[i]: (
+              ns: result.stageNs[i],
+              items: result.stageItems[i],
+            ),
+      },
+      libcGetpidSo: libcSo.isEmpty ? '' : libcSo.first,
+      gotMismatch: gotMismatch,
+      textMismatch: textMismatch,
+      suspiciousModules: suspiciousModules,
+      memorySignature: memorySignature.isEmpty ? '' : memorySignature.first,
+      memoryRegionPath: memoryRegionPath.isEmpty ? '' : memoryRegionPath.first,
+      memoryRegionStart: result.memoryRegionStart,
+      memoryMatchAddress: result.memoryMatchAddress,
+    );
+  }
+
+  /// Whether a writable and executable region was found.
+  bool get hasRwx => flags & _flagHasRwx != 0;
+
+  /// Whether a Frida library is mapped.
+  bool get fridaLibLoaded => flags & _flagFridaLib != 0;
+
+  /// Whether an open file descriptor points at a Frida artifact.
+  bool get fdFrida => flags & _flagFdFrida != 0;
+
+  /// Whether `getpid` resolves outside libc.
+  bool get libcGetpidUnexpected => flags & _flagLibcUnexpected != 0;
+
+  /// Whether the native stages ran out of budget.
+  bool get budgetExceeded => flags & _flagBudgetExceeded != 0;
+
+  /// Whether a string list was cut short.
+  bool get truncated => flags & _flagTruncated != 0;
+
+  /// Whether the memory stage only read sampled windows of its candidates.
+  bool get memorySampled => flags & _flagMemorySampled != 0;
+
+  /// Whether the memory stage found a Frida byte signature.
+  bool get memorySignatureFound => flags & _flagMemorySignature != 0;
+
+  /// Native signal names, same rules as `applyNativeResult` in
+  /// `DeviceTrust.kt`.
+  List<String> get signals => [
+    if (fridaLibLoaded) 'fridaLibLoaded',
+    if (fdFrida) 'fdFrida',
+    if (libcGetpidUnexpected) 'libcGetpidUnexpected',
+    if (hasRwx) 'hasRwx',
+    if (gotMismatch.isNotEmpty) 'gotMismatch',
+    if (textMismatch.isNotEmpty) 'textMismatch',
+    if (memorySignatureFound) 'memorySignature',
+  ];
+
+  /// Stage names for a hook stage bit mask.
+  static List<String> stageNamesOf(int mask) => [
+    for (var i = 0; i < stageNames.length; i++)
+      if (mask & (1 << i) != 0) stageNames[i],
+  ];
+
+  /// Writes the native details keys the Kotlin layer writes for a JNI scan.
+  void applyTo(Map<String, dynamic> details) {
+    details['nativeTracerPid'] = tracerPid;
+    details['nativeBudgetExceeded'] = budgetExceeded;
+    details['nativeStages'] = {
+      for (final MapEntry(:key, :value) in stages.entries)
+        key: {'ns': value.ns, 'items': value.items},
+    };
+    if (demotedStages != 0) {
+      final demoted = stageNamesOf(
+        demotedStages,
+      ).map((stage) => _stageKeys[stage] ?? stage).toList();
+      for (final key in demoted) {
+        details[key] = 'skipped:demoted';
+      }
+      details['nativeDemoted'] = demoted;
+    }
+    if (skippedStages != 0) {
+      final skipped = stageNamesOf(skippedStages);
+      for (final stage in skipped) {
+        details[_stageKeys[stage] ?? 'native_$stage'] = 'skipped:decided';
+      }
+      details['nativeSkipped'] = skipped;
+    }
+    if (memorySignatureFound) {
+      details['memorySignature'] = {
+        'signature': memorySignature,
+        'regionStart': memoryRegionStart,
+        'regionPath': memoryRegionPath,
+        'address': memoryMatchAddress,
+        'sampled': memorySampled,
+      };
+    }
+    details['nativeSignals'] = signals;
+  }
+}
+
+/// Reads u16 count + (u16 length + UTF-8 bytes)* lists up to [_end].
+class _ListReader {
+  final Array<Uint8> _bytes;
+  final int _end;
+  int _pos = 0;
+  bool overrun = false;
+
+  _ListReader(this._bytes, int length)
+    : _end = length < dtListsCapacity ? length : dtListsCapacity;
+
+  // Native byte order; every Android ABI is little-endian
+  int _u16(int pos) => _bytes[pos] | (_bytes[pos + 1] << 8);
+
+  List<String> next() {
+    if (_pos + 2 > _end) {
+      overrun = true;
+      return const [];
+    }
+    final count = _u16(_pos);
+    _pos += 2;
+    final items = <String>[];
+    for (var i = 0; i < count; i++) {
+      if (_pos + 2 > _end) {
+        overrun = true;
+        break;
+      }
+      final length = _u16(_pos);
+      if (_pos + 2 + length > _end) {
+        overrun = true;
+        break;
+      }
+      final bytes = Uint8List(length);
+      for (var j = 0; j < length; j++) {
+        bytes[j] = _bytes[_pos + 2 + j];
+      }
+      items.add(utf8.decode(bytes, allowMalformed: true));
+      _pos += 2 + length;
+    }
+    return items;
+  }
+}
+
+/// C ABI entry points resolved from `libdevice_trust_native.so`.
+class _DtBindings {
+  final _DtCollect collect;
+
+  // Leaf calls: a single atomic load / CAS, no callbacks into Dart
+  final _DtVerdictLoad verdictLoad;
+  final _DtVerdictPublish verdictPublish;
+  final _DtClockMs clockMs;
+
+  _DtBindings._(
+    this.collect,
+    this.verdictLoad,
+    this.verdictPublish,
+    this.clockMs,
+  );
+
+  // Resolved once per isolate; null if the library or ABI does not match
+  static final _DtBindings? instance = _open();
+
+  static _DtBindings? _open() {
+    try {
+      final library = DynamicLibrary.open('libdevice_trust_native.so');
+      final version = library
+          .lookupFunction<_DtAbiVersionNative, _DtAbiVersion>(
+            'dt_abi_version',
+          );
+      if (version() != dtAbiVersion) return null;
+      return _DtBindings._(
+        library.lookupFunction<_DtCollectNative, _DtCollect>('dt_collect'),
+        library.lookupFunction<_DtVerdictLoadNative, _DtVerdictLoad>(
+          'dt_verdict_load',
+          isLeaf: true,
+        ),
+        library.lookupFunction<_DtVerdictPublishNative, _DtVerdictPublish>(
+          'dt_verdict_publish',
+          isLeaf: true,
+        ),
+        library.lookupFunction<_DtClockMsNative, _DtClockMs>(
+          'dt_clock_ms',
+          isLeaf: true,
+        ),
+      );
+    } catch (_) {
+      // Fail-soft: library missing or built without the C ABI
+      return null;
+    }
+  }
+}
+
+/// Android [DeviceTrustPlatform] that collects the native signals through
+/// `dart:ffi` instead of the method channel.
+///
+/// `dt_collect` runs on a background isolate while the method channel
+/// carries only the checks that need Android framework APIs (packages,
+/// build properties, settings, `Debug`); the native results are merged into
+/// the channel report with the same details keys. Requests that need no
+/// framework check (fast hook-only scans) skip the channel entirely.
+///
+/// [currentVerdict] reads the verdict word the native library keeps with two
+/// leaf FFI calls (no isolate hop, no channel). Reports merged here are
+/// published to it from Dart, since Kotlin only sees the channel part.
+///
+/// Streams, [watchRaw] and [isSupported] use the method channel. If the
+/// library cannot be opened, every call falls back to
+/// [MethodChannelDeviceTrust].
+class FfiDeviceTrust extends MethodChannelDeviceTrust {
+  // Latency budgets per tier (ScanLevel.budgetMs in DeviceTrust.kt)
+  static const Map<String, int> _budgetMs = {
+    'fast': 1,
+    'standard': 500,
+    'deep': 1200,
+  };
+
+  static const Map<String, int> _nativeLevels = {
+    'fast': 0,
+    'standard': 1,
+    'deep': 2,
+  };
+
+  static final int _nativeGroups =
+      SignalGroup.hook.bit | SignalGroup.debugger.bit;
+
+  /// Registers this class as the default [DeviceTrustPlatform] (Android).
+  static void registerWith() {
+    DeviceTrustPlatform.instance = FfiDeviceTrust();
+  }
+
+  /// Whether the native library exposes a compatible C ABI.
+  ///
+  /// The first access opens the library on the calling isolate.
+  static bool get isAvailable =>
+      Platform.isAndroid && _DtBindings.instance != null;
+
+  @override
+  Future<Map<String, Object?>> getReportRawWithOptions(
+    Map<String, Object?> options,
+  ) async {
+    final mask =
+        (options['signalMask'] as int?) ?? SignalGroup.maskOf(SignalGroup.all);
+    if (mask & _nativeGroups == 0 || !isAvailable) {
+      return super.getReportRawWithOptions(options);
+    }
+
+    final levelName = _budgetMs.containsKey(options['level'])
+        ? options['level']! as String
+        : ScanLevel.standard.name;
+    final level = _nativeLevels[levelName]!;
+    final budgetNs = _budgetMs[levelName]! * 1000000;
+    final verdictsOnly = (options['verdictsOnly'] as bool?) ?? false;
+
+    final stopwatch = Stopwatch()..start();
+    final native = _collectInBackground(level, mask, verdictsOnly, budgetNs);
+
+    // Fast hook-only scans have no framework check left for the channel
+    final channelReport =
+        levelName == ScanLevel.fast.name && mask & ~SignalGroup.hook.bit == 0
+        ? Future.value(_nativeOnlyReport(levelName, mask, verdictsOnly))
+        : super.getReportRawWithOptions({
+            ...options,
+            'nativeTransport': 'ffi',
+          });
+
+    // Both are in flight; channel errors propagate as before
+    final report = await channelReport;
+    final nativeResult = await native;
+    final merged = mergeNativeResult(
+      report,
+      nativeResult,
+      signalMask: mask,
+    );
+    final details = merged['details'];
+    if (details is Map<String, dynamic> &&
+        details['nativeTransport'] == 'ffi') {
+      details['ffiTotalTimeUs'] = stopwatch.elapsedMicroseconds;
+      _publishVerdict(merged, mask, level);
+    }
+    return merged;
+  }
+
+  @override
+  DeviceTrustVerdict? currentVerdict() {
+    if (!isAvailable) return null;
+    final bindings = _DtBindings.instance!;
+    return DeviceTrustVerdict.fromWord(
+      bindings.verdictLoad(),
+      bindings.clockMs(),
+    );
+  }
+
+  // Same groups rule as buildReport in DeviceTrust.kt: a cold fast static
+  // tier evaluated nothing for root/emulator/developer, and incomplete
+  // groups only add hits
+  static void _publishVerdict(
+    Map<String, Object?> report,
+    int signalMask,
+    int level,
+  ) {
+    final details = report['details']! as Map<String, dynamic>;
+    final staticGroups =
+        SignalGroup.root.bit |
+        SignalGroup.emulator.bit |
+        SignalGroup.developer.bit;
+    final coldStatic =
+        signalMask & staticGroups != 0 && details['staticTier'] == 'cold';
+    final incomplete = SignalGroup.maskOf(
+      SignalGroup.values.where(
+        (group) =>
+            (details['incompleteSignals'] as List?)?.contains(group.name) ??
+            false,
+      ),
+    );
+    final groups = coldStatic ? signalMask & ~staticGroups : signalMask;
+    _DtBindings.instance?.verdictPublish(
+      groups & ~incomplete,
+      DeviceTrustVerdict.flagsOf(report),
+      level,
+    );
+  }
+
+  static Future<FfiNativeResult?> _collectInBackground(
+    int level,
+    int signalMask,
+    bool verdictsOnly,
+    int budgetNs,
+  ) async {
+    try {
+      return await Isolate.run(
+        () => collectNative(level, signalMask, verdictsOnly, budgetNs),
+      );
+    } catch (_) {
+      // Fail-soft: recorded as nativeError by mergeNativeResult
+      return null;
+    }
+  }
+
+  /// Runs `dt_collect` on the calling isolate.
+  ///
+  /// Returns `null` if the library is unavailable or rejects the request.
+  static FfiNativeResult? collectNative(
+    int level,
+    int signalMask,
+    bool verdictsOnly,
+    int budgetNs,
+  ) {
+    final bindings = _DtBindings.instance;
+    if (bindings == null) return null;
+
+    final request = calloc<DtRequest>();
+    final result = calloc<DtResult>();
+    try {
+      request.ref
+        ..structSize = sizeOf<DtRequest>()
+        ..level = level
+        ..signalMask = signalMask
+        ..verdictsOnly = verdictsOnly ? 1 : 0
+        ..budgetNs = budgetNs;
+      result.ref.structSize = sizeOf<DtResult>();
+      if (bindings.collect(request, result) != _dtOk) return null;
+      return FfiNativeResult.fromStruct(result.ref);
+    } finally {
+      calloc.free(request);
+      calloc.free(result);
+    }
+  }
+
+  /// Merges [native] into a channel [report] built with
+  /// `nativeTransport: 'ffi'`, applying the hook verdict rules of
+  /// `DeviceTrust.buildReport`.
+  ///
+  /// Reports whose details do not say `nativeTransport: 'ffi'` (e.g. from a
+  /// platform that ignores the transport option) already contain native
+  /// signals and are returned unchanged. A `null` [native] (FFI call failed) is recorded in
+  /// `details['nativeError']`.
+  @visibleForTesting
+  static Map<String, Object?> mergeNativeResult(
+    Map<String, Object?> report,
+    FfiNativeResult? native, {
+    required int signalMask,
+  }) {
+    final rawDetails = report['details'] as Map?;
+    if (rawDetails == null || rawDetails['nativeTransport'] != 'ffi') {
+      return report;
+    }
+
+    final details = Map<String, dynamic>.from(rawDetails);
+    final merged = {...report, 'details': details};
+    if (native == null) {
+      details['nativeSignals'] = const <String>[];
+      details['nativeError'] = 'dt_collect failed';
+      _markIncomplete(details, signalMask, _nativeGroups);
+      return merged;
+    }
+
+    native.applyTo(details);
+    final hookRequested = signalMask & SignalGroup.hook.bit != 0;
+    // FAST has RWX and Frida module paths from one maps pass; TracerPid
+    // only feeds the debugger verdict
+    final nativeFrida = hookRequested && native.signals.length >= 2;
+    merged['fridaSuspected'] =
+        (report['fridaSuspected'] as bool? ?? false) || nativeFrida;
+
+    details['budgetExceeded'] =
+        (details['budgetExceeded'] as bool? ?? false) || native.budgetExceeded;
+    // Cut or demoted native stages leave their groups incomplete (buildReport)
+    _markIncomplete(
+      details,
+      signalMask,
+      (native.budgetExceeded || native.demotedStages != 0
+              ? SignalGroup.hook.bit
+              : 0) |
+          (native.budgetExceeded ? SignalGroup.debugger.bit : 0),
+    );
+    final demoted = details['nativeDemoted'] as List<String>?;
+    if (demoted != null) {
+      details['demotedSkipped'] = [
+        ...(details['demotedSkipped'] as List?) ?? const [],
+        ...demoted,
+      ];
+    }
+    details['nativeScanTimeMs'] = native.nativeTimeNs / 1e6;
+    details['timeBreakdownMs'] = {
+      ...(details['timeBreakdownMs'] as Map?) ?? const {},
+      for (final MapEntry(:key, :value) in native.stages.entries)
+        key: value.ns / 1e6,
+    };
+    return merged;
+  }
+
+  // Adds the requested groups of [groups] to details['incompleteSignals']
+  static void _markIncomplete(
+    Map<String, dynamic> details,
+    int signalMask,
+    int groups,
+  ) {
+    final current = (details['incompleteSignals'] as List?) ?? const [];
+    details['incompleteSignals'] = [
+      for (final group in SignalGroup.values)
+        if (current.contains(group.name) ||
+            groups & signalMask & group.bit != 0)
+          group.name,
+    ];
+  }
+
+  static Map<String, Object?> _nativeOnlyReport(
+    String levelName,
+    int signalMask,
+    bool verdictsOnly,
+  ) => {
+    'rootedOrJailbroken': false,
+    'emulator': false,
+    'devModeEnabled': false,
+    'adbEnabled': false,
+    'fridaSuspected': false,
+    'debuggerAttached': false,
+    'details': <String, dynamic>{
+      'scanLevel': levelName,
+      'budgetMs': _budgetMs[levelName],
+      'signalMask': signalMask,
+      'requestedSignals': [
+        for (final group in SignalGroup.values)
+          if (signalMask & group.bit != 0) group.name,
+      ],
+      'verdictsOnly': verdictsOnly,
+      'nativeTransport': 'ffi',
+      'skippedChecks': const <String>[],
+      'budgetExceeded': false,
+      'demotedSkipped': const <String>[],
+      'incompleteSignals': const <String>[],
+    },
+  };
+}
@@ -1,4 +1,7 @@
 import 'dart:async';
+import 'dart:convert';
+import 'dart:typed_data';
+
 import 'package:flutter/services.dart';
 import 'device_trust_platform_interface.dart';
 
@@ -10,10 +13,24 @@ class MethodChannelDeviceTrust extends DeviceTrustPlatform {
   /// The method channel used to interact with the native platform.
   static const MethodChannel _channel = MethodChannel('device_trust');
 
+  /// The event channel carrying background monitor events.
+  static const EventChannel _watchChannel = EventChannel('device_trust/watch');
+
+  /// The event channel carrying streaming report events.
+  static const EventChannel _reportChannel = EventChannel(
+    'device_trust/report',
+  );
+
+  @override
+  Future<Map<String, Object?>> getReportRaw() =>
+      getReportRawWithOptions(const {});
+
   @override
-  Future<Map<String, Object?>> getReportRaw() async {
+  Future<Map<String, Object?>> getReportRawWithOptions(
+    Map<String, Object?> options,
+  ) async {
     final Map<Object?, Object?>? result = await _channel
-        .invokeMethod<Map<Object?, Object?>>('getDeviceTrustReport');
+        .invokeMethod<Map<Object?, Object?>>('getDeviceTrustReport', options);
 
     if (result == null) {
       throw PlatformException(
@@ -26,6 +43,65 @@ class MethodChannelDeviceTrust extends DeviceTrustPlatform {
     return result.map((key, value) => MapEntry(key.toString(), value));
   }
 
+  @override
+  Stream<Map<String, Object?>> getReportStreamRaw(
+    Map<String, Object?> options,
+  ) => _reportChannel.receiveBroadcastStream(options).map(_normalize);
+
+  @override
+  Stream<Map<String, Object?>> watchRaw() =>
+      _watchChannel.receiveBroadcastStream().map(_normalize);
+
+  static Map<String, Object?> _normalize(Object? event) =>
+      (event as Map<Object?, Object?>).map(
+        (key, value) => MapEntry(key.toString(), value),
+      );
+
+  @override
+  Future<Uint8List?> captureSnapshot() async {
+    try {
+      return await _channel.invokeMethod<Uint8List>('captureSnapshot');
+    } on MissingPluginException {
+      // iOS and older Android builds do not capture snapshots
+      return null;
+    }
+  }
+
+  @override
+  Future<Map<String, Object?>?> getStatsRaw() async {
+    try {
+      final json = await _channel.invokeMethod<String>('getStats');
+      if (json == null) return null;
+      return (jsonDecode(json) as Map).cast<String, Object?>();
+    } on MissingPluginException {
+      // iOS and older Android builds keep no telemetry
+      return null;
+    }
+  }
+
+  @override
+  Future<String?> dumpTrace() async {
+    try {
+      return await _channel.invokeMethod<String>('dumpTrace');
+    } on MissingPluginException {
+      // iOS and older Android builds record no trace
+      return null;
+    }
+  }
+
+  @override
+  Future<int?> loadSignaturePack(String path) async {
+    try {
+      return await _channel.invokeMethod<int>(
+        'loadSignaturePack',
+        {'path': path},
+      );
+    } on MissingPluginException {
+      // Older builds ship only the built-in signatures
+      return null;
+    }
+  }
+
   @override
   Future<bool> isSupported() async {
     try {
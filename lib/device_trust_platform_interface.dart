@@ -1,6 +1,164 @@
+import 'dart:typed_data';
+
 import 'package:plugin_platform_interface/plugin_platform_interface.dart';
 import 'device_trust_method_channel.dart';
 
+/// Scan tier requested from the native layer.
+///
+/// Each tier has a latency budget that the platform enforces; checks that do
+/// not fit are listed in `details['skippedChecks']` and
+/// `details['budgetExceeded']` is set.
+enum ScanLevel {
+  /// ~1 ms budget: debugger/TracerPid, a quick RWX count with Frida module
+  /// paths (the hook verdict needs both) and the cached static tier
+  /// (root/emulator results of the last standard or deep scan).
+  fast,
+
+  /// 500 ms budget: all root, emulator and hook checks (default).
+  standard,
+
+  /// 1200 ms budget: standard plus native libc ELF prologue and GOT checks
+  /// and a byte-signature search of anonymous and memfd memory (Android).
+  deep,
+}
+
+/// Groups of checks a caller can request from the platform.
+///
+/// Checks of groups that are not requested are never executed, and the
+/// corresponding report flags stay `false`.
+enum SignalGroup {
+  /// Root/jailbreak checks (`rootedOrJailbroken`).
+  root(1),
+
+  /// Emulator/simulator checks (`emulator`).
+  emulator(2),
+
+  /// Developer options and ADB (`devModeEnabled`, `adbEnabled`; Android only).
+  developer(4),
+
+  /// Hook/Frida checks, Kotlin and native (`fridaSuspected`).
+  hook(8),
+
+  /// Debugger checks (`debuggerAttached`).
+  debugger(16);
+
+  const SignalGroup(this.bit);
+
+  /// Bit value shared with the native layers.
+  final int bit;
+
+  /// Every group (default for [DeviceTrust.getReport]).
+  static const Set<SignalGroup> all = {
+    root,
+    emulator,
+    developer,
+    hook,
+    debugger,
+  };
+
+  /// Combines [groups] into the bitmask sent over the method channel.
+  static int maskOf(Iterable<SignalGroup> groups) =>
+      groups.fold(0, (mask, group) => mask | group.bit);
+}
+
+/// Latest verdict published by the platform, read synchronously.
+///
+/// Every report the platform builds publishes its six flags; reading them back
+/// costs one atomic load in native code (see [DeviceTrustPlatform.currentVerdict]).
+/// Flags of groups that were never evaluated completely ([covers]) only
+/// reflect hits of scans that skipped some of their checks, and a hook hit of
+/// a [ScanLevel.deep] scan is only cleared by the next deep scan.
+class DeviceTrustVerdict {
+  // Must match VERDICT_* in src/core/verdict.h
+  static const int _flagRooted = 1 << 0;
+  static const int _flagEmulator = 1 << 1;
+  static const int _flagDevMode = 1 << 2;
+  static const int _flagAdb = 1 << 3;
+  static const int _flagFrida = 1 << 4;
+  static const int _flagDebugger = 1 << 5;
+  static const int _groupsShift = 6;
+  static const int _groupsMask = 0x1F;
+  static const int _pending = 1 << 11;
+  static const int _seqShift = 12;
+  static const int _seqMask = 0xFFF;
+  static const int _timeShift = 26;
+
+  /// Packed verdict word.
+  final int word;
+
+  /// Time since the verdict was published.
+  final Duration age;
+
+  /// Creates a [DeviceTrustVerdict] from a packed [word] and its [age].
+  const DeviceTrustVerdict(this.word, this.age);
+
+  /// Decodes a verdict word read at [nowMs] (both on the platform clock).
+  ///
+  /// Returns `null` if nothing was published yet.
+  static DeviceTrustVerdict? fromWord(int word, int nowMs) {
+    if ((word >>> _seqShift) & _seqMask == 0) return null;
+    final publishedAtMs = word >>> _timeShift;
+    return DeviceTrustVerdict(
+      word,
+      Duration(milliseconds: nowMs - publishedAtMs),
+    );
+  }
+
+  /// See `DeviceTrustReport.rootedOrJailbroken`.
+  bool get rootedOrJailbroken => word & _flagRooted != 0;
+
+  /// See `DeviceTrustReport.emulator`.
+  bool get emulator => word & _flagEmulator != 0;
+
+  /// See `DeviceTrustReport.devModeEnabled`.
+  bool get devModeEnabled => word & _flagDevMode != 0;
+
+  /// See `DeviceTrustReport.adbEnabled`.
+  bool get adbEnabled => word & _flagAdb != 0;
+
+  /// See `DeviceTrustReport.fridaSuspected`.
+  bool get fridaSuspected => word & _flagFrida != 0;
+
+  /// See `DeviceTrustReport.debuggerAttached`.
+  bool get debuggerAttached => word & _flagDebugger != 0;
+
+  /// Publish sequence number (1..4095, wraps); changes on every publish.
+  int get seq => (word >>> _seqShift) & _seqMask;
+
+  /// Whether the background monitor saw a detector change that has not been
+  /// rescanned and published yet.
+  bool get pending => word & _pending != 0;
+
+  /// Groups evaluated completely by at least one report since process start.
+  Set<SignalGroup> get evaluated => {
+    for (final group in SignalGroup.values)
+      if ((word >>> _groupsShift) & _groupsMask & group.bit != 0) group,
+  };
+
+  /// Whether [group] has been evaluated completely by at least one report.
+  bool covers(SignalGroup group) => evaluated.contains(group);
+
+  /// Whether the verdict is older than [maxAge] or a rescan is [pending].
+  bool isStale(Duration maxAge) => pending || age > maxAge;
+
+  /// VERDICT bits of a raw report map (see [DeviceTrustPlatform.getReportRaw]).
+  static int flagsOf(Map<String, Object?> report) {
+    bool flag(String key) => (report[key] as bool?) ?? false;
+    return (flag('rootedOrJailbroken') ? _flagRooted : 0) |
+        (flag('emulator') ? _flagEmulator : 0) |
+        (flag('devModeEnabled') ? _flagDevMode : 0) |
+        (flag('adbEnabled') ? _flagAdb : 0) |
+        (flag('fridaSuspected') ? _flagFrida : 0) |
+        (flag('debuggerAttached') ? _flagDebugger : 0);
+  }
+
+  @override
+  String toString() =>
+      'DeviceTrustVerdict{seq=$seq, rooted=$rootedOrJailbroken, '
+      'emulator=$emulator, frida=$fridaSuspected, '
+      'debugger=$debuggerAttached, pending=$pending, age=$age}';
+}
+
 /// Platform interface for the device_trust plugin.
 ///
 /// This exposes low-level, raw map results so the public API wrapper
@@ -39,6 +197,62 @@ abstract class DeviceTrustPlatform extends PlatformInterface {
   /// - `details` (`Map<String, dynamic>`)
   Future<Map<String, Object?>> getReportRaw();
 
+  /// Collects device trust signals with scan [options].
+  ///
+  /// [options] are forwarded to the platform as method-call arguments
+  /// (e.g. `{'level': 'fast'}`). The default implementation ignores them and
+  /// falls back to [getReportRaw], so existing implementations keep working.
+  Future<Map<String, Object?>> getReportRawWithOptions(
+    Map<String, Object?> options,
+  ) => getReportRaw();
+
+  /// Runs one scan and streams each check result as it completes.
+  ///
+  /// Check events are maps with `type: 'check'`, `seq`, `id`, `result`,
+  /// `hit` and `elapsedUs`; the last event is `{type: 'summary', seq,
+  /// report}`. The default implementation emits only the summary, built from
+  /// [getReportRawWithOptions].
+  Stream<Map<String, Object?>> getReportStreamRaw(
+    Map<String, Object?> options,
+  ) => Stream.fromFuture(
+    getReportRawWithOptions(
+      options,
+    ).then((report) => {'type': 'summary', 'seq': 1, 'report': report}),
+  );
+
+  /// Streams monitor events from the platform's background monitor.
+  ///
+  /// Each event is a map with `type` (`baseline`/`change`), `seq`,
+  /// `triggers`, `changed` (flag name to new value) and `monitor` stats.
+  /// Listening starts the monitor; cancelling stops it.
+  Stream<Map<String, Object?>> watchRaw() {
+    throw UnimplementedError('watchRaw() has not been implemented.');
+  }
+
+  /// Returns the latest published verdict synchronously, or `null` if the
+  /// platform has none (nothing published yet, or no native accessor).
+  ///
+  /// Must not block: implementations read a value the platform keeps
+  /// up to date, they never run a scan or a channel call.
+  DeviceTrustVerdict? currentVerdict() => null;
+
+  /// Captures every input of the native checks as a compressed snapshot
+  /// bundle, or `null` if the platform cannot capture one.
+  Future<Uint8List?> captureSnapshot() async => null;
+
+  /// Returns the cumulative native telemetry snapshot (see
+  /// [DeviceTrustStats]) as decoded JSON, or `null` if the platform keeps
+  /// none.
+  Future<Map<String, Object?>?> getStatsRaw() async => null;
+
+  /// Returns the recent scan trace sections as Chrome trace JSON, or `null`
+  /// if the platform records none.
+  Future<String?> dumpTrace() async => null;
+
+  /// Installs the signature pack at [path] and returns its version, or
+  /// `null` if the platform does not support signature packs.
+  Future<int?> loadSignaturePack(String path) async => null;
+
   /// Returns `true` if the platform side responds to method calls.
   ///
   /// Used to check if a native implementation is available.
@@ -0,0 +1,97 @@
+// [DeviceTrust/Core] Synthetic procfs fixtures for benchmarks
+// Sized like real apps: a small app maps a few hundred regions, a large
+// Flutter/Unity app with JIT and many libraries tens of thousands.
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+#include "fixture_backend.h"
+
+namespace device_trust_bench {
+
+using device_trust_test::FixtureBackend;
+
+/**
+ * /proc/self/maps lines mixing anonymous regions, long APK paths, deleted
+ * mappings, memfd entries and (every 2500th line) a hook module
+ */
+inline FixtureBackend syntheticMaps(int lines) {
+    static const char* const PATHS[] = {
+        "/system/lib64/libandroid_runtime.so",
+        "/data/app/~~qY3nHkX0Zr9wL1bT5sUe0A==/com.example.shop-Vd8Wn2cJp4Kx7Gm1Ty6Ra==/lib/arm64/libflutter.so",
+        "/dev/ashmem/dalvik-jit-code-cache (deleted)",
+        "/memfd:jit-cache (deleted)",
+        "/data/app/~~qY3nHkX0Zr9wL1bT5sUe0A==/com.example.shop-Vd8Wn2cJp4Kx7Gm1Ty6Ra==/base.apk",
+        "[anon:dalvik-LinearAlloc]",
+        "/apex/com.android.art/lib64/libart.so",
+    };
+    static const char* const HOOKS[] = {
+        "/data/local/tmp/re.frida.server/frida-agent-64.so",
+        "/data/local/tmp/libgadget.so",
+        "/data/app/de.robv.android.xposed.installer/XposedBridge.jar",
+        "/memfd:frida-agent-64.so (deleted)",
+    };
+
+    FixtureBackend backend;
+    backend.mapsLines.reserve(lines);
+    char line[512];
+    for (int i = 0; i < lines; i++) {
+        unsigned long start = 0x700000000000UL + (unsigned long)i * 0x1000;
+        const char* path = (i % 11 == 0) ? "" : PATHS[i % 7];
+        if (i % 2500 == 1250) {
+            path = HOOKS[(i / 2500) % 4];
+        }
+        const char* perms = (i % 97 == 0) ? "rwxp" : (i % 3 == 0) ? "r-xp" : (i % 3 == 1) ? "r--p" : "rw-p";
+        snprintf(line, sizeof(line), "%lx-%lx %s %08x fd:01 %d%s%s", start, start + 0x1000, perms,
+                 (unsigned)(i % 64) * 0x1000, 100000 + i, path[0] ? "                          " : "", path);
+        backend.mapsLines.push_back(line);
+    }
+    return backend;
+}
+
+/**
+ * readlink targets of /proc/self/fd: sockets, pipes, anon inodes, app files
+ * and system files; none of them match the Frida keywords, so scans walk
+ * every entry
+ */
+inline FixtureBackend syntheticFds(int entries) {
+    FixtureBackend backend;
+    backend.openFiles.reserve(entries);
+    char path[256];
+    for (int i = 0; i < entries; i++) {
+        switch (i % 6) {
+            case 0:
+                snprintf(path, sizeof(path), "socket:[%d]", 4000000 + i);
+                break;
+            case 1:
+                snprintf(path, sizeof(path), "pipe:[%d]", 5000000 + i);
+                break;
+            case 2:
+                snprintf(path, sizeof(path), "anon_inode:[eventfd]");
+                break;
+            case 3:
+                snprintf(path, sizeof(path), "/data/user/0/com.example.shop/databases/cache-%d.db", i);
+                break;
+            case 4:
+                snprintf(path, sizeof(path), "/dev/ashmem%d", i);
+                break;
+            default:
+                snprintf(path, sizeof(path), "/system/framework/framework-res.apk");
+        }
+        backend.openFiles.push_back(path);
+    }
+    return backend;
+}
+
+// Input bytes a scan over [lines] reads (line + newline), for bytes/s
+inline long long bytesOf(const std::vector<std::string>& lines) {
+    long long bytes = 0;
+    for (const std::string& line : lines) {
+        bytes += (long long)line.size() + 1;
+    }
+    return bytes;
+}
+
+}  // namespace device_trust_bench
@@ -0,0 +1,110 @@
+// [DeviceTrust/Core] Host benchmarks
+// Usage: device_trust_core_bench [iterations]
+// Prints ns per call for the live procfs backend and for synthetic fixtures,
+// plus cycles, instructions, cache misses and page faults per call where
+// perf events are permitted (perf_event_paranoid <= 2, hardware counters
+// exposed); the scaling suite with allocation counters is scan_bench.cpp.
+
+#include <unistd.h>
+
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "../core/arena.h"
+#include "../core/json.h"
+#include "../core/keywords.h"
+#include "../core/perf_counters.h"
+#include "../core/scanners.h"
+#include "../core/signature_pack.h"
+#include "../platform/procfs_backend.h"
+#include "bench_fixtures.h"
+
+using namespace device_trust;
+using device_trust_bench::FixtureBackend;
+
+static const long long NO_BUDGET = LLONG_MAX;
+
+// Built-in lists in plain text; the library only holds them encoded
+static const char* const* const MODULE_KEYWORDS_LINUX = SignaturePack::builtin()->list(SIGNATURE_MODULE_KEYWORDS);
+static const char* const* const FD_KEYWORDS_LINUX = SignaturePack::builtin()->list(SIGNATURE_FD_KEYWORDS);
+
+// Keeps results observable so the optimizer cannot drop the work
+static volatile long long g_sink = 0;
+
+static PerfCounters* g_perf = nullptr;
+
+template <typename Body>
+static void bench(const char* name, int iterations, Body body) {
+    body();  // warm-up
+    PerfSample perf;
+    if (g_perf != nullptr) {
+        g_perf->start();
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        body();
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    if (g_perf != nullptr) {
+        g_perf->stop(&perf);
+    }
+    printf("%-40s %12.0f ns/op", name, ns / iterations);
+    for (int counter = 0; counter < PERF_COUNTER_COUNT; counter++) {
+        if (perf.has(static_cast<PerfCounter>(counter))) {
+            printf("  %s/op %.0f", PERF_COUNTER_NAMES[counter], (double)perf.values[counter] / iterations);
+        }
+    }
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 200;
+    if (iterations <= 0) {
+        iterations = 200;
+    }
+    PerfCounters perf;
+    if (perf.available()) {
+        g_perf = &perf;
+    } else {
+        printf("perf events not permitted; timing only\n");
+    }
+
+    ProcfsBackend live;
+    ScanArena arena;  // reset per call, as the shims do per scan
+    bench("live countRwxRegions", iterations, [&] {
+        Deadline deadline(NO_BUDGET);
+        g_sink += countRwxRegions(live, deadline).rwxSegments;
+    });
+    bench("live analyzeRegions", iterations, [&] {
+        Deadline deadline(NO_BUDGET);
+        arena.reset();
+        g_sink += analyzeRegions(live, deadline, arena, MODULE_KEYWORDS_LINUX).rwxSegments;
+    });
+    bench("live openFilesMatch", iterations, [&] {
+        Deadline deadline(NO_BUDGET);
+        g_sink += openFilesMatch(live, deadline, FD_KEYWORDS_LINUX);
+    });
+    bench("live checkSymbolImage(getpid)", iterations, [&] {
+        arena.reset();
+        g_sink += checkSymbolImage(live, arena, reinterpret_cast<void*>(getpid), LIBC_IMAGE_FRAGMENTS_LINUX).unexpected;
+    });
+
+    for (int lines : {500, 5000}) {
+        FixtureBackend fixture = device_trust_bench::syntheticMaps(lines);
+        std::string name = "fixture analyzeRegions " + std::to_string(lines) + " lines";
+        bench(name.c_str(), iterations, [&] {
+            Deadline deadline(NO_BUDGET);
+            arena.reset();
+            g_sink += analyzeRegions(fixture, deadline, arena, MODULE_KEYWORDS_LINUX).rwxSegments;
+        });
+    }
+
+    std::string path = "/data/app/com.example-1/lib/arm64/lib\"quoted\"\\name.so";
+    bench("escapeJsonString", iterations * 100, [&] {
+        g_sink += (long long)escapeJsonString(path).size();
+    });
+    return 0;
+}
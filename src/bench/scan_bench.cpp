@@ -0,0 +1,441 @@
+// [DeviceTrust/Core] Scanner scaling suite (Google Benchmark)
+// Usage: device_trust_scan_bench [--benchmark_filter=<regex>] [--benchmark_min_time=<s>]
+//
+// Counters per benchmark:
+//   per_line / per_entry  time per maps line or fd entry
+//   allocs, alloc_bytes   operator new calls / bytes per iteration (calling thread)
+//   bytes_per_second      input bytes read by the scanner (SetBytesProcessed)
+//   speedup               parallel scans: serial time / time per scan
+//   cycles, instructions, cacheMisses, pageFaults
+//                         per iteration (calling thread, user space), where perf
+//                         events are permitted; absent otherwise
+
+#include <benchmark/benchmark.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <string>
+
+#include "../core/arena.h"
+#include "../core/json.h"
+#include "../core/keyword_automaton.h"
+#include "../core/keywords.h"
+#include "../core/obfuscated_string.h"
+#include "../core/perf_counters.h"
+#include "../core/packed_writer.h"
+#include "../core/pattern_search.h"
+#include "../core/scanners.h"
+#include "../core/signature_pack.h"
+#include "../core/work_pool.h"
+#include "../platform/procfs_backend.h"
+#include "alloc_counter.h"
+#include "bench_fixtures.h"
+
+using namespace device_trust;
+using device_trust_bench::FixtureBackend;
+using device_trust_test::AllocationCounter;
+
+static const long long NO_BUDGET = LLONG_MAX;
+
+// Built-in lists in plain text; the library only holds them encoded
+static const char* const* const MODULE_KEYWORDS_LINUX = SignaturePack::builtin()->list(SIGNATURE_MODULE_KEYWORDS);
+static const char* const* const FD_KEYWORDS_LINUX = SignaturePack::builtin()->list(SIGNATURE_FD_KEYWORDS);
+static const char* const* const MEMORY_SIGNATURES_LINUX = SignaturePack::builtin()->list(SIGNATURE_MEMORY_SIGNATURES);
+
+static void reportAllocations(benchmark::State& state, const AllocationCounter& allocations) {
+    // Read both before inserting into state.counters, which allocates
+    double count = (double)allocations.count();
+    double bytes = (double)allocations.bytes();
+    state.counters["allocs"] = benchmark::Counter(count, benchmark::Counter::kAvgIterations);
+    state.counters["alloc_bytes"] = benchmark::Counter(bytes, benchmark::Counter::kAvgIterations);
+}
+
+/**
+ * Counts the benchmark loop between construction and report()
+ */
+class PerfScope {
+public:
+    PerfScope() { counters_.start(); }
+
+    void report(benchmark::State& state) {
+        PerfSample sample;
+        counters_.stop(&sample);
+        for (int counter = 0; counter < PERF_COUNTER_COUNT; counter++) {
+            if (sample.has(static_cast<PerfCounter>(counter))) {
+                state.counters[PERF_COUNTER_NAMES[counter]] =
+                    benchmark::Counter((double)sample.values[counter], benchmark::Counter::kAvgIterations);
+            }
+        }
+    }
+
+private:
+    PerfCounters counters_;
+};
+
+static void reportPerItem(benchmark::State& state, const char* name, double items) {
+    state.counters[name] =
+        benchmark::Counter(items, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+// --- maps ---
+
+static void BM_AnalyzeRegions(benchmark::State& state) {
+    FixtureBackend fixture = device_trust_bench::syntheticMaps((int)state.range(0));
+    ScanArena arena;
+    AllocationCounter allocations;
+    PerfScope perf;
+    for (auto _ : state) {
+        arena.reset();
+        Deadline deadline(NO_BUDGET);
+        RegionAnalysis analysis = analyzeRegions(fixture, deadline, arena, MODULE_KEYWORDS_LINUX, INT_MAX);
+        benchmark::DoNotOptimize(analysis.rwxSegments);
+    }
+    reportAllocations(state, allocations);
+    perf.report(state);
+    reportPerItem(state, "per_line", (double)state.range(0));
+    state.SetBytesProcessed((int64_t)state.iterations() * device_trust_bench::bytesOf(fixture.mapsLines));
+}
+BENCHMARK(BM_AnalyzeRegions)->RangeMultiplier(4)->Range(500, 100000);
+
+static void BM_CountRwxRegions(benchmark::State& state) {
+    FixtureBackend fixture = device_trust_bench::syntheticMaps((int)state.range(0));
+    AllocationCounter allocations;
+    PerfScope perf;
+    for (auto _ : state) {
+        Deadline deadline(NO_BUDGET);
+        benchmark::DoNotOptimize(countRwxRegions(fixture, deadline, 0, INT_MAX).rwxSegments);
+    }
+    reportAllocations(state, allocations);
+    perf.report(state);
+    reportPerItem(state, "per_line", (double)state.range(0));
+    state.SetBytesProcessed((int64_t)state.iterations() * device_trust_bench::bytesOf(fixture.mapsLines));
+}
+BENCHMARK(BM_CountRwxRegions)->RangeMultiplier(4)->Range(500, 100000);
+
+// Parsing alone, without the keyword search
+static void BM_ParseMapsLine(benchmark::State& state) {
+    FixtureBackend fixture = device_trust_bench::syntheticMaps((int)state.range(0));
+    AllocationCounter allocations;
+    PerfScope perf;
+    for (auto _ : state) {
+        MemoryRegion region;
+        for (const std::string& line : fixture.mapsLines) {
+            benchmark::DoNotOptimize(parseMapsLine(line.data(), line.size(), &region));
+        }
+    }
+    reportAllocations(state, allocations);
+    perf.report(state);
+    reportPerItem(state, "per_line", (double)state.range(0));
+    state.SetBytesProcessed((int64_t)state.iterations() * device_trust_bench::bytesOf(fixture.mapsLines));
+}
+BENCHMARK(BM_ParseMapsLine)->Arg(500)->Arg(100000);
+
+// Keyword search alone: one pass per keyword vs. the compiled automaton
+static void BM_FindKeyword(benchmark::State& state) {
+    FixtureBackend fixture = device_trust_bench::syntheticMaps((int)state.range(0));
+    const KeywordAutomaton& automaton = MODULE_AUTOMATON_LINUX;
+    bool compiled = state.range(1) != 0;
+    AllocationCounter allocations;
+    PerfScope perf;
+    for (auto _ : state) {
+        for (const std::string& line : fixture.mapsLines) {
+            benchmark::DoNotOptimize(compiled ? automaton.find(line.data(), line.size()) >= 0
+                                              : findKeyword(line.data(), line.size(), MODULE_KEYWORDS_LINUX) != nullptr);
+        }
+    }
+    reportAllocations(state, allocations);
+    perf.report(state);
+    reportPerItem(state, "per_line", (double)state.range(0));
+    state.SetBytesProcessed((int64_t)state.iterations() * device_trust_bench::bytesOf(fixture.mapsLines));
+    state.SetLabel(compiled ? "automaton" : "findKeyword");
+}
+BENCHMARK(BM_FindKeyword)->Args({500, 0})->Args({500, 1})->Args({100000, 0})->Args({100000, 1});
+
+// Cost of keeping a keyword encoded: plain literal vs. matching the encoded
+// bytes vs. decoding to the stack first
+static void BM_ObfuscatedKeyword(benchmark::State& state) {
+    static constexpr ObfuscatedString<6> FRIDA("frida", 0x5a1c37e9u);
+    static const char* const PLAIN[] = {"frida", nullptr};
+    FixtureBackend fixture = device_trust_bench::syntheticMaps(500);
+    int mode = (int)state.range(0);
+    AllocationCounter allocations;
+    PerfScope perf;
+    for (auto _ : state) {
+        for (const std::string& line : fixture.mapsLines) {
+            bool found;
+            if (mode == 0) {
+                found = findKeyword(line.data(), line.size(), PLAIN) != nullptr;
+            } else if (mode == 1) {
+                found = FRIDA.text().containedIn(line.data(), line.size());
+            } else {
+                char plain[decltype(FRIDA)::BUFFER_SIZE];
+                const char* const decoded[] = {FRIDA.text().decode(plain), nullptr};
+                found = findKeyword(line.data(), line.size(), decoded) != nullptr;
+            }
+            benchmark::DoNotOptimize(found);
+        }
+    }
+    reportAllocations(state, allocations);
+    perf.report(state);
+    reportPerItem(state, "per_line", 500);
+    state.SetLabel(mode == 0 ? "plain" : mode == 1 ? "containedIn" : "decode");
+}
+BENCHMARK(BM_ObfuscatedKeyword)->Arg(0)->Arg(1)->Arg(2);
+
+// What the generated MODULE_AUTOMATON_LINUX tables save at startup
+static void BM_CompileKeywordAutomaton(benchmark::State& state) {
+    AllocationCounter allocations;
+    PerfScope perf;
+    for (auto _ : state) {
+        KeywordAutomatonTables tables(MODULE_KEYWORDS_LINUX);
+        benchmark::DoNotOptimize(tables.automaton().states());
+    }
+    reportAllocations(state, allocations);
+    perf.report(state);
+}
+BENCHMARK(BM_CompileKeywordAutomaton);
+
+// Validating and compiling the default pack (what loadSignaturePack pays)
+static void BM_LoadSignaturePack(benchmark::State& state) {
+    SignaturePackSource source;
+    source.version = 1;
+    for (SignatureSection section : {SIGNATURE_MODULE_KEYWORDS, SIGNATURE_FD_KEYWORDS, SIGNATURE_IMAGE_KEYWORDS,
+                                     SIGNATURE_MEMORY_SIGNATURES}) {
+        std::vector<std::string> entries;
+        for (const char* const* entry = SignaturePack::builtin()->list(section); *entry != nullptr; entry++) {
+            entries.emplace_back(*entry);
+        }
+        source.lists.emplace_back(section, std::move(entries));
+    }
+    std::string bytes;
+    encodeSignaturePack(source, &bytes);
+    char path[] = "/tmp/device_trust_bench_pack_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0 || write(fd, bytes.data(), bytes.size()) != (ssize_t)bytes.size()) {
+        state.SkipWithError("cannot write the pack");
+        return;
+    }
+    close(fd);
+    AllocationCounter allocations;
+    PerfScope perf;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SignaturePack::open(path));
+    }
+    reportAllocations(state, allocations);
+    perf.report(state);
+    state.SetBytesProcessed((int64_t)state.iterations() * (int64_t)bytes.size());
+    unlink(path);
+}
+BENCHMARK(BM_LoadSignaturePack);
+
+// --- fd ---
+
+static void BM_OpenFilesMatch(benchmark::State& state) {
+    int entries = (int)state.range(0);
+    FixtureBackend fixture = device_trust_bench::syntheticFds(entries);
+    AllocationCounter allocations;
+    PerfScope perf;
+    for (auto _ : state) {
+        Deadline deadline(NO_BUDGET);
+        benchmark::DoNotOptimize(openFilesMatch(fixture, deadline, FD_KEYWORDS_LINUX, entries));
+    }
+    reportAllocations(state, allocations);
+    perf.report(state);
+    reportPerItem(state, "per_entry", entries);
+    state.SetBytesProcessed((int64_t)state.iterations() * device_trust_bench::bytesOf(fixture.openFiles));
+}
+BENCHMARK(BM_OpenFilesMatch)->Arg(10)->Arg(100)->Arg(1000)->Arg(5000);
+
+// --- symbol checks ---
+
+static void BM_CheckSymbolImageFixture(benchmark::State& state) {
+    FixtureBackend fixture;
+    fixture.symbolImage = "/apex/com.android.runtime/lib64/bionic/libc.so";
+    ScanArena arena;
+    AllocationCounter allocations;
+    PerfScope perf;
+    for (auto _ : state) {
+        arena.reset();
+        benchmark::DoNotOptimize(checkSymbolImage(fixture, arena, nullptr, LIBC_IMAGE_FRAGMENTS_LINUX).unexpected);
+    }
+    reportAllocations(state, allocations);
+    perf.report(state);
+}
+BENCHMARK(BM_CheckSymbolImageFixture);
+
+// dladdr on the live process
+static void BM_CheckSymbolImageLive(benchmark::State& state) {
+    ProcfsBackend live;
+    ScanArena arena;
+    AllocationCounter allocations;
+    PerfScope perf;
+    for (auto _ : state) {
+        arena.reset();
+        benchmark::DoNotOptimize(
+            checkSymbolImage(live, arena, reinterpret_cast<void*>(getpid), LIBC_IMAGE_FRAGMENTS_LINUX).unexpected);
+    }
+    reportAllocations(state, allocations);
+    perf.report(state);
+}
+BENCHMARK(BM_CheckSymbolImageLive);
+
+// --- memory signatures ---
+
+// Signature search over a window without a match (the common case)
+static void BM_PatternSearch(benchmark::State& state) {
+    size_t length = (size_t)state.range(0);
+    std::string window(length, '\0');
+    for (size_t i = 0; i < length; i++) {
+        window[i] = "GfQuJ:r\x90\x00ip"[i % 11];  // first / last bytes of the signatures
+    }
+    PatternSearch search(MEMORY_SIGNATURES_LINUX);
+    AllocationCounter allocations;
+    PerfScope perf;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(search.find(reinterpret_cast<const uint8_t*>(window.data()), length).pattern);
+    }
+    reportAllocations(state, allocations);
+    perf.report(state);
+    state.SetBytesProcessed((int64_t)state.iterations() * (int64_t)length);
+}
+BENCHMARK(BM_PatternSearch)->Arg(MEMORY_SCAN_WINDOW)->Arg(1 << 20);
+
+// Anonymous executable and memfd regions of the live process, 1 MiB budget
+static void BM_LiveScanMemorySignatures(benchmark::State& state) {
+    ProcfsBackend live;
+    ScanArena arena;
+    AllocationCounter allocations;
+    PerfScope perf;
+    size_t scanned = 0;
+    uint32_t seed = 0;
+    for (auto _ : state) {
+        arena.reset();
+        Deadline deadline(NO_BUDGET);
+        MemorySignatureScan scan = scanMemorySignatures(live, deadline, arena, MEMORY_SIGNATURES_LINUX,
+                                                        1024 * 1024, seed++);
+        scanned += scan.bytesScanned;
+        benchmark::DoNotOptimize(scan.found);
+    }
+    reportAllocations(state, allocations);
+    perf.report(state);
+    state.SetBytesProcessed((int64_t)scanned);
+}
+BENCHMARK(BM_LiveScanMemorySignatures);
+
+// 32 MiB of anonymous code in the live process, read in full by
+// state.range(0) workers; "speedup" is against the serial scan
+static void BM_ParallelScanMemorySignatures(benchmark::State& state) {
+    const size_t length = 32 * 1024 * 1024;
+    void* code = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (code == MAP_FAILED) {
+        state.SkipWithError("mmap failed");
+        return;
+    }
+    memset(code, 0x90, length);
+    mprotect(code, length, PROT_READ | PROT_EXEC);
+
+    ProcfsBackend live;
+    ScanArena arena;
+    WorkPool pool((int)state.range(0) - 1);
+    auto scanOnce = [&](WorkPool* workers) {
+        arena.reset();
+        Deadline deadline(NO_BUDGET);
+        return scanMemorySignatures(live, deadline, arena, MEMORY_SIGNATURES_LINUX, 2 * length, 0, 256, workers);
+    };
+
+    const int SERIAL_RUNS = 3;
+    auto start = std::chrono::steady_clock::now();
+    for (int run = 0; run < SERIAL_RUNS; run++) {
+        benchmark::DoNotOptimize(scanOnce(nullptr).found);
+    }
+    double serialSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / SERIAL_RUNS;
+
+    size_t scanned = 0;
+    start = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        MemorySignatureScan scan = scanOnce(&pool);
+        scanned += scan.bytesScanned;
+        benchmark::DoNotOptimize(scan.found);
+    }
+    double parallelSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    state.counters["speedup"] = serialSeconds * (double)state.iterations() / parallelSeconds;
+    state.SetBytesProcessed((int64_t)scanned);
+    munmap(code, length);
+}
+BENCHMARK(BM_ParallelScanMemorySignatures)->Arg(1)->Arg(2)->Arg(DEEP_SCAN_MAX_WORKERS)->UseRealTime();
+
+// --- live procfs ---
+
+static void BM_LiveAnalyzeRegions(benchmark::State& state) {
+    ProcfsBackend live;
+    ScanArena arena;
+    AllocationCounter allocations;
+    PerfScope perf;
+    for (auto _ : state) {
+        arena.reset();
+        Deadline deadline(NO_BUDGET);
+        benchmark::DoNotOptimize(analyzeRegions(live, deadline, arena, MODULE_KEYWORDS_LINUX).rwxSegments);
+    }
+    reportAllocations(state, allocations);
+    perf.report(state);
+}
+BENCHMARK(BM_LiveAnalyzeRegions);
+
+// --- serializers ---
+
+static StringList moduleList(ScanArena& arena, int count) {
+    StringList list;
+    char name[64];
+    for (int i = 0; i < count; i++) {
+        int length = snprintf(name, sizeof(name), "frida-agent-%d\"x\".so", i);
+        list.push(arena, arena.copy(name, (size_t)length));
+    }
+    return list;
+}
+
+static void BM_VectorToJsonArray(benchmark::State& state) {
+    ScanArena arena;
+    StringList modules = moduleList(arena, (int)state.range(0));
+    AllocationCounter allocations;
+    PerfScope perf;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(vectorToJsonArray(modules).size());
+    }
+    reportAllocations(state, allocations);
+    perf.report(state);
+}
+BENCHMARK(BM_VectorToJsonArray)->Arg(4)->Arg(64);
+
+static void BM_PackedWriterLists(benchmark::State& state) {
+    ScanArena arena;
+    StringList modules = moduleList(arena, (int)state.range(0));
+    uint8_t buffer[4096];
+    AllocationCounter allocations;
+    PerfScope perf;
+    for (auto _ : state) {
+        PackedWriter writer{buffer, sizeof(buffer)};
+        writer.putList(modules);
+        benchmark::DoNotOptimize(writer.pos);
+        benchmark::ClobberMemory();
+    }
+    reportAllocations(state, allocations);
+    perf.report(state);
+}
+BENCHMARK(BM_PackedWriterLists)->Arg(4)->Arg(64);
+
+static void BM_EscapeJsonString(benchmark::State& state) {
+    std::string path = "/data/app/com.example-1/lib/arm64/lib\"quoted\"\\name.so";
+    AllocationCounter allocations;
+    PerfScope perf;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(escapeJsonString(path).size());
+    }
+    reportAllocations(state, allocations);
+    perf.report(state);
+}
+BENCHMARK(BM_EscapeJsonString);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,169 @@
+// [DeviceTrust/Core] Per-scan arena
+
+#include "arena.h"
+
+#include <new>
+
+namespace device_trust {
+
+static uint64_t hashBytes(const char* data, size_t length) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+ScanArena::ScanArena(size_t blockSize) : blockSize_(blockSize > 0 ? blockSize : DEFAULT_BLOCK_SIZE) {}
+
+ScanArena::~ScanArena() {
+    Block* block = first_;
+    while (block != nullptr) {
+        Block* next = block->next;
+        ::operator delete(block);
+        block = next;
+    }
+}
+
+void ScanArena::enter(Block* block) {
+    current_ = block;
+    cursor_ = dataOf(block);
+    end_ = cursor_ + block->size;
+}
+
+void* ScanArena::allocate(size_t size, size_t align) {
+    uintptr_t aligned = (reinterpret_cast<uintptr_t>(cursor_) + align - 1) & ~(uintptr_t)(align - 1);
+    if (cursor_ != nullptr && aligned + size <= reinterpret_cast<uintptr_t>(end_)) {
+        char* result = reinterpret_cast<char*>(aligned);
+        used_ += (result + size) - cursor_;
+        cursor_ = result + size;
+        return result;
+    }
+    return allocateSlow(size, align);
+}
+
+void* ScanArena::allocateSlow(size_t size, size_t align) {
+    size_t needed = size + align;
+
+    // Reuse the blocks kept by reset() before growing the chain
+    Block* next = current_ != nullptr ? current_->next : first_;
+    if (next == nullptr || next->size < needed) {
+        size_t blockSize = needed > blockSize_ ? needed : blockSize_;
+        Block* block = static_cast<Block*>(::operator new(sizeof(Block) + blockSize));
+        block->size = blockSize;
+        if (current_ == nullptr) {
+            block->next = first_;
+            first_ = block;
+        } else {
+            block->next = current_->next;
+            current_->next = block;
+        }
+        reserved_ += blockSize;
+        blocks_++;
+        next = block;
+    }
+
+    // The rest of the current block is given up
+    if (current_ != nullptr) {
+        used_ += end_ - cursor_;
+    }
+    enter(next);
+    return allocate(size, align);
+}
+
+StringRef ScanArena::copy(const char* data, size_t length) {
+    char* copy = static_cast<char*>(allocate(length + 1, 1));
+    if (length > 0) {
+        memcpy(copy, data, length);
+    }
+    copy[length] = '\0';
+    return StringRef{copy, length};
+}
+
+void ScanArena::reset() {
+    current_ = nullptr;
+    cursor_ = nullptr;
+    end_ = nullptr;
+    used_ = 0;
+    if (first_ != nullptr) {
+        enter(first_);
+    }
+}
+
+void StringList::push(ScanArena& arena, StringRef item) {
+    if (count_ == capacity_) {
+        size_t capacity = capacity_ == 0 ? 8 : capacity_ * 2;
+        StringRef* items = arena.allocateArray<StringRef>(capacity);
+        for (size_t i = 0; i < count_; i++) {
+            items[i] = items_[i];
+        }
+        items_ = items;
+        capacity_ = capacity;
+    }
+    items_[count_++] = item;
+}
+
+InternedSet::InternedSet(ScanArena& arena, size_t initialCapacity) : arena_(&arena) {
+    capacity_ = 8;
+    while (capacity_ < initialCapacity) {
+        capacity_ *= 2;
+    }
+    slots_ = arena.allocateArray<Slot>(capacity_);
+    for (size_t i = 0; i < capacity_; i++) {
+        slots_[i] = Slot{0, StringRef()};
+    }
+}
+
+StringRef InternedSet::intern(const char* data, size_t length, bool* inserted) {
+    // Keep the load factor at or below 1/2
+    if ((size_ + 1) * 2 > capacity_) {
+        grow();
+    }
+
+    uint64_t hash = hashBytes(data, length);
+    size_t mask = capacity_ - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        Slot& slot = slots_[i];
+        if (slot.value.data == nullptr) {
+            slot.hash = hash;
+            slot.value = arena_->copy(data, length);
+            size_++;
+            if (inserted != nullptr) {
+                *inserted = true;
+            }
+            return slot.value;
+        }
+        if (slot.hash == hash && slot.value.equals(data, length)) {
+            if (inserted != nullptr) {
+                *inserted = false;
+            }
+            return slot.value;
+        }
+    }
+}
+
+void InternedSet::grow() {
+    Slot* old = slots_;
+    size_t oldCapacity = capacity_;
+    capacity_ *= 2;
+    slots_ = arena_->allocateArray<Slot>(capacity_);
+    for (size_t i = 0; i < capacity_; i++) {
+        slots_[i] = Slot{0, StringRef()};
+    }
+
+    size_t mask = capacity_ - 1;
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (old[i].value.data == nullptr) {
+            continue;
+        }
+        size_t j = old[i].hash & mask;
+        while (slots_[j].value.data != nullptr) {
+            j = (j + 1) & mask;
+        }
+        slots_[j] = old[i];
+    }
+}
+
+}  // namespace device_trust
@@ -0,0 +1,174 @@
+// [DeviceTrust/Core] Per-scan arena
+// Scanner results (module names, image paths) live in a monotonic arena that
+// is reset between scans, so a warmed-up scan does not touch the heap.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace device_trust {
+
+/**
+ * Non-owning string; data points into a ScanArena (or static storage) and is
+ * NUL-terminated when produced by ScanArena::copy
+ */
+struct StringRef {
+    const char* data = nullptr;
+    size_t length = 0;
+
+    bool empty() const {
+        return length == 0;
+    }
+
+    bool equals(const char* str, size_t strLength) const {
+        return length == strLength && (length == 0 || memcmp(data, str, length) == 0);
+    }
+
+    bool operator==(const char* str) const {
+        return equals(str, strlen(str));
+    }
+};
+
+/**
+ * Monotonic bump allocator
+ *
+ * Memory comes from a chain of blocks that is only ever extended; reset()
+ * rewinds to the first block in O(1) and keeps every block, so once a scan
+ * has run, the same scan allocates nothing. Not thread-safe: use one arena
+ * per scanning thread. Destructors of arena objects are never run.
+ */
+class ScanArena {
+public:
+    static const size_t DEFAULT_BLOCK_SIZE = 16 * 1024;
+
+    explicit ScanArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~ScanArena();
+
+    ScanArena(const ScanArena&) = delete;
+    ScanArena& operator=(const ScanArena&) = delete;
+
+    /**
+     * @return [size] bytes aligned to [align] (a power of two); valid until reset()
+     */
+    void* allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+    template <typename T>
+    T* allocateArray(size_t count) {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /**
+     * NUL-terminated copy of [length] bytes at [data]
+     */
+    StringRef copy(const char* data, size_t length);
+
+    /**
+     * Invalidates everything allocated so far; keeps the blocks
+     */
+    void reset();
+
+    size_t bytesUsed() const {
+        return used_;
+    }
+
+    size_t bytesReserved() const {
+        return reserved_;
+    }
+
+    size_t blockCount() const {
+        return blocks_;
+    }
+
+private:
+    struct Block {
+        Block* next;
+        size_t size;  // usable bytes after the header
+    };
+
+    static char* dataOf(Block* block) {
+        return reinterpret_cast<char*>(block + 1);
+    }
+
+    void* allocateSlow(size_t size, size_t align);
+    void enter(Block* block);
+
+    size_t blockSize_;
+    Block* first_ = nullptr;
+    Block* current_ = nullptr;
+    char* cursor_ = nullptr;
+    char* end_ = nullptr;
+    size_t used_ = 0;
+    size_t reserved_ = 0;
+    size_t blocks_ = 0;
+};
+
+/**
+ * Growable array of StringRef backed by a ScanArena (capacity doubles; old
+ * storage is left to the arena)
+ */
+class StringList {
+public:
+    void push(ScanArena& arena, StringRef item);
+
+    size_t size() const {
+        return count_;
+    }
+
+    bool empty() const {
+        return count_ == 0;
+    }
+
+    const StringRef& operator[](size_t index) const {
+        return items_[index];
+    }
+
+    const StringRef* begin() const {
+        return items_;
+    }
+
+    const StringRef* end() const {
+        return items_ + count_;
+    }
+
+private:
+    StringRef* items_ = nullptr;
+    size_t count_ = 0;
+    size_t capacity_ = 0;
+};
+
+/**
+ * Open-addressing hash set of strings interned into a ScanArena
+ *
+ * Replaces linear de-duplication of scan results; lookups are O(1) expected.
+ */
+class InternedSet {
+public:
+    explicit InternedSet(ScanArena& arena, size_t initialCapacity = 16);
+
+    /**
+     * @param inserted set to whether [data] was new
+     * @return the interned copy (same data pointer for equal strings)
+     */
+    StringRef intern(const char* data, size_t length, bool* inserted = nullptr);
+
+    size_t size() const {
+        return size_;
+    }
+
+private:
+    struct Slot {
+        uint64_t hash;
+        StringRef value;  // value.data == nullptr: empty slot
+    };
+
+    void grow();
+
+    ScanArena* arena_;
+    Slot* slots_;
+    size_t capacity_;  // power of two
+    size_t size_ = 0;
+};
+
+}  // namespace device_trust
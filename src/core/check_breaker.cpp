@@ -0,0 +1,176 @@
+// [DeviceTrust/Core] Check cost model and circuit breakers
+
+#include "check_breaker.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace device_trust {
+
+static int64_t cooldownMs(uint32_t trips) {
+    uint32_t shift = trips > 0 ? std::min(trips - 1, BREAKER_MAX_BACKOFF_SHIFT) : 0;
+    return BREAKER_BASE_COOLDOWN_MS << shift;
+}
+
+CheckBreakers::Entry* CheckBreakers::find(const char* check, bool create) {
+    for (int i = 0; i < count_; i++) {
+        if (strncmp(entries_[i].name, check, BREAKER_NAME_LEN) == 0) {
+            return &entries_[i];
+        }
+    }
+    if (!create || count_ >= BREAKER_MAX_CHECKS) {
+        return nullptr;
+    }
+    Entry* entry = &entries_[count_++];
+    memset(entry, 0, sizeof(*entry));
+    strncpy(entry->name, check, BREAKER_NAME_LEN - 1);
+    return entry;
+}
+
+int CheckBreakers::admit(const char* check, int64_t nowMs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry* entry = find(check, false);
+    if (entry == nullptr) {
+        return BREAKER_CLOSED;
+    }
+    if (entry->state == BREAKER_OPEN && nowMs - entry->openedAtMs >= cooldownMs(entry->trips)) {
+        entry->state = BREAKER_HALF_OPEN;
+    }
+    return entry->state;
+}
+
+void CheckBreakers::record(const char* check, double elapsedNs, bool hit, bool overBudget, int64_t nowMs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry* entry = find(check, true);
+    if (entry == nullptr) {
+        return;
+    }
+    entry->costEwmaNs = entry->runs == 0
+        ? elapsedNs
+        : entry->costEwmaNs + BREAKER_EWMA_ALPHA * (elapsedNs - entry->costEwmaNs);
+    entry->runs++;
+    if (hit) {
+        entry->hits++;
+    }
+
+    if (!overBudget) {
+        entry->overBudgetStreak = 0;
+        if (entry->state != BREAKER_CLOSED) {
+            // Probe (or DEEP run) fit its budget again
+            entry->state = BREAKER_CLOSED;
+            entry->trips = 0;
+        }
+        return;
+    }
+    entry->overBudgetStreak++;
+    bool reopen = entry->state != BREAKER_CLOSED;
+    if (reopen || entry->overBudgetStreak >= BREAKER_TRIP_STREAK) {
+        entry->state = BREAKER_OPEN;
+        entry->openedAtMs = nowMs;
+        entry->trips++;
+    }
+}
+
+double CheckBreakers::score(const char* check, double priorNs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry* entry = find(check, false);
+    double cost = entry != nullptr && entry->runs > 0 ? entry->costEwmaNs : priorNs;
+    double hitRate = entry != nullptr ? (entry->hits + 1.0) / (entry->runs + 2.0) : 0.5;
+    return cost / hitRate;
+}
+
+std::string CheckBreakers::demotedJson(const TelemetrySnapshot& latency) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream json;
+    json << "[";
+    bool first = true;
+    for (int i = 0; i < count_; i++) {
+        const Entry& entry = entries_[i];
+        if (entry.state == BREAKER_CLOSED) {
+            continue;
+        }
+        uint64_t p99Ns = 0;
+        for (const TelemetrySnapshot::Check& check : latency.checks) {
+            if (strncmp(check.name, entry.name, BREAKER_NAME_LEN) == 0) {
+                p99Ns = check.latency.percentileNs(0.99);
+                break;
+            }
+        }
+        json << (first ? "" : ",") << "{";
+        json << "\"id\":\"" << entry.name << "\",";
+        json << "\"state\":\"" << (entry.state == BREAKER_OPEN ? "open" : "halfOpen") << "\",";
+        json << "\"trips\":" << entry.trips << ",";
+        json << "\"ewmaMs\":" << entry.costEwmaNs / 1e6 << ",";
+        json << "\"p99Ms\":" << p99Ns / 1e6;
+        json << "}";
+        first = false;
+    }
+    json << "]";
+    return json.str();
+}
+
+std::string CheckBreakers::exportText() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream out;
+    out << "v2\n";
+    for (int i = 0; i < count_; i++) {
+        const Entry& entry = entries_[i];
+        out << entry.name << " " << (long long)entry.costEwmaNs << " " << entry.runs << " "
+            << entry.hits << " " << entry.overBudgetStreak << " " << entry.trips << " "
+            << entry.state << " " << (long long)entry.openedAtMs << "\n";
+    }
+    return out.str();
+}
+
+int CheckBreakers::importText(const std::string& text) {
+    std::istringstream in(text);
+    std::string line;
+    if (!std::getline(in, line) || (line != "v1" && line != "v2")) {
+        return 0;
+    }
+    bool v1 = line == "v1";
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    int restored = 0;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string name, buckets;
+        long long ewma = 0, openedAtMs = 0;
+        uint32_t runs = 0, hits = 0, streak = 0, trips = 0;
+        int state = 0;
+        if (!(fields >> name >> ewma >> runs >> hits >> streak >> trips >> state >> openedAtMs) ||
+            (v1 && !(fields >> buckets))) {
+            continue;
+        }
+        if (name.size() >= (size_t)BREAKER_NAME_LEN || hits > runs ||
+            state < BREAKER_CLOSED || state > BREAKER_HALF_OPEN) {
+            continue;
+        }
+        Entry* entry = find(name.c_str(), true);
+        if (entry == nullptr) {
+            break;
+        }
+        entry->costEwmaNs = (double)ewma;
+        entry->runs = runs;
+        entry->hits = hits;
+        entry->overBudgetStreak = streak;
+        entry->trips = trips;
+        entry->state = state;
+        entry->openedAtMs = openedAtMs;
+        restored++;
+    }
+    return restored;
+}
+
+void CheckBreakers::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    count_ = 0;
+}
+
+CheckBreakers& checkBreakers() {
+    static CheckBreakers breakers;
+    return breakers;
+}
+
+}  // namespace device_trust
@@ -0,0 +1,111 @@
+// [DeviceTrust/Core] Check cost model and circuit breakers
+// Per-check cost EWMA, hit counts and breaker state, keyed by check id. Used
+// by the hook stage planners to order and demote checks. Latency
+// distributions live in the telemetry store (see telemetry.h); this store
+// only keeps what the planner needs and what is persisted across launches.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "telemetry.h"
+
+namespace device_trust {
+
+/**
+ * Breaker: BREAKER_TRIP_STREAK consecutive over-budget runs open it (the
+ * check is demoted to DEEP). After a cooldown that doubles per trip it goes
+ * half-open; the next run is a probe that closes or re-opens it.
+ */
+enum BreakerState {
+    BREAKER_CLOSED = 0,
+    BREAKER_OPEN = 1,
+    BREAKER_HALF_OPEN = 2
+};
+
+static const int BREAKER_MAX_CHECKS = 64;
+static const int BREAKER_NAME_LEN = 32;
+static const double BREAKER_EWMA_ALPHA = 0.2;
+
+static const uint32_t BREAKER_TRIP_STREAK = 3;
+static const int64_t BREAKER_BASE_COOLDOWN_MS = 10LL * 60 * 1000;
+static const uint32_t BREAKER_MAX_BACKOFF_SHIFT = 6;
+
+/**
+ * Mutex-guarded table of at most BREAKER_MAX_CHECKS checks; checks past
+ * that stay closed and unmeasured. Times are wall-clock ms, so open
+ * breakers survive an export/import across launches.
+ */
+class CheckBreakers {
+public:
+    CheckBreakers() = default;
+    CheckBreakers(const CheckBreakers&) = delete;
+    CheckBreakers& operator=(const CheckBreakers&) = delete;
+
+    /**
+     * Breaker state for the next run of [check]; moves OPEN to HALF_OPEN
+     * once the cooldown has elapsed
+     */
+    int admit(const char* check, int64_t nowMs);
+
+    void record(const char* check, double elapsedNs, bool hit, bool overBudget, int64_t nowMs);
+
+    /**
+     * Expected cost per hit: cost EWMA / Laplace-smoothed hit rate
+     * ([priorNs] until the check has been measured)
+     */
+    double score(const char* check, double priorNs);
+
+    /**
+     * Checks whose breaker is not closed, as a JSON array of
+     * {id, state, trips, ewmaMs, p99Ms}; p99Ms comes from [latency]
+     * (0 for checks it has no calls of)
+     */
+    std::string demotedJson(const TelemetrySnapshot& latency);
+
+    /**
+     * Text export, one check per line:
+     *   v2
+     *   name ewmaNs runs hits streak trips state openedAtMs
+     */
+    std::string exportText();
+
+    /**
+     * Restores an export; malformed lines are ignored. v1 exports (which
+     * carried a latency histogram per line) are accepted without it.
+     *
+     * @return number of checks restored
+     */
+    int importText(const std::string& text);
+
+    // Forgets every check (tests)
+    void reset();
+
+private:
+    struct Entry {
+        char name[BREAKER_NAME_LEN];
+        double costEwmaNs;
+        uint32_t runs;
+        uint32_t hits;
+        uint32_t overBudgetStreak;
+        uint32_t trips;
+        int state;
+        int64_t openedAtMs;
+    };
+
+    // Caller holds mutex_; nullptr if absent (or the table is full)
+    Entry* find(const char* check, bool create);
+
+    std::mutex mutex_;
+    Entry entries_[BREAKER_MAX_CHECKS];
+    int count_ = 0;
+};
+
+/**
+ * Breakers shared by the native stages and the platform layers
+ */
+CheckBreakers& checkBreakers();
+
+}  // namespace device_trust
@@ -0,0 +1,46 @@
+// [DeviceTrust/Core] Scan deadline
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+namespace device_trust {
+
+/**
+ * Latency budget for one scan; loops poll expired()
+ *
+ * Budgets larger than the clock can represent (e.g. INT64_MAX) never expire.
+ * An optional [cancel] flag, set from another thread, expires the deadline
+ * early (cancelled stream or monitor); copies handed to pool workers share it.
+ */
+struct Deadline {
+    std::chrono::steady_clock::time_point end;
+    const std::atomic<bool>* cancel;
+    bool hit = false;
+
+    explicit Deadline(long long budgetNs, const std::atomic<bool>* cancel = nullptr) : cancel(cancel) {
+        auto now = std::chrono::steady_clock::now();
+        auto budget = std::chrono::nanoseconds(budgetNs > 0 ? budgetNs : 0);
+        auto headroom = std::chrono::steady_clock::time_point::max() - now;
+        end = budget >= headroom
+            ? std::chrono::steady_clock::time_point::max()
+            : now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(budget);
+    }
+
+    bool expired() {
+        if (!hit && (cancelled() || std::chrono::steady_clock::now() >= end)) {
+            hit = true;
+        }
+        return hit;
+    }
+
+    bool cancelled() const {
+        return cancel != nullptr && cancel->load(std::memory_order_relaxed);
+    }
+};
+
+// How often (in lines / entries) scan loops poll the deadline
+static const int DEADLINE_POLL_INTERVAL = 64;
+
+}  // namespace device_trust
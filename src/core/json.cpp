@@ -0,0 +1,81 @@
+// [DeviceTrust/Core] JSON helpers
+
+#include "json.h"
+
+namespace device_trust {
+
+void appendJsonEscaped(std::string& out, const char* str, size_t length) {
+    static const char HEX[] = "0123456789abcdef";
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = static_cast<unsigned char>(str[i]);
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (c < 0x20) {
+                    out += "\\u00";
+                    out += HEX[c >> 4];
+                    out += HEX[c & 0xF];
+                } else {
+                    out += static_cast<char>(c);
+                }
+        }
+    }
+}
+
+std::string escapeJsonString(const std::string& str) {
+    std::string escaped;
+    escaped.reserve(str.size());
+    appendJsonEscaped(escaped, str.data(), str.size());
+    return escaped;
+}
+
+std::string escapeJsonString(StringRef str) {
+    std::string escaped;
+    escaped.reserve(str.length);
+    appendJsonEscaped(escaped, str.data, str.length);
+    return escaped;
+}
+
+std::string vectorToJsonArray(const std::vector<std::string>& vec) {
+    std::string json = "[";
+    for (size_t i = 0; i < vec.size(); i++) {
+        if (i > 0) {
+            json += ",";
+        }
+        json += "\"";
+        appendJsonEscaped(json, vec[i].data(), vec[i].size());
+        json += "\"";
+    }
+    json += "]";
+    return json;
+}
+
+std::string vectorToJsonArray(const StringList& list) {
+    std::string json = "[";
+    for (size_t i = 0; i < list.size(); i++) {
+        if (i > 0) {
+            json += ",";
+        }
+        json += "\"";
+        appendJsonEscaped(json, list[i].data, list[i].length);
+        json += "\"";
+    }
+    json += "]";
+    return json;
+}
+
+}  // namespace device_trust
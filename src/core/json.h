@@ -0,0 +1,32 @@
+// [DeviceTrust/Core] JSON helpers
+// Native results are built by hand; these keep the escaping in one place.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "arena.h"
+
+namespace device_trust {
+
+/**
+ * Appends [str] escaped for use inside a JSON string literal (no quotes)
+ *
+ * Escapes '"', '\\' and control characters; other bytes (including UTF-8
+ * sequences) are copied as-is.
+ */
+void appendJsonEscaped(std::string& out, const char* str, size_t length);
+
+std::string escapeJsonString(const std::string& str);
+
+std::string escapeJsonString(StringRef str);
+
+/**
+ * ["a","b",...] with every element escaped
+ */
+std::string vectorToJsonArray(const std::vector<std::string>& vec);
+
+std::string vectorToJsonArray(const StringList& list);
+
+}  // namespace device_trust
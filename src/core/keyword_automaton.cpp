@@ -0,0 +1,114 @@
+// [DeviceTrust/Core] Keyword automaton
+
+#include "keyword_automaton.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "keywords.h"
+
+namespace device_trust {
+
+namespace {
+
+inline uint8_t asciiLowerByte(uint8_t c) {
+    return (c >= 'A' && c <= 'Z') ? (uint8_t)(c - 'A' + 'a') : c;
+}
+
+// State ids are uint16_t, with UINT16_MAX reserved
+const size_t MAX_STATES = 65535;
+
+}  // namespace
+
+KeywordAutomatonTables::KeywordAutomatonTables(const char* const* keywords) {
+    if (keywords == nullptr) {
+        return;
+    }
+    size_t classes = 1;
+    size_t total = 1;
+    for (size_t i = 0; keywords[i] != nullptr; i++) {
+        frida_.push_back(isFridaKeyword(keywords[i]) ? 1 : 0);
+        for (const char* c = keywords[i]; *c != '\0'; c++) {
+            uint8_t byte = asciiLowerByte((uint8_t)*c);
+            if (classOf_[byte] == 0) {
+                classOf_[byte] = (uint8_t)classes++;
+            }
+        }
+        total += strlen(keywords[i]);
+    }
+    // Both cases of a letter share its class
+    for (int c = 'A'; c <= 'Z'; c++) {
+        classOf_[c] = classOf_[c - 'A' + 'a'];
+    }
+    if (classes > 255 || total > MAX_STATES) {
+        return;  // never matches; lists are a few dozen short keywords
+    }
+
+    // Trie; 0 in next_ means "no edge" until failure links are folded in
+    next_.assign(total * classes, 0);
+    match_.assign(total, KeywordAutomaton::NO_MATCH);
+    size_t states = 1;
+    for (size_t i = 0; keywords[i] != nullptr; i++) {
+        if (keywords[i][0] == '\0') {
+            continue;
+        }
+        size_t state = 0;
+        for (const char* c = keywords[i]; *c != '\0'; c++) {
+            uint16_t& edge = next_[state * classes + classOf_[(uint8_t)*c]];
+            if (edge == 0) {
+                edge = (uint16_t)states++;
+            }
+            state = edge;
+        }
+        match_[state] = std::min<uint16_t>(match_[state], (uint16_t)i);
+    }
+    next_.resize(states * classes);
+    match_.resize(states);
+
+    // Breadth-first: missing edges take the failure state's edge, and each
+    // state inherits the best match of its failure state
+    std::vector<uint16_t> fail(states, 0);
+    std::vector<uint16_t> queue;
+    queue.reserve(states);
+    for (size_t c = 1; c < classes; c++) {
+        if (next_[c] != 0) {
+            queue.push_back(next_[c]);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); head++) {
+        uint16_t state = queue[head];
+        match_[state] = std::min(match_[state], match_[fail[state]]);
+        for (size_t c = 1; c < classes; c++) {
+            uint16_t& edge = next_[state * classes + c];
+            uint16_t fallback = next_[fail[state] * classes + c];
+            if (edge != 0) {
+                fail[edge] = fallback;
+                queue.push_back(edge);
+            } else {
+                edge = fallback;
+            }
+        }
+    }
+    automaton_ = KeywordAutomaton(frida_.data(), classOf_, (uint16_t)classes, (uint16_t)states, next_.data(),
+                                  match_.data());
+}
+
+int KeywordAutomaton::find(const char* text, size_t length) const {
+    if (text == nullptr || states_ <= 1) {
+        return -1;
+    }
+    uint16_t best = NO_MATCH;
+    size_t state = 0;
+    for (size_t i = 0; i < length; i++) {
+        state = next_[state * classes_ + classOf_[(uint8_t)text[i]]];
+        if (match_[state] < best) {
+            best = match_[state];
+            if (best == 0) {
+                break;
+            }
+        }
+    }
+    return best == NO_MATCH ? -1 : best;
+}
+
+}  // namespace device_trust
@@ -0,0 +1,115 @@
+// [DeviceTrust/Core] Keyword automaton
+// Aho-Corasick over a keyword list, so a path is matched against every
+// keyword in one pass instead of one pass per keyword.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace device_trust {
+
+/**
+ * Compiled, case-insensitive keyword set
+ *
+ * Same contract as findKeyword: keywords are lowercase, input is folded to
+ * ASCII lowercase, and the keyword listed first wins when several occur.
+ * A view over transition tables it does not own: the built-in ones are
+ * generated constexpr tables (keywords.h), others are built at runtime by
+ * KeywordAutomatonTables. The tables hold no keyword text. find() is
+ * allocation-free and thread-safe.
+ */
+class KeywordAutomaton {
+public:
+    static constexpr uint16_t NO_MATCH = UINT16_MAX;
+
+    // Never matches
+    constexpr KeywordAutomaton() = default;
+
+    /**
+     * @param frida    per keyword: 1 if isFridaKeyword
+     * @param classOf  256 entries: byte -> alphabet class, 0 for bytes in no keyword
+     * @param next     states x classes transitions, failure links folded in
+     * @param match    per state: lowest keyword index ending here, or NO_MATCH
+     */
+    constexpr KeywordAutomaton(const uint8_t* frida, const uint8_t* classOf, uint16_t classes, uint16_t states,
+                               const uint16_t* next, const uint16_t* match)
+        : frida_(frida), classOf_(classOf), classes_(classes), states_(states), next_(next), match_(match) {}
+
+    /**
+     * First keyword (in list order) contained in text[0, length)
+     *
+     * @return its index in the keyword list, or -1
+     */
+    int find(const char* text, size_t length) const;
+
+    /**
+     * Whether keyword [index] names Frida itself (see isFridaKeyword)
+     */
+    bool isFrida(int index) const {
+        return frida_[index] != 0;
+    }
+
+    size_t classes() const {
+        return classes_;
+    }
+
+    size_t states() const {
+        return states_;
+    }
+
+    // Tables, for the signature table generator
+    const uint8_t* frida() const {
+        return frida_;
+    }
+
+    const uint8_t* classOf() const {
+        return classOf_;
+    }
+
+    const uint16_t* next() const {
+        return next_;
+    }
+
+    const uint16_t* match() const {
+        return match_;
+    }
+
+private:
+    const uint8_t* frida_ = nullptr;
+    const uint8_t* classOf_ = nullptr;
+    uint16_t classes_ = 0;
+    uint16_t states_ = 0;
+    const uint16_t* next_ = nullptr;
+    const uint16_t* match_ = nullptr;
+};
+
+/**
+ * Tables of a keyword list compiled at runtime (signature packs, tools)
+ *
+ * Not copyable: automaton() points into this object.
+ */
+class KeywordAutomatonTables {
+public:
+    /**
+     * @param keywords nullptr-terminated, lowercase
+     */
+    explicit KeywordAutomatonTables(const char* const* keywords);
+
+    KeywordAutomatonTables(const KeywordAutomatonTables&) = delete;
+    KeywordAutomatonTables& operator=(const KeywordAutomatonTables&) = delete;
+
+    const KeywordAutomaton& automaton() const {
+        return automaton_;
+    }
+
+private:
+    std::vector<uint8_t> frida_;
+    uint8_t classOf_[256] = {};
+    std::vector<uint16_t> next_;
+    std::vector<uint16_t> match_;
+    KeywordAutomaton automaton_;
+};
+
+}  // namespace device_trust
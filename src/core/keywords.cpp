@@ -0,0 +1,82 @@
+// [DeviceTrust/Core] Keyword tables and matching
+
+#include "keywords.h"
+
+#include <cstring>
+
+namespace device_trust {
+
+#include "builtin_signatures.inc"
+
+// Expected: /system/lib64/libc.so, /apex/.../libc.so (or any libc.so on a Linux host)
+const char* const LIBC_IMAGE_FRAGMENTS_LINUX[] = {
+    "/system/lib", "/apex/", "libc.so",
+    nullptr
+};
+
+// Expected: /usr/lib/libSystem*, /usr/lib/system/*
+const char* const LIBC_IMAGE_FRAGMENTS_DARWIN[] = {
+    "/usr/lib/libsystem", "/usr/lib/system/", "/usr/lib/libSystem",
+    nullptr
+};
+
+static inline char asciiLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+static bool containsIgnoreCase(const char* text, size_t length, const char* keyword) {
+    size_t keywordLength = strlen(keyword);
+    if (keywordLength == 0 || keywordLength > length) {
+        return false;
+    }
+    char first = keyword[0];
+    for (size_t i = 0; i + keywordLength <= length; i++) {
+        if (asciiLower(text[i]) != first) {
+            continue;
+        }
+        size_t j = 1;
+        while (j < keywordLength && asciiLower(text[i + j]) == keyword[j]) {
+            j++;
+        }
+        if (j == keywordLength) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* findKeyword(const char* text, size_t length, const char* const* keywords) {
+    if (text == nullptr || keywords == nullptr) {
+        return nullptr;
+    }
+    for (size_t i = 0; keywords[i] != nullptr; i++) {
+        if (containsIgnoreCase(text, length, keywords[i])) {
+            return keywords[i];
+        }
+    }
+    return nullptr;
+}
+
+bool isFridaKeyword(const char* keyword) {
+    static constexpr ObfuscatedString<6> FRIDA("frida", 0x6b2d91f3u);
+    static constexpr ObfuscatedString<4> GUM("gum", 0x1f83c25du);
+    if (keyword == nullptr) {
+        return false;
+    }
+    size_t length = strlen(keyword);
+    return FRIDA.text().containedIn(keyword, length) || GUM.text().containedIn(keyword, length);
+}
+
+bool containsAnyFragment(const char* path, const char* const* fragments) {
+    if (path == nullptr || fragments == nullptr) {
+        return false;
+    }
+    for (size_t i = 0; fragments[i] != nullptr; i++) {
+        if (strstr(path, fragments[i]) != nullptr) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace device_trust
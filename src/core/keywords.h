@@ -0,0 +1,55 @@
+// [DeviceTrust/Core] Keyword tables and matching
+// Lists are nullptr-terminated and lowercase; matching is case-insensitive
+// and allocation-free. The signature lists and their automata are generated
+// from src/signatures/signatures.txt (builtin_signatures.inc) and compiled
+// in encoded form (obfuscated_string.h); SignaturePack::builtin() holds
+// the only decoded copy.
+
+#pragma once
+
+#include <cstddef>
+
+#include "keyword_automaton.h"
+#include "obfuscated_string.h"
+
+namespace device_trust {
+
+// Encoded built-in lists, each ended by an empty ObfuscatedText:
+// hook framework names in /proc/self/maps paths and /proc/self/fd link
+// targets (Android/Linux), injected dylib names in the dyld image list
+// (iOS), and byte signatures of Frida agents / gadgets in code and string
+// tables for PatternSearch over anonymous and memfd memory (case-sensitive)
+extern const ObfuscatedText MODULE_KEYWORDS_ENCODED[];
+extern const ObfuscatedText FD_KEYWORDS_ENCODED[];
+extern const ObfuscatedText IMAGE_KEYWORDS_ENCODED[];
+extern const ObfuscatedText MEMORY_SIGNATURES_ENCODED[];
+
+// Compiled MODULE / FD / IMAGE keyword lists; constant-initialized tables
+extern const KeywordAutomaton MODULE_AUTOMATON_LINUX;
+extern const KeywordAutomaton FD_AUTOMATON_LINUX;
+extern const KeywordAutomaton IMAGE_AUTOMATON_DARWIN;
+
+// Path fragments of the image getpid is expected to resolve to
+// (case-sensitive, any match is expected)
+extern const char* const LIBC_IMAGE_FRAGMENTS_LINUX[];
+extern const char* const LIBC_IMAGE_FRAGMENTS_DARWIN[];
+
+/**
+ * First keyword of [keywords] contained in text[0, length), ignoring ASCII case
+ *
+ * @return the matching keyword, or nullptr
+ */
+const char* findKeyword(const char* text, size_t length, const char* const* keywords);
+
+/**
+ * Whether [keyword] names Frida itself (frida, gum-js, ...) rather than
+ * another hooking framework
+ */
+bool isFridaKeyword(const char* keyword);
+
+/**
+ * Whether [path] contains one of [fragments] (case-sensitive)
+ */
+bool containsAnyFragment(const char* path, const char* const* fragments);
+
+}  // namespace device_trust
@@ -0,0 +1,45 @@
+// [DeviceTrust/Core] Obfuscated strings
+
+#include "obfuscated_string.h"
+
+namespace device_trust {
+
+char* ObfuscatedText::decode(char* out) const {
+    for (size_t i = 0; i < length_; i++) {
+        out[i] = (char)(encoded_[i] ^ obfuscationKey(seed_, i));
+    }
+    out[length_] = '\0';
+    return out;
+}
+
+bool ObfuscatedText::containedIn(const char* text, size_t length) const {
+    if (text == nullptr || length_ == 0 || length_ > length) {
+        return false;
+    }
+    // Same loop as containsIgnoreCase (keywords.cpp), with each input byte
+    // encoded at its position instead of the keyword decoded
+    uint8_t first = encoded_[0];
+    uint8_t firstKey = obfuscationKey(seed_, 0);
+    for (size_t i = 0; i + length_ <= length; i++) {
+        uint8_t c = (uint8_t)text[i];
+        c = (c >= 'A' && c <= 'Z') ? (uint8_t)(c - 'A' + 'a') : c;
+        if ((uint8_t)(c ^ firstKey) != first) {
+            continue;
+        }
+        size_t j = 1;
+        while (j < length_) {
+            c = (uint8_t)text[i + j];
+            c = (c >= 'A' && c <= 'Z') ? (uint8_t)(c - 'A' + 'a') : c;
+            if ((uint8_t)(c ^ obfuscationKey(seed_, j)) != encoded_[j]) {
+                break;
+            }
+            j++;
+        }
+        if (j == length_) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace device_trust
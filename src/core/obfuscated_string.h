@@ -0,0 +1,91 @@
+// [DeviceTrust/Core] Obfuscated strings
+// Detection keywords compiled as XOR-encoded bytes instead of plain .rodata
+// text, so `strings` or a hex editor on the library does not list them.
+// Encoding runs at compile time; uses either match the encoded bytes
+// directly or decode into a caller (stack) buffer.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace device_trust {
+
+/**
+ * Keystream byte [index] of a string encoded with [seed]
+ *
+ * The high bit is always set, so encoded ASCII is neither printable nor NUL.
+ * Not cryptography: it only keeps the keyword list out of the binary's text.
+ */
+constexpr uint8_t obfuscationKey(uint32_t seed, size_t index) {
+    return (uint8_t)((((seed + (uint32_t)index * 0x9E3779B1u) * 0x85EBCA77u) >> 24) | 0x80);
+}
+
+/**
+ * Encoded string, viewed
+ *
+ * Trivially copyable; a default-constructed (empty) text ends generated lists.
+ */
+class ObfuscatedText {
+public:
+    constexpr ObfuscatedText() = default;
+
+    constexpr ObfuscatedText(const uint8_t* encoded, uint16_t length, uint32_t seed)
+        : encoded_(encoded), length_(length), seed_(seed) {}
+
+    size_t size() const {
+        return length_;
+    }
+
+    /**
+     * Writes the plain text and a NUL to out[0, size() + 1)
+     *
+     * @return out
+     */
+    char* decode(char* out) const;
+
+    /**
+     * Whether text[0, length) contains this (lowercase) string, ignoring
+     * ASCII case; compares against the encoded bytes, nothing is decoded
+     */
+    bool containedIn(const char* text, size_t length) const;
+
+private:
+    const uint8_t* encoded_ = nullptr;
+    uint16_t length_ = 0;
+    uint32_t seed_ = 0;
+};
+
+/**
+ * Compile-time encoded string literal
+ *
+ *     static constexpr ObfuscatedString<6> FRIDA("frida", 0x2f1c9a4bu);
+ *     FRIDA.text().containedIn(path, length);
+ *
+ * Declare it constexpr: the literal is then only read by the compiler and
+ * the binary holds the encoded bytes alone.
+ */
+template <size_t N>
+class ObfuscatedString {
+public:
+    static_assert(N >= 2 && N <= UINT16_MAX, "non-empty literal");
+
+    constexpr ObfuscatedString(const char (&plain)[N], uint32_t seed) : encoded_(), seed_(seed) {
+        for (size_t i = 0; i + 1 < N; i++) {
+            encoded_[i] = (uint8_t)((uint8_t)plain[i] ^ obfuscationKey(seed, i));
+        }
+    }
+
+    constexpr ObfuscatedText text() const {
+        return ObfuscatedText(encoded_, (uint16_t)(N - 1), seed_);
+    }
+
+    // Stack buffer size for decode()
+    static constexpr size_t BUFFER_SIZE = N;
+
+private:
+    uint8_t encoded_[N - 1];
+    uint32_t seed_;
+};
+
+}  // namespace device_trust
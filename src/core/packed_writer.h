@@ -0,0 +1,65 @@
+// [DeviceTrust/Core] Packed result writer
+// Fixed-layout binary results (Android direct ByteBuffer, dart:ffi struct);
+// the header layout belongs to the caller, this writes fields and string lists.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "arena.h"
+
+namespace device_trust {
+
+/**
+ * Writes into a caller-owned buffer; never allocates
+ *
+ * String lists are u16 count + (u16 length + UTF-8 bytes)*, little-endian
+ * (host order on every supported ABI). A list that does not fit is cut short,
+ * its count covers the items written, and [truncated] is set.
+ */
+struct PackedWriter {
+    uint8_t* buf;
+    size_t capacity;
+    size_t pos = 0;
+    bool truncated = false;
+
+    template <typename T>
+    void putAt(size_t offset, T value) {
+        memcpy(buf + offset, &value, sizeof(T));
+    }
+
+    /**
+     * @return false if the list was cut short
+     */
+    bool putList(const StringRef* items, size_t itemCount) {
+        size_t countPos = pos;
+        if (pos + 2 > capacity) {
+            truncated = true;
+            return false;
+        }
+        pos += 2;
+        uint16_t count = 0;
+        for (size_t i = 0; i < itemCount; i++) {
+            size_t length = std::min(items[i].length, (size_t)UINT16_MAX);
+            if (pos + 2 + length > capacity) {
+                truncated = true;
+                break;
+            }
+            putAt<uint16_t>(pos, (uint16_t)length);
+            memcpy(buf + pos + 2, items[i].data, length);
+            pos += 2 + length;
+            count++;
+        }
+        putAt<uint16_t>(countPos, count);
+        return !truncated;
+    }
+
+    bool putList(const StringList& items) {
+        return putList(items.begin(), items.size());
+    }
+};
+
+}  // namespace device_trust
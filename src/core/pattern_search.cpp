@@ -0,0 +1,119 @@
+// [DeviceTrust/Core] Multi-pattern byte search
+
+#include "pattern_search.h"
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define DEVICE_TRUST_PATTERN_SIMD 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DEVICE_TRUST_PATTERN_SIMD 1
+#endif
+
+namespace device_trust {
+
+namespace {
+
+// Bits per input byte in the candidate masks: movemask yields one, the NEON
+// narrowing shift one nibble
+#if defined(__ARM_NEON) && !defined(__SSE2__)
+const int LANE_BITS = 4;
+#else
+const int LANE_BITS = 1;
+#endif
+const uint64_t LANE_MASK = (1ull << LANE_BITS) - 1;
+const size_t BLOCK = 16;
+
+}  // namespace
+
+PatternSearch::PatternSearch(const char* const* patterns) {
+    for (size_t i = 0; patterns != nullptr && patterns[i] != nullptr && count_ < PATTERN_SEARCH_MAX_PATTERNS; i++) {
+        size_t length = strlen(patterns[i]);
+        if (length < 2) {
+            continue;
+        }
+        patterns_[count_] = patterns[i];
+        lengths_[count_] = length;
+        count_++;
+        if (length > maxLength_) {
+            maxLength_ = length;
+        }
+        if (minLength_ == 0 || length < minLength_) {
+            minLength_ = length;
+        }
+    }
+}
+
+bool PatternSearch::confirm(const uint8_t* data, size_t pos, int pattern) const {
+    // First and last byte already compared
+    return lengths_[pattern] <= 2 ||
+           memcmp(data + pos + 1, patterns_[pattern] + 1, lengths_[pattern] - 2) == 0;
+}
+
+PatternMatch PatternSearch::findScalar(const uint8_t* data, size_t from, size_t length) const {
+    PatternMatch match;
+    for (size_t pos = from; pos + minLength_ <= length; pos++) {
+        for (int p = 0; p < count_; p++) {
+            size_t patternLength = lengths_[p];
+            if (pos + patternLength <= length && data[pos] == (uint8_t)patterns_[p][0] &&
+                data[pos + patternLength - 1] == (uint8_t)patterns_[p][patternLength - 1] && confirm(data, pos, p)) {
+                match.pattern = p;
+                match.offset = pos;
+                return match;
+            }
+        }
+    }
+    return match;
+}
+
+PatternMatch PatternSearch::find(const uint8_t* data, size_t length) const {
+    PatternMatch match;
+    if (count_ == 0 || data == nullptr || length < minLength_) {
+        return match;
+    }
+    size_t pos = 0;
+#ifdef DEVICE_TRUST_PATTERN_SIMD
+    // Both loads of every pattern stay inside the window
+    for (; pos + BLOCK + maxLength_ - 1 <= length; pos += BLOCK) {
+        size_t best = BLOCK;
+        for (int p = 0; p < count_; p++) {
+            const uint8_t* lastBytes = data + pos + lengths_[p] - 1;
+#if defined(__SSE2__)
+            __m128i first = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos)),
+                                           _mm_set1_epi8(patterns_[p][0]));
+            __m128i last = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lastBytes)),
+                                          _mm_set1_epi8(patterns_[p][lengths_[p] - 1]));
+            uint64_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(first, last));
+#else
+            uint8x16_t first = vceqq_u8(vld1q_u8(data + pos), vdupq_n_u8((uint8_t)patterns_[p][0]));
+            uint8x16_t last = vceqq_u8(vld1q_u8(lastBytes), vdupq_n_u8((uint8_t)patterns_[p][lengths_[p] - 1]));
+            // 0xff / 0x00 lanes narrowed to one nibble each
+            uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(vandq_u8(first, last)), 4);
+            uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+#endif
+            while (mask != 0) {
+                int bit = __builtin_ctzll(mask);
+                size_t lane = (size_t)(bit / LANE_BITS);
+                if (lane >= best) {
+                    break;
+                }
+                if (confirm(data, pos + lane, p)) {
+                    best = lane;
+                    match.pattern = p;
+                    break;
+                }
+                mask &= ~(LANE_MASK << (lane * LANE_BITS));
+            }
+        }
+        if (match.pattern >= 0) {
+            match.offset = pos + best;
+            return match;
+        }
+    }
+#endif
+    return findScalar(data, pos, length);
+}
+
+}  // namespace device_trust
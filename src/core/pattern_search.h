@@ -0,0 +1,71 @@
+// [DeviceTrust/Core] Multi-pattern byte search
+// Finds the first of a small set of byte signatures in a memory window,
+// 16 candidate positions per step (SSE2 on x86, NEON on ARM, scalar
+// elsewhere).
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace device_trust {
+
+static const int PATTERN_SEARCH_MAX_PATTERNS = 16;
+
+/**
+ * One hit of PatternSearch::find
+ */
+struct PatternMatch {
+    int pattern = -1;   // index into the pattern list; -1 if none matched
+    size_t offset = 0;  // first byte of the match in the searched window
+};
+
+/**
+ * Compiled pattern set
+ *
+ * Each position is filtered by comparing the first and the last byte of every
+ * pattern against 16 input bytes at once; only positions where both agree are
+ * confirmed with memcmp. Patterns are case-sensitive byte strings of at least
+ * 2 bytes; shorter ones and those past PATTERN_SEARCH_MAX_PATTERNS are
+ * ignored.
+ */
+class PatternSearch {
+public:
+    /**
+     * @param patterns nullptr-terminated list; must outlive the search
+     */
+    explicit PatternSearch(const char* const* patterns);
+
+    /**
+     * Earliest match in data[0, length); ties go to the pattern listed first
+     */
+    PatternMatch find(const uint8_t* data, size_t length) const;
+
+    /**
+     * Windows read in chunks must overlap by maxLength() - 1 bytes so no
+     * match spanning two chunks is missed
+     */
+    size_t maxLength() const {
+        return maxLength_;
+    }
+
+    int count() const {
+        return count_;
+    }
+
+    const char* pattern(int index) const {
+        return patterns_[index];
+    }
+
+private:
+    bool confirm(const uint8_t* data, size_t pos, int pattern) const;
+    PatternMatch findScalar(const uint8_t* data, size_t from, size_t length) const;
+
+    const char* patterns_[PATTERN_SEARCH_MAX_PATTERNS];
+    size_t lengths_[PATTERN_SEARCH_MAX_PATTERNS];
+    int count_ = 0;
+    size_t maxLength_ = 0;
+    size_t minLength_ = 0;
+};
+
+}  // namespace device_trust
@@ -0,0 +1,112 @@
+// [DeviceTrust/Core] Hardware performance counters
+
+#include "perf_counters.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace device_trust {
+
+const char* const PERF_COUNTER_NAMES[PERF_COUNTER_COUNT] = {"cycles", "instructions", "cacheMisses",
+                                                            "pageFaults"};
+
+#if defined(__linux__)
+
+namespace {
+
+struct PerfEventSpec {
+    uint32_t type;
+    uint64_t config;
+};
+
+const PerfEventSpec PERF_EVENTS[PERF_COUNTER_COUNT] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+};
+
+int openEvent(const PerfEventSpec& spec, int groupFd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.disabled = groupFd < 0;  // members follow their leader
+    attr.exclude_kernel = 1;      // allowed up to perf_event_paranoid 2
+    attr.exclude_hv = 1;
+    // pid 0, cpu -1: the calling thread on any CPU
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC);
+}
+
+}  // namespace
+
+PerfCounters::PerfCounters() {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        fds_[i] = openEvent(PERF_EVENTS[i], leader_);
+        if (fds_[i] < 0) {
+            continue;
+        }
+        if (leader_ < 0) {
+            leader_ = fds_[i];
+        }
+        valid_ |= 1u << i;
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+void PerfCounters::start() {
+    if (leader_ < 0) {
+        return;
+    }
+    ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void PerfCounters::stop(PerfSample* out) {
+    *out = PerfSample();
+    if (leader_ < 0) {
+        return;
+    }
+    ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        uint64_t value;
+        if (fds_[i] >= 0 && read(fds_[i], &value, sizeof(value)) == (ssize_t)sizeof(value)) {
+            out->values[i] = value;
+            out->valid |= 1u << i;
+        }
+    }
+}
+
+#else
+
+PerfCounters::PerfCounters() {
+    for (int& fd : fds_) {
+        fd = -1;
+    }
+}
+
+PerfCounters::~PerfCounters() {}
+
+void PerfCounters::start() {}
+
+void PerfCounters::stop(PerfSample* out) {
+    *out = PerfSample();
+}
+
+#endif
+
+}  // namespace device_trust
@@ -0,0 +1,65 @@
+// [DeviceTrust/Core] Hardware performance counters
+// Optional perf_event_open counters (cycles, instructions, cache misses,
+// page faults) around a code region, so regressions can be attributed to
+// micro-architectural costs instead of noisy wall-clock time.
+
+#pragma once
+
+#include <cstdint>
+
+namespace device_trust {
+
+enum PerfCounter {
+    PERF_CYCLES = 0,
+    PERF_INSTRUCTIONS = 1,
+    PERF_CACHE_MISSES = 2,
+    PERF_PAGE_FAULTS = 3,
+    PERF_COUNTER_COUNT
+};
+
+// JSON / benchmark counter names, indexed by PerfCounter
+extern const char* const PERF_COUNTER_NAMES[PERF_COUNTER_COUNT];
+
+/**
+ * Counter values of one measured region
+ */
+struct PerfSample {
+    uint32_t valid = 0;  // bit per PerfCounter that could be opened
+    uint64_t values[PERF_COUNTER_COUNT] = {};
+
+    bool has(PerfCounter counter) const { return (valid & (1u << counter)) != 0; }
+};
+
+/**
+ * Counters of the calling thread, user space only
+ *
+ * Opened once per instance as one perf event group so a region costs three
+ * ioctls and one read per counter. Each counter is optional: hardware
+ * events are missing in most VMs and CI containers, and perf_event_paranoid
+ * or the Android SELinux policy may deny all of them (production app
+ * processes usually are). Without perf_event_open (iOS, macOS) nothing is
+ * available. Not thread-safe; use one instance per thread.
+ */
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // At least one counter was opened
+    bool available() const { return valid_ != 0; }
+
+    // Zeroes and enables the counters
+    void start();
+
+    // Disables the counters and reads them into [out]; out->valid is 0 if unavailable
+    void stop(PerfSample* out);
+
+private:
+    int fds_[PERF_COUNTER_COUNT];
+    int leader_ = -1;
+    uint32_t valid_ = 0;
+};
+
+}  // namespace device_trust
@@ -0,0 +1,90 @@
+// [DeviceTrust/Core] Platform backend interface
+// Scanners in scanners.h only see the process through this interface:
+// procfs on Android/Linux (platform/procfs_backend.h), Mach/dyld on iOS
+// (platform/mach_backend.h), or a fixture in tests and benchmarks.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace device_trust {
+
+/**
+ * One mapped memory region
+ *
+ * [path] points into the backend's buffer and is only valid during the
+ * visit call; it is not NUL-terminated (use pathLength). Anonymous regions
+ * have pathLength 0.
+ */
+struct MemoryRegion {
+    uintptr_t start = 0;
+    uintptr_t end = 0;
+    bool read = false;
+    bool write = false;
+    bool exec = false;
+    const char* path = nullptr;
+    size_t pathLength = 0;
+};
+
+// Visitors return false to stop the iteration early
+typedef bool (*RegionVisitor)(const MemoryRegion& region, void* context);
+typedef bool (*PathVisitor)(const char* path, size_t length, void* context);
+
+class PlatformBackend {
+public:
+    virtual ~PlatformBackend() = default;
+
+    /**
+     * Visits the mapped regions of the process in address order
+     *
+     * @return false if the source is unavailable on this platform / process
+     */
+    virtual bool forEachRegion(RegionVisitor visit, void* context) = 0;
+
+    /**
+     * Visits the paths of loaded images (shared objects / dylibs)
+     */
+    virtual bool forEachImage(PathVisitor visit, void* context) = 0;
+
+    /**
+     * Visits the targets of open file descriptors
+     */
+    virtual bool forEachOpenFile(PathVisitor visit, void* context) = 0;
+
+    /**
+     * Path of the image containing [address] (dladdr)
+     *
+     * [path] is set to a NUL-terminated string owned by the backend or the
+     * dynamic loader; copy it before the image can be unloaded.
+     *
+     * @return false if the address is not inside a loaded image
+     */
+    virtual bool imagePathForAddress(const void* address, const char** path) = 0;
+
+    /**
+     * Copies up to [size] bytes at [address] of the process into [out]
+     *
+     * Unmapped or unreadable pages end the copy instead of faulting the
+     * caller.
+     *
+     * @return bytes copied; 0 if the backend cannot read process memory
+     *   (the default)
+     */
+    virtual size_t readMemory(uintptr_t /* address */, void* /* out */, size_t /* size */) {
+        return 0;
+    }
+
+    /**
+     * Residency of [pages] pages from the page-aligned [address]: resident[i]
+     * is non-zero if page i is in RAM, so reading it neither faults a page in
+     * nor allocates one
+     *
+     * @return false if unknown (the default); callers then read every page
+     */
+    virtual bool residentPages(uintptr_t /* address */, size_t /* pages */, uint8_t* /* resident */) {
+        return false;
+    }
+};
+
+}  // namespace device_trust
@@ -0,0 +1,571 @@
+// [DeviceTrust/Core] Platform-neutral scanners
+
+#include "scanners.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include "keyword_automaton.h"
+#include "keywords.h"
+#include "pattern_search.h"
+#include "work_pool.h"
+
+namespace device_trust {
+
+namespace {
+
+struct RwxScan {
+    Deadline* deadline;
+    const KeywordAutomaton* keywords;  // nullptr: RWX count only
+    RwxCount result;
+    int stopAfter;
+    int maxRegions;
+    int visited = 0;
+};
+
+bool visitRwx(const MemoryRegion& region, void* context) {
+    RwxScan& scan = *static_cast<RwxScan*>(context);
+    if (++scan.visited > scan.maxRegions) {
+        scan.result.truncated = true;
+        return false;
+    }
+    if (scan.visited % DEADLINE_POLL_INTERVAL == 0 && scan.deadline->expired()) {
+        scan.result.truncated = true;
+        return false;
+    }
+    if (scan.keywords != nullptr && !scan.result.fridaLibLoaded) {
+        int index = scan.keywords->find(region.path, region.pathLength);
+        scan.result.fridaLibLoaded = index >= 0 && scan.keywords->isFrida(index);
+    }
+    if (region.write && region.exec) {
+        scan.result.rwxSegments++;
+        if (scan.stopAfter > 0 && scan.result.rwxSegments >= scan.stopAfter) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Keyword list, or its compiled automaton when the caller has one
+struct KeywordMatch {
+    const char* const* list;
+    const KeywordAutomaton* automaton;
+
+    // Whether text[0, length) contains a keyword; [frida] set if it names Frida
+    bool find(const char* text, size_t length, bool* frida = nullptr) const {
+        if (automaton != nullptr) {
+            int index = automaton->find(text, length);
+            if (index >= 0 && frida != nullptr) {
+                *frida = automaton->isFrida(index);
+            }
+            return index >= 0;
+        }
+        const char* keyword = findKeyword(text, length, list);
+        if (keyword != nullptr && frida != nullptr) {
+            *frida = isFridaKeyword(keyword);
+        }
+        return keyword != nullptr;
+    }
+};
+
+struct RegionScan {
+    Deadline* deadline;
+    ScanArena* arena;
+    InternedSet* modules;
+    KeywordMatch keywords;
+    RegionAnalysis result;
+    int maxRegions;
+    int visited = 0;
+};
+
+bool visitRegion(const MemoryRegion& region, void* context) {
+    RegionScan& scan = *static_cast<RegionScan*>(context);
+    if (++scan.visited > scan.maxRegions) {
+        return false;
+    }
+    if (scan.visited % DEADLINE_POLL_INTERVAL == 0 && scan.deadline->expired()) {
+        scan.result.truncated = true;
+        return false;
+    }
+
+    if (region.write && region.exec) {
+        scan.result.rwxSegments++;
+        scan.result.hasRwx = true;
+    }
+
+    bool frida = false;
+    if (!scan.keywords.find(region.path, region.pathLength, &frida)) {
+        return true;
+    }
+    if (frida) {
+        scan.result.fridaLibLoaded = true;
+    }
+
+    // Module basename, up to the first space (" (deleted)")
+    size_t lastSlash = region.pathLength;
+    for (size_t i = region.pathLength; i > 0; i--) {
+        if (region.path[i - 1] == '/') {
+            lastSlash = i - 1;
+            break;
+        }
+    }
+    if (lastSlash == region.pathLength) {
+        return true;
+    }
+    size_t begin = lastSlash + 1;
+    size_t end = begin;
+    while (end < region.pathLength && region.path[end] != ' ') {
+        end++;
+    }
+    if (end == begin) {
+        return true;
+    }
+
+    bool inserted = false;
+    StringRef module = scan.modules->intern(region.path + begin, end - begin, &inserted);
+    if (inserted) {
+        scan.result.suspiciousModules.push(*scan.arena, module);
+    }
+    return true;
+}
+
+struct ImageScan {
+    Deadline* deadline;
+    ScanArena* arena;
+    KeywordMatch keywords;
+    ImageAnalysis result;
+    size_t maxFound;
+    int visited = 0;
+};
+
+bool visitImage(const char* path, size_t length, void* context) {
+    ImageScan& scan = *static_cast<ImageScan*>(context);
+    if (++scan.visited % DEADLINE_POLL_INTERVAL == 0 && scan.deadline->expired()) {
+        scan.result.truncated = true;
+        return false;
+    }
+    if (scan.keywords.find(path, length)) {
+        scan.result.suspiciousImages.push(*scan.arena, scan.arena->copy(path, length));
+    }
+    return scan.result.suspiciousImages.size() < scan.maxFound;
+}
+
+struct OpenFileScan {
+    Deadline* deadline;
+    KeywordMatch keywords;
+    int maxEntries;
+    OpenFileMatch result;
+};
+
+bool visitOpenFile(const char* path, size_t length, void* context) {
+    OpenFileScan& scan = *static_cast<OpenFileScan*>(context);
+    if (scan.result.visited >= scan.maxEntries) {
+        scan.result.truncated = true;
+        return false;
+    }
+    if (++scan.result.visited % DEADLINE_POLL_INTERVAL == 0 && scan.deadline->expired()) {
+        scan.result.truncated = true;
+        return false;
+    }
+    if (scan.keywords.find(path, length)) {
+        scan.result.found = true;
+        return false;
+    }
+    return true;
+}
+
+bool startsWith(const char* text, size_t length, const char* prefix) {
+    size_t prefixLength = strlen(prefix);
+    return length >= prefixLength && memcmp(text, prefix, prefixLength) == 0;
+}
+
+bool endsWith(const char* text, size_t length, const char* suffix) {
+    size_t suffixLength = strlen(suffix);
+    return length >= suffixLength && memcmp(text + length - suffixLength, suffix, suffixLength) == 0;
+}
+
+// Executable anonymous or deleted-file regions, or memfd regions other than
+// ART's JIT caches
+bool isSignatureCandidate(const MemoryRegion& region) {
+    if (!region.read || region.end <= region.start) {
+        return false;
+    }
+    if (startsWith(region.path, region.pathLength, "/memfd:")) {
+        return !startsWith(region.path, region.pathLength, "/memfd:jit-cache") &&
+               !startsWith(region.path, region.pathLength, "/memfd:jit-zygote-cache");
+    }
+    if (region.pathLength == 0 || startsWith(region.path, region.pathLength, "[anon:") ||
+        endsWith(region.path, region.pathLength, " (deleted)")) {
+        return region.exec;
+    }
+    return false;
+}
+
+struct SignatureCandidate {
+    uintptr_t start;
+    uintptr_t end;
+    StringRef path;
+};
+
+struct CandidateScan {
+    Deadline* deadline;
+    ScanArena* arena;
+    SignatureCandidate* candidates;
+    int maxRegions;
+    MemorySignatureScan* result;
+    int visited = 0;
+};
+
+bool visitCandidate(const MemoryRegion& region, void* context) {
+    CandidateScan& scan = *static_cast<CandidateScan*>(context);
+    if (++scan.visited % DEADLINE_POLL_INTERVAL == 0 && scan.deadline->expired()) {
+        scan.result->truncated = true;
+        return false;
+    }
+    if (!isSignatureCandidate(region)) {
+        return true;
+    }
+    if (scan.result->regions >= scan.maxRegions) {
+        scan.result->truncated = true;
+        return false;
+    }
+    SignatureCandidate& candidate = scan.candidates[scan.result->regions++];
+    candidate.start = region.start;
+    candidate.end = region.end;
+    candidate.path = region.pathLength > 0 ? scan.arena->copy(region.path, region.pathLength) : StringRef();
+    scan.result->candidateBytes += region.end - region.start;
+    return true;
+}
+
+struct MemorySpan {
+    int region;  // index into the candidates
+    uintptr_t from;
+    uintptr_t to;
+};
+
+// Scratch and earliest match of one worker; only that worker writes it
+struct alignas(64) MemoryWorker {
+    uint8_t* buffer;    // MEMORY_SCAN_WINDOW bytes
+    uint8_t* resident;  // one entry per page of a window
+    size_t span;        // earliest matching span; SIZE_MAX if none
+    int pattern;
+    uintptr_t address;
+    bool truncated;
+};
+
+struct MemoryScan {
+    PlatformBackend* backend;
+    const PatternSearch* search;
+    const MemorySpan* spans;
+    MemoryWorker* workers;
+    uintptr_t pageSize;
+    size_t byteBudget;
+    std::atomic<size_t> bytesScanned{0};
+    std::atomic<size_t> firstMatch{SIZE_MAX};  // earliest matching span of any worker
+};
+
+// Takes up to [want] bytes of the shared budget
+size_t reserveBytes(MemoryScan& scan, size_t want) {
+    size_t used = scan.bytesScanned.load(std::memory_order_relaxed);
+    size_t granted;
+    do {
+        granted = std::min(want, scan.byteBudget - used);
+    } while (!scan.bytesScanned.compare_exchange_weak(used, used + granted, std::memory_order_relaxed));
+    return granted;
+}
+
+void releaseBytes(MemoryScan& scan, size_t unused) {
+    if (unused > 0) {
+        scan.bytesScanned.fetch_sub(unused, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Searches span [index] window by window; consecutive windows overlap by
+ * the longest signature minus one byte
+ *
+ * @return false once the scan is over (budget spent or deadline)
+ */
+bool scanSpan(MemoryScan& scan, MemoryWorker& worker, Deadline& deadline, size_t index) {
+    const MemorySpan& span = scan.spans[index];
+    size_t minRead = scan.search->maxLength();
+    uintptr_t pos = span.from;
+    while (pos < span.to) {
+        if (index > scan.firstMatch.load(std::memory_order_relaxed)) {
+            return true;  // an earlier span already matched
+        }
+        if (deadline.expired()) {
+            worker.truncated = true;
+            return false;
+        }
+        size_t want = (size_t)std::min<uintptr_t>(span.to - pos, MEMORY_SCAN_WINDOW);
+        if (want < minRead) {
+            return true;  // a tail no signature fits in, not the end of the scan
+        }
+        size_t granted = reserveBytes(scan, want);
+        if (granted < minRead) {
+            releaseBytes(scan, granted);
+            return false;
+        }
+        uintptr_t windowEnd = pos + granted;
+
+        // Only the run of resident pages from the first resident one
+        uintptr_t pageStart = pos & ~(scan.pageSize - 1);
+        size_t pages = (size_t)((windowEnd - pageStart + scan.pageSize - 1) / scan.pageSize);
+        if (scan.backend->residentPages(pageStart, pages, worker.resident)) {
+            size_t first = 0;
+            while (first < pages && !(worker.resident[first] & 1)) {
+                first++;
+            }
+            if (first == pages) {
+                releaseBytes(scan, granted);
+                pos = pageStart + pages * scan.pageSize;
+                continue;
+            }
+            size_t last = first;
+            while (last < pages && (worker.resident[last] & 1)) {
+                last++;
+            }
+            pos = std::max<uintptr_t>(pos, pageStart + first * scan.pageSize);
+            windowEnd = std::min<uintptr_t>(windowEnd, pageStart + last * scan.pageSize);
+        }
+
+        size_t copied = scan.backend->readMemory(pos, worker.buffer, (size_t)(windowEnd - pos));
+        releaseBytes(scan, granted - copied);
+        if (copied < minRead) {
+            pos = (pos & ~(scan.pageSize - 1)) + scan.pageSize;  // unreadable page
+            continue;
+        }
+        PatternMatch match = scan.search->find(worker.buffer, copied);
+        if (match.pattern >= 0) {
+            if (index < worker.span) {
+                worker.span = index;
+                worker.pattern = match.pattern;
+                worker.address = pos + match.offset;
+            }
+            size_t first = scan.firstMatch.load(std::memory_order_relaxed);
+            while (index < first &&
+                   !scan.firstMatch.compare_exchange_weak(first, index, std::memory_order_relaxed)) {
+            }
+            return true;
+        }
+        if (pos + copied >= span.to) {
+            break;
+        }
+        pos += copied - (minRead - 1);
+    }
+    return true;
+}
+
+bool scanSpans(size_t begin, size_t end, int worker, Deadline& deadline, void* context) {
+    MemoryScan& scan = *static_cast<MemoryScan*>(context);
+    for (size_t index = begin; index < end; index++) {
+        if (!scanSpan(scan, scan.workers[worker], deadline, index)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+RwxCount countRwxRegions(PlatformBackend& backend, Deadline& deadline, int stopAfter, int maxRegions) {
+    RwxScan scan{&deadline, nullptr, RwxCount(), stopAfter, maxRegions};
+    backend.forEachRegion(visitRwx, &scan);
+    scan.result.visited = std::min(scan.visited, maxRegions);
+    return scan.result;
+}
+
+RwxCount countRwxRegions(PlatformBackend& backend, Deadline& deadline, const KeywordAutomaton& keywords,
+                         int maxRegions) {
+    RwxScan scan{&deadline, &keywords, RwxCount(), 0, maxRegions};
+    backend.forEachRegion(visitRwx, &scan);
+    scan.result.visited = std::min(scan.visited, maxRegions);
+    return scan.result;
+}
+
+namespace {
+
+RegionAnalysis analyzeRegionsWith(PlatformBackend& backend, Deadline& deadline, ScanArena& arena,
+                                  KeywordMatch keywords, int maxRegions) {
+    InternedSet modules(arena);
+    RegionScan scan{&deadline, &arena, &modules, keywords, RegionAnalysis(), maxRegions};
+    backend.forEachRegion(visitRegion, &scan);
+    scan.result.visited = std::min(scan.visited, maxRegions);
+    return scan.result;
+}
+
+ImageAnalysis analyzeImagesWith(PlatformBackend& backend, Deadline& deadline, ScanArena& arena,
+                                KeywordMatch keywords, size_t maxFound) {
+    ImageScan scan{&deadline, &arena, keywords, ImageAnalysis(), maxFound};
+    if (maxFound > 0) {
+        backend.forEachImage(visitImage, &scan);
+    }
+    scan.result.visited = scan.visited;
+    return scan.result;
+}
+
+OpenFileMatch scanOpenFilesWith(PlatformBackend& backend, Deadline& deadline, KeywordMatch keywords,
+                                int maxEntries) {
+    OpenFileScan scan{&deadline, keywords, maxEntries, OpenFileMatch()};
+    backend.forEachOpenFile(visitOpenFile, &scan);
+    return scan.result;
+}
+
+}  // namespace
+
+RegionAnalysis analyzeRegions(PlatformBackend& backend, Deadline& deadline, ScanArena& arena,
+                              const char* const* keywords, int maxRegions) {
+    return analyzeRegionsWith(backend, deadline, arena, KeywordMatch{keywords, nullptr}, maxRegions);
+}
+
+RegionAnalysis analyzeRegions(PlatformBackend& backend, Deadline& deadline, ScanArena& arena,
+                              const KeywordAutomaton& keywords, int maxRegions) {
+    return analyzeRegionsWith(backend, deadline, arena, KeywordMatch{nullptr, &keywords}, maxRegions);
+}
+
+ImageAnalysis analyzeImages(PlatformBackend& backend, Deadline& deadline, ScanArena& arena,
+                            const char* const* keywords, size_t maxFound) {
+    return analyzeImagesWith(backend, deadline, arena, KeywordMatch{keywords, nullptr}, maxFound);
+}
+
+ImageAnalysis analyzeImages(PlatformBackend& backend, Deadline& deadline, ScanArena& arena,
+                            const KeywordAutomaton& keywords, size_t maxFound) {
+    return analyzeImagesWith(backend, deadline, arena, KeywordMatch{nullptr, &keywords}, maxFound);
+}
+
+OpenFileMatch scanOpenFiles(PlatformBackend& backend, Deadline& deadline, const char* const* keywords,
+                            int maxEntries) {
+    return scanOpenFilesWith(backend, deadline, KeywordMatch{keywords, nullptr}, maxEntries);
+}
+
+OpenFileMatch scanOpenFiles(PlatformBackend& backend, Deadline& deadline, const KeywordAutomaton& keywords,
+                            int maxEntries) {
+    return scanOpenFilesWith(backend, deadline, KeywordMatch{nullptr, &keywords}, maxEntries);
+}
+
+bool openFilesMatch(PlatformBackend& backend, Deadline& deadline, const char* const* keywords, int maxEntries) {
+    return scanOpenFiles(backend, deadline, keywords, maxEntries).found;
+}
+
+SymbolImageCheck checkSymbolImage(PlatformBackend& backend, ScanArena& arena, const void* symbol,
+                                  const char* const* expectedFragments) {
+    SymbolImageCheck result;
+    const char* path = nullptr;
+    if (backend.imagePathForAddress(symbol, &path) && path != nullptr && path[0] != '\0') {
+        result.imagePath = arena.copy(path, strlen(path));
+        result.unexpected = !containsAnyFragment(result.imagePath.data, expectedFragments);
+    }
+    return result;
+}
+
+MemorySignatureScan scanMemorySignatures(PlatformBackend& backend, Deadline& deadline, ScanArena& arena,
+                                         const char* const* signatures, size_t byteBudget, uint32_t sampleSeed,
+                                         int maxRegions, WorkPool* pool) {
+    MemorySignatureScan result;
+    PatternSearch search(signatures);
+    if (search.count() == 0 || maxRegions <= 0 || byteBudget < search.maxLength()) {
+        return result;
+    }
+    SignatureCandidate* candidates = arena.allocateArray<SignatureCandidate>((size_t)maxRegions);
+    CandidateScan collect{&deadline, &arena, candidates, maxRegions, &result};
+    backend.forEachRegion(visitCandidate, &collect);
+    if (result.regions == 0 || deadline.hit) {
+        return result;  // over the region cap, the kept candidates are still searched
+    }
+
+    uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+    if (pageSize == 0 || (pageSize & (pageSize - 1)) != 0) {
+        pageSize = 4096;
+    }
+
+    // Spans of at most one window each, in address order per region, so
+    // workers can split them and the earliest match still wins
+    MemorySpan* spans;
+    size_t spanCount = 0;
+    if (result.candidateBytes <= byteBudget) {
+        size_t step = MEMORY_SCAN_WINDOW - (search.maxLength() - 1);
+        spans = arena.allocateArray<MemorySpan>((size_t)result.regions + result.candidateBytes / step + 1);
+        for (int i = 0; i < result.regions; i++) {
+            for (uintptr_t from = candidates[i].start;; from += step) {
+                uintptr_t to = std::min<uintptr_t>(candidates[i].end, from + MEMORY_SCAN_WINDOW);
+                spans[spanCount++] = MemorySpan{i, from, to};
+                if (to == candidates[i].end) {
+                    break;
+                }
+            }
+        }
+    } else {
+        // Windows every [stride] bytes across the candidates laid end to end,
+        // the first one [phase] bytes in
+        result.sampled = true;
+        size_t windows = std::max<size_t>(1, byteBudget / MEMORY_SCAN_WINDOW);
+        size_t stride = result.candidateBytes / windows;
+        size_t phase = stride > MEMORY_SCAN_WINDOW
+            ? (size_t)((sampleSeed * 2654435761u) % (stride - MEMORY_SCAN_WINDOW + 1)) & ~(size_t)(pageSize - 1)
+            : 0;
+        spans = arena.allocateArray<MemorySpan>(windows);
+        int region = 0;
+        size_t regionOffset = 0;  // candidate bytes before [region]
+        for (size_t window = 0; window < windows; window++) {
+            size_t offset = phase + window * stride;
+            while (region < result.regions &&
+                   offset >= regionOffset + (candidates[region].end - candidates[region].start)) {
+                regionOffset += candidates[region].end - candidates[region].start;
+                region++;
+            }
+            if (region == result.regions) {
+                break;
+            }
+            uintptr_t from = candidates[region].start + (offset - regionOffset);
+            spans[spanCount++] =
+                MemorySpan{region, from, std::min<uintptr_t>(candidates[region].end, from + MEMORY_SCAN_WINDOW)};
+        }
+    }
+
+    int workerCount = pool != nullptr ? pool->workers() : 1;
+    MemoryWorker* workers = arena.allocateArray<MemoryWorker>((size_t)workerCount);
+    for (int i = 0; i < workerCount; i++) {
+        workers[i] = MemoryWorker{arena.allocateArray<uint8_t>(MEMORY_SCAN_WINDOW),
+                                  arena.allocateArray<uint8_t>(MEMORY_SCAN_WINDOW / pageSize + 2),
+                                  SIZE_MAX,
+                                  -1,
+                                  0,
+                                  false};
+    }
+    // Every candidate fits: only window overlaps are read twice, and capping
+    // them would make the result depend on which worker ran first
+    MemoryScan scan{&backend, &search, spans, workers, pageSize, result.sampled ? byteBudget : SIZE_MAX};
+    if (pool != nullptr) {
+        pool->run(spanCount, 1, scanSpans, &scan, deadline);
+    } else {
+        scanSpans(0, spanCount, 0, deadline, &scan);
+    }
+
+    // Merge: the earliest span any worker matched
+    result.bytesScanned = scan.bytesScanned.load(std::memory_order_relaxed);
+    const MemoryWorker* best = nullptr;
+    for (int i = 0; i < workerCount; i++) {
+        result.truncated = result.truncated || workers[i].truncated;
+        if (workers[i].span != SIZE_MAX && (best == nullptr || workers[i].span < best->span)) {
+            best = &workers[i];
+        }
+    }
+    result.truncated = result.truncated || deadline.hit;
+    if (best != nullptr) {
+        const SignatureCandidate& region = candidates[spans[best->span].region];
+        result.found = true;
+        result.signature = search.pattern(best->pattern);
+        result.regionStart = region.start;
+        result.regionEnd = region.end;
+        result.regionPath = region.path;
+        result.address = best->address;
+    }
+    return result;
+}
+
+}  // namespace device_trust
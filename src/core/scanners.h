@@ -0,0 +1,157 @@
+// [DeviceTrust/Core] Platform-neutral scanners
+// Hook/injection heuristics shared by the Android JNI and iOS ObjC++ shims.
+
+#pragma once
+
+#include "arena.h"
+#include "deadline.h"
+#include "platform.h"
+
+namespace device_trust {
+
+class KeywordAutomaton;
+class WorkPool;
+
+/**
+ * Writable + executable region count
+ */
+struct RwxCount {
+    int rwxSegments = 0;
+    bool fridaLibLoaded = false;  // a region path names Frida (keyword overload only)
+    int visited = 0;              // regions visited
+    bool truncated = false;       // deadline or region cap hit before the end
+};
+
+/**
+ * @param stopAfter   stop once this many RWX regions were seen (0 = count all)
+ * @param maxRegions  performance guardrail on regions visited
+ */
+RwxCount countRwxRegions(PlatformBackend& backend, Deadline& deadline, int stopAfter = 0,
+                         int maxRegions = 100000);
+
+/**
+ * Same count, also matching region paths against [keywords] in the same
+ * pass; only Frida keywords set fridaLibLoaded. Collects no module names,
+ * so it allocates nothing (FAST hook tier).
+ */
+RwxCount countRwxRegions(PlatformBackend& backend, Deadline& deadline, const KeywordAutomaton& keywords,
+                         int maxRegions = 100000);
+
+/**
+ * RWX regions plus hook framework keywords in region paths
+ *
+ * Strings in the results below live in the ScanArena passed to the scanner
+ * and are valid until that arena is reset.
+ */
+struct RegionAnalysis {
+    int rwxSegments = 0;
+    bool hasRwx = false;
+    bool fridaLibLoaded = false;
+    bool truncated = false;
+    int visited = 0;               // maps lines visited
+    StringList suspiciousModules;  // unique basenames of matching paths
+};
+
+RegionAnalysis analyzeRegions(PlatformBackend& backend, Deadline& deadline, ScanArena& arena,
+                              const char* const* keywords, int maxRegions = 10000);
+
+// Same, matching with a compiled keyword set (e.g. from a SignaturePack)
+RegionAnalysis analyzeRegions(PlatformBackend& backend, Deadline& deadline, ScanArena& arena,
+                              const KeywordAutomaton& keywords, int maxRegions = 10000);
+
+/**
+ * Loaded images whose path contains one of [keywords] (full paths)
+ */
+struct ImageAnalysis {
+    StringList suspiciousImages;
+    bool truncated = false;
+    int visited = 0;  // images visited
+};
+
+ImageAnalysis analyzeImages(PlatformBackend& backend, Deadline& deadline, ScanArena& arena,
+                            const char* const* keywords, size_t maxFound = 8);
+
+ImageAnalysis analyzeImages(PlatformBackend& backend, Deadline& deadline, ScanArena& arena,
+                            const KeywordAutomaton& keywords, size_t maxFound = 8);
+
+/**
+ * Whether an open file descriptor points at a path containing one of [keywords]
+ */
+struct OpenFileMatch {
+    bool found = false;
+    bool truncated = false;  // deadline or entry cap hit before the end
+    int visited = 0;         // fd entries visited
+};
+
+OpenFileMatch scanOpenFiles(PlatformBackend& backend, Deadline& deadline, const char* const* keywords,
+                            int maxEntries = 100);
+
+OpenFileMatch scanOpenFiles(PlatformBackend& backend, Deadline& deadline, const KeywordAutomaton& keywords,
+                            int maxEntries = 100);
+
+// scanOpenFiles(...).found
+bool openFilesMatch(PlatformBackend& backend, Deadline& deadline, const char* const* keywords,
+                    int maxEntries = 100);
+
+/**
+ * Image a libc function resolves to (dladdr); unexpected if it matches none
+ * of [expectedFragments], which may indicate hooking / interposition
+ */
+struct SymbolImageCheck {
+    StringRef imagePath;
+    bool unexpected = false;
+};
+
+SymbolImageCheck checkSymbolImage(PlatformBackend& backend, ScanArena& arena, const void* symbol,
+                                  const char* const* expectedFragments);
+
+// Bytes read per PlatformBackend::readMemory call and per sampled window
+static const size_t MEMORY_SCAN_WINDOW = 16 * 1024;
+
+/**
+ * First of [signatures] found in memory no file on disk accounts for
+ *
+ * Candidates are readable regions that are executable and anonymous or
+ * backed by a deleted file, or backed by a memfd (any permissions). Agents
+ * loaded that way carry no telling path, but their code and string tables
+ * still do. ART's JIT code caches (/memfd:jit-cache, /memfd:jit-zygote-cache)
+ * and its non-executable heaps (/dev/ashmem/dalvik-* (deleted)) are left
+ * out: they hold the app's own string literals.
+ */
+struct MemorySignatureScan {
+    bool found = false;
+    const char* signature = nullptr;  // matching entry of [signatures]
+    uintptr_t regionStart = 0;        // region holding the match
+    uintptr_t regionEnd = 0;
+    uintptr_t address = 0;            // first byte of the match
+    StringRef regionPath;             // empty for anonymous regions
+    int regions = 0;                  // candidate regions
+    size_t candidateBytes = 0;
+    size_t bytesScanned = 0;          // bytes read and searched; at most the budget plus window overlaps
+    bool sampled = false;             // candidates exceeded the budget
+    bool truncated = false;           // deadline or region cap hit before the end
+};
+
+/**
+ * Reads candidates through PlatformBackend::readMemory, skipping pages
+ * residentPages reports as swapped out or never touched, and searches them
+ * with PatternSearch.
+ *
+ * When the candidates exceed [byteBudget], evenly spaced windows of
+ * MEMORY_SCAN_WINDOW bytes are read instead; [sampleSeed] shifts them, so
+ * successive scans with different seeds cover different bytes. Backends that
+ * cannot read memory yield a scan with bytesScanned 0.
+ *
+ * With a [pool], windows are searched on its workers; readMemory and
+ * residentPages are then called from several threads at once. The result
+ * is the same as a serial scan's: the match in the earliest window wins.
+ *
+ * @param maxRegions performance guardrail on candidate regions kept
+ * @param pool       nullptr: the calling thread reads every window
+ */
+MemorySignatureScan scanMemorySignatures(PlatformBackend& backend, Deadline& deadline, ScanArena& arena,
+                                         const char* const* signatures, size_t byteBudget = 1024 * 1024,
+                                         uint32_t sampleSeed = 0, int maxRegions = 256,
+                                         WorkPool* pool = nullptr);
+
+}  // namespace device_trust
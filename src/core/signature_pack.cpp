@@ -0,0 +1,423 @@
+// [DeviceTrust/Core] Signature packs
+
+#include "signature_pack.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+#include "keywords.h"
+#include "pattern_search.h"
+
+namespace device_trust {
+
+namespace {
+
+const char* const SECTION_NAMES[SIGNATURE_SECTION_LIMIT] = {
+    nullptr,
+    "module_keywords",
+    "fd_keywords",
+    "image_keywords",
+    "memory_signatures",
+    "su_paths",
+    "root_packages",
+    "qemu_files",
+    "jailbreak_paths",
+    "jailbreak_schemes",
+    "frida_ports",
+};
+
+// Native lists the core falls back to when a pack lacks the section
+const ObfuscatedText* builtinEncoded(int section) {
+    switch (section) {
+        case SIGNATURE_MODULE_KEYWORDS:
+            return MODULE_KEYWORDS_ENCODED;
+        case SIGNATURE_FD_KEYWORDS:
+            return FD_KEYWORDS_ENCODED;
+        case SIGNATURE_IMAGE_KEYWORDS:
+            return IMAGE_KEYWORDS_ENCODED;
+        case SIGNATURE_MEMORY_SIGNATURES:
+            return MEMORY_SIGNATURES_ENCODED;
+        default:
+            return nullptr;
+    }
+}
+
+const KeywordAutomaton* builtinAutomaton(int section) {
+    switch (section) {
+        case SIGNATURE_FD_KEYWORDS:
+            return &FD_AUTOMATON_LINUX;
+        case SIGNATURE_IMAGE_KEYWORDS:
+            return &IMAGE_AUTOMATON_DARWIN;
+        default:
+            return &MODULE_AUTOMATON_LINUX;
+    }
+}
+
+bool isKeywordSection(int section) {
+    return section == SIGNATURE_MODULE_KEYWORDS || section == SIGNATURE_FD_KEYWORDS ||
+           section == SIGNATURE_IMAGE_KEYWORDS;
+}
+
+// Well-formed 1-3 byte UTF-8 (no overlong forms, no surrogates), no C0/C1
+// controls or DEL
+bool isPrintableUtf8(const uint8_t* text, size_t length) {
+    size_t i = 0;
+    while (i < length) {
+        uint8_t lead = text[i];
+        if (lead < 0x80) {
+            if (lead < 0x20 || lead == 0x7F) {
+                return false;
+            }
+            i++;
+            continue;
+        }
+        size_t extra = (lead & 0xE0) == 0xC0 ? 1 : (lead & 0xF0) == 0xE0 ? 2 : 0;
+        if (extra == 0 || length - i <= extra) {
+            return false;  // stray continuation byte, 4-byte form or cut sequence
+        }
+        uint32_t codePoint = lead & (extra == 1 ? 0x1F : 0x0F);
+        for (size_t k = 1; k <= extra; k++) {
+            if ((text[i + k] & 0xC0) != 0x80) {
+                return false;
+            }
+            codePoint = (codePoint << 6) | (text[i + k] & 0x3F);
+        }
+        if ((extra == 1 && codePoint < 0x80) || (extra == 2 && codePoint < 0x800) ||
+            (codePoint >= 0xD800 && codePoint <= 0xDFFF) || codePoint <= 0x9F) {
+            return false;
+        }
+        i += extra + 1;
+    }
+    return true;
+}
+
+// CRC-32, reflected polynomial 0xEDB88320 (same value as zlib's crc32)
+struct Crc32Table {
+    uint32_t entries[256];
+
+    constexpr Crc32Table() : entries() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320u : 0);
+            }
+            entries[i] = crc;
+        }
+    }
+};
+
+constexpr Crc32Table CRC32_TABLE;
+
+uint32_t crc32Of(const uint8_t* data, size_t length) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; i++) {
+        crc = CRC32_TABLE.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+template <typename T>
+void append(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readAt(const uint8_t* data, size_t offset) {
+    T value;
+    memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+// Guarded by std::atomic_load / std::atomic_store
+std::shared_ptr<const SignaturePack> g_activePack;
+std::mutex g_installMutex;  // serializes the version check of installs
+
+}  // namespace
+
+const char* signatureSectionName(int section) {
+    return section > 0 && section < SIGNATURE_SECTION_LIMIT ? SECTION_NAMES[section] : nullptr;
+}
+
+bool isTextSection(int section) {
+    return section > 0 && section < SIGNATURE_SECTION_LIMIT && section != SIGNATURE_MEMORY_SIGNATURES &&
+           section != SIGNATURE_FRIDA_PORTS;
+}
+
+SignaturePack::~SignaturePack() {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, mappingSize_);
+    }
+}
+
+std::shared_ptr<const SignaturePack> SignaturePack::open(const char* path, SignaturePackStatus* status) {
+    if (status != nullptr) {
+        *status = SIGNATURE_PACK_IO_ERROR;
+    }
+    int fd = path != nullptr ? ::open(path, O_RDONLY | O_CLOEXEC) : -1;
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return nullptr;
+    }
+    if ((size_t)info.st_size > SIGNATURE_PACK_MAX_SIZE) {
+        close(fd);
+        if (status != nullptr) {
+            *status = SIGNATURE_PACK_LIMIT_EXCEEDED;
+        }
+        return nullptr;
+    }
+    size_t size = (size_t)info.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SignaturePack> pack(new SignaturePack());
+    pack->mapping_ = mapping;
+    pack->mappingSize_ = size;
+    return compile(std::move(pack), static_cast<const uint8_t*>(mapping), size, status);
+}
+
+std::shared_ptr<const SignaturePack> SignaturePack::fromBytes(const void* data, size_t size,
+                                                              SignaturePackStatus* status) {
+    if (size > SIGNATURE_PACK_MAX_SIZE) {
+        if (status != nullptr) {
+            *status = SIGNATURE_PACK_LIMIT_EXCEEDED;
+        }
+        return nullptr;
+    }
+    std::unique_ptr<SignaturePack> pack(new SignaturePack());
+    pack->copy_.assign(static_cast<const char*>(data), size);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(pack->copy_.data());
+    return compile(std::move(pack), bytes, size, status);
+}
+
+std::shared_ptr<const SignaturePack> SignaturePack::builtin() {
+    static const std::shared_ptr<const SignaturePack> pack = [] {
+        std::unique_ptr<SignaturePack> builtin(new SignaturePack());
+        // Decoded once into copy_; entries point into it once it stops growing
+        std::vector<size_t> offsets[SIGNATURE_SECTION_LIMIT];
+        for (int section = 1; section < SIGNATURE_SECTION_LIMIT; section++) {
+            const ObfuscatedText* encoded = builtinEncoded(section);
+            for (size_t i = 0; encoded != nullptr && encoded[i].size() > 0; i++) {
+                size_t offset = builtin->copy_.size();
+                builtin->copy_.resize(offset + encoded[i].size() + 1);
+                encoded[i].decode(&builtin->copy_[offset]);
+                offsets[section].push_back(offset);
+            }
+        }
+        for (int section = 1; section < SIGNATURE_SECTION_LIMIT; section++) {
+            if (offsets[section].empty()) {
+                continue;
+            }
+            for (size_t offset : offsets[section]) {
+                builtin->entries_[section].push_back(builtin->copy_.data() + offset);
+            }
+            builtin->entries_[section].push_back(nullptr);
+            builtin->lists_[section] = builtin->entries_[section].data();
+        }
+        for (int section = SIGNATURE_MODULE_KEYWORDS; section <= SIGNATURE_IMAGE_KEYWORDS; section++) {
+            builtin->keywords_[section] = builtinAutomaton(section);
+        }
+        return std::shared_ptr<const SignaturePack>(std::move(builtin));
+    }();
+    return pack;
+}
+
+std::shared_ptr<const SignaturePack> SignaturePack::compile(std::unique_ptr<SignaturePack> pack,
+                                                            const uint8_t* data, size_t size,
+                                                            SignaturePackStatus* status) {
+    SignaturePackStatus parsed = pack->parse(data, size);
+    if (status != nullptr) {
+        *status = parsed;
+    }
+    if (parsed != SIGNATURE_PACK_OK) {
+        return nullptr;
+    }
+    pack->compileAutomata();
+    return std::shared_ptr<const SignaturePack>(std::move(pack));
+}
+
+SignaturePackStatus SignaturePack::parse(const uint8_t* data, size_t size) {
+    if (size < SIGNATURE_PACK_HEADER_SIZE || readAt<uint32_t>(data, 0) != SIGNATURE_PACK_MAGIC ||
+        readAt<uint16_t>(data, 4) != SIGNATURE_PACK_FORMAT || readAt<uint16_t>(data, 6) != 0 ||
+        readAt<uint32_t>(data, 12) != size - SIGNATURE_PACK_HEADER_SIZE) {
+        return SIGNATURE_PACK_BAD_FORMAT;
+    }
+    version_ = readAt<uint32_t>(data, 8);
+    const uint8_t* payload = data + SIGNATURE_PACK_HEADER_SIZE;
+    size_t length = size - SIGNATURE_PACK_HEADER_SIZE;
+    if (crc32Of(payload, length) != readAt<uint32_t>(data, 16)) {
+        return SIGNATURE_PACK_BAD_CHECKSUM;
+    }
+
+    size_t pos = 0;
+    while (pos < length) {
+        if (length - pos < 5) {
+            return SIGNATURE_PACK_BAD_FORMAT;
+        }
+        uint8_t tag = payload[pos];
+        uint32_t bodyLength = readAt<uint32_t>(payload, pos + 1);
+        pos += 5;
+        if (bodyLength > length - pos) {
+            return SIGNATURE_PACK_BAD_FORMAT;
+        }
+        const uint8_t* body = payload + pos;
+        pos += bodyLength;
+
+        if (tag == SIGNATURE_FRIDA_PORTS) {
+            if (bodyLength % 2 != 0) {
+                return SIGNATURE_PACK_BAD_FORMAT;
+            }
+            if (bodyLength / 2 > SIGNATURE_PACK_MAX_ENTRIES) {
+                return SIGNATURE_PACK_LIMIT_EXCEEDED;
+            }
+            ports_.clear();
+            for (size_t i = 0; i < bodyLength; i += 2) {
+                ports_.push_back(readAt<uint16_t>(body, i));
+            }
+            hasPorts_ = true;
+            continue;
+        }
+        if (tag == 0 || tag >= SIGNATURE_SECTION_LIMIT) {
+            continue;  // newer section
+        }
+
+        if (isKeywordSection(tag) && bodyLength > SIGNATURE_PACK_MAX_KEYWORD_BYTES) {
+            return SIGNATURE_PACK_LIMIT_EXCEEDED;  // automaton state ids are 16-bit
+        }
+        // Entries are used in place: the body must end with a NUL
+        if (bodyLength > 0 && body[bodyLength - 1] != '\0') {
+            return SIGNATURE_PACK_BAD_FORMAT;
+        }
+        std::vector<const char*>& entries = entries_[tag];
+        entries.clear();
+        size_t begin = 0;
+        for (size_t i = 0; i < bodyLength; i++) {
+            if (body[i] != '\0') {
+                if (isKeywordSection(tag) && body[i] >= 'A' && body[i] <= 'Z') {
+                    return SIGNATURE_PACK_BAD_FORMAT;  // keyword lists are lowercase
+                }
+                continue;
+            }
+            size_t entryLength = i - begin;
+            if (entryLength == 0) {
+                return SIGNATURE_PACK_BAD_FORMAT;
+            }
+            if (entryLength > SIGNATURE_PACK_MAX_ENTRY || entries.size() >= SIGNATURE_PACK_MAX_ENTRIES) {
+                return SIGNATURE_PACK_LIMIT_EXCEEDED;
+            }
+            if (isTextSection(tag) && !isPrintableUtf8(body + begin, entryLength)) {
+                return SIGNATURE_PACK_BAD_FORMAT;
+            }
+            entries.push_back(reinterpret_cast<const char*>(body + begin));
+            begin = i + 1;
+        }
+        if (tag == SIGNATURE_MEMORY_SIGNATURES && entries.size() > (size_t)PATTERN_SEARCH_MAX_PATTERNS) {
+            return SIGNATURE_PACK_LIMIT_EXCEEDED;
+        }
+        entries.push_back(nullptr);
+    }
+
+    fallback_ = builtin();
+    for (int section = 1; section < SIGNATURE_SECTION_LIMIT; section++) {
+        lists_[section] = entries_[section].empty() ? fallback_->lists_[section] : entries_[section].data();
+    }
+    return SIGNATURE_PACK_OK;
+}
+
+void SignaturePack::compileAutomata() {
+    for (int section = SIGNATURE_MODULE_KEYWORDS; section <= SIGNATURE_IMAGE_KEYWORDS; section++) {
+        if (entries_[section].empty()) {
+            keywords_[section] = builtinAutomaton(section);
+            continue;
+        }
+        keywordTables_[section].reset(new KeywordAutomatonTables(lists_[section]));
+        keywords_[section] = &keywordTables_[section]->automaton();
+    }
+}
+
+const char* const* SignaturePack::list(SignatureSection section) const {
+    return section > 0 && section < SIGNATURE_SECTION_LIMIT ? lists_[section] : nullptr;
+}
+
+const KeywordAutomaton& SignaturePack::keywords(SignatureSection section) const {
+    return section >= SIGNATURE_MODULE_KEYWORDS && section <= SIGNATURE_IMAGE_KEYWORDS
+               ? *keywords_[section]
+               : *keywords_[SIGNATURE_MODULE_KEYWORDS];
+}
+
+bool encodeSignaturePack(const SignaturePackSource& source, std::string* out) {
+    std::string payload;
+    for (const auto& list : source.lists) {
+        if (list.first == 0 || list.first >= SIGNATURE_SECTION_LIMIT || list.first == SIGNATURE_FRIDA_PORTS ||
+            list.second.size() > SIGNATURE_PACK_MAX_ENTRIES) {
+            return false;
+        }
+        std::string body;
+        for (const std::string& entry : list.second) {
+            if (entry.empty() || entry.size() > SIGNATURE_PACK_MAX_ENTRY || entry.find('\0') != std::string::npos) {
+                return false;
+            }
+            body += entry;
+            body += '\0';
+        }
+        append<uint8_t>(payload, list.first);
+        append<uint32_t>(payload, (uint32_t)body.size());
+        payload += body;
+    }
+    if (source.hasPorts) {
+        if (source.fridaPorts.size() > SIGNATURE_PACK_MAX_ENTRIES) {
+            return false;
+        }
+        append<uint8_t>(payload, SIGNATURE_FRIDA_PORTS);
+        append<uint32_t>(payload, (uint32_t)(source.fridaPorts.size() * 2));
+        for (uint16_t port : source.fridaPorts) {
+            append<uint16_t>(payload, port);
+        }
+    }
+    if (SIGNATURE_PACK_HEADER_SIZE + payload.size() > SIGNATURE_PACK_MAX_SIZE) {
+        return false;
+    }
+
+    out->clear();
+    out->reserve(SIGNATURE_PACK_HEADER_SIZE + payload.size());
+    append<uint32_t>(*out, SIGNATURE_PACK_MAGIC);
+    append<uint16_t>(*out, SIGNATURE_PACK_FORMAT);
+    append<uint16_t>(*out, 0);
+    append<uint32_t>(*out, source.version);
+    append<uint32_t>(*out, (uint32_t)payload.size());
+    append<uint32_t>(*out, crc32Of(reinterpret_cast<const uint8_t*>(payload.data()), payload.size()));
+    *out += payload;
+    return true;
+}
+
+std::shared_ptr<const SignaturePack> activeSignaturePack() {
+    std::shared_ptr<const SignaturePack> pack = std::atomic_load(&g_activePack);
+    return pack != nullptr ? pack : SignaturePack::builtin();
+}
+
+SignaturePackStatus installSignaturePack(std::shared_ptr<const SignaturePack> pack, bool allowDowngrade) {
+    if (pack == nullptr) {
+        return SIGNATURE_PACK_BAD_FORMAT;
+    }
+    std::lock_guard<std::mutex> lock(g_installMutex);
+    if (!allowDowngrade && pack->version() <= activeSignaturePack()->version()) {
+        return SIGNATURE_PACK_STALE;
+    }
+    // The previous pack is unmapped once the last scan holding it returns
+    std::atomic_store(&g_activePack, std::move(pack));
+    return SIGNATURE_PACK_OK;
+}
+
+}  // namespace device_trust
@@ -0,0 +1,196 @@
+// [DeviceTrust/Core] Signature packs
+// Detection lists (keywords, byte signatures, paths, packages, ports) shipped
+// as a file that can be replaced without an app release. Packs are mapped
+// read-only, validated, compiled once and swapped in atomically; scans keep
+// the pack they started with.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "keyword_automaton.h"
+
+namespace device_trust {
+
+/**
+ * Pack layout (little-endian):
+ *
+ *   0   u32  magic "DTP1"
+ *   4   u16  format version (SIGNATURE_PACK_FORMAT)
+ *   6   u16  flags (none defined; must be 0)
+ *   8   u32  pack version (content serial, chosen by the publisher)
+ *  12   u32  payload length
+ *  16   u32  CRC-32 (zlib polynomial) of the payload
+ *  20   ...  payload: sections of u8 tag + u32 length + body
+ *
+ * String sections are NUL-terminated entries laid end to end, so entries
+ * are used in place as C strings; no entry can contain a 0x00 byte, byte
+ * signatures included (encodeSignaturePack rejects such entries). The port
+ * section is an array of u16. Unknown tags are
+ * skipped; a section that is absent keeps the built-in list, an empty one
+ * clears it. Keyword sections must be lowercase.
+ */
+static const uint32_t SIGNATURE_PACK_MAGIC = 0x31505444;  // "DTP1"
+static const uint16_t SIGNATURE_PACK_FORMAT = 1;
+static const size_t SIGNATURE_PACK_HEADER_SIZE = 20;
+
+// Guardrails against corrupt or hostile packs
+static const size_t SIGNATURE_PACK_MAX_SIZE = 1024 * 1024;
+static const size_t SIGNATURE_PACK_MAX_ENTRIES = 1024;  // per section
+static const size_t SIGNATURE_PACK_MAX_ENTRY = 255;     // bytes per entry
+static const size_t SIGNATURE_PACK_MAX_KEYWORD_BYTES = 32 * 1024;  // per keyword section
+
+enum SignatureSection : uint8_t {
+    SIGNATURE_MODULE_KEYWORDS = 1,    // maps paths (native, Android)
+    SIGNATURE_FD_KEYWORDS = 2,        // fd link targets (native, Android)
+    SIGNATURE_IMAGE_KEYWORDS = 3,     // dyld images (native, iOS)
+    SIGNATURE_MEMORY_SIGNATURES = 4,  // byte signatures without 0x00 (native, Android deep)
+    SIGNATURE_SU_PATHS = 5,           // su binaries (Kotlin)
+    SIGNATURE_ROOT_PACKAGES = 6,      // root manager packages (Kotlin)
+    SIGNATURE_QEMU_FILES = 7,         // emulator files (Kotlin)
+    SIGNATURE_JAILBREAK_PATHS = 8,    // jailbreak files (Swift)
+    SIGNATURE_JAILBREAK_SCHEMES = 9,  // jailbreak URL schemes (Swift)
+    SIGNATURE_FRIDA_PORTS = 10,       // u16 ports (Kotlin)
+};
+
+static const int SIGNATURE_SECTION_LIMIT = 11;  // tags are 1..SIGNATURE_SECTION_LIMIT-1
+
+// Name of [section] in pack sources ("module_keywords", ...); nullptr if unknown
+const char* signatureSectionName(int section);
+
+/**
+ * Whether entries of [section] are text: every string section but the byte
+ * signatures. Packs are only accepted if those entries are UTF-8 within the
+ * BMP (JNI's modified UTF-8 has no 4-byte form) without control characters,
+ * so they can become Java and Swift strings as they are.
+ */
+bool isTextSection(int section);
+
+enum SignaturePackStatus {
+    SIGNATURE_PACK_OK = 0,
+    SIGNATURE_PACK_IO_ERROR = -1,        // missing, unreadable or not mappable
+    SIGNATURE_PACK_BAD_FORMAT = -2,      // magic, format, flags or section framing
+    SIGNATURE_PACK_BAD_CHECKSUM = -3,
+    SIGNATURE_PACK_LIMIT_EXCEEDED = -4,  // size, entry count or entry length
+    SIGNATURE_PACK_STALE = -5,           // not newer than the active pack
+};
+
+/**
+ * Loaded, compiled pack
+ *
+ * Immutable once built; shared between scans through std::shared_ptr.
+ * Sections the pack lacks fall back to the built-in tables (keywords.h)
+ * for the native lists, generated automata included, so only replaced
+ * keyword sections are compiled at load time. The library holds the
+ * built-in lists encoded; builtin() decodes them once, to the heap. For the Kotlin / Swift
+ * lists list() returns nullptr and the platform keeps its own defaults.
+ */
+class SignaturePack {
+public:
+    ~SignaturePack();
+
+    SignaturePack(const SignaturePack&) = delete;
+    SignaturePack& operator=(const SignaturePack&) = delete;
+
+    /**
+     * Maps [path] read-only and compiles it
+     *
+     * @return nullptr with [status] set if the file is not a valid pack
+     */
+    static std::shared_ptr<const SignaturePack> open(const char* path, SignaturePackStatus* status = nullptr);
+
+    /**
+     * Same as open() over a copy of data[0, size)
+     */
+    static std::shared_ptr<const SignaturePack> fromBytes(const void* data, size_t size,
+                                                         SignaturePackStatus* status = nullptr);
+
+    /**
+     * The compiled-in tables, version 0: decodes the native lists on first
+     * use and compiles nothing
+     */
+    static std::shared_ptr<const SignaturePack> builtin();
+
+    uint32_t version() const {
+        return version_;
+    }
+
+    /**
+     * nullptr-terminated entries of string [section]; nullptr if neither the
+     * pack nor the core has that list
+     */
+    const char* const* list(SignatureSection section) const;
+
+    /**
+     * Compiled keyword section (module, fd or image keywords)
+     */
+    const KeywordAutomaton& keywords(SignatureSection section) const;
+
+    const std::vector<uint16_t>& fridaPorts() const {
+        return ports_;
+    }
+
+    bool hasPorts() const {
+        return hasPorts_;
+    }
+
+private:
+    SignaturePack() = default;
+
+    static std::shared_ptr<const SignaturePack> compile(std::unique_ptr<SignaturePack> pack, const uint8_t* data,
+                                                        size_t size, SignaturePackStatus* status);
+    SignaturePackStatus parse(const uint8_t* data, size_t size);
+    void compileAutomata();
+
+    uint32_t version_ = 0;
+    void* mapping_ = nullptr;  // munmap'ed on destruction
+    size_t mappingSize_ = 0;
+    std::string copy_;         // fromBytes storage; decoded lists of builtin()
+    std::vector<const char*> entries_[SIGNATURE_SECTION_LIMIT];  // nullptr-terminated; empty: absent
+    const char* const* lists_[SIGNATURE_SECTION_LIMIT] = {};
+    // Keyword sections the pack replaces are compiled here; the others use
+    // the generated built-in automata
+    std::unique_ptr<KeywordAutomatonTables> keywordTables_[SIGNATURE_IMAGE_KEYWORDS + 1];
+    const KeywordAutomaton* keywords_[SIGNATURE_IMAGE_KEYWORDS + 1] = {};
+    std::vector<uint16_t> ports_;
+    bool hasPorts_ = false;
+    std::shared_ptr<const SignaturePack> fallback_;  // builtin(), for absent sections
+};
+
+/**
+ * Input of encodeSignaturePack (pack tool, tests)
+ */
+struct SignaturePackSource {
+    uint32_t version = 0;
+    std::vector<std::pair<SignatureSection, std::vector<std::string>>> lists;
+    std::vector<uint16_t> fridaPorts;
+    bool hasPorts = false;
+};
+
+/**
+ * @return false if the source exceeds the pack limits or has an empty entry
+ *   or one with a 0x00 byte
+ */
+bool encodeSignaturePack(const SignaturePackSource& source, std::string* out);
+
+/**
+ * Pack every scan started from now on uses; never nullptr (built-in until
+ * a pack is installed). One atomic load; in-flight scans keep the pack
+ * they loaded.
+ */
+std::shared_ptr<const SignaturePack> activeSignaturePack();
+
+/**
+ * Replaces the active pack unless [pack] is not newer than it
+ *
+ * @param allowDowngrade also install older packs (rollback to builtin(), tests)
+ * @return SIGNATURE_PACK_OK, or SIGNATURE_PACK_STALE and the active pack is kept
+ */
+SignaturePackStatus installSignaturePack(std::shared_ptr<const SignaturePack> pack, bool allowDowngrade = false);
+
+}  // namespace device_trust
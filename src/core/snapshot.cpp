@@ -0,0 +1,256 @@
+// [DeviceTrust/Core] Snapshot bundles
+
+#include "snapshot.h"
+
+#include <zlib.h>
+
+#include <cstring>
+
+#include "../platform/procfs_backend.h"
+
+namespace device_trust {
+
+namespace {
+
+template <typename T>
+void append(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readAt(const char* data, size_t offset) {
+    T value;
+    memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+bool appendSection(std::string& out, SnapshotSection tag, const std::string& body) {
+    if (body.size() > UINT32_MAX) {
+        return false;
+    }
+    append<uint8_t>(out, tag);
+    append<uint32_t>(out, (uint32_t)body.size());
+    out += body;
+    return true;
+}
+
+std::string joinList(const std::vector<std::string>& items) {
+    std::string joined;
+    for (const std::string& item : items) {
+        joined += item;
+        joined += '\0';
+    }
+    return joined;
+}
+
+std::vector<std::string> splitList(const char* data, size_t length) {
+    std::vector<std::string> items;
+    size_t begin = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (data[i] == '\0') {
+            items.emplace_back(data + begin, i - begin);
+            begin = i + 1;
+        }
+    }
+    return items;
+}
+
+bool parseSections(const char* data, size_t length, Snapshot* out) {
+    size_t pos = 0;
+    while (pos < length) {
+        if (length - pos < 5) {
+            return false;
+        }
+        uint8_t tag = readAt<uint8_t>(data, pos);
+        uint32_t size = readAt<uint32_t>(data, pos + 1);
+        pos += 5;
+        if (size > length - pos) {
+            return false;
+        }
+        const char* body = data + pos;
+        switch (tag) {
+            case SNAPSHOT_SECTION_META: {
+                size_t lineStart = 0;
+                for (size_t i = 0; i <= size; i++) {
+                    if (i == size || body[i] == '\n') {
+                        std::string line(body + lineStart, i - lineStart);
+                        size_t equals = line.find('=');
+                        if (equals != std::string::npos) {
+                            out->meta.emplace_back(line.substr(0, equals), line.substr(equals + 1));
+                        }
+                        lineStart = i + 1;
+                    }
+                }
+                break;
+            }
+            case SNAPSHOT_SECTION_MAPS:
+                out->maps.assign(body, size);
+                break;
+            case SNAPSHOT_SECTION_STATUS:
+                out->status.assign(body, size);
+                break;
+            case SNAPSHOT_SECTION_FDS:
+                out->openFiles = splitList(body, size);
+                break;
+            case SNAPSHOT_SECTION_THREADS:
+                out->threadNames = splitList(body, size);
+                break;
+            case SNAPSHOT_SECTION_IMAGES:
+                out->images = splitList(body, size);
+                break;
+            case SNAPSHOT_SECTION_SYMBOLS: {
+                std::vector<std::string> pairs = splitList(body, size);
+                for (size_t i = 0; i + 1 < pairs.size(); i += 2) {
+                    out->symbols.push_back({pairs[i], pairs[i + 1]});
+                }
+                break;
+            }
+            default:
+                break;  // newer section
+        }
+        pos += size;
+    }
+    return true;
+}
+
+}  // namespace
+
+std::string Snapshot::metaValue(const char* key) const {
+    for (const auto& entry : meta) {
+        if (entry.first == key) {
+            return entry.second;
+        }
+    }
+    return std::string();
+}
+
+const char* Snapshot::symbolImage(const char* symbol) const {
+    for (const SnapshotSymbol& entry : symbols) {
+        if (entry.name == symbol) {
+            return entry.imagePath.c_str();
+        }
+    }
+    return nullptr;
+}
+
+bool encodeSnapshot(const Snapshot& snapshot, std::string* out, bool compress) {
+    std::string meta;
+    for (const auto& entry : snapshot.meta) {
+        meta += entry.first + "=" + entry.second + "\n";
+    }
+    std::vector<std::string> symbolPairs;
+    for (const SnapshotSymbol& symbol : snapshot.symbols) {
+        symbolPairs.push_back(symbol.name);
+        symbolPairs.push_back(symbol.imagePath);
+    }
+
+    std::string payload;
+    bool ok = appendSection(payload, SNAPSHOT_SECTION_META, meta) &&
+              appendSection(payload, SNAPSHOT_SECTION_MAPS, snapshot.maps) &&
+              appendSection(payload, SNAPSHOT_SECTION_STATUS, snapshot.status) &&
+              appendSection(payload, SNAPSHOT_SECTION_FDS, joinList(snapshot.openFiles)) &&
+              appendSection(payload, SNAPSHOT_SECTION_THREADS, joinList(snapshot.threadNames)) &&
+              appendSection(payload, SNAPSHOT_SECTION_IMAGES, joinList(snapshot.images)) &&
+              appendSection(payload, SNAPSHOT_SECTION_SYMBOLS, joinList(symbolPairs));
+    if (!ok || payload.size() > SNAPSHOT_MAX_PAYLOAD) {
+        return false;
+    }
+
+    uint16_t flags = 0;
+    std::string stored;
+    if (compress) {
+        uLongf storedLength = compressBound((uLong)payload.size());
+        stored.resize(storedLength);
+        if (compress2(reinterpret_cast<Bytef*>(&stored[0]), &storedLength,
+                      reinterpret_cast<const Bytef*>(payload.data()), (uLong)payload.size(),
+                      Z_BEST_COMPRESSION) == Z_OK) {
+            stored.resize(storedLength);
+            flags |= SNAPSHOT_FLAG_DEFLATE;
+        }
+    }
+    const std::string& body = (flags & SNAPSHOT_FLAG_DEFLATE) ? stored : payload;
+
+    out->clear();
+    out->reserve(SNAPSHOT_HEADER_SIZE + body.size());
+    append<uint32_t>(*out, SNAPSHOT_MAGIC);
+    append<uint16_t>(*out, SNAPSHOT_VERSION);
+    append<uint16_t>(*out, flags);
+    append<uint32_t>(*out, (uint32_t)payload.size());
+    append<uint32_t>(*out, (uint32_t)body.size());
+    *out += body;
+    return true;
+}
+
+bool decodeSnapshot(const char* data, size_t size, Snapshot* out) {
+    if (data == nullptr || size < SNAPSHOT_HEADER_SIZE || readAt<uint32_t>(data, 0) != SNAPSHOT_MAGIC ||
+        readAt<uint16_t>(data, 4) != SNAPSHOT_VERSION) {
+        return false;
+    }
+    uint16_t flags = readAt<uint16_t>(data, 6);
+    uint32_t payloadLength = readAt<uint32_t>(data, 8);
+    uint32_t storedLength = readAt<uint32_t>(data, 12);
+    if (storedLength != size - SNAPSHOT_HEADER_SIZE || payloadLength > SNAPSHOT_MAX_PAYLOAD) {
+        return false;
+    }
+    const char* stored = data + SNAPSHOT_HEADER_SIZE;
+
+    *out = Snapshot();
+    if (!(flags & SNAPSHOT_FLAG_DEFLATE)) {
+        return payloadLength == storedLength && parseSections(stored, storedLength, out);
+    }
+
+    std::string payload(payloadLength, '\0');
+    uLongf inflated = payloadLength;
+    if (uncompress(reinterpret_cast<Bytef*>(&payload[0]), &inflated, reinterpret_cast<const Bytef*>(stored),
+                   storedLength) != Z_OK ||
+        inflated != payloadLength) {
+        return false;
+    }
+    return parseSections(payload.data(), payload.size(), out);
+}
+
+bool SnapshotBackend::forEachRegion(RegionVisitor visit, void* context) {
+    const std::string& maps = snapshot_.maps;
+    MemoryRegion region;
+    size_t begin = 0;
+    while (begin < maps.size()) {
+        size_t end = maps.find('\n', begin);
+        if (end == std::string::npos) {
+            end = maps.size();
+        }
+        if (parseMapsLine(maps.data() + begin, end - begin, &region) && !visit(region, context)) {
+            break;
+        }
+        begin = end + 1;
+    }
+    return !maps.empty();
+}
+
+bool SnapshotBackend::forEachImage(PathVisitor visit, void* context) {
+    for (const std::string& image : snapshot_.images) {
+        if (!visit(image.data(), image.size(), context)) {
+            break;
+        }
+    }
+    return true;
+}
+
+bool SnapshotBackend::forEachOpenFile(PathVisitor visit, void* context) {
+    for (const std::string& target : snapshot_.openFiles) {
+        if (!visit(target.data(), target.size(), context)) {
+            break;
+        }
+    }
+    return true;
+}
+
+bool SnapshotBackend::imagePathForAddress(const void* /* address */, const char** path) {
+    const char* image = snapshot_.symbolImage(SNAPSHOT_PROBE_SYMBOL);
+    if (image == nullptr) {
+        return false;
+    }
+    *path = image;
+    return true;
+}
+
+}  // namespace device_trust
@@ -0,0 +1,107 @@
+// [DeviceTrust/Core] Snapshot bundles
+// Every input the native checks read, captured on a device (see
+// platform/procfs_snapshot.h) and replayed offline through SnapshotBackend.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "platform.h"
+
+namespace device_trust {
+
+/**
+ * Bundle layout (little-endian):
+ *
+ *   0   u32  magic "DTS1"
+ *   4   u16  version (SNAPSHOT_VERSION)
+ *   6   u16  flags (SNAPSHOT_FLAG_DEFLATE: payload is zlib-compressed)
+ *   8   u32  payload length before compression
+ *  12   u32  stored payload length
+ *  16   ...  payload: sections of u8 tag + u32 length + bytes
+ *
+ * Lists are NUL-separated; unknown section tags are skipped, so older
+ * readers accept bundles with new sections.
+ */
+static const uint32_t SNAPSHOT_MAGIC = 0x31535444;  // "DTS1"
+static const uint16_t SNAPSHOT_VERSION = 1;
+static const uint16_t SNAPSHOT_FLAG_DEFLATE = 1 << 0;
+static const size_t SNAPSHOT_HEADER_SIZE = 16;
+
+// Largest payload decodeSnapshot inflates (guards against corrupt lengths)
+static const uint32_t SNAPSHOT_MAX_PAYLOAD = 64u * 1024 * 1024;
+
+// Symbol probed by checkSymbolImage; SnapshotBackend resolves every address to it
+static const char* const SNAPSHOT_PROBE_SYMBOL = "getpid";
+
+enum SnapshotSection : uint8_t {
+    SNAPSHOT_SECTION_META = 1,      // key=value lines
+    SNAPSHOT_SECTION_MAPS = 2,      // raw maps text
+    SNAPSHOT_SECTION_STATUS = 3,    // raw status text
+    SNAPSHOT_SECTION_FDS = 4,       // fd link targets
+    SNAPSHOT_SECTION_THREADS = 5,   // task comms
+    SNAPSHOT_SECTION_IMAGES = 6,    // loaded image paths
+    SNAPSHOT_SECTION_SYMBOLS = 7    // symbol name, image path pairs
+};
+
+struct SnapshotSymbol {
+    std::string name;
+    std::string imagePath;
+};
+
+struct Snapshot {
+    std::vector<std::pair<std::string, std::string>> meta;  // pid, capturedAtMs, ...
+    std::string maps;
+    std::string status;
+    std::vector<std::string> openFiles;
+    std::vector<std::string> threadNames;
+    std::vector<std::string> images;
+    std::vector<SnapshotSymbol> symbols;
+
+    /**
+     * @return value of [key] in meta; empty if absent
+     */
+    std::string metaValue(const char* key) const;
+
+    /**
+     * @return image recorded for [symbol]; nullptr if not resolved at capture
+     */
+    const char* symbolImage(const char* symbol) const;
+};
+
+/**
+ * @param compress deflate the payload (zlib); stored uncompressed if that fails
+ * @return false if a section exceeds the format limits
+ */
+bool encodeSnapshot(const Snapshot& snapshot, std::string* out, bool compress = true);
+
+/**
+ * @return false if [data] is not a bundle this version can read
+ */
+bool decodeSnapshot(const char* data, size_t size, Snapshot* out);
+
+/**
+ * Replays a decoded snapshot through the scanners
+ *
+ * imagePathForAddress ignores the address and answers with the image
+ * recorded for SNAPSHOT_PROBE_SYMBOL, the only symbol the scans resolve.
+ * [snapshot] must outlive the backend.
+ */
+class SnapshotBackend : public PlatformBackend {
+public:
+    explicit SnapshotBackend(const Snapshot& snapshot) : snapshot_(snapshot) {}
+
+    bool forEachRegion(RegionVisitor visit, void* context) override;
+    bool forEachImage(PathVisitor visit, void* context) override;
+    bool forEachOpenFile(PathVisitor visit, void* context) override;
+    bool imagePathForAddress(const void* address, const char** path) override;
+
+private:
+    const Snapshot& snapshot_;
+};
+
+}  // namespace device_trust
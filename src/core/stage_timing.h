@@ -0,0 +1,70 @@
+// [DeviceTrust/Core] Per-stage timing
+// Nanosecond duration and work counter of each native stage, reported next
+// to the total scan time so the dominant stage can be told apart per device.
+
+#pragma once
+
+#include <time.h>
+
+#include "perf_counters.h"
+
+namespace device_trust {
+
+/**
+ * CLOCK_MONOTONIC in ns (same clock on Android, Linux and iOS)
+ */
+inline long long monotonicNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/**
+ * One stage of a native scan
+ *
+ * [items] is the stage's work counter: maps lines, fd entries, regions,
+ * images or symbols visited, depending on the stage. [perf] is only filled
+ * when the stage was timed with PerfCounters.
+ */
+struct StageTiming {
+    bool ran = false;
+    long long ns = 0;
+    int items = 0;
+    PerfSample perf;
+};
+
+/**
+ * Starts on construction; stop() fills the timing in
+ *
+ * With [perf], the counters run for the same region; their ioctls are kept
+ * outside the measured ns.
+ */
+class StageTimer {
+public:
+    explicit StageTimer(StageTiming& timing, PerfCounters* perf = nullptr) : timing_(timing), perf_(perf) {
+        if (perf_ != nullptr) {
+            perf_->start();
+        }
+        start_ = monotonicNs();
+    }
+
+    /**
+     * @return elapsed ns since construction
+     */
+    long long stop(int items) {
+        timing_.ran = true;
+        timing_.ns = monotonicNs() - start_;
+        timing_.items = items;
+        if (perf_ != nullptr) {
+            perf_->stop(&timing_.perf);
+        }
+        return timing_.ns;
+    }
+
+private:
+    StageTiming& timing_;
+    PerfCounters* perf_;
+    long long start_;
+};
+
+}  // namespace device_trust
@@ -0,0 +1,212 @@
+// [DeviceTrust/Core] Cumulative check telemetry
+
+#include "telemetry.h"
+
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+namespace device_trust {
+
+int histogramBucket(uint64_t ns) {
+    if (ns < (uint64_t)HISTOGRAM_LINEAR_LIMIT) {
+        return (int)ns;
+    }
+    int msb = 63 - __builtin_clzll(ns);
+    if (msb >= HISTOGRAM_MAX_BIT) {
+        return HISTOGRAM_BUCKETS - 1;
+    }
+    int shift = msb - HISTOGRAM_SUB_BUCKET_BITS;
+    int sub = (int)(ns >> shift) - HISTOGRAM_SUB_BUCKETS;
+    return HISTOGRAM_LINEAR_LIMIT + (shift - 1) * HISTOGRAM_SUB_BUCKETS + sub;
+}
+
+uint64_t histogramBucketLowerNs(int bucket) {
+    if (bucket < HISTOGRAM_LINEAR_LIMIT) {
+        return (uint64_t)bucket;
+    }
+    int shift = (bucket - HISTOGRAM_LINEAR_LIMIT) / HISTOGRAM_SUB_BUCKETS + 1;
+    uint64_t sub = (uint64_t)((bucket - HISTOGRAM_LINEAR_LIMIT) % HISTOGRAM_SUB_BUCKETS + HISTOGRAM_SUB_BUCKETS);
+    return sub << shift;
+}
+
+uint64_t histogramBucketUpperNs(int bucket) {
+    if (bucket >= HISTOGRAM_BUCKETS - 1) {
+        return UINT64_MAX;
+    }
+    return histogramBucketLowerNs(bucket + 1) - 1;
+}
+
+uint64_t LatencyHistogram::percentileNs(double percentile) const {
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t target = (uint64_t)(percentile * total + 0.999999);
+    target = target == 0 ? 1 : target;
+    uint64_t seen = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += counts[i];
+        if (seen >= target) {
+            return histogramBucketUpperNs(i);
+        }
+    }
+    return histogramBucketUpperNs(HISTOGRAM_BUCKETS - 1);
+}
+
+// Round-robin shard assignment, shared by all stores
+static std::atomic<unsigned> g_nextShard(0);
+
+TelemetryStore::Shard& TelemetryStore::shard() {
+    static thread_local int t_shard = -1;
+    if (t_shard < 0) {
+        t_shard = (int)(g_nextShard.fetch_add(1, std::memory_order_relaxed) % TELEMETRY_SHARDS);
+    }
+    return shards_[t_shard];
+}
+
+int TelemetryStore::slotFor(const char* check) {
+    for (int i = 0; i < TELEMETRY_MAX_CHECKS; i++) {
+        Slot& slot = slots_[i];
+        int state = slot.state.load(std::memory_order_acquire);
+        if (state == SLOT_EMPTY) {
+            int expected = SLOT_EMPTY;
+            if (slot.state.compare_exchange_strong(expected, SLOT_WRITING, std::memory_order_acquire)) {
+                strncpy(slot.name, check, TELEMETRY_NAME_LEN - 1);
+                slot.name[TELEMETRY_NAME_LEN - 1] = '\0';
+                slot.state.store(SLOT_READY, std::memory_order_release);
+                return i;
+            }
+            state = expected;
+        }
+        // Another thread is copying its id into this slot
+        while (state == SLOT_WRITING) {
+            std::this_thread::yield();
+            state = slot.state.load(std::memory_order_acquire);
+        }
+        if (strncmp(slot.name, check, TELEMETRY_NAME_LEN - 1) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void TelemetryStore::record(const char* check, TelemetryEvent event, uint64_t elapsedNs) {
+    Shard& local = shard();
+    int slot = check != nullptr ? slotFor(check) : -1;
+    if (slot < 0) {
+        local.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    local.events[slot][event].fetch_add(1, std::memory_order_relaxed);
+    if (event != TELEMETRY_CALL) {
+        return;
+    }
+    local.sumNs[slot].fetch_add(elapsedNs, std::memory_order_relaxed);
+    local.latency[slot][histogramBucket(elapsedNs)].fetch_add(1, std::memory_order_relaxed);
+    uint64_t max = local.maxNs[slot].load(std::memory_order_relaxed);
+    while (elapsedNs > max &&
+           !local.maxNs[slot].compare_exchange_weak(max, elapsedNs, std::memory_order_relaxed)) {
+    }
+}
+
+void TelemetryStore::addIo(TelemetryIo counter, uint64_t amount) {
+    shard().io[counter].fetch_add(amount, std::memory_order_relaxed);
+}
+
+void TelemetryStore::snapshot(TelemetrySnapshot* out) const {
+    out->checks.clear();
+    for (int i = 0; i < TELEMETRY_IO_COUNT; i++) {
+        out->io[i] = 0;
+    }
+    out->droppedEvents = 0;
+    for (const Shard& shard : shards_) {
+        for (int i = 0; i < TELEMETRY_IO_COUNT; i++) {
+            out->io[i] += shard.io[i].load(std::memory_order_relaxed);
+        }
+        out->droppedEvents += shard.dropped.load(std::memory_order_relaxed);
+    }
+
+    for (int slot = 0; slot < TELEMETRY_MAX_CHECKS; slot++) {
+        if (slots_[slot].state.load(std::memory_order_acquire) != SLOT_READY) {
+            break;  // slots are claimed in order
+        }
+        out->checks.emplace_back();  // value-initialized: counters start at zero
+        TelemetrySnapshot::Check& check = out->checks.back();
+        memcpy(check.name, slots_[slot].name, TELEMETRY_NAME_LEN);
+        for (const Shard& shard : shards_) {
+            for (int event = 0; event < TELEMETRY_EVENT_COUNT; event++) {
+                check.events[event] += shard.events[slot][event].load(std::memory_order_relaxed);
+            }
+            check.sumNs += shard.sumNs[slot].load(std::memory_order_relaxed);
+            uint64_t max = shard.maxNs[slot].load(std::memory_order_relaxed);
+            check.maxNs = max > check.maxNs ? max : check.maxNs;
+            for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+                uint32_t count = shard.latency[slot][bucket].load(std::memory_order_relaxed);
+                if (count > 0) {
+                    check.latency.add(histogramBucketLowerNs(bucket), count);
+                }
+            }
+        }
+    }
+}
+
+void TelemetryStore::reset() {
+    for (Shard& shard : shards_) {
+        for (int slot = 0; slot < TELEMETRY_MAX_CHECKS; slot++) {
+            for (int event = 0; event < TELEMETRY_EVENT_COUNT; event++) {
+                shard.events[slot][event].store(0, std::memory_order_relaxed);
+            }
+            shard.sumNs[slot].store(0, std::memory_order_relaxed);
+            shard.maxNs[slot].store(0, std::memory_order_relaxed);
+            for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+                shard.latency[slot][bucket].store(0, std::memory_order_relaxed);
+            }
+        }
+        for (int i = 0; i < TELEMETRY_IO_COUNT; i++) {
+            shard.io[i].store(0, std::memory_order_relaxed);
+        }
+        shard.dropped.store(0, std::memory_order_relaxed);
+    }
+}
+
+TelemetryStore& telemetry() {
+    static TelemetryStore store;
+    return store;
+}
+
+std::string telemetryToJson(const TelemetrySnapshot& snapshot) {
+    static const char* const EVENT_KEYS[TELEMETRY_EVENT_COUNT] = {"calls", "cacheHits", "timeouts",
+                                                                  "cancellations"};
+    std::ostringstream json;
+    json << "{\"v\":1,\"histogram\":\"log2x" << HISTOGRAM_SUB_BUCKETS << "\",";
+    json << "\"io\":{\"procfsBytes\":" << snapshot.io[TELEMETRY_IO_PROCFS_BYTES]
+         << ",\"syscalls\":" << snapshot.io[TELEMETRY_IO_SYSCALLS] << "},";
+    json << "\"dropped\":" << snapshot.droppedEvents << ",";
+    json << "\"checks\":{";
+    bool firstCheck = true;
+    for (const TelemetrySnapshot::Check& check : snapshot.checks) {
+        json << (firstCheck ? "" : ",") << "\"" << check.name << "\":{";
+        for (int event = 0; event < TELEMETRY_EVENT_COUNT; event++) {
+            json << "\"" << EVENT_KEYS[event] << "\":" << check.events[event] << ",";
+        }
+        json << "\"sumNs\":" << check.sumNs << ",\"maxNs\":" << check.maxNs << ",";
+        json << "\"p50Ns\":" << check.latency.percentileNs(0.50) << ",";
+        json << "\"p90Ns\":" << check.latency.percentileNs(0.90) << ",";
+        json << "\"p99Ns\":" << check.latency.percentileNs(0.99) << ",";
+        json << "\"buckets\":[";
+        bool firstBucket = true;
+        for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+            if (check.latency.counts[bucket] == 0) {
+                continue;
+            }
+            json << (firstBucket ? "" : ",") << "[" << bucket << "," << check.latency.counts[bucket] << "]";
+            firstBucket = false;
+        }
+        json << "]}";
+        firstCheck = false;
+    }
+    json << "}}";
+    return json.str();
+}
+
+}  // namespace device_trust
@@ -0,0 +1,176 @@
+// [DeviceTrust/Core] Cumulative check telemetry
+// Per-check latency histograms and event counters plus procfs I/O counters,
+// kept since process start for SLO tracking. Writers only do relaxed atomic
+// increments on their thread's shard; readers merge all shards.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace device_trust {
+
+/**
+ * HDR-style log-linear latency histogram (ns)
+ *
+ * Values below 16 ns get one bucket each; above that every power of two is
+ * split into 8 linear sub-buckets, so a bucket's width is at most 1/8 of its
+ * lower bound (2 significant bits after the leading one). Values from 2^40 ns
+ * (~18 min) on share the last bucket.
+ */
+static const int HISTOGRAM_SUB_BUCKET_BITS = 3;
+static const int HISTOGRAM_SUB_BUCKETS = 1 << HISTOGRAM_SUB_BUCKET_BITS;           // 8
+static const int HISTOGRAM_LINEAR_LIMIT = 2 * HISTOGRAM_SUB_BUCKETS;               // 16
+static const int HISTOGRAM_MAX_BIT = 40;
+static const int HISTOGRAM_BUCKETS =
+    HISTOGRAM_LINEAR_LIMIT + (HISTOGRAM_MAX_BIT - HISTOGRAM_SUB_BUCKET_BITS - 1) * HISTOGRAM_SUB_BUCKETS;
+
+int histogramBucket(uint64_t ns);
+
+// Smallest value (ns) counted in [bucket]
+uint64_t histogramBucketLowerNs(int bucket);
+
+// Largest value (ns) counted in [bucket]; UINT64_MAX for the last one
+uint64_t histogramBucketUpperNs(int bucket);
+
+struct LatencyHistogram {
+    uint64_t counts[HISTOGRAM_BUCKETS] = {};
+    uint64_t total = 0;
+
+    void add(uint64_t ns, uint64_t count = 1) {
+        counts[histogramBucket(ns)] += count;
+        total += count;
+    }
+
+    /**
+     * @return upper bound of the bucket holding the [percentile] (0..1)
+     *   sample; 0 if empty
+     */
+    uint64_t percentileNs(double percentile) const;
+};
+
+/**
+ * Per-check events; TELEMETRY_CALL also feeds the latency histogram
+ */
+enum TelemetryEvent {
+    TELEMETRY_CALL = 0,           // check ran to completion
+    TELEMETRY_CACHE_HIT = 1,      // result served from a cache instead of running
+    TELEMETRY_TIMEOUT = 2,        // over its budget, or skipped because the scan budget was spent
+    TELEMETRY_CANCELLATION = 3,   // not run or stopped: verdict settled, stream cancelled
+    TELEMETRY_EVENT_COUNT
+};
+
+// Process-wide I/O counters
+enum TelemetryIo {
+    TELEMETRY_IO_PROCFS_BYTES = 0,
+    TELEMETRY_IO_SYSCALLS = 1,
+    TELEMETRY_IO_COUNT
+};
+
+static const int TELEMETRY_MAX_CHECKS = 64;
+static const int TELEMETRY_NAME_LEN = 32;
+static const int TELEMETRY_SHARDS = 8;
+
+/**
+ * Merged view of every shard
+ */
+struct TelemetrySnapshot {
+    struct Check {
+        char name[TELEMETRY_NAME_LEN];
+        uint64_t events[TELEMETRY_EVENT_COUNT];
+        uint64_t sumNs;
+        uint64_t maxNs;
+        LatencyHistogram latency;
+    };
+
+    std::vector<Check> checks;  // in registration order
+    uint64_t io[TELEMETRY_IO_COUNT] = {};
+    uint64_t droppedEvents = 0;  // events of checks past TELEMETRY_MAX_CHECKS
+};
+
+/**
+ * Lock-free telemetry store
+ *
+ * Check ids are registered on first use in a fixed table (a CAS claims a
+ * slot; concurrent registrations of the same id wait for the copy of the
+ * name, a few ns). Each thread writes to one of TELEMETRY_SHARDS cache-line
+ * aligned shards, picked round-robin on its first event, so concurrent
+ * scans rarely share counters. The store is ~640 KB of zero-initialized
+ * storage of which only the pages of registered checks get touched.
+ * Counters are monotonic; a snapshot taken while writers run may miss
+ * their in-flight increments.
+ */
+class TelemetryStore {
+public:
+    TelemetryStore() = default;
+    TelemetryStore(const TelemetryStore&) = delete;
+    TelemetryStore& operator=(const TelemetryStore&) = delete;
+
+    /**
+     * @param elapsedNs latency of a TELEMETRY_CALL; ignored for other events
+     */
+    void record(const char* check, TelemetryEvent event, uint64_t elapsedNs = 0);
+
+    void addIo(TelemetryIo counter, uint64_t amount);
+
+    // Procfs read of [bytes], counted as one syscall
+    void addRead(uint64_t bytes) {
+        addIo(TELEMETRY_IO_PROCFS_BYTES, bytes);
+        addIo(TELEMETRY_IO_SYSCALLS, 1);
+    }
+
+    void snapshot(TelemetrySnapshot* out) const;
+
+    /**
+     * Zeroes every counter; registered ids are kept. Not atomic with
+     * respect to concurrent writers (tests, benchmarks).
+     */
+    void reset();
+
+private:
+    enum SlotState { SLOT_EMPTY = 0, SLOT_WRITING = 1, SLOT_READY = 2 };
+
+    struct Slot {
+        std::atomic<int> state{SLOT_EMPTY};
+        char name[TELEMETRY_NAME_LEN];
+    };
+
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> events[TELEMETRY_MAX_CHECKS][TELEMETRY_EVENT_COUNT];
+        std::atomic<uint64_t> sumNs[TELEMETRY_MAX_CHECKS];
+        std::atomic<uint64_t> maxNs[TELEMETRY_MAX_CHECKS];
+        std::atomic<uint32_t> latency[TELEMETRY_MAX_CHECKS][HISTOGRAM_BUCKETS];  // widened on merge
+        std::atomic<uint64_t> io[TELEMETRY_IO_COUNT];
+        std::atomic<uint64_t> dropped;
+    };
+
+    // -1 if the table is full
+    int slotFor(const char* check);
+    Shard& shard();
+
+    Slot slots_[TELEMETRY_MAX_CHECKS];
+    Shard shards_[TELEMETRY_SHARDS] = {};
+};
+
+/**
+ * Store shared by the native stages and the platform layers
+ */
+TelemetryStore& telemetry();
+
+/**
+ * Compact JSON rendering:
+ *
+ *   {"v":1,"histogram":"log2x8","io":{"procfsBytes":N,"syscalls":N},
+ *    "dropped":N,"checks":{"<id>":{"calls":N,"cacheHits":N,"timeouts":N,
+ *    "cancellations":N,"sumNs":N,"maxNs":N,"p50Ns":N,"p90Ns":N,"p99Ns":N,
+ *    "buckets":[[index,count],...]}}}
+ *
+ * Only non-empty buckets are listed; indexes follow histogramBucket, so
+ * histograms from many devices can be merged bucket by bucket.
+ */
+std::string telemetryToJson(const TelemetrySnapshot& snapshot);
+
+}  // namespace device_trust
@@ -0,0 +1,190 @@
+// [DeviceTrust/Core] Trace sections
+
+#include "trace.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#if defined(__ANDROID__)
+#include <android/trace.h>
+#elif defined(__linux__)
+#include <sys/syscall.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+#include "json.h"
+#include "stage_timing.h"
+
+namespace device_trust {
+
+namespace {
+
+std::atomic<bool> g_traceRecording(true);
+
+int currentTid() {
+#if defined(__ANDROID__)
+    return gettid();
+#elif defined(__linux__)
+    return (int)syscall(SYS_gettid);
+#elif defined(__APPLE__)
+    uint64_t tid = 0;
+    pthread_threadid_np(nullptr, &tid);
+    return (int)tid;
+#else
+    return 0;
+#endif
+}
+
+#if !defined(__ANDROID__) && defined(__linux__)
+/**
+ * ftrace marker, opened on first use if tracing was on at that point
+ * (tracefs or the older debugfs mount); -1 otherwise
+ */
+int traceMarkerFd() {
+    static const int fd = [] {
+        static const char* const ROOTS[] = {"/sys/kernel/tracing", "/sys/kernel/debug/tracing"};
+        for (const char* root : ROOTS) {
+            char path[64];
+            snprintf(path, sizeof(path), "%s/tracing_on", root);
+            int onFd = open(path, O_RDONLY | O_CLOEXEC);
+            if (onFd < 0) {
+                continue;
+            }
+            char on = '0';
+            ssize_t len = read(onFd, &on, 1);
+            close(onFd);
+            if (len != 1 || on != '1') {
+                return -1;
+            }
+            snprintf(path, sizeof(path), "%s/trace_marker", root);
+            return open(path, O_WRONLY | O_CLOEXEC);
+        }
+        return -1;
+    }();
+    return fd;
+}
+#endif
+
+bool beginSystemSection(const char* name) {
+#if defined(__ANDROID__)
+    if (!ATrace_isEnabled()) {
+        return false;
+    }
+    ATrace_beginSection(name);
+    return true;
+#elif defined(__linux__)
+    int fd = traceMarkerFd();
+    if (fd < 0) {
+        return false;
+    }
+    char marker[TRACE_NAME_LEN + 32];
+    int length = snprintf(marker, sizeof(marker), "B|%d|%s", (int)getpid(), name);
+    if (length <= 0) {
+        return false;
+    }
+    size_t size = std::min((size_t)length, sizeof(marker) - 1);  // long names are truncated
+    return write(fd, marker, size) == (ssize_t)size;
+#else
+    (void)name;
+    return false;
+#endif
+}
+
+void endSystemSection() {
+#if defined(__ANDROID__)
+    ATrace_endSection();
+#elif defined(__linux__)
+    char marker[32];
+    int length = snprintf(marker, sizeof(marker), "E|%d", (int)getpid());
+    if (length > 0 && write(traceMarkerFd(), marker, (size_t)length) < 0) {
+        // Fail-soft: the section stays open in the trace
+    }
+#endif
+}
+
+}  // namespace
+
+void TraceRing::record(const char* name, long long beginNs, long long durationNs, int tid) {
+    uint64_t claim = next_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[claim & (TRACE_RING_CAPACITY - 1)];
+    slot.sequence.store(2 * claim + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    strncpy(slot.event.name, name, TRACE_NAME_LEN - 1);
+    slot.event.name[TRACE_NAME_LEN - 1] = '\0';
+    slot.event.beginNs = beginNs;
+    slot.event.durationNs = durationNs;
+    slot.event.tid = tid;
+    slot.sequence.store(2 * claim + 2, std::memory_order_release);
+}
+
+std::string TraceRing::toChromeJson() const {
+    uint64_t end = next_.load(std::memory_order_acquire);
+    uint64_t begin = end > (uint64_t)TRACE_RING_CAPACITY ? end - TRACE_RING_CAPACITY : 0;
+    int pid = (int)getpid();
+
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3);
+    json << "{\"traceEvents\":[";
+    bool first = true;
+    for (uint64_t claim = begin; claim < end; claim++) {
+        const Slot& slot = slots_[claim & (TRACE_RING_CAPACITY - 1)];
+        uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * claim + 2) {
+            continue;  // still being written, or already overwritten
+        }
+        TraceEvent event;
+        memcpy(&event, &slot.event, sizeof(event));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+        json << (first ? "" : ",") << "{\"name\":\"" << escapeJsonString(std::string(event.name))
+             << "\",\"cat\":\"device_trust\",\"ph\":\"X\",\"ts\":" << event.beginNs / 1000.0
+             << ",\"dur\":" << event.durationNs / 1000.0 << ",\"pid\":" << pid << ",\"tid\":" << event.tid
+             << "}";
+        first = false;
+    }
+    json << "],\"displayTimeUnit\":\"ns\"}";
+    return json.str();
+}
+
+void TraceRing::clear() {
+    for (Slot& slot : slots_) {
+        slot.sequence.store(0, std::memory_order_relaxed);
+    }
+    next_.store(0, std::memory_order_release);
+}
+
+TraceRing& traceRing() {
+    static TraceRing ring;
+    return ring;
+}
+
+void setTraceRecording(bool enabled) {
+    g_traceRecording.store(enabled, std::memory_order_relaxed);
+}
+
+void recordTraceSection(const char* name, long long beginNs, long long durationNs) {
+    if (g_traceRecording.load(std::memory_order_relaxed)) {
+        traceRing().record(name, beginNs, durationNs, currentTid());
+    }
+}
+
+TraceSection::TraceSection(const char* name)
+    : name_(name), beginNs_(monotonicNs()), systemTraced_(beginSystemSection(name)) {}
+
+TraceSection::~TraceSection() {
+    if (systemTraced_) {
+        endSystemSection();
+    }
+    recordTraceSection(name_, beginNs_, monotonicNs() - beginNs_);
+}
+
+}  // namespace device_trust
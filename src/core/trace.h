@@ -0,0 +1,100 @@
+// [DeviceTrust/Core] Trace sections
+// Scoped sections around every check so scans show up on system traces
+// (Perfetto / systrace on Android, ftrace on Linux hosts), plus an
+// in-process ring buffer of completed sections that can be exported as
+// Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace device_trust {
+
+static const int TRACE_RING_CAPACITY = 1024;  // power of two
+static const int TRACE_NAME_LEN = 48;
+
+/**
+ * One completed section
+ */
+struct TraceEvent {
+    char name[TRACE_NAME_LEN];
+    long long beginNs;  // CLOCK_MONOTONIC (System.nanoTime() on Android)
+    long long durationNs;
+    int tid;
+};
+
+/**
+ * Lock-free ring of the last TRACE_RING_CAPACITY sections
+ *
+ * Writers claim a slot with one fetch_add and publish it with a per-slot
+ * sequence number (seqlock), so a concurrent dump skips slots that are being
+ * overwritten instead of returning torn events.
+ */
+class TraceRing {
+public:
+    TraceRing() = default;
+    TraceRing(const TraceRing&) = delete;
+    TraceRing& operator=(const TraceRing&) = delete;
+
+    void record(const char* name, long long beginNs, long long durationNs, int tid);
+
+    /**
+     * Chrome trace JSON of the buffered sections, oldest first:
+     *
+     *   {"traceEvents":[{"name":"nativeMaps","cat":"device_trust","ph":"X",
+     *     "ts":<us>,"dur":<us>,"pid":N,"tid":N},...],"displayTimeUnit":"ns"}
+     */
+    std::string toChromeJson() const;
+
+    void clear();
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};  // 2 * claim + 1 while written, + 2 once published
+        TraceEvent event;
+    };
+
+    std::atomic<uint64_t> next_{0};
+    Slot slots_[TRACE_RING_CAPACITY];
+};
+
+/**
+ * Ring shared by the native stages and the platform layers
+ */
+TraceRing& traceRing();
+
+/**
+ * Enables or disables recording into traceRing() (on by default); system
+ * trace sections are emitted independently whenever a tracer is attached.
+ */
+void setTraceRecording(bool enabled);
+
+/**
+ * Records a section of the calling thread timed elsewhere (Kotlin checks,
+ * same clock) into traceRing(), if recording is enabled
+ */
+void recordTraceSection(const char* name, long long beginNs, long long durationNs);
+
+/**
+ * Scoped section: ATrace_beginSection/endSection on Android, "B|pid|name" /
+ * "E|pid" writes to the ftrace trace_marker on Linux hosts with tracing on,
+ * and one TraceEvent in traceRing() when the scope ends
+ *
+ * [name] must outlive the section (string literals, stage tables).
+ */
+class TraceSection {
+public:
+    explicit TraceSection(const char* name);
+    ~TraceSection();
+    TraceSection(const TraceSection&) = delete;
+    TraceSection& operator=(const TraceSection&) = delete;
+
+private:
+    const char* name_;
+    long long beginNs_;
+    bool systemTraced_;
+};
+
+}  // namespace device_trust
@@ -0,0 +1,149 @@
+// [DeviceTrust/Core] Published verdict
+// Latest report flags in one atomic word, for per-request checks that cannot
+// afford an async report round-trip.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace device_trust {
+
+/**
+ * Verdict word layout (one 64-bit value; readers need a single atomic load)
+ *
+ *   bits  0-5   report flags (VERDICT_*)
+ *   bits  6-10  signal groups evaluated so far (SignalGroup bits)
+ *   bit   11    pending: a monitor detector changed, rescan not published yet
+ *   bits 12-23  sequence number, 1..4095 then wraps to 1 (0 = never published)
+ *   bits 24-25  hook tier: scan level (0 fast, 1 standard, 2 deep) behind the
+ *               hook flag
+ *   bits 26-63  publish time in ms on the platform clock (CLOCK_BOOTTIME on
+ *               Android, i.e. SystemClock.elapsedRealtime)
+ */
+enum VerdictFlag : uint32_t {
+    VERDICT_ROOTED = 1u << 0,
+    VERDICT_EMULATOR = 1u << 1,
+    VERDICT_DEV_MODE = 1u << 2,
+    VERDICT_ADB = 1u << 3,
+    VERDICT_FRIDA = 1u << 4,
+    VERDICT_DEBUGGER = 1u << 5,
+    VERDICT_FLAG_MASK = (1u << 6) - 1
+};
+
+static const int VERDICT_GROUPS_SHIFT = 6;
+static const uint32_t VERDICT_GROUPS_MASK = 0x1F;
+static const uint64_t VERDICT_PENDING = 1ull << 11;
+static const int VERDICT_SEQ_SHIFT = 12;
+static const uint32_t VERDICT_SEQ_MASK = 0xFFF;
+static const int VERDICT_TIER_SHIFT = 24;
+static const uint32_t VERDICT_TIER_MASK = 0x3;
+static const int VERDICT_TIME_SHIFT = 26;
+static const uint64_t VERDICT_TIME_MASK = (1ull << 38) - 1;
+
+// SignalGroup bit of the hook group, the only one whose checks depend on the
+// scan level
+static const uint32_t VERDICT_HOOK_GROUP = 8;
+
+/**
+ * Flags owned by each signal group (SignalGroup bits: root, emulator,
+ * developer, hook, debugger)
+ */
+inline uint32_t verdictFlagsOfGroups(uint32_t groups) {
+    uint32_t flags = 0;
+    if (groups & 1) {
+        flags |= VERDICT_ROOTED;
+    }
+    if (groups & 2) {
+        flags |= VERDICT_EMULATOR;
+    }
+    if (groups & 4) {
+        flags |= VERDICT_DEV_MODE | VERDICT_ADB;
+    }
+    if (groups & 8) {
+        flags |= VERDICT_FRIDA;
+    }
+    if (groups & 16) {
+        flags |= VERDICT_DEBUGGER;
+    }
+    return flags;
+}
+
+inline uint32_t verdictSeq(uint64_t word) {
+    return (uint32_t)(word >> VERDICT_SEQ_SHIFT) & VERDICT_SEQ_MASK;
+}
+
+inline uint32_t verdictHookTier(uint64_t word) {
+    return (uint32_t)(word >> VERDICT_TIER_SHIFT) & VERDICT_TIER_MASK;
+}
+
+/**
+ * Single-word verdict, on its own cache line so publishes do not contend
+ * with unrelated writes
+ *
+ * Writers are rare (one per scan) and use a CAS loop; readers only load().
+ */
+struct alignas(64) VerdictBlock {
+    std::atomic<uint64_t> word{0};
+
+    uint64_t load() const {
+        return word.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Publishes one report's flags
+     *
+     * Flags of [groups], the groups the report evaluated completely, replace
+     * their last published value; any other set bit of [flags] (a hit of a
+     * group the report only partly evaluated) is added but clears nothing.
+     * A hook flag set by a scan of a higher [tier] is not cleared by a weaker
+     * one (a FAST scan after a DEEP one). Clears the pending bit.
+     *
+     * @param tier scan level of the report (0 fast, 1 standard, 2 deep)
+     * @return the published word
+     */
+    uint64_t publish(uint32_t groups, uint32_t flags, uint32_t tier, uint64_t nowMs) {
+        groups &= VERDICT_GROUPS_MASK;
+        flags &= VERDICT_FLAG_MASK;
+        tier &= VERDICT_TIER_MASK;
+        uint64_t current = word.load(std::memory_order_relaxed);
+        uint64_t next;
+        do {
+            uint32_t currentFlags = (uint32_t)current & VERDICT_FLAG_MASK;
+            uint32_t hookTier = verdictHookTier(current);
+            uint32_t owned = verdictFlagsOfGroups(groups);
+            bool hookHeld = (currentFlags & VERDICT_FRIDA) && tier < hookTier;
+            if (hookHeld) {
+                owned &= ~VERDICT_FRIDA;  // only a scan of the same tier or higher clears it
+            }
+            bool hookRaised = (flags & VERDICT_FRIDA) && !(currentFlags & VERDICT_FRIDA);
+            if (hookRaised || ((groups & VERDICT_HOOK_GROUP) && !hookHeld)) {
+                hookTier = tier;
+            }
+            uint32_t seq = verdictSeq(current) % VERDICT_SEQ_MASK + 1;
+            uint32_t mergedFlags = (currentFlags & ~owned) | flags;
+            uint32_t mergedGroups = ((uint32_t)(current >> VERDICT_GROUPS_SHIFT) & VERDICT_GROUPS_MASK) | groups;
+            next = (uint64_t)mergedFlags | ((uint64_t)mergedGroups << VERDICT_GROUPS_SHIFT) |
+                   ((uint64_t)seq << VERDICT_SEQ_SHIFT) | ((uint64_t)hookTier << VERDICT_TIER_SHIFT) |
+                   ((nowMs & VERDICT_TIME_MASK) << VERDICT_TIME_SHIFT);
+        } while (!word.compare_exchange_weak(current, next, std::memory_order_release, std::memory_order_relaxed));
+        return next;
+    }
+
+    /**
+     * Marks the published verdict as possibly outdated (no-op before the
+     * first publish)
+     */
+    void markPending() {
+        uint64_t current = word.load(std::memory_order_relaxed);
+        while (current != 0 && !(current & VERDICT_PENDING) &&
+               !word.compare_exchange_weak(current, current | VERDICT_PENDING, std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+        }
+    }
+};
+
+static_assert(sizeof(VerdictBlock) == 64, "VerdictBlock must fill one cache line");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "verdict word must be lock-free");
+
+}  // namespace device_trust
@@ -0,0 +1,220 @@
+// [DeviceTrust/Core] Work-stealing pool for deep-tier scans
+
+#include "work_pool.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace device_trust {
+
+namespace {
+
+// cpuinfo_max_freq of [cpu] in kHz; 0 if unreadable
+long cpuMaxFrequency(int cpu) {
+    char path[96];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", cpu);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return 0;
+    }
+    char text[32];
+    ssize_t length = read(fd, text, sizeof(text) - 1);
+    close(fd);
+    if (length <= 0) {
+        return 0;
+    }
+    text[length] = '\0';
+    return strtol(text, nullptr, 10);
+}
+
+#ifdef __linux__
+void pinToBigCores(int worker) {
+    char name[16];
+    snprintf(name, sizeof(name), "dt-deep-%d", worker);
+    pthread_setname_np(pthread_self(), name);
+
+    static const int MAX_CPUS = 256;
+    int cpus[MAX_CPUS];
+    int count = bigCores(cpus, MAX_CPUS);
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int i = 0; i < count; i++) {
+        if (cpus[i] < CPU_SETSIZE) {
+            CPU_SET(cpus[i], &set);
+        }
+    }
+    // Fail-soft: left on every core if the kernel refuses
+    sched_setaffinity(0, sizeof(set), &set);
+}
+#else
+void pinToBigCores(int /* worker */) {
+    // No affinity API on Apple platforms; QoS of the caller applies
+}
+#endif
+
+}  // namespace
+
+WorkPool::WorkPool(int threads) : threads_(std::max(threads, 0)), ranges_((size_t)std::max(threads, 0) + 1) {}
+
+WorkPool::~WorkPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& thread : pool_) {
+        thread.join();
+    }
+}
+
+void WorkPool::start() {
+    for (int worker = 1; worker <= threads_; worker++) {
+        pool_.emplace_back(&WorkPool::workerLoop, this, worker);
+    }
+}
+
+void WorkPool::workerLoop(int worker) {
+    pinToBigCores(worker);
+    unsigned long seen = 0;
+    while (true) {
+        Job* job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this, seen] { return stopping_ || generation_ != seen; });
+            if (stopping_) {
+                return;
+            }
+            seen = generation_;
+            job = job_;
+        }
+        work(*job, worker);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+}
+
+void WorkPool::work(Job& job, int worker) {
+    Deadline deadline = job.deadline;
+    // Own range first, then steal from the next ones
+    for (int offset = 0; offset < job.workers; offset++) {
+        Range& range = job.ranges[(worker + offset) % job.workers];
+        while (true) {
+            if (job.stopped.load(std::memory_order_relaxed)) {
+                return;
+            }
+            if ((job.cancel != nullptr && job.cancel->load(std::memory_order_relaxed)) || deadline.expired()) {
+                if (deadline.hit) {
+                    job.deadlineHit.store(true, std::memory_order_relaxed);
+                }
+                job.stopped.store(true, std::memory_order_relaxed);
+                return;
+            }
+            size_t begin = range.next.fetch_add(job.grain, std::memory_order_relaxed);
+            if (begin >= range.end) {
+                break;
+            }
+            size_t end = std::min(begin + job.grain, range.end);
+            if (!job.chunk(begin, end, worker, deadline, job.context)) {
+                if (deadline.hit) {
+                    job.deadlineHit.store(true, std::memory_order_relaxed);
+                }
+                job.stopped.store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+    if (deadline.hit) {
+        job.deadlineHit.store(true, std::memory_order_relaxed);
+    }
+}
+
+bool WorkPool::run(size_t count, size_t grain, WorkChunk chunk, void* context, Deadline& deadline,
+                   const std::atomic<bool>* cancel) {
+    if (count == 0) {
+        return true;
+    }
+    grain = std::max<size_t>(grain, 1);
+
+    // Busy (another scan thread owns the pool) or too small: inline
+    std::unique_lock<std::mutex> running(runMutex_, std::defer_lock);
+    bool parallel = threads_ > 0 && count > grain && running.try_lock();
+    int workers = parallel ? threads_ + 1 : 1;
+    Range inlineRange;
+    Range* ranges = parallel ? ranges_.data() : &inlineRange;
+    for (int worker = 0; worker < workers; worker++) {
+        ranges[worker].next.store(count * worker / workers, std::memory_order_relaxed);
+        ranges[worker].end = count * (worker + 1) / workers;
+    }
+    Job job{grain, chunk, context, deadline, cancel, ranges, workers};
+
+    if (parallel) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (pool_.empty()) {
+                start();
+            }
+            job_ = &job;
+            pending_ = threads_;
+            generation_++;
+        }
+        wake_.notify_all();
+        work(job, 0);
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+        job_ = nullptr;
+    } else {
+        work(job, 0);
+    }
+
+    if (job.deadlineHit.load(std::memory_order_relaxed)) {
+        deadline.hit = true;
+    }
+    return !job.stopped.load(std::memory_order_relaxed);
+}
+
+int bigCores(int* cpus, int max) {
+    long configured = sysconf(_SC_NPROCESSORS_CONF);
+    int total = (int)std::min<long>(configured > 0 ? configured : 1, max);
+    long slowest = 0;
+    long fastest = 0;
+    bool known = true;
+    for (int cpu = 0; cpu < total && known; cpu++) {
+        long frequency = cpuMaxFrequency(cpu);
+        known = frequency > 0;
+        slowest = cpu == 0 ? frequency : std::min(slowest, frequency);
+        fastest = std::max(fastest, frequency);
+    }
+
+    int count = 0;
+    for (int cpu = 0; cpu < total; cpu++) {
+        if (!known || slowest == fastest || cpuMaxFrequency(cpu) > slowest) {
+            cpus[count++] = cpu;
+        }
+    }
+    return count;
+}
+
+WorkPool& deepScanPool() {
+    // Leaked: worker threads must outlive static destruction at exit
+    static WorkPool* pool = [] {
+        int cpus[DEEP_SCAN_MAX_WORKERS * 64];
+        int cores = bigCores(cpus, DEEP_SCAN_MAX_WORKERS * 64);
+        return new WorkPool(std::min(cores, DEEP_SCAN_MAX_WORKERS) - 1);
+    }();
+    return *pool;
+}
+
+}  // namespace device_trust
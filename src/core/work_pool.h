@@ -0,0 +1,125 @@
+// [DeviceTrust/Core] Work-stealing pool for deep-tier scans
+// Splits an index range (regions, windows, ...) into chunks and runs them on
+// the calling thread plus a few worker threads kept on the big cores.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "deadline.h"
+
+namespace device_trust {
+
+/**
+ * Runs items [begin, end) of a WorkPool::run job
+ *
+ * [worker] is 0 for the calling thread and 1..workers()-1 for pool threads;
+ * per-worker state indexed by it needs no locks. [deadline] is the worker's
+ * copy of the job deadline.
+ *
+ * @return false to stop the whole job (result found, deadline hit)
+ */
+typedef bool (*WorkChunk)(size_t begin, size_t end, int worker, Deadline& deadline, void* context);
+
+/**
+ * Small work-stealing pool
+ *
+ * A job of [count] items is cut into one contiguous range per worker. Each
+ * worker claims [grain] items at a time from the front of its own range
+ * with one fetch_add; once it is empty it claims from the others' ranges
+ * the same way, so uneven chunks (a large region, a slow page) do not leave
+ * workers idle. Claims are the only shared writes; results go to per-worker
+ * slots that the caller merges after run() returns.
+ *
+ * Threads start on the first run and are kept until destruction. One job
+ * runs at a time; a run() that finds the pool busy runs inline on its
+ * caller instead of waiting.
+ */
+class WorkPool {
+public:
+    /**
+     * @param threads worker threads besides the caller (0: every job runs inline)
+     */
+    explicit WorkPool(int threads);
+    ~WorkPool();
+
+    WorkPool(const WorkPool&) = delete;
+    WorkPool& operator=(const WorkPool&) = delete;
+
+    /**
+     * Upper bound of the [worker] index passed to chunks, plus one
+     */
+    int workers() const {
+        return threads_ + 1;
+    }
+
+    /**
+     * Runs [chunk] over [0, count) and returns once every claimed chunk finished
+     *
+     * @param deadline stops claiming once expired; marked hit if any worker hit it
+     * @param cancel   stops claiming once set (e.g. by another thread)
+     * @return false if the job stopped before every item ran
+     */
+    bool run(size_t count, size_t grain, WorkChunk chunk, void* context, Deadline& deadline,
+             const std::atomic<bool>* cancel = nullptr);
+
+private:
+    struct alignas(64) Range {
+        std::atomic<size_t> next{0};
+        size_t end = 0;
+    };
+
+    struct Job {
+        size_t grain;
+        WorkChunk chunk;
+        void* context;
+        Deadline deadline;
+        const std::atomic<bool>* cancel;
+        Range* ranges;
+        int workers;  // ranges in use
+        std::atomic<bool> stopped{false};
+        std::atomic<bool> deadlineHit{false};
+    };
+
+    void start();
+    void workerLoop(int worker);
+    void work(Job& job, int worker);
+
+    int threads_;
+    std::vector<std::thread> pool_;
+    std::vector<Range> ranges_;
+
+    std::mutex runMutex_;  // one job at a time
+    std::mutex mutex_;     // guards job_, generation_, pending_, stopping_
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    Job* job_ = nullptr;
+    unsigned long generation_ = 0;
+    int pending_ = 0;  // pool threads still on the current job
+    bool stopping_ = false;
+};
+
+/**
+ * CPUs of the fastest cluster(s): every core whose cpufreq maximum is above
+ * the slowest cluster's, so big.LITTLE devices skip the little cores.
+ * Falls back to every configured CPU when cpufreq is not readable (hosts,
+ * emulators, iOS).
+ *
+ * @return number of CPUs written to [cpus] (at most [max])
+ */
+int bigCores(int* cpus, int max);
+
+/**
+ * Pool shared by the deep-tier stages: one thread per big core besides the
+ * caller, at most DEEP_SCAN_MAX_WORKERS workers in total
+ */
+static const int DEEP_SCAN_MAX_WORKERS = 4;
+
+WorkPool& deepScanPool();
+
+}  // namespace device_trust
@@ -0,0 +1,71 @@
+// [DeviceTrust/Core] Mach/dyld backend (iOS)
+
+#if defined(__APPLE__)
+
+#include "mach_backend.h"
+
+#include <dlfcn.h>
+#include <mach-o/dyld.h>
+#include <mach/mach.h>
+
+#include <cstring>
+
+namespace device_trust {
+
+bool MachBackend::forEachRegion(RegionVisitor visit, void* context) {
+    mach_port_t task = mach_task_self();
+    vm_address_t address = 0;
+    vm_size_t size = 0;
+    MemoryRegion region;
+
+    while (true) {
+        vm_region_basic_info_data_64_t info;
+        mach_msg_type_number_t count = VM_REGION_BASIC_INFO_COUNT_64;
+        mach_port_t objectName = MACH_PORT_NULL;
+
+        kern_return_t kr = vm_region_64(task, &address, &size, VM_REGION_BASIC_INFO_64,
+                                        (vm_region_info_t)&info, &count, &objectName);
+        if (kr != KERN_SUCCESS) {
+            break;
+        }
+
+        region.start = address;
+        region.end = address + size;
+        region.read = (info.protection & VM_PROT_READ) != 0;
+        region.write = (info.protection & VM_PROT_WRITE) != 0;
+        region.exec = (info.protection & VM_PROT_EXECUTE) != 0;
+        if (!visit(region, context)) {
+            break;
+        }
+        address += size;
+    }
+    return true;
+}
+
+bool MachBackend::forEachImage(PathVisitor visit, void* context) {
+    uint32_t imageCount = _dyld_image_count();
+    for (uint32_t i = 0; i < imageCount; i++) {
+        const char* imageName = _dyld_get_image_name(i);
+        if (imageName != nullptr && !visit(imageName, strlen(imageName), context)) {
+            break;
+        }
+    }
+    return true;
+}
+
+bool MachBackend::forEachOpenFile(PathVisitor /* visit */, void* /* context */) {
+    return false;
+}
+
+bool MachBackend::imagePathForAddress(const void* address, const char** path) {
+    Dl_info info;
+    if (dladdr(address, &info) == 0 || info.dli_fname == nullptr) {
+        return false;
+    }
+    *path = info.dli_fname;
+    return true;
+}
+
+}  // namespace device_trust
+
+#endif  // __APPLE__
@@ -0,0 +1,22 @@
+// [DeviceTrust/Core] Mach/dyld backend (iOS)
+
+#pragma once
+
+#include "../core/platform.h"
+
+namespace device_trust {
+
+/**
+ * Reads the calling task through vm_region_64, the dyld image list and dladdr
+ *
+ * Regions carry no paths (use forEachImage); open files are not available.
+ */
+class MachBackend : public PlatformBackend {
+public:
+    bool forEachRegion(RegionVisitor visit, void* context) override;
+    bool forEachImage(PathVisitor visit, void* context) override;
+    bool forEachOpenFile(PathVisitor visit, void* context) override;
+    bool imagePathForAddress(const void* address, const char** path) override;
+};
+
+}  // namespace device_trust
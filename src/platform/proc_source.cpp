@@ -0,0 +1,88 @@
+// [DeviceTrust/Core] procfs root
+
+#include "proc_source.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include "../core/telemetry.h"
+
+namespace device_trust {
+
+// Room kept for the longest relative name ("fd/<number>")
+static const size_t RELATIVE_NAME_MAX = 32;
+
+ProcSource::ProcSource() : self_(true), pid_(getpid()) {
+    strcpy(root_, "/proc/self");
+}
+
+ProcSource ProcSource::forPid(int pid) {
+    ProcSource source;
+    source.self_ = pid == getpid();
+    source.pid_ = pid;
+    snprintf(source.root_, sizeof(source.root_), "/proc/%d", pid);
+    return source;
+}
+
+ProcSource ProcSource::snapshot(const char* dir) {
+    ProcSource source;
+    source.self_ = false;
+    source.pid_ = -1;
+    size_t length = dir != nullptr ? strlen(dir) : 0;
+    if (length == 0 || length > sizeof(source.root_) - RELATIVE_NAME_MAX) {
+        source.root_[0] = '\0';  // resolve() fails for every name
+        return source;
+    }
+    memcpy(source.root_, dir, length + 1);
+    // "snap/" and "snap" name the same root
+    while (length > 1 && source.root_[length - 1] == '/') {
+        source.root_[--length] = '\0';
+    }
+    return source;
+}
+
+bool ProcSource::resolve(const char* name, char* out, size_t size) const {
+    if (root_[0] == '\0') {
+        return false;
+    }
+    int written = snprintf(out, size, "%s/%s", root_, name);
+    return written > 0 && static_cast<size_t>(written) < size;
+}
+
+int ProcSource::openFile(const char* name) const {
+    char path[PATH_MAX];
+    if (!resolve(name, path, sizeof(path))) {
+        return -1;
+    }
+    telemetry().addIo(TELEMETRY_IO_SYSCALLS, 1);
+    return open(path, O_RDONLY | O_CLOEXEC);
+}
+
+DIR* ProcSource::openDir(const char* name) const {
+    char path[PATH_MAX];
+    if (!resolve(name, path, sizeof(path))) {
+        return nullptr;
+    }
+    telemetry().addIo(TELEMETRY_IO_SYSCALLS, 1);
+    return opendir(path);
+}
+
+ssize_t ProcSource::readLink(const char* name, char* buf, size_t size) const {
+    char path[PATH_MAX];
+    if (size == 0 || !resolve(name, path, sizeof(path))) {
+        return -1;
+    }
+    ssize_t len = readlink(path, buf, size - 1);
+    if (len < 0) {
+        telemetry().addIo(TELEMETRY_IO_SYSCALLS, 1);
+        return -1;
+    }
+    telemetry().addRead((uint64_t)len);
+    buf[len] = '\0';
+    return len;
+}
+
+}  // namespace device_trust
@@ -0,0 +1,88 @@
+// [DeviceTrust/Core] procfs root
+// Every procfs read of the procfs backend goes through a ProcSource, so the
+// same scanners run against the live process, another PID or a captured
+// snapshot directory (regression tests, benchmark replay of device captures).
+
+#pragma once
+
+#include <dirent.h>
+#include <limits.h>
+#include <sys/types.h>
+
+#include <cstddef>
+
+namespace device_trust {
+
+/**
+ * Directory laid out like /proc/<pid>
+ *
+ * Files read below the root:
+ * - maps      memory regions
+ * - status    TracerPid, Threads
+ * - fd/       one symlink per descriptor; only the link text is read, so a
+ *             snapshot stores targets such as "socket:[1234]" as dangling links
+ *
+ * Open descriptors are never cached: the source is only a path prefix.
+ */
+class ProcSource {
+public:
+    /**
+     * /proc/self
+     */
+    ProcSource();
+
+    static ProcSource forPid(int pid);
+
+    /**
+     * @param dir snapshot root; paths longer than PATH_MAX - 32 yield a
+     *            source whose reads all fail
+     */
+    static ProcSource snapshot(const char* dir);
+
+    /**
+     * True for /proc/self: the loader (dladdr, dl_iterate_phdr) describes the
+     * same process, so image checks are meaningful
+     */
+    bool isSelf() const {
+        return self_;
+    }
+
+    /**
+     * Process behind the source; -1 for snapshots
+     */
+    int pid() const {
+        return pid_;
+    }
+
+    const char* root() const {
+        return root_;
+    }
+
+    /**
+     * root + "/" + [name] into [out]
+     *
+     * @return false if it does not fit
+     */
+    bool resolve(const char* name, char* out, size_t size) const;
+
+    /**
+     * open(O_RDONLY | O_CLOEXEC) of [name] below the root; -1 on error
+     */
+    int openFile(const char* name) const;
+
+    DIR* openDir(const char* name) const;
+
+    /**
+     * readlink of [name] below the root, NUL-terminated
+     *
+     * @return target length; -1 on error
+     */
+    ssize_t readLink(const char* name, char* buf, size_t size) const;
+
+private:
+    char root_[PATH_MAX];
+    bool self_ = false;
+    int pid_ = -1;
+};
+
+}  // namespace device_trust
@@ -0,0 +1,257 @@
+// [DeviceTrust/Core] procfs backend (Android / Linux)
+
+#include "procfs_backend.h"
+
+#include <dirent.h>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <link.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../core/telemetry.h"
+
+namespace device_trust {
+
+namespace {
+
+// Longest maps line kept whole; longer paths are cut (the keyword scan
+// still sees the first PATH_MAX bytes)
+const size_t MAPS_LINE_MAX = PATH_MAX + 128;
+
+bool parseHex(const char*& cursor, const char* end, uintptr_t* out) {
+    uintptr_t value = 0;
+    const char* start = cursor;
+    while (cursor < end) {
+        char c = *cursor;
+        int digit;
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            digit = c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else {
+            break;
+        }
+        value = (value << 4) | static_cast<uintptr_t>(digit);
+        cursor++;
+    }
+    *out = value;
+    return cursor > start;
+}
+
+const char* skipField(const char* cursor, const char* end) {
+    while (cursor < end && *cursor == ' ') {
+        cursor++;
+    }
+    while (cursor < end && *cursor != ' ') {
+        cursor++;
+    }
+    return cursor;
+}
+
+struct ImageVisit {
+    PathVisitor visit;
+    void* context;
+};
+
+int visitLoadedObject(struct dl_phdr_info* info, size_t /* size */, void* data) {
+    ImageVisit& images = *static_cast<ImageVisit*>(data);
+    if (info->dlpi_name == nullptr || info->dlpi_name[0] == '\0') {
+        return 0;  // main executable / vdso without a path
+    }
+    return images.visit(info->dlpi_name, strlen(info->dlpi_name), images.context) ? 0 : 1;
+}
+
+}  // namespace
+
+bool parseMapsLine(const char* line, size_t length, MemoryRegion* region) {
+    const char* cursor = line;
+    const char* end = line + length;
+
+    if (!parseHex(cursor, end, &region->start) || cursor >= end || *cursor != '-') {
+        return false;
+    }
+    cursor++;
+    if (!parseHex(cursor, end, &region->end) || cursor >= end || *cursor != ' ') {
+        return false;
+    }
+    cursor++;
+    if (end - cursor < 4) {
+        return false;
+    }
+    region->read = cursor[0] == 'r';
+    region->write = cursor[1] == 'w';
+    region->exec = cursor[2] == 'x';
+    cursor += 4;
+
+    // offset, dev, inode
+    for (int field = 0; field < 3; field++) {
+        cursor = skipField(cursor, end);
+    }
+    while (cursor < end && *cursor == ' ') {
+        cursor++;
+    }
+    region->path = cursor;
+    region->pathLength = static_cast<size_t>(end - cursor);
+    return true;
+}
+
+bool ProcfsBackend::forEachRegion(RegionVisitor visit, void* context) {
+    int fd = source_.openFile("maps");
+    if (fd < 0) {
+        return false;
+    }
+
+    char chunk[8192];
+    char carry[MAPS_LINE_MAX];  // line split across read() chunks
+    size_t carryLength = 0;
+    bool stopped = false;
+    MemoryRegion region;
+    ssize_t len;
+
+    while (!stopped && (len = read(fd, chunk, sizeof(chunk))) > 0) {
+        telemetry().addRead((uint64_t)len);
+        const char* cursor = chunk;
+        const char* chunkEnd = chunk + len;
+        while (cursor < chunkEnd) {
+            const char* newline = static_cast<const char*>(memchr(cursor, '\n', chunkEnd - cursor));
+            size_t piece = static_cast<size_t>((newline != nullptr ? newline : chunkEnd) - cursor);
+
+            if (newline == nullptr || carryLength > 0) {
+                size_t room = sizeof(carry) - carryLength;
+                size_t copied = piece < room ? piece : room;
+                memcpy(carry + carryLength, cursor, copied);
+                carryLength += copied;
+            }
+            if (newline == nullptr) {
+                break;  // rest of the line arrives with the next read()
+            }
+
+            const char* line = carryLength > 0 ? carry : cursor;
+            size_t lineLength = carryLength > 0 ? carryLength : piece;
+            if (parseMapsLine(line, lineLength, &region) && !visit(region, context)) {
+                stopped = true;
+                break;
+            }
+            carryLength = 0;
+            cursor = newline + 1;
+        }
+    }
+    if (!stopped && carryLength > 0 && parseMapsLine(carry, carryLength, &region)) {
+        visit(region, context);
+    }
+
+    close(fd);
+    telemetry().addIo(TELEMETRY_IO_SYSCALLS, 1);
+    return true;
+}
+
+bool ProcfsBackend::forEachImage(PathVisitor visit, void* context) {
+    if (!source_.isSelf()) {
+        return false;
+    }
+    ImageVisit images{visit, context};
+    dl_iterate_phdr(visitLoadedObject, &images);
+    return true;
+}
+
+bool ProcfsBackend::forEachOpenFile(PathVisitor visit, void* context) {
+    DIR* dir = source_.openDir("fd");
+    if (!dir) {
+        return false;
+    }
+
+    char fdName[NAME_MAX + 4];
+    char linkTarget[PATH_MAX];
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        snprintf(fdName, sizeof(fdName), "fd/%s", entry->d_name);
+        ssize_t len = source_.readLink(fdName, linkTarget, sizeof(linkTarget));
+        if (len <= 0) {
+            continue;
+        }
+        if (!visit(linkTarget, static_cast<size_t>(len), context)) {
+            break;
+        }
+    }
+
+    closedir(dir);
+    return true;
+}
+
+bool ProcfsBackend::imagePathForAddress(const void* address, const char** path) {
+    if (!source_.isSelf()) {
+        return false;
+    }
+    Dl_info info;
+    if (dladdr(address, &info) == 0 || info.dli_fname == nullptr) {
+        return false;
+    }
+    *path = info.dli_fname;
+    return true;
+}
+
+size_t ProcfsBackend::readMemory(uintptr_t address, void* out, size_t size) {
+    if (source_.pid() <= 0 || size == 0) {
+        return 0;
+    }
+    struct iovec local = {out, size};
+    struct iovec remote = {reinterpret_cast<void*>(address), size};
+    ssize_t copied = process_vm_readv(source_.pid(), &local, 1, &remote, 1, 0);
+    telemetry().addIo(TELEMETRY_IO_SYSCALLS, 1);
+    return copied > 0 ? (size_t)copied : 0;
+}
+
+bool ProcfsBackend::residentPages(uintptr_t address, size_t pages, uint8_t* resident) {
+    if (!source_.isSelf() || pages == 0) {
+        return false;
+    }
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    telemetry().addIo(TELEMETRY_IO_SYSCALLS, 1);
+    return mincore(reinterpret_cast<void*>(address), pages * pageSize, resident) == 0;
+}
+
+ProcStatus readProcStatus(const ProcSource& source) {
+    ProcStatus status;
+    int fd = source.openFile("status");
+    if (fd < 0) {
+        return status;
+    }
+
+    char buf[4096];
+    ssize_t len = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    telemetry().addRead(len > 0 ? (uint64_t)len : 0);
+    telemetry().addIo(TELEMETRY_IO_SYSCALLS, 1);
+    if (len <= 0) {
+        return status;
+    }
+    buf[len] = '\0';
+    return parseProcStatus(buf);
+}
+
+ProcStatus parseProcStatus(const char* text) {
+    ProcStatus status;
+    const char* tracer = strstr(text, "TracerPid:");
+    if (tracer != nullptr) {
+        status.tracerPid = atoi(tracer + strlen("TracerPid:"));
+    }
+    const char* threads = strstr(text, "Threads:");
+    if (threads != nullptr) {
+        status.threads = atoi(threads + strlen("Threads:"));
+    }
+    return status;
+}
+
+}  // namespace device_trust
@@ -0,0 +1,72 @@
+// [DeviceTrust/Core] procfs backend (Android / Linux)
+
+#pragma once
+
+#include <cstddef>
+
+#include "../core/platform.h"
+#include "proc_source.h"
+
+namespace device_trust {
+
+/**
+ * Reads a process through its procfs directory (see ProcSource), plus
+ * dl_iterate_phdr and dladdr for the calling process
+ *
+ * Images and symbol addresses come from the dynamic loader, so they are only
+ * available when [source] is the calling process; for other PIDs and
+ * snapshots forEachImage / imagePathForAddress return false. Snapshots hold
+ * no memory contents, so readMemory copies nothing for them.
+ */
+class ProcfsBackend : public PlatformBackend {
+public:
+    explicit ProcfsBackend(const ProcSource& source = ProcSource()) : source_(source) {}
+
+    const ProcSource& source() const {
+        return source_;
+    }
+
+    bool forEachRegion(RegionVisitor visit, void* context) override;
+    bool forEachImage(PathVisitor visit, void* context) override;
+    bool forEachOpenFile(PathVisitor visit, void* context) override;
+    bool imagePathForAddress(const void* address, const char** path) override;
+
+    /**
+     * process_vm_readv on the source's PID (needs ptrace access for other
+     * processes; always 0 for snapshots)
+     */
+    size_t readMemory(uintptr_t address, void* out, size_t size) override;
+
+    /**
+     * mincore; only known for the calling process
+     */
+    bool residentPages(uintptr_t address, size_t pages, uint8_t* resident) override;
+
+private:
+    ProcSource source_;
+};
+
+/**
+ * Parses one /proc/<pid>/maps line (without the trailing newline):
+ *   start-end perms offset dev inode [path]
+ *
+ * @return false if the address range or permissions are malformed
+ */
+bool parseMapsLine(const char* line, size_t length, MemoryRegion* region);
+
+/**
+ * TracerPid and thread count from <source>/status (0 if unreadable)
+ */
+struct ProcStatus {
+    int tracerPid = 0;
+    int threads = 0;
+};
+
+ProcStatus readProcStatus(const ProcSource& source = ProcSource());
+
+/**
+ * Same fields from status text already in memory (NUL-terminated)
+ */
+ProcStatus parseProcStatus(const char* text);
+
+}  // namespace device_trust
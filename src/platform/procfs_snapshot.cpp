@@ -0,0 +1,87 @@
+// [DeviceTrust/Core] Snapshot capture (procfs)
+
+#include "procfs_snapshot.h"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace device_trust {
+
+namespace {
+
+bool readWhole(const ProcSource& source, const char* name, size_t maxBytes, std::string* out) {
+    int fd = source.openFile(name);
+    if (fd < 0) {
+        return false;
+    }
+    char chunk[8192];
+    ssize_t len;
+    while (out->size() < maxBytes && (len = read(fd, chunk, sizeof(chunk))) > 0) {
+        out->append(chunk, static_cast<size_t>(len));
+    }
+    close(fd);
+    if (out->size() > maxBytes) {
+        out->resize(maxBytes);
+    }
+    return true;
+}
+
+bool collectPath(const char* path, size_t length, void* context) {
+    auto& list = *static_cast<std::vector<std::string>*>(context);
+    list.emplace_back(path, length);
+    return list.size() < static_cast<size_t>(SNAPSHOT_LIST_MAX_ENTRIES);
+}
+
+void readThreadNames(const ProcSource& source, std::vector<std::string>* out) {
+    DIR* dir = source.openDir("task");
+    if (dir == nullptr) {
+        return;
+    }
+    char name[NAME_MAX + 16];
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr && out->size() < static_cast<size_t>(SNAPSHOT_LIST_MAX_ENTRIES)) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        snprintf(name, sizeof(name), "task/%s/comm", entry->d_name);
+        std::string comm;
+        if (readWhole(source, name, 64, &comm)) {
+            while (!comm.empty() && comm.back() == '\n') {
+                comm.pop_back();
+            }
+            out->push_back(comm);
+        }
+    }
+    closedir(dir);
+}
+
+}  // namespace
+
+bool captureSnapshot(ProcfsBackend& backend, const void* symbolAddress, Snapshot* out) {
+    const ProcSource& source = backend.source();
+    *out = Snapshot();
+    if (!readWhole(source, "maps", SNAPSHOT_MAPS_MAX_BYTES, &out->maps)) {
+        return false;
+    }
+    readWhole(source, "status", 64 * 1024, &out->status);
+    readThreadNames(source, &out->threadNames);
+    backend.forEachOpenFile(collectPath, &out->openFiles);
+    backend.forEachImage(collectPath, &out->images);
+
+    const char* image = nullptr;
+    if (backend.imagePathForAddress(symbolAddress, &image) && image != nullptr) {
+        out->symbols.push_back({SNAPSHOT_PROBE_SYMBOL, image});
+    }
+
+    long long nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+    out->meta.emplace_back("source", source.root());
+    out->meta.emplace_back("capturedAtMs", std::to_string(nowMs));
+    return true;
+}
+
+}  // namespace device_trust
@@ -0,0 +1,26 @@
+// [DeviceTrust/Core] Snapshot capture (procfs)
+
+#pragma once
+
+#include "../core/snapshot.h"
+#include "procfs_backend.h"
+
+namespace device_trust {
+
+// Per-capture guardrails; a capture is for one flagged device, not a dump
+static const size_t SNAPSHOT_MAPS_MAX_BYTES = 16u * 1024 * 1024;
+static const int SNAPSHOT_LIST_MAX_ENTRIES = 20000;
+
+/**
+ * Reads every input of the native checks from [backend]: maps, status,
+ * task comms, fd link targets, loaded images and the image SNAPSHOT_PROBE_SYMBOL
+ * resolves to (calling process only)
+ *
+ * [symbolAddress] is the caller's address of SNAPSHOT_PROBE_SYMBOL, as passed
+ * to checkSymbolImage. Fail-soft: unreadable inputs stay empty.
+ *
+ * @return false if maps could not be read (nothing worth replaying)
+ */
+bool captureSnapshot(ProcfsBackend& backend, const void* symbolAddress, Snapshot* out);
+
+}  // namespace device_trust
@@ -0,0 +1,101 @@
+// [DeviceTrust/Core] Heap allocation counter for tests and benchmarks
+
+#include "alloc_counter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+thread_local size_t t_allocations = 0;
+thread_local size_t t_allocatedBytes = 0;
+
+void* countedAlloc(size_t size) {
+    t_allocations++;
+    t_allocatedBytes += size;
+    void* ptr = malloc(size > 0 ? size : 1);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* countedAlignedAlloc(size_t size, std::align_val_t align) {
+    t_allocations++;
+    t_allocatedBytes += size;
+    size_t alignment = static_cast<size_t>(align);
+    // aligned_alloc needs a size that is a multiple of the alignment
+    size_t rounded = (size + alignment - 1) / alignment * alignment;
+    void* ptr = aligned_alloc(alignment, rounded > 0 ? rounded : alignment);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+}  // namespace
+
+namespace device_trust_test {
+
+AllocationCounter::AllocationCounter() : startCount_(t_allocations), startBytes_(t_allocatedBytes) {}
+
+size_t AllocationCounter::count() const {
+    return t_allocations - startCount_;
+}
+
+size_t AllocationCounter::bytes() const {
+    return t_allocatedBytes - startBytes_;
+}
+
+}  // namespace device_trust_test
+
+// Replacement global allocation functions; the nothrow and array forms of the
+// standard library forward to these.
+
+void* operator new(size_t size) {
+    return countedAlloc(size);
+}
+
+void* operator new[](size_t size) {
+    return countedAlloc(size);
+}
+
+void* operator new(size_t size, std::align_val_t align) {
+    return countedAlignedAlloc(size, align);
+}
+
+void* operator new[](size_t size, std::align_val_t align) {
+    return countedAlignedAlloc(size, align);
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept {
+    free(ptr);
+}
@@ -0,0 +1,28 @@
+// [DeviceTrust/Core] Heap allocation counter for tests and benchmarks
+// alloc_counter.cpp replaces the global operator new/delete; linking it into
+// a binary makes every heap allocation on the counting thread observable.
+
+#pragma once
+
+#include <cstddef>
+
+namespace device_trust_test {
+
+/**
+ * Counts operator new calls made by the current thread while in scope
+ *
+ * Scopes nest; each sees the allocations made since it was opened.
+ */
+class AllocationCounter {
+public:
+    AllocationCounter();
+
+    size_t count() const;
+    size_t bytes() const;
+
+private:
+    size_t startCount_;
+    size_t startBytes_;
+};
+
+}  // namespace device_trust_test
@@ -0,0 +1,1619 @@
+// [DeviceTrust/Core] Host tests for the detection core
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../core/arena.h"
+#include "../core/check_breaker.h"
+#include "../core/json.h"
+#include "../core/keyword_automaton.h"
+#include "../core/keywords.h"
+#include "../core/obfuscated_string.h"
+#include "../core/packed_writer.h"
+#include "../core/pattern_search.h"
+#include "../core/perf_counters.h"
+#include "../core/scanners.h"
+#include "../core/signature_pack.h"
+#include "../core/snapshot.h"
+#include "../core/stage_timing.h"
+#include "../core/telemetry.h"
+#include "../core/trace.h"
+#include "../core/verdict.h"
+#include "../core/work_pool.h"
+#include "../platform/procfs_backend.h"
+#include "../platform/procfs_snapshot.h"
+#include "../tools/signature_source.h"
+#include "alloc_counter.h"
+#include "fixture_backend.h"
+#include "test_main.h"
+
+using namespace device_trust;
+using device_trust_test::AllocationCounter;
+using device_trust_test::FixtureBackend;
+
+static const long long NO_BUDGET = LLONG_MAX;
+
+// Built-in lists in plain text; the library only holds them encoded
+static const char* const* const MODULE_KEYWORDS_LINUX = SignaturePack::builtin()->list(SIGNATURE_MODULE_KEYWORDS);
+static const char* const* const FD_KEYWORDS_LINUX = SignaturePack::builtin()->list(SIGNATURE_FD_KEYWORDS);
+static const char* const* const IMAGE_KEYWORDS_DARWIN = SignaturePack::builtin()->list(SIGNATURE_IMAGE_KEYWORDS);
+static const char* const* const MEMORY_SIGNATURES_LINUX = SignaturePack::builtin()->list(SIGNATURE_MEMORY_SIGNATURES);
+
+// --- keywords ---
+
+TEST(findKeywordIgnoresCase) {
+    const char* text = "/data/local/tmp/Frida-Agent-64.so";
+    CHECK(findKeyword(text, strlen(text), MODULE_KEYWORDS_LINUX) != nullptr);
+    CHECK(strcmp(findKeyword(text, strlen(text), MODULE_KEYWORDS_LINUX), "frida") == 0);
+}
+
+TEST(findKeywordRespectsLength) {
+    const char* text = "/system/lib64/libc.so frida";
+    CHECK(findKeyword(text, strlen("/system/lib64/libc.so"), MODULE_KEYWORDS_LINUX) == nullptr);
+    CHECK(findKeyword(text, 0, MODULE_KEYWORDS_LINUX) == nullptr);
+    CHECK(findKeyword(nullptr, 10, MODULE_KEYWORDS_LINUX) == nullptr);
+}
+
+TEST(fridaKeywordsAreClassified) {
+    CHECK(isFridaKeyword("frida"));
+    CHECK(isFridaKeyword("gum-js"));
+    CHECK(isFridaKeyword("gum_js"));
+    CHECK(!isFridaKeyword("xposed"));
+    CHECK(!isFridaKeyword("gadget"));
+    CHECK(!isFridaKeyword(nullptr));
+}
+
+TEST(containsAnyFragmentIsCaseSensitive) {
+    CHECK(containsAnyFragment("/apex/com.android.runtime/lib64/bionic/libc.so", LIBC_IMAGE_FRAGMENTS_LINUX));
+    CHECK(containsAnyFragment("/usr/lib/system/libsystem_kernel.dylib", LIBC_IMAGE_FRAGMENTS_DARWIN));
+    CHECK(!containsAnyFragment("/data/app/libhook.so", LIBC_IMAGE_FRAGMENTS_LINUX));
+    CHECK(!containsAnyFragment("/APEX/LIBC.SO", LIBC_IMAGE_FRAGMENTS_LINUX));
+}
+
+TEST(obfuscatedStringDecodesAndMatchesEncoded) {
+    static constexpr ObfuscatedString<7> GUM_JS("gum-js", 0x1234abcdu);
+    ObfuscatedText text = GUM_JS.text();
+    char plain[decltype(GUM_JS)::BUFFER_SIZE];
+    CHECK(text.size() == 6);
+    CHECK(strcmp(text.decode(plain), "gum-js") == 0);
+    CHECK(memmem(&GUM_JS, sizeof(GUM_JS), "gum", 3) == nullptr);
+
+    const char* path = "/data/local/tmp/re.frida.server/GUM-JS-loop";
+    CHECK(text.containedIn(path, strlen(path)));
+    CHECK(!text.containedIn(path, strlen(path) - strlen("-JS-loop")));
+    CHECK(!text.containedIn("gum_js", 6));
+    CHECK(!text.containedIn(nullptr, 10));
+    CHECK(!ObfuscatedText().containedIn(path, strlen(path)));
+
+    // Built-in lists decode to their plain entries
+    size_t count = 0;
+    for (const ObfuscatedText* entry = MODULE_KEYWORDS_ENCODED; entry->size() > 0; entry++, count++) {
+        std::vector<char> decoded(entry->size() + 1);
+        CHECK(strcmp(entry->decode(decoded.data()), MODULE_KEYWORDS_LINUX[count]) == 0);
+    }
+    CHECK(count > 0 && MODULE_KEYWORDS_LINUX[count] == nullptr);
+}
+
+// Keyword the automaton found, from the list it was compiled from
+static const char* automatonKeyword(const KeywordAutomaton& automaton, const char* const* list, const char* text) {
+    int index = automaton.find(text, strlen(text));
+    return index >= 0 ? list[index] : nullptr;
+}
+
+TEST(keywordAutomatonAgreesWithFindKeyword) {
+    KeywordAutomatonTables compiled(MODULE_KEYWORDS_LINUX);
+    const KeywordAutomaton& modules = compiled.automaton();
+    const KeywordAutomaton& images = IMAGE_AUTOMATON_DARWIN;  // generated tables
+    const char* paths[] = {
+        "/data/local/tmp/Frida-Agent-64.so",
+        "/system/framework/EdXposed.jar",        // xposed listed before edxposed
+        "/data/app/LSPosed/lib/arm64/liblspd.so",
+        "/data/local/tmp/re.frida.server/gum_js_loop",
+        "/data/local/tmp/gum-jsx",
+        "/usr/lib/FridaGadget.dylib",            // frida before fridagadget
+        "/Library/MobileSubstrate/DynamicLibraries/SSLKillSwitch2.dylib",
+        "/system/lib64/libc.so",
+        "fridfrida",                             // restart after a partial match
+        "",
+    };
+    for (const char* path : paths) {
+        const char* module = automatonKeyword(modules, MODULE_KEYWORDS_LINUX, path);
+        CHECK(module == findKeyword(path, strlen(path), MODULE_KEYWORDS_LINUX));
+        CHECK(automatonKeyword(images, IMAGE_KEYWORDS_DARWIN, path) ==
+              findKeyword(path, strlen(path), IMAGE_KEYWORDS_DARWIN));
+        if (module != nullptr) {
+            CHECK(modules.isFrida(modules.find(path, strlen(path))) == isFridaKeyword(module));
+        }
+    }
+    const char* text = "/system/lib64/libc.so frida";
+    CHECK(modules.find(text, strlen("/system/lib64/libc.so")) == -1);
+    CHECK(modules.find(nullptr, 10) == -1);
+    CHECK(KeywordAutomaton().find(text, strlen(text)) == -1);
+    CHECK(modules.states() > 1);
+}
+
+TEST(generatedAutomataMatchRuntimeTables) {
+    const KeywordAutomaton* generated[] = {&MODULE_AUTOMATON_LINUX, &FD_AUTOMATON_LINUX, &IMAGE_AUTOMATON_DARWIN};
+    const char* const* lists[] = {MODULE_KEYWORDS_LINUX, FD_KEYWORDS_LINUX, IMAGE_KEYWORDS_DARWIN};
+    for (int i = 0; i < 3; i++) {
+        KeywordAutomatonTables tables(lists[i]);
+        const KeywordAutomaton& runtime = tables.automaton();
+        const KeywordAutomaton& builtin = *generated[i];
+        CHECK(builtin.states() == runtime.states() && builtin.classes() == runtime.classes());
+        CHECK(builtin.states() > 1);
+        size_t count = 0;
+        while (lists[i][count] != nullptr) {
+            count++;
+        }
+        CHECK(memcmp(builtin.frida(), runtime.frida(), count) == 0);
+        CHECK(memcmp(builtin.classOf(), runtime.classOf(), 256) == 0);
+        CHECK(memcmp(builtin.next(), runtime.next(), runtime.states() * runtime.classes() * sizeof(uint16_t)) == 0);
+        CHECK(memcmp(builtin.match(), runtime.match(), runtime.states() * sizeof(uint16_t)) == 0);
+    }
+    // Loaded packs reuse the generated automata for sections they keep
+    CHECK(&SignaturePack::builtin()->keywords(SIGNATURE_FD_KEYWORDS) == &FD_AUTOMATON_LINUX);
+}
+
+// --- json ---
+
+TEST(escapeJsonStringEscapesQuotesBackslashesAndControls) {
+    CHECK(escapeJsonString("plain") == "plain");
+    CHECK(escapeJsonString("a\"b") == "a\\\"b");
+    CHECK(escapeJsonString("a\\b") == "a\\\\b");
+    CHECK(escapeJsonString("a\nb\tc\r") == "a\\nb\\tc\\r");
+    CHECK(escapeJsonString(std::string("a\x01z", 3)) == "a\\u0001z");
+    CHECK(escapeJsonString("\xc3\xa9") == "\xc3\xa9");
+}
+
+TEST(vectorToJsonArrayQuotesElements) {
+    CHECK(vectorToJsonArray(std::vector<std::string>()) == "[]");
+    CHECK(vectorToJsonArray({"a"}) == "[\"a\"]");
+    CHECK(vectorToJsonArray({"a", "b\"c"}) == "[\"a\",\"b\\\"c\"]");
+
+    ScanArena arena;
+    StringList list;
+    CHECK(vectorToJsonArray(list) == "[]");
+    list.push(arena, arena.copy("a", 1));
+    list.push(arena, arena.copy("b\"c", 3));
+    CHECK(vectorToJsonArray(list) == "[\"a\",\"b\\\"c\"]");
+    CHECK(escapeJsonString(list[1]) == "b\\\"c");
+}
+
+// --- arena ---
+
+TEST(arenaAlignsAndGrowsPastBlockSize) {
+    ScanArena arena(256);
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(8, 8);
+    CHECK(a != nullptr && b != nullptr);
+    CHECK(reinterpret_cast<uintptr_t>(b) % 8 == 0);
+
+    char* big = static_cast<char*>(arena.allocate(1000, 16));
+    memset(big, 'x', 1000);
+    CHECK(reinterpret_cast<uintptr_t>(big) % 16 == 0);
+    CHECK(arena.blockCount() == 2);
+    CHECK(arena.bytesUsed() >= 1011);
+
+    StringRef copy = arena.copy("frida", 5);
+    CHECK(copy == "frida");
+    CHECK(copy.data[5] == '\0');
+}
+
+TEST(arenaResetKeepsBlocksAndReusesThem) {
+    ScanArena arena(256);
+    for (int i = 0; i < 20; i++) {
+        arena.allocate(100);
+    }
+    size_t blocks = arena.blockCount();
+    size_t reserved = arena.bytesReserved();
+    CHECK(blocks > 1);
+
+    arena.reset();
+    CHECK(arena.bytesUsed() == 0);
+    CHECK(arena.blockCount() == blocks);
+
+    AllocationCounter allocations;
+    for (int i = 0; i < 20; i++) {
+        arena.allocate(100);
+    }
+    CHECK(allocations.count() == 0);
+    CHECK(arena.blockCount() == blocks);
+    CHECK(arena.bytesReserved() == reserved);
+}
+
+TEST(internedSetDeduplicatesAcrossGrowth) {
+    ScanArena arena;
+    InternedSet set(arena, 4);
+    char name[32];
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < 500; i++) {
+            int length = snprintf(name, sizeof(name), "module-%d.so", i);
+            bool inserted = false;
+            StringRef ref = set.intern(name, (size_t)length, &inserted);
+            CHECK(inserted == (round == 0));
+            CHECK(ref.equals(name, (size_t)length));
+        }
+    }
+    CHECK(set.size() == 500);
+
+    StringRef first = set.intern("module-7.so", 11);
+    StringRef again = set.intern("module-7.so", 11);
+    CHECK(first.data == again.data);
+    CHECK(set.intern("", 0).empty());
+    CHECK(set.size() == 501);
+}
+
+// --- packed writer ---
+
+TEST(packedWriterCutsListsThatDoNotFit) {
+    ScanArena arena;
+    StringList modules;
+    modules.push(arena, arena.copy("frida-agent-64.so", 17));
+    modules.push(arena, arena.copy("XposedBridge.jar", 16));
+
+    uint8_t buffer[32];
+    PackedWriter fits{buffer, sizeof(buffer)};
+    CHECK(!fits.putList(modules));  // 2 + 19 + 18 > 32
+    CHECK(fits.truncated);
+    CHECK(fits.pos == 21);
+    uint16_t count = 0;
+    memcpy(&count, buffer, sizeof(count));
+    CHECK(count == 1);
+    CHECK(memcmp(buffer + 4, "frida-agent-64.so", 17) == 0);
+    // Lists after a cut one are still written, so decoders stay aligned
+    CHECK(!fits.putList(nullptr, 0));
+    CHECK(fits.pos == 23);
+
+    uint8_t large[64];
+    PackedWriter all{large, sizeof(large)};
+    CHECK(all.putList(modules));
+    CHECK(all.putList(nullptr, 0));
+    CHECK(all.pos == 2 + 19 + 18 + 2);
+    CHECK(!all.truncated);
+}
+
+// --- maps parsing ---
+
+TEST(parseMapsLineReadsRangePermsAndPath) {
+    std::string line = "7f1c2a000000-7f1c2a021000 rwxp 00000000 00:00 0                          [anon:frida]";
+    MemoryRegion region;
+    CHECK(parseMapsLine(line.data(), line.size(), &region));
+    CHECK(region.start == 0x7f1c2a000000);
+    CHECK(region.end == 0x7f1c2a021000);
+    CHECK(region.read && region.write && region.exec);
+    CHECK(std::string(region.path, region.pathLength) == "[anon:frida]");
+}
+
+TEST(parseMapsLineHandlesAnonymousAndDeleted) {
+    std::string anonymous = "00400000-00452000 r-xp 00000000 08:02 173521";
+    MemoryRegion region;
+    CHECK(parseMapsLine(anonymous.data(), anonymous.size(), &region));
+    CHECK(region.read && !region.write && region.exec);
+    CHECK(region.pathLength == 0);
+
+    std::string deleted = "7000-8000 rw-s 00000000 00:01 1234 /memfd:frida-agent (deleted)";
+    CHECK(parseMapsLine(deleted.data(), deleted.size(), &region));
+    CHECK(std::string(region.path, region.pathLength) == "/memfd:frida-agent (deleted)");
+}
+
+TEST(parseMapsLineRejectsMalformedLines) {
+    MemoryRegion region;
+    CHECK(!parseMapsLine("", 0, &region));
+    CHECK(!parseMapsLine("zzzz-1000 r--p", 14, &region));
+    CHECK(!parseMapsLine("1000 r--p", 9, &region));
+    CHECK(!parseMapsLine("1000-2000 r-", 12, &region));
+}
+
+// --- scanners (fixture backend) ---
+
+static FixtureBackend hookedProcess() {
+    FixtureBackend backend;
+    backend.mapsLines = {
+        "1000-2000 r-xp 00000000 08:02 1 /system/lib64/libc.so",
+        "2000-3000 rwxp 00000000 00:00 0",
+        "3000-4000 r-xp 00000000 08:02 2 /data/local/tmp/re.frida.server/frida-agent-64.so",
+        "4000-5000 r--p 00001000 08:02 2 /data/local/tmp/re.frida.server/frida-agent-64.so",
+        "5000-6000 r-xp 00000000 08:02 3 /data/app/XposedBridge.jar",
+        "6000-7000 rwxp 00000000 00:01 4 /memfd:jit-cache (deleted)",
+    };
+    return backend;
+}
+
+TEST(countRwxRegionsCountsWritableExecutable) {
+    FixtureBackend backend = hookedProcess();
+    Deadline deadline(NO_BUDGET);
+    RwxCount count = countRwxRegions(backend, deadline);
+    CHECK(count.rwxSegments == 2);
+    CHECK(!count.truncated);
+
+    RwxCount first = countRwxRegions(backend, deadline, 1);
+    CHECK(first.rwxSegments == 1);
+    CHECK(!first.fridaLibLoaded);
+
+    // FAST hook tier: Frida module paths in the same pass
+    RwxCount hooked = countRwxRegions(backend, deadline, MODULE_AUTOMATON_LINUX);
+    CHECK(hooked.rwxSegments == 2);
+    CHECK(hooked.fridaLibLoaded);
+
+    backend.mapsLines.erase(backend.mapsLines.begin() + 2, backend.mapsLines.begin() + 4);
+    RwxCount xposed = countRwxRegions(backend, deadline, MODULE_AUTOMATON_LINUX);
+    CHECK(xposed.rwxSegments == 2);
+    CHECK(!xposed.fridaLibLoaded);
+}
+
+TEST(countRwxRegionsStopsAtRegionCap) {
+    FixtureBackend backend = hookedProcess();
+    Deadline deadline(NO_BUDGET);
+    RwxCount count = countRwxRegions(backend, deadline, 0, 2);
+    CHECK(count.rwxSegments == 1);
+    CHECK(count.truncated);
+}
+
+TEST(analyzeRegionsFindsModulesOnce) {
+    FixtureBackend backend = hookedProcess();
+    Deadline deadline(NO_BUDGET);
+    ScanArena arena;
+    RegionAnalysis analysis = analyzeRegions(backend, deadline, arena, MODULE_KEYWORDS_LINUX);
+    CHECK(analysis.rwxSegments == 2);
+    CHECK(analysis.hasRwx);
+    CHECK(analysis.fridaLibLoaded);
+    CHECK(analysis.suspiciousModules.size() == 2);
+    CHECK(analysis.suspiciousModules[0] == "frida-agent-64.so");
+    CHECK(analysis.suspiciousModules[1] == "XposedBridge.jar");
+}
+
+TEST(analyzeRegionsCleanProcess) {
+    FixtureBackend backend;
+    backend.mapsLines = {"1000-2000 r-xp 00000000 08:02 1 /system/lib64/libc.so"};
+    Deadline deadline(NO_BUDGET);
+    ScanArena arena;
+    RegionAnalysis analysis = analyzeRegions(backend, deadline, arena, MODULE_KEYWORDS_LINUX);
+    CHECK(!analysis.hasRwx);
+    CHECK(!analysis.fridaLibLoaded);
+    CHECK(analysis.suspiciousModules.empty());
+}
+
+TEST(analyzeRegionsStopsOnExpiredDeadline) {
+    FixtureBackend backend;
+    for (int i = 0; i < 1000; i++) {
+        backend.mapsLines.push_back("1000-2000 rwxp 00000000 00:00 0");
+    }
+    Deadline deadline(0);
+    ScanArena arena;
+    RegionAnalysis analysis = analyzeRegions(backend, deadline, arena, MODULE_KEYWORDS_LINUX);
+    CHECK(analysis.truncated);
+    CHECK(analysis.rwxSegments < 1000);
+    CHECK(deadline.hit);
+}
+
+TEST(analyzeImagesKeepsFullPathsUpToLimit) {
+    FixtureBackend backend;
+    backend.images = {
+        "/usr/lib/libobjc.A.dylib",
+        "/Library/MobileSubstrate/DynamicLibraries/SSLKillSwitch2.dylib",
+        "/usr/lib/FridaGadget.dylib",
+        "/usr/lib/libsubstrate.dylib",
+    };
+    Deadline deadline(NO_BUDGET);
+    ScanArena arena;
+    ImageAnalysis all = analyzeImages(backend, deadline, arena, IMAGE_KEYWORDS_DARWIN);
+    CHECK(all.suspiciousImages.size() == 3);
+    CHECK(all.suspiciousImages[1] == "/usr/lib/FridaGadget.dylib");
+
+    ImageAnalysis capped = analyzeImages(backend, deadline, arena, IMAGE_KEYWORDS_DARWIN, 1);
+    CHECK(capped.suspiciousImages.size() == 1);
+}
+
+TEST(openFilesMatchFindsKeywordTargets) {
+    FixtureBackend backend;
+    backend.openFiles = {"/dev/null", "socket:[1234]", "/data/local/tmp/frida-gadget.config"};
+    Deadline deadline(NO_BUDGET);
+    CHECK(openFilesMatch(backend, deadline, FD_KEYWORDS_LINUX));
+    CHECK(!openFilesMatch(backend, deadline, FD_KEYWORDS_LINUX, 2));
+
+    backend.openFiles = {"/dev/null", "pipe:[99]"};
+    CHECK(!openFilesMatch(backend, deadline, FD_KEYWORDS_LINUX));
+}
+
+TEST(scannersCountVisitedWork) {
+    FixtureBackend backend;
+    for (int i = 0; i < 300; i++) {
+        backend.mapsLines.push_back(i % 100 == 0 ? "1000-2000 rwxp 00000000 00:00 0" : "1000-2000 r--p 00000000 00:00 0");
+    }
+    backend.openFiles = {"/dev/null", "socket:[1234]", "/data/local/tmp/frida-gadget.config", "pipe:[99]"};
+    backend.images = {"/usr/lib/libobjc.A.dylib", "/usr/lib/libc++.1.dylib"};
+    Deadline deadline(NO_BUDGET);
+    ScanArena arena;
+
+    CHECK(analyzeRegions(backend, deadline, arena, MODULE_KEYWORDS_LINUX).visited == 300);
+    CHECK(analyzeRegions(backend, deadline, arena, MODULE_KEYWORDS_LINUX, 120).visited == 120);
+    CHECK(countRwxRegions(backend, deadline).visited == 300);
+    CHECK(countRwxRegions(backend, deadline, 2).visited == 101);  // stops on the second RWX region
+    CHECK(analyzeImages(backend, deadline, arena, IMAGE_KEYWORDS_DARWIN).visited == 2);
+
+    OpenFileMatch fd = scanOpenFiles(backend, deadline, FD_KEYWORDS_LINUX);
+    CHECK(fd.found);
+    CHECK(fd.visited == 3);  // stops at the match
+    CHECK(!fd.truncated);
+    OpenFileMatch capped = scanOpenFiles(backend, deadline, FD_KEYWORDS_LINUX, 2);
+    CHECK(!capped.found);
+    CHECK(capped.visited == 2);
+    CHECK(capped.truncated);
+}
+
+// --- memory signatures ---
+
+TEST(patternSearchFindsEarliestMatch) {
+    static const char* const patterns[] = {"GumJS", "frida:rpc", "ab", "x", nullptr};
+    PatternSearch search(patterns);
+    CHECK(search.count() == 3);  // "x" is too short
+    CHECK(search.maxLength() == 9);
+
+    // Every offset and window length, across the 16-byte blocks and the tail
+    for (size_t length = 0; length < 80; length++) {
+        for (size_t at = 0; at + 9 <= length; at++) {
+            std::string window(length, 'G');
+            memcpy(&window[at], "frida:rpc", 9);
+            PatternMatch match = search.find(reinterpret_cast<const uint8_t*>(window.data()), window.size());
+            CHECK(match.pattern == 1);
+            CHECK(match.offset == at);
+        }
+    }
+
+    std::string both = std::string(40, '.') + "frida:rpc GumJS ab";
+    PatternMatch first = search.find(reinterpret_cast<const uint8_t*>(both.data()), both.size());
+    CHECK(first.pattern == 1);
+    CHECK(first.offset == 40);
+    std::string near = "GumJ frida:rp GumjS fr1da:rpc";
+    CHECK(search.find(reinterpret_cast<const uint8_t*>(near.data()), near.size()).pattern == -1);
+}
+
+TEST(scanMemorySignaturesFindsAgentsWithoutPaths) {
+    FixtureBackend backend;
+    backend.mapsLines = {
+        "10000-20000 r-xp 00000000 fd:01 42 /data/app/lib/libapp.so",  // file-backed: not read
+        "20000-30000 rw-p 00000000 00:00 0",                            // anonymous data: not read
+        "30000-40000 r-xp 00000000 00:00 0",
+        "40000-42000 r--p 00000000 00:01 7 /memfd:agent (deleted)",
+        // ART's JIT caches and heap hold the app's own literals: not read
+        "50000-51000 r-xp 00000000 00:01 8 /memfd:jit-cache (deleted)",
+        "51000-52000 r--p 00000000 00:01 9 /memfd:jit-zygote-cache (deleted)",
+        "60000-70000 rw-p 00000000 00:05 10 /dev/ashmem/dalvik-main space (region space) (deleted)",
+        "70000-71000 r-xp 00000000 fd:01 11 /data/local/tmp/agent.so (deleted)",
+    };
+    std::string clean(0x10000, '\0');
+    std::string agent = clean;
+    memcpy(&agent[5000], "frida:rpc", 9);
+    backend.memory = {{0x10000, agent}, {0x20000, agent}, {0x30000, clean}, {0x40000, std::string(0x2000, 'q')},
+                      {0x50000, agent.substr(0, 0x2000)}, {0x60000, agent}, {0x70000, clean.substr(0, 0x1000)}};
+    Deadline deadline(NO_BUDGET);
+    ScanArena arena;
+
+    MemorySignatureScan none = scanMemorySignatures(backend, deadline, arena, MEMORY_SIGNATURES_LINUX);
+    CHECK(!none.found);
+    CHECK(none.regions == 3);
+    CHECK(none.candidateBytes == 0x13000);
+    CHECK(none.bytesScanned >= 0x13000);
+    CHECK(!none.sampled);
+
+    backend.memory[2].second = agent;
+    MemorySignatureScan anonymous = scanMemorySignatures(backend, deadline, arena, MEMORY_SIGNATURES_LINUX);
+    CHECK(anonymous.found);
+    CHECK(strcmp(anonymous.signature, "frida:rpc") == 0);
+    CHECK(anonymous.regionStart == 0x30000);
+    CHECK(anonymous.address == 0x30000 + 5000);
+    CHECK(anonymous.regionPath.empty());
+
+    std::string gum(0x2000, 'q');
+    memcpy(&gum[0x1ffb], "GumJS", 5);  // last bytes of the region
+    backend.memory = {{0x40000, gum}};
+    MemorySignatureScan memfd = scanMemorySignatures(backend, deadline, arena, MEMORY_SIGNATURES_LINUX);
+    CHECK(memfd.found);
+    CHECK(memfd.address == 0x41ffb);
+    CHECK(memfd.regionPath == "/memfd:agent (deleted)");
+
+    // Backends without memory access read nothing
+    Snapshot snapshot;
+    snapshot.maps = backend.mapsLines[2];
+    SnapshotBackend replay(snapshot);
+    MemorySignatureScan unreadable = scanMemorySignatures(replay, deadline, arena, MEMORY_SIGNATURES_LINUX);
+    CHECK(unreadable.regions == 1);
+    CHECK(unreadable.bytesScanned == 0);
+    CHECK(!unreadable.found);
+}
+
+TEST(scanMemorySignaturesSamplesWithinBudget) {
+    FixtureBackend backend;
+    backend.mapsLines = {"100000-200000 r-xp 00000000 00:00 0"};  // 1 MiB
+    std::string code(0x100000, '\x90');
+    memcpy(&code[100], "GumJS", 5);
+    backend.memory = {{0x100000, code}};
+    Deadline deadline(NO_BUDGET);
+    ScanArena arena;
+
+    // 4 windows of 16 KiB, 256 KiB apart; seed 0 starts at the region start
+    MemorySignatureScan first = scanMemorySignatures(backend, deadline, arena, MEMORY_SIGNATURES_LINUX, 64 * 1024, 0);
+    CHECK(first.sampled);
+    CHECK(first.found);
+    CHECK(first.address == 0x100000 + 100);
+
+    MemorySignatureScan shifted = scanMemorySignatures(backend, deadline, arena, MEMORY_SIGNATURES_LINUX, 64 * 1024, 1);
+    CHECK(shifted.sampled);
+    CHECK(!shifted.found);
+    CHECK(shifted.bytesScanned == 64 * 1024);
+
+    MemorySignatureScan odd = scanMemorySignatures(backend, deadline, arena, MEMORY_SIGNATURES_LINUX, 5000, 1);
+    CHECK(odd.bytesScanned <= 5000);
+
+    // Pages that are not resident are skipped, not faulted in
+    backend.evictedPages = {0x100000};
+    MemorySignatureScan evicted = scanMemorySignatures(backend, deadline, arena, MEMORY_SIGNATURES_LINUX, 64 * 1024, 0);
+    CHECK(!evicted.found);
+    CHECK(evicted.bytesScanned < 64 * 1024);
+}
+
+TEST(scanMemorySignaturesSkipsShortSampledTails) {
+    FixtureBackend backend;
+    backend.mapsLines = {"100000-10d000 r-xp 00000000 00:00 0", "200000-20d000 r-xp 00000000 00:00 0"};  // 52 KiB each
+    std::string code(0xd000, '\x90');
+    std::string hooked = code;
+    memcpy(&hooked[0x5000], "GumJS", 5);
+    backend.memory = {{0x100000, code}, {0x200000, hooked}};
+    ScanArena arena;
+    WorkPool pool(2);
+
+    // 6 windows 17749 bytes apart: the fourth starts 1 byte before the end
+    // of the first region, the fifth covers the match
+    Deadline deadline(NO_BUDGET);
+    MemorySignatureScan serial = scanMemorySignatures(backend, deadline, arena, MEMORY_SIGNATURES_LINUX, 6 * 16 * 1024, 0);
+    CHECK(serial.sampled);
+    CHECK(serial.found);
+    CHECK(serial.address == 0x200000 + 0x5000);
+    MemorySignatureScan parallel =
+        scanMemorySignatures(backend, deadline, arena, MEMORY_SIGNATURES_LINUX, 6 * 16 * 1024, 0, 256, &pool);
+    CHECK(parallel.found);
+    CHECK(parallel.address == serial.address);
+}
+
+TEST(scanMemorySignaturesInParallelMatchesSerial) {
+    FixtureBackend backend;
+    std::string code(0x40000, '\x90');
+    std::string late = code;
+    memcpy(&late[0x3c000], "frida_agent_main", 16);
+    std::string early = code;
+    memcpy(&early[0x3fff0 - 3], "GumJS", 5);  // spans two windows
+    backend.mapsLines = {"100000-140000 r-xp 00000000 00:00 0", "200000-240000 r-xp 00000000 00:00 0",
+                         "300000-340000 r-xp 00000000 00:00 0", "400000-440000 r-xp 00000000 00:00 0"};
+    backend.memory = {{0x100000, code}, {0x200000, early}, {0x300000, code}, {0x400000, late}};
+    WorkPool pool(3);
+    ScanArena arena;
+
+    Deadline serialDeadline(NO_BUDGET);
+    MemorySignatureScan serial = scanMemorySignatures(backend, serialDeadline, arena, MEMORY_SIGNATURES_LINUX);
+    Deadline parallelDeadline(NO_BUDGET);
+    MemorySignatureScan parallel =
+        scanMemorySignatures(backend, parallelDeadline, arena, MEMORY_SIGNATURES_LINUX, 1024 * 1024, 0, 256, &pool);
+    CHECK(serial.found && parallel.found);
+    CHECK(strcmp(parallel.signature, "GumJS") == 0);
+    CHECK(parallel.address == serial.address);
+    CHECK(parallel.address == 0x200000 + 0x3fff0 - 3);
+    CHECK(parallel.regionStart == 0x200000);
+
+    backend.memory[1].second = code;
+    Deadline cleanDeadline(NO_BUDGET);
+    MemorySignatureScan clean =
+        scanMemorySignatures(backend, cleanDeadline, arena, MEMORY_SIGNATURES_LINUX, 1024 * 1024, 0, 256, &pool);
+    CHECK(clean.found);
+    CHECK(clean.address == 0x400000 + 0x3c000);
+
+    // The shared budget holds across workers
+    backend.memory[3].second = code;
+    Deadline sampledDeadline(NO_BUDGET);
+    MemorySignatureScan sampled =
+        scanMemorySignatures(backend, sampledDeadline, arena, MEMORY_SIGNATURES_LINUX, 96 * 1024, 3, 256, &pool);
+    CHECK(sampled.sampled);
+    CHECK(!sampled.found);
+    CHECK(sampled.bytesScanned == 96 * 1024);
+
+    Deadline expired(0);
+    MemorySignatureScan stale =
+        scanMemorySignatures(backend, expired, arena, MEMORY_SIGNATURES_LINUX, 1024 * 1024, 0, 256, &pool);
+    CHECK(stale.truncated);
+    CHECK(stale.bytesScanned == 0);
+
+    // A cancel flag stops the workers like an expired budget
+    backend.memory[3].second = late;
+    std::atomic<bool> cancel{true};
+    Deadline cancelled(NO_BUDGET, &cancel);
+    MemorySignatureScan stopped =
+        scanMemorySignatures(backend, cancelled, arena, MEMORY_SIGNATURES_LINUX, 1024 * 1024, 0, 256, &pool);
+    CHECK(stopped.truncated);
+    CHECK(!stopped.found);
+    CHECK(stopped.bytesScanned == 0);
+    CHECK(cancelled.hit && cancelled.cancelled());
+}
+
+struct PoolCounts {
+    std::vector<std::atomic<int>>* hits;
+    std::atomic<int> chunks{0};
+    std::thread::id caller;
+    bool offCaller = false;
+};
+
+static bool countChunk(size_t begin, size_t end, int worker, Deadline& /* deadline */, void* context) {
+    PoolCounts& counts = *static_cast<PoolCounts*>(context);
+    for (size_t i = begin; i < end; i++) {
+        (*counts.hits)[i].fetch_add(1);
+    }
+    counts.chunks.fetch_add(1);
+    if (worker == 0 && std::this_thread::get_id() != counts.caller) {
+        counts.offCaller = true;
+    }
+    return true;
+}
+
+TEST(workPoolRunsEveryItemOnce) {
+    WorkPool pool(3);
+    CHECK(pool.workers() == 4);
+    for (int round = 0; round < 3; round++) {  // threads are reused
+        std::vector<std::atomic<int>> hits(10007);
+        PoolCounts counts;
+        counts.hits = &hits;
+        counts.caller = std::this_thread::get_id();
+        Deadline deadline(NO_BUDGET);
+        CHECK(pool.run(hits.size(), 16, countChunk, &counts, deadline));
+        CHECK(!deadline.hit);
+        CHECK(!counts.offCaller);
+        CHECK(counts.chunks.load() >= (int)((hits.size() + 15) / 16));
+        bool once = true;
+        for (const std::atomic<int>& hit : hits) {
+            once = once && hit.load() == 1;
+        }
+        CHECK(once);
+    }
+
+    // Without threads everything runs on the caller
+    WorkPool inlinePool(0);
+    std::vector<std::atomic<int>> hits(100);
+    PoolCounts counts;
+    counts.hits = &hits;
+    counts.caller = std::this_thread::get_id();
+    Deadline deadline(NO_BUDGET);
+    CHECK(inlinePool.run(hits.size(), 7, countChunk, &counts, deadline));
+    CHECK(counts.chunks.load() == 15);
+    CHECK(!counts.offCaller);
+
+    int cpus[256];
+    CHECK(bigCores(cpus, 256) >= 1);
+}
+
+static bool stopAtFifty(size_t begin, size_t /* end */, int /* worker */, Deadline& /* deadline */,
+                        void* /* context */) {
+    return begin < 50;
+}
+
+TEST(workPoolHonoursDeadlineAndCancel) {
+    WorkPool pool(2);
+    std::vector<std::atomic<int>> hits(1000);
+    PoolCounts counts;
+    counts.hits = &hits;
+    counts.caller = std::this_thread::get_id();
+
+    Deadline expired(0);
+    CHECK(!pool.run(hits.size(), 1, countChunk, &counts, expired));
+    CHECK(expired.hit);
+    CHECK(counts.chunks.load() == 0);
+
+    std::atomic<bool> cancel(true);
+    Deadline deadline(NO_BUDGET);
+    CHECK(!pool.run(hits.size(), 1, countChunk, &counts, deadline, &cancel));
+    CHECK(!deadline.hit);
+    CHECK(counts.chunks.load() == 0);
+
+    // A chunk returning false stops the job
+    CHECK(!pool.run(hits.size(), 10, stopAtFifty, nullptr, deadline));
+    CHECK(!deadline.hit);
+}
+
+TEST(stageTimerRecordsDurationAndItems) {
+    StageTiming timing;
+    CHECK(!timing.ran);
+    StageTimer timer(timing);
+    usleep(1000);
+    long long ns = timer.stop(42);
+    CHECK(timing.ran);
+    CHECK(timing.ns == ns);
+    CHECK(ns >= 1000000);
+    CHECK(timing.items == 42);
+
+    long long before = monotonicNs();
+    CHECK(monotonicNs() >= before);
+}
+
+TEST(perfCountersFailSoftAroundStages) {
+    PerfCounters perf;
+    StageTiming timing;
+    StageTimer timer(timing, &perf);
+    std::vector<char> touched(1 << 20);
+    for (size_t i = 0; i < touched.size(); i += 4096) {
+        touched[i] = 1;
+    }
+    timer.stop((int)touched.size());
+    CHECK(timing.ran && timing.items == 1 << 20);
+    if (!perf.available()) {
+        CHECK(timing.perf.valid == 0);  // denied (paranoid, seccomp) or no perf_event_open
+        return;
+    }
+    CHECK(timing.perf.valid != 0);
+    if (timing.perf.has(PERF_INSTRUCTIONS)) {
+        CHECK(timing.perf.values[PERF_INSTRUCTIONS] > 0);
+    }
+    if (timing.perf.has(PERF_PAGE_FAULTS)) {
+        CHECK(timing.perf.values[PERF_PAGE_FAULTS] > 0);  // 256 fresh pages
+    }
+    CHECK(strcmp(PERF_COUNTER_NAMES[PERF_CACHE_MISSES], "cacheMisses") == 0);
+}
+
+TEST(checkSymbolImageFlagsUnexpectedImages) {
+    FixtureBackend backend;
+    ScanArena arena;
+    backend.symbolImage = "/apex/com.android.runtime/lib64/bionic/libc.so";
+    SymbolImageCheck expected = checkSymbolImage(backend, arena, nullptr, LIBC_IMAGE_FRAGMENTS_LINUX);
+    CHECK(expected.imagePath == backend.symbolImage.c_str());
+    CHECK(!expected.unexpected);
+
+    backend.symbolImage = "/data/local/tmp/libhook.so";
+    CHECK(checkSymbolImage(backend, arena, nullptr, LIBC_IMAGE_FRAGMENTS_LINUX).unexpected);
+
+    backend.symbolImage.clear();
+    SymbolImageCheck unresolved = checkSymbolImage(backend, arena, nullptr, LIBC_IMAGE_FRAGMENTS_LINUX);
+    CHECK(unresolved.imagePath.empty());
+    CHECK(!unresolved.unexpected);
+}
+
+TEST(deadlineSaturatesHugeBudgets) {
+    Deadline unlimited(LLONG_MAX);
+    CHECK(!unlimited.expired());
+    Deadline spent(0);
+    CHECK(spent.expired());
+    Deadline negative(-5);
+    CHECK(negative.expired());
+}
+
+// --- verdict ---
+
+TEST(verdictPublishMergesGroupsAndStampsTime) {
+    VerdictBlock block;
+    CHECK(block.load() == 0);
+
+    // hook + debugger scan: frida set
+    uint64_t word = block.publish(8 | 16, VERDICT_FRIDA, 1, 1234);
+    CHECK((word & VERDICT_FLAG_MASK) == VERDICT_FRIDA);
+    CHECK(((word >> VERDICT_GROUPS_SHIFT) & VERDICT_GROUPS_MASK) == (8 | 16));
+    CHECK(verdictSeq(word) == 1);
+    CHECK(verdictHookTier(word) == 1);
+    CHECK((word >> VERDICT_TIME_SHIFT) == 1234);
+
+    // root-only scan keeps the hook flag
+    word = block.publish(1, VERDICT_ROOTED, 1, 2000);
+    CHECK((word & VERDICT_FLAG_MASK) == (VERDICT_FRIDA | VERDICT_ROOTED));
+    CHECK(((word >> VERDICT_GROUPS_SHIFT) & VERDICT_GROUPS_MASK) == (1 | 8 | 16));
+    CHECK(verdictSeq(word) == 2);
+
+    // clean hook scan clears it
+    word = block.publish(8, 0, 1, 3000);
+    CHECK((word & VERDICT_FLAG_MASK) == VERDICT_ROOTED);
+    CHECK(block.load() == word);
+}
+
+TEST(verdictPublishKeepsHitsOfStrongerOrPartialScans) {
+    VerdictBlock block;
+    // DEEP scan finds Frida (memory signature)
+    block.publish(31, VERDICT_FRIDA, 2, 10);
+
+    // FAST and STANDARD scans do not clear it
+    uint64_t word = block.publish(8 | 16, 0, 0, 20);
+    CHECK(word & VERDICT_FRIDA);
+    word = block.publish(31, 0, 1, 30);
+    CHECK(word & VERDICT_FRIDA);
+    CHECK(verdictHookTier(word) == 2);
+
+    // a scan that skipped root checks (budget) adds its hit but clears nothing
+    block.publish(31 & ~1, VERDICT_ROOTED, 2, 40);
+    word = block.publish(31 & ~1, 0, 2, 50);
+    CHECK(word & VERDICT_ROOTED);
+
+    // the next clean DEEP scan clears the hook flag
+    word = block.publish(31, 0, 2, 60);
+    CHECK(!(word & (VERDICT_FRIDA | VERDICT_ROOTED)));
+
+    // a hit of a weaker scan can be cleared by the same tier
+    word = block.publish(8, VERDICT_FRIDA, 0, 70);
+    CHECK((word & VERDICT_FRIDA) && verdictHookTier(word) == 0);
+    word = block.publish(8, 0, 0, 80);
+    CHECK(!(word & VERDICT_FRIDA));
+}
+
+TEST(verdictSequenceWrapsPastZero) {
+    VerdictBlock block;
+    for (int i = 0; i < (int)VERDICT_SEQ_MASK; i++) {
+        block.publish(8, 0, 1, 1);
+    }
+    CHECK(verdictSeq(block.load()) == VERDICT_SEQ_MASK);
+    block.publish(8, 0, 1, 1);
+    CHECK(verdictSeq(block.load()) == 1);
+}
+
+TEST(verdictPendingIsClearedByPublish) {
+    VerdictBlock block;
+    block.markPending();
+    CHECK(block.load() == 0);  // nothing published yet
+
+    block.publish(16, VERDICT_DEBUGGER, 1, 10);
+    block.markPending();
+    CHECK(block.load() & VERDICT_PENDING);
+    CHECK(block.load() & VERDICT_DEBUGGER);
+    block.publish(16, 0, 1, 20);
+    CHECK(!(block.load() & VERDICT_PENDING));
+}
+
+// --- heap allocations ---
+
+TEST(fastTierAllocatesNothing) {
+    ProcfsBackend backend;
+    VerdictBlock verdict;
+
+    AllocationCounter allocations;
+    Deadline deadline(NO_BUDGET);
+    ProcStatus status = readProcStatus();
+    RwxCount rwx = countRwxRegions(backend, deadline, MODULE_AUTOMATON_LINUX);
+    verdict.publish(8 | 16, rwx.rwxSegments > 0 && rwx.fridaLibLoaded ? uint32_t(VERDICT_FRIDA) : 0u, 0, 1);
+    CHECK(allocations.count() == 0);
+    CHECK(status.threads >= 1);
+}
+
+TEST(standardScanAllocatesNothingOnceArenaIsWarm) {
+    ProcfsBackend backend;
+    FixtureBackend hooked = hookedProcess();
+    ScanArena arena;
+    auto scan = [&] {
+        Deadline deadline(NO_BUDGET);
+        RegionAnalysis live = analyzeRegions(backend, deadline, arena, MODULE_KEYWORDS_LINUX);
+        RegionAnalysis fixture = analyzeRegions(hooked, deadline, arena, MODULE_KEYWORDS_LINUX);
+        bool fd = openFilesMatch(backend, deadline, FD_KEYWORDS_LINUX);
+        SymbolImageCheck libc =
+            checkSymbolImage(backend, arena, reinterpret_cast<void*>(getpid), LIBC_IMAGE_FRAGMENTS_LINUX);
+        return live.rwxSegments + (int)fixture.suspiciousModules.size() + fd + libc.unexpected;
+    };
+
+    int first = scan();
+    arena.reset();
+
+    AllocationCounter allocations;
+    int second = scan();
+    CHECK(allocations.count() == 0);
+    CHECK(first == second);
+}
+
+TEST(allocationCounterSeesHeapAllocations) {
+    AllocationCounter allocations;
+    std::string* heap = new std::string(100, 'x');
+    CHECK(allocations.count() >= 1);
+    CHECK(allocations.bytes() >= sizeof(std::string));
+    delete heap;
+}
+
+// --- procfs backend (live process) ---
+
+TEST(procfsBackendReadsOwnProcess) {
+    ProcfsBackend backend;
+    Deadline deadline(NO_BUDGET);
+    ScanArena arena;
+
+    RegionAnalysis analysis = analyzeRegions(backend, deadline, arena, MODULE_KEYWORDS_LINUX);
+    CHECK(!analysis.truncated);
+    CHECK(!analysis.fridaLibLoaded);
+
+    int regions = 0;
+    backend.forEachRegion([](const MemoryRegion&, void* context) {
+        (*static_cast<int*>(context))++;
+        return true;
+    }, &regions);
+    CHECK(regions > 5);
+
+    SymbolImageCheck libc = checkSymbolImage(backend, arena, reinterpret_cast<void*>(getpid), LIBC_IMAGE_FRAGMENTS_LINUX);
+    CHECK(strstr(libc.imagePath.data, "libc") != nullptr);
+    CHECK(!libc.unexpected);
+}
+
+TEST(procfsBackendReadsOwnAnonymousCode) {
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    void* mapping = mmap(nullptr, 2 * pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    CHECK(mapping != MAP_FAILED);
+    char* code = static_cast<char*>(mapping);
+    memcpy(code + pageSize + 64, "frida_agent_main", 16);
+    CHECK(mprotect(mapping, 2 * pageSize, PROT_READ | PROT_EXEC) == 0);
+
+    ProcfsBackend backend;
+    Deadline deadline(NO_BUDGET);
+    ScanArena arena;
+    MemorySignatureScan scan = scanMemorySignatures(backend, deadline, arena, MEMORY_SIGNATURES_LINUX, 64 * 1024 * 1024);
+    CHECK(scan.found);
+    CHECK(scan.address == reinterpret_cast<uintptr_t>(code + pageSize + 64));
+    CHECK(scan.regionStart <= reinterpret_cast<uintptr_t>(mapping));
+
+    char buffer[16];
+    CHECK(backend.readMemory(reinterpret_cast<uintptr_t>(code + pageSize + 64), buffer, sizeof(buffer)) == 16);
+    CHECK(memcmp(buffer, "frida_agent_main", 16) == 0);
+    munmap(mapping, 2 * pageSize);
+    CHECK(backend.readMemory(reinterpret_cast<uintptr_t>(mapping), buffer, sizeof(buffer)) == 0);
+}
+
+TEST(procfsBackendSeesOpenFiles) {
+    int fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    CHECK(fd >= 0);
+    ProcfsBackend backend;
+    bool sawDevNull = false;
+    backend.forEachOpenFile([](const char* path, size_t length, void* context) {
+        if (std::string(path, length) == "/dev/null") {
+            *static_cast<bool*>(context) = true;
+            return false;
+        }
+        return true;
+    }, &sawDevNull);
+    CHECK(sawDevNull);
+    close(fd);
+
+    Deadline deadline(NO_BUDGET);
+    CHECK(!openFilesMatch(backend, deadline, FD_KEYWORDS_LINUX));
+}
+
+TEST(procfsBackendListsImagesAndStatus) {
+    ProcfsBackend backend;
+    bool sawLibc = false;
+    backend.forEachImage([](const char* path, size_t length, void* context) {
+        if (std::string(path, length).find("libc") != std::string::npos) {
+            *static_cast<bool*>(context) = true;
+        }
+        return true;
+    }, &sawLibc);
+    CHECK(sawLibc);
+
+    ProcStatus status = readProcStatus();
+    CHECK(status.threads >= 1);
+}
+
+// --- procfs snapshots (ProcSource) ---
+
+static void writeFile(const std::string& path, const std::string& content) {
+    FILE* file = fopen(path.c_str(), "w");
+    CHECK(file != nullptr);
+    if (file != nullptr) {
+        fwrite(content.data(), 1, content.size(), file);
+        fclose(file);
+    }
+}
+
+// Captured /proc/<pid> of a hooked process: maps, status, fd symlinks
+static std::string hookedSnapshot() {
+    char dir[] = "/tmp/device_trust_snapshot_XXXXXX";
+    CHECK(mkdtemp(dir) != nullptr);
+    std::string root = dir;
+    writeFile(root + "/maps",
+              "1000-2000 r-xp 00000000 08:02 1 /system/lib64/libc.so\n"
+              "2000-3000 rwxp 00000000 00:00 0\n"
+              "3000-4000 r-xp 00000000 08:02 2 /data/local/tmp/re.frida.server/frida-agent-64.so\n"
+              "4000-5000 r-xp 00000000 08:02 3 /data/app/XposedBridge.jar");  // no trailing newline
+    writeFile(root + "/status", "Name:\tcom.example\nTracerPid:\t4242\nThreads:\t17\n");
+    mkdir((root + "/fd").c_str(), 0700);
+    CHECK(symlink("/dev/null", (root + "/fd/0").c_str()) == 0);
+    CHECK(symlink("socket:[81234]", (root + "/fd/3").c_str()) == 0);
+    CHECK(symlink("/data/local/tmp/frida-gadget.config", (root + "/fd/7").c_str()) == 0);
+    return root;
+}
+
+static void removeSnapshot(const std::string& root) {
+    for (const char* fd : {"0", "3", "7"}) {
+        unlink((root + "/fd/" + fd).c_str());
+    }
+    rmdir((root + "/fd").c_str());
+    unlink((root + "/maps").c_str());
+    unlink((root + "/status").c_str());
+    rmdir(root.c_str());
+}
+
+TEST(procfsBackendReplaysSnapshotDirectory) {
+    std::string root = hookedSnapshot();
+    ProcfsBackend backend(ProcSource::snapshot((root + "/").c_str()));
+    CHECK(!backend.source().isSelf());
+    CHECK(std::string(backend.source().root()) == root);
+
+    Deadline deadline(NO_BUDGET);
+    ScanArena arena;
+    RegionAnalysis analysis = analyzeRegions(backend, deadline, arena, MODULE_KEYWORDS_LINUX);
+    CHECK(analysis.rwxSegments == 1);
+    CHECK(analysis.fridaLibLoaded);
+    CHECK(analysis.suspiciousModules.size() == 2);
+    CHECK(analysis.suspiciousModules[1] == "XposedBridge.jar");
+    CHECK(openFilesMatch(backend, deadline, FD_KEYWORDS_LINUX));
+
+    ProcStatus status = readProcStatus(backend.source());
+    CHECK(status.tracerPid == 4242);
+    CHECK(status.threads == 17);
+
+    // Loader-based checks describe this process, not the snapshot
+    SymbolImageCheck libc = checkSymbolImage(backend, arena, reinterpret_cast<void*>(getpid), LIBC_IMAGE_FRAGMENTS_LINUX);
+    CHECK(libc.imagePath.empty());
+    CHECK(!libc.unexpected);
+    CHECK(!backend.forEachImage([](const char*, size_t, void*) { return true; }, nullptr));
+
+    removeSnapshot(root);
+}
+
+TEST(procSourceFailsSoftOnMissingRoots) {
+    ProcfsBackend missing(ProcSource::snapshot("/nonexistent/device_trust"));
+    Deadline deadline(NO_BUDGET);
+    CHECK(countRwxRegions(missing, deadline).rwxSegments == 0);
+    CHECK(!openFilesMatch(missing, deadline, FD_KEYWORDS_LINUX));
+    CHECK(readProcStatus(missing.source()).threads == 0);
+
+    std::string tooLong(PATH_MAX, 'a');
+    ProcSource unusable = ProcSource::snapshot(tooLong.c_str());
+    char path[PATH_MAX];
+    CHECK(!unusable.resolve("maps", path, sizeof(path)));
+    CHECK(!ProcSource::snapshot("").resolve("maps", path, sizeof(path)));
+}
+
+TEST(procSourceForPidReadsThatProcess) {
+    ProcSource own = ProcSource::forPid(getpid());
+    CHECK(own.isSelf());
+    CHECK(readProcStatus(own).threads >= 1);
+
+    ProcSource parent = ProcSource::forPid(getppid());
+    CHECK(!parent.isSelf());
+    char path[PATH_MAX];
+    CHECK(parent.resolve("status", path, sizeof(path)));
+    CHECK(std::string(path) == "/proc/" + std::to_string(getppid()) + "/status");
+}
+
+// --- snapshot bundles ---
+
+static Snapshot hookedBundleInputs() {
+    Snapshot snapshot;
+    snapshot.meta = {{"source", "/proc/4242"}, {"capturedAtMs", "1700000000000"}};
+    snapshot.maps =
+        "1000-2000 r-xp 00000000 08:02 1 /system/lib64/libc.so\n"
+        "2000-3000 rwxp 00000000 00:00 0\n"
+        "3000-4000 r-xp 00000000 08:02 2 /data/local/tmp/frida-agent-64.so\n";
+    snapshot.status = "Name:\tcom.example\nTracerPid:\t0\nThreads:\t2\n";
+    snapshot.openFiles = {"/dev/null", "socket:[1]", "/data/local/tmp/frida-gadget.config"};
+    snapshot.threadNames = {"com.example", "gum-js-loop"};
+    snapshot.images = {"/system/lib64/libc.so"};
+    snapshot.symbols = {{SNAPSHOT_PROBE_SYMBOL, "/data/local/tmp/libhook.so"}};
+    return snapshot;
+}
+
+TEST(snapshotRoundTripsCompressedAndPlain) {
+    Snapshot original = hookedBundleInputs();
+    for (bool compress : {true, false}) {
+        std::string bundle;
+        CHECK(encodeSnapshot(original, &bundle, compress));
+        uint16_t flags = 0;
+        memcpy(&flags, bundle.data() + 6, sizeof(flags));
+        CHECK(((flags & SNAPSHOT_FLAG_DEFLATE) != 0) == compress);
+
+        Snapshot decoded;
+        CHECK(decodeSnapshot(bundle.data(), bundle.size(), &decoded));
+        CHECK(decoded.maps == original.maps);
+        CHECK(decoded.status == original.status);
+        CHECK(decoded.openFiles == original.openFiles);
+        CHECK(decoded.threadNames == original.threadNames);
+        CHECK(decoded.images == original.images);
+        CHECK(decoded.metaValue("source") == "/proc/4242");
+        CHECK(decoded.metaValue("missing").empty());
+        CHECK(std::string(decoded.symbolImage(SNAPSHOT_PROBE_SYMBOL)) == "/data/local/tmp/libhook.so");
+        CHECK(decoded.symbolImage("open") == nullptr);
+    }
+}
+
+TEST(snapshotRejectsCorruptBundles) {
+    std::string bundle;
+    CHECK(encodeSnapshot(hookedBundleInputs(), &bundle));
+    Snapshot decoded;
+    CHECK(!decodeSnapshot(bundle.data(), bundle.size() - 1, &decoded));
+    CHECK(!decodeSnapshot(bundle.data(), 8, &decoded));
+    CHECK(!decodeSnapshot(nullptr, 0, &decoded));
+
+    std::string badMagic = bundle;
+    badMagic[0] = 'X';
+    CHECK(!decodeSnapshot(badMagic.data(), badMagic.size(), &decoded));
+
+    std::string badPayload = bundle;
+    badPayload[SNAPSHOT_HEADER_SIZE + 2] ^= 0x5A;
+    CHECK(!decodeSnapshot(badPayload.data(), badPayload.size(), &decoded));
+
+    // Unknown sections are skipped
+    std::string plain;
+    CHECK(encodeSnapshot(hookedBundleInputs(), &plain, false));
+    plain += std::string("\x63\x03\x00\x00\x00new", 8);
+    uint32_t length = (uint32_t)(plain.size() - SNAPSHOT_HEADER_SIZE);
+    memcpy(&plain[8], &length, sizeof(length));
+    memcpy(&plain[12], &length, sizeof(length));
+    CHECK(decodeSnapshot(plain.data(), plain.size(), &decoded));
+    CHECK(decoded.openFiles.size() == 3);
+}
+
+TEST(snapshotBackendReplaysScanners) {
+    Snapshot snapshot = hookedBundleInputs();
+    SnapshotBackend backend(snapshot);
+    Deadline deadline(NO_BUDGET);
+    ScanArena arena;
+
+    RegionAnalysis maps = analyzeRegions(backend, deadline, arena, MODULE_KEYWORDS_LINUX);
+    CHECK(maps.rwxSegments == 1);
+    CHECK(maps.fridaLibLoaded);
+    CHECK(maps.suspiciousModules.size() == 1);
+    CHECK(openFilesMatch(backend, deadline, FD_KEYWORDS_LINUX));
+    SymbolImageCheck libc = checkSymbolImage(backend, arena, nullptr, LIBC_IMAGE_FRAGMENTS_LINUX);
+    CHECK(libc.unexpected);
+    CHECK(parseProcStatus(snapshot.status.c_str()).threads == 2);
+}
+
+TEST(captureSnapshotReadsOwnProcess) {
+    ProcfsBackend backend;
+    Snapshot snapshot;
+    CHECK(captureSnapshot(backend, reinterpret_cast<void*>(getpid), &snapshot));
+    CHECK(!snapshot.maps.empty());
+    CHECK(parseProcStatus(snapshot.status.c_str()).threads >= 1);
+    CHECK(!snapshot.threadNames.empty());
+    CHECK(!snapshot.openFiles.empty());
+    CHECK(!snapshot.images.empty());
+    const char* libc = snapshot.symbolImage(SNAPSHOT_PROBE_SYMBOL);
+    CHECK(libc != nullptr && strstr(libc, "libc") != nullptr);
+    CHECK(snapshot.metaValue("source") == "/proc/self");
+
+    // Replaying the capture gives the live verdicts
+    std::string bundle;
+    Snapshot decoded;
+    CHECK(encodeSnapshot(snapshot, &bundle));
+    CHECK(bundle.size() < snapshot.maps.size());
+    CHECK(decodeSnapshot(bundle.data(), bundle.size(), &decoded));
+    SnapshotBackend replay(decoded);
+    Deadline deadline(NO_BUDGET);
+    ScanArena arena;
+    CHECK(countRwxRegions(replay, deadline).rwxSegments == countRwxRegions(backend, deadline).rwxSegments);
+    CHECK(!checkSymbolImage(replay, arena, nullptr, LIBC_IMAGE_FRAGMENTS_LINUX).unexpected);
+
+    ProcfsBackend missing(ProcSource::snapshot("/nonexistent/device_trust"));
+    CHECK(!captureSnapshot(missing, nullptr, &snapshot));
+}
+
+// --- signature packs ---
+
+static SignaturePackSource smallPackSource(uint32_t version) {
+    SignaturePackSource source;
+    source.version = version;
+    source.lists.emplace_back(SIGNATURE_MODULE_KEYWORDS, std::vector<std::string>{"evilhook", "frida"});
+    source.lists.emplace_back(SIGNATURE_SU_PATHS, std::vector<std::string>{"/system/xbin/su", "/vendor/bin/su"});
+    source.lists.emplace_back(SIGNATURE_MEMORY_SIGNATURES, std::vector<std::string>{"EvilJS"});
+    source.fridaPorts = {27042, 31337};
+    source.hasPorts = true;
+    return source;
+}
+
+TEST(signaturePackRoundTripsAndFallsBack) {
+    std::string bytes;
+    CHECK(encodeSignaturePack(smallPackSource(7), &bytes));
+    SignaturePackStatus status;
+    std::shared_ptr<const SignaturePack> pack = SignaturePack::fromBytes(bytes.data(), bytes.size(), &status);
+    CHECK(status == SIGNATURE_PACK_OK);
+    CHECK(pack != nullptr);
+    CHECK(pack->version() == 7);
+
+    const char* const* modules = pack->list(SIGNATURE_MODULE_KEYWORDS);
+    CHECK(strcmp(modules[0], "evilhook") == 0 && strcmp(modules[1], "frida") == 0 && modules[2] == nullptr);
+    CHECK(strcmp(pack->list(SIGNATURE_SU_PATHS)[1], "/vendor/bin/su") == 0);
+    CHECK(strcmp(pack->list(SIGNATURE_MEMORY_SIGNATURES)[0], "EvilJS") == 0);
+    CHECK(pack->hasPorts() && pack->fridaPorts().size() == 2 && pack->fridaPorts()[1] == 31337);
+
+    // Absent sections: built-in native tables, nothing for platform lists
+    CHECK(pack->list(SIGNATURE_FD_KEYWORDS) == FD_KEYWORDS_LINUX);
+    CHECK(pack->list(SIGNATURE_JAILBREAK_PATHS) == nullptr);
+    CHECK(SignaturePack::builtin()->list(SIGNATURE_MODULE_KEYWORDS) == MODULE_KEYWORDS_LINUX);
+    CHECK(!SignaturePack::builtin()->hasPorts());
+
+    // Scanners match with the compiled sections
+    FixtureBackend backend;
+    backend.mapsLines = {"1000-2000 r-xp 00000000 08:02 1 /data/app/lib/arm64/libEvilHook.so",
+                         "3000-4000 r-xp 00000000 08:02 2 /data/app/XposedBridge.jar"};
+    backend.openFiles = {"/data/local/tmp/frida-gadget.config"};
+    Deadline deadline(NO_BUDGET);
+    ScanArena arena;
+    RegionAnalysis analysis = analyzeRegions(backend, deadline, arena, pack->keywords(SIGNATURE_MODULE_KEYWORDS));
+    CHECK(analysis.suspiciousModules.size() == 1);
+    CHECK(analysis.suspiciousModules[0] == "libEvilHook.so");
+    CHECK(!analysis.fridaLibLoaded);
+    CHECK(scanOpenFiles(backend, deadline, pack->keywords(SIGNATURE_FD_KEYWORDS)).found);
+}
+
+TEST(signaturePackRejectsCorruptPacks) {
+    std::string bytes;
+    CHECK(encodeSignaturePack(smallPackSource(1), &bytes));
+    SignaturePackStatus status;
+
+    std::string flipped = bytes;
+    flipped[SIGNATURE_PACK_HEADER_SIZE + 8] ^= 0x20;
+    CHECK(SignaturePack::fromBytes(flipped.data(), flipped.size(), &status) == nullptr);
+    CHECK(status == SIGNATURE_PACK_BAD_CHECKSUM);
+
+    CHECK(SignaturePack::fromBytes(bytes.data(), bytes.size() - 1, &status) == nullptr);
+    CHECK(status == SIGNATURE_PACK_BAD_FORMAT);
+    std::string magic = bytes;
+    magic[0] = 'X';
+    CHECK(SignaturePack::fromBytes(magic.data(), magic.size(), &status) == nullptr);
+    CHECK(status == SIGNATURE_PACK_BAD_FORMAT);
+
+    SignaturePackSource upper = smallPackSource(1);
+    upper.lists[0].second[0] = "EvilHook";
+    CHECK(encodeSignaturePack(upper, &bytes));
+    CHECK(SignaturePack::fromBytes(bytes.data(), bytes.size(), &status) == nullptr);
+    CHECK(status == SIGNATURE_PACK_BAD_FORMAT);
+
+    // Text sections become Java/Swift strings: no control characters, no
+    // malformed or 4-byte UTF-8
+    const char* const badText[] = {"/system/bin/su\n", "/data/\xC0\xAFsu", "/data/\xED\xA0\x80",
+                                   "/data/\xF0\x9F\x98\x80", "/data/su\xE2\x82", "/data/\xC2\x85"};
+    for (const char* text : badText) {
+        SignaturePackSource paths = smallPackSource(1);
+        paths.lists[1].second = {"/sbin/su", text};
+        CHECK(encodeSignaturePack(paths, &bytes));
+        CHECK(SignaturePack::fromBytes(bytes.data(), bytes.size(), &status) == nullptr);
+        CHECK(status == SIGNATURE_PACK_BAD_FORMAT);
+    }
+    SignaturePackSource unicode = smallPackSource(1);
+    unicode.lists.push_back({SIGNATURE_ROOT_PACKAGES, {"com.caf\xC3\xA9.su", "\xE6\xA0\xB9.manager"}});
+    CHECK(encodeSignaturePack(unicode, &bytes));
+    CHECK(SignaturePack::fromBytes(bytes.data(), bytes.size(), &status) != nullptr);
+    CHECK(status == SIGNATURE_PACK_OK);
+    CHECK(isTextSection(SIGNATURE_SU_PATHS) && !isTextSection(SIGNATURE_MEMORY_SIGNATURES));
+
+    SignaturePackSource many = smallPackSource(1);
+    many.lists[2].second.assign(PATTERN_SEARCH_MAX_PATTERNS + 1, "EvilJS");
+    CHECK(encodeSignaturePack(many, &bytes));
+    CHECK(SignaturePack::fromBytes(bytes.data(), bytes.size(), &status) == nullptr);
+    CHECK(status == SIGNATURE_PACK_LIMIT_EXCEEDED);
+
+    SignaturePackSource empty = smallPackSource(1);
+    empty.lists[0].second.push_back("");
+    CHECK(!encodeSignaturePack(empty, &bytes));
+
+    // Entries are C strings, so a byte signature cannot hold 0x00
+    SignaturePackSource binary = smallPackSource(1);
+    binary.lists[2].second.push_back(std::string("ab\0cd", 5));
+    CHECK(!encodeSignaturePack(binary, &bytes));
+
+    CHECK(SignaturePack::open("/nonexistent/pack.dtp", &status) == nullptr);
+    CHECK(status == SIGNATURE_PACK_IO_ERROR);
+}
+
+TEST(signaturePackSwapsWithoutDisturbingScans) {
+    char path[] = "/tmp/device_trust_pack_XXXXXX";
+    int fd = mkstemp(path);
+    CHECK(fd >= 0);
+    close(fd);
+    std::string bytes;
+    CHECK(encodeSignaturePack(smallPackSource(3), &bytes));
+    writeFile(path, bytes);
+
+    std::shared_ptr<const SignaturePack> mapped = SignaturePack::open(path);
+    unlink(path);  // the mapping outlives the file
+    CHECK(mapped != nullptr);
+    CHECK(activeSignaturePack()->version() == 0);
+
+    // A scan in flight keeps the pack it started with
+    std::shared_ptr<const SignaturePack> inFlight = activeSignaturePack();
+    CHECK(installSignaturePack(mapped) == SIGNATURE_PACK_OK);
+    CHECK(activeSignaturePack()->version() == 3);
+    CHECK(inFlight->list(SIGNATURE_MODULE_KEYWORDS) == MODULE_KEYWORDS_LINUX);
+
+    std::shared_ptr<const SignaturePack> held = activeSignaturePack();
+    mapped.reset();
+    CHECK(installSignaturePack(SignaturePack::builtin()) == SIGNATURE_PACK_STALE);
+    CHECK(installSignaturePack(SignaturePack::builtin(), true) == SIGNATURE_PACK_OK);
+    CHECK(activeSignaturePack()->version() == 0);
+    const char* text = "/data/app/libevilhook.so";
+    CHECK(held->keywords(SIGNATURE_MODULE_KEYWORDS).find(text, strlen(text)) >= 0);
+    CHECK(strcmp(held->list(SIGNATURE_SU_PATHS)[0], "/system/xbin/su") == 0);
+}
+
+TEST(defaultSignatureSourceMatchesBuiltins) {
+    FILE* file = fopen(DEVICE_TRUST_SIGNATURES_SOURCE, "rb");
+    CHECK(file != nullptr);
+    std::string text;
+    char chunk[4096];
+    size_t length;
+    while (file != nullptr && (length = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        text.append(chunk, length);
+    }
+    if (file != nullptr) {
+        fclose(file);
+    }
+
+    SignaturePackSource source;
+    std::string error;
+    CHECK(parseSignatureSource(text, &source, &error));
+    CHECK(error.empty());
+    std::string bytes;
+    CHECK(encodeSignaturePack(source, &bytes));
+    std::shared_ptr<const SignaturePack> pack = SignaturePack::fromBytes(bytes.data(), bytes.size());
+    CHECK(pack != nullptr);
+    if (pack == nullptr) {
+        return;
+    }
+    // Native sections must list exactly what keywords.cpp compiles in
+    for (SignatureSection section : {SIGNATURE_MODULE_KEYWORDS, SIGNATURE_FD_KEYWORDS, SIGNATURE_IMAGE_KEYWORDS,
+                                     SIGNATURE_MEMORY_SIGNATURES}) {
+        const char* const* loaded = pack->list(section);
+        const char* const* builtin = SignaturePack::builtin()->list(section);
+        CHECK(loaded != builtin);
+        size_t i = 0;
+        while (loaded[i] != nullptr && builtin[i] != nullptr && strcmp(loaded[i], builtin[i]) == 0) {
+            i++;
+        }
+        CHECK(loaded[i] == nullptr && builtin[i] == nullptr);
+    }
+    CHECK(pack->list(SIGNATURE_JAILBREAK_SCHEMES) != nullptr);
+    CHECK(pack->fridaPorts().size() == 2);
+
+    CHECK(!parseSignatureSource("[module_keywords]\nfrida\n", &source, &error));
+    CHECK(error == "line 3: missing `version N`");
+    CHECK(!parseSignatureSource("version 2\n[nope]\n", &source, &error));
+    CHECK(error == "line 2: unknown section [nope]");
+    CHECK(parseSignatureSource("version 2\n[fd_keywords]\n  FRIDA  \n", &source, &error));
+    CHECK(source.lists[0].second[0] == "frida");
+    CHECK(!parseSignatureSource(std::string("version 2\n[memory_signatures]\nab\0cd\n", 36), &source, &error));
+    CHECK(error == "line 3: entries cannot contain NUL bytes");
+}
+
+// --- telemetry ---
+
+TEST(histogramBucketsCoverEveryValue) {
+    // Exact below 16 ns, then 8 sub-buckets per power of two
+    CHECK(histogramBucket(0) == 0);
+    CHECK(histogramBucket(15) == 15);
+    CHECK(histogramBucket(16) == 16);
+    CHECK(histogramBucket(17) == 16);
+    CHECK(histogramBucket(18) == 17);
+    CHECK(histogramBucket(UINT64_MAX) == HISTOGRAM_BUCKETS - 1);
+    for (int bucket = 0; bucket < HISTOGRAM_BUCKETS - 1; bucket++) {
+        uint64_t lower = histogramBucketLowerNs(bucket);
+        uint64_t upper = histogramBucketUpperNs(bucket);
+        CHECK(histogramBucket(lower) == bucket);
+        CHECK(histogramBucket(upper) == bucket);
+        CHECK(histogramBucketLowerNs(bucket + 1) == upper + 1);
+        CHECK(upper - lower <= lower / 8);  // relative error stays under 12.5%
+    }
+}
+
+TEST(latencyHistogramPercentiles) {
+    LatencyHistogram histogram;
+    CHECK(histogram.percentileNs(0.5) == 0);
+    for (uint64_t ns = 1; ns <= 100; ns++) {
+        histogram.add(ns * 1000000);  // 1..100 ms
+    }
+    uint64_t p50 = histogram.percentileNs(0.50);
+    uint64_t p99 = histogram.percentileNs(0.99);
+    CHECK(p50 >= 50000000 && p50 <= 50000000 + 50000000 / 8);
+    CHECK(p99 >= 99000000 && p99 <= 99000000 + 99000000 / 8);
+    CHECK(histogram.percentileNs(1.0) >= 100000000);
+}
+
+TEST(telemetryStoreMergesShards) {
+    std::unique_ptr<TelemetryStore> store(new TelemetryStore());
+    const int threads = 6;
+    const int perThread = 2000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&store, t]() {
+            for (int i = 0; i < perThread; i++) {
+                store->record("maps", TELEMETRY_CALL, 1000 + t);
+                store->record(t % 2 == 0 ? "fd" : "maps", TELEMETRY_TIMEOUT);
+                store->addRead(10);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    store->record("maps", TELEMETRY_CACHE_HIT);
+
+    TelemetrySnapshot snapshot;
+    store->snapshot(&snapshot);
+    CHECK(snapshot.checks.size() == 2);
+    const TelemetrySnapshot::Check* maps = nullptr;
+    const TelemetrySnapshot::Check* fd = nullptr;
+    for (const TelemetrySnapshot::Check& check : snapshot.checks) {
+        (strcmp(check.name, "maps") == 0 ? maps : fd) = &check;
+    }
+    CHECK(maps != nullptr && fd != nullptr);
+    CHECK(maps->events[TELEMETRY_CALL] == (uint64_t)threads * perThread);
+    CHECK(maps->latency.total == (uint64_t)threads * perThread);
+    CHECK(maps->events[TELEMETRY_TIMEOUT] == (uint64_t)threads / 2 * perThread);
+    CHECK(maps->events[TELEMETRY_CACHE_HIT] == 1);
+    CHECK(maps->maxNs == 1000 + threads - 1);
+    CHECK(fd->events[TELEMETRY_TIMEOUT] == (uint64_t)threads / 2 * perThread);
+    CHECK(fd->events[TELEMETRY_CALL] == 0);
+    CHECK(snapshot.io[TELEMETRY_IO_PROCFS_BYTES] == (uint64_t)threads * perThread * 10);
+    CHECK(snapshot.io[TELEMETRY_IO_SYSCALLS] == (uint64_t)threads * perThread);
+
+    store->reset();
+    store->snapshot(&snapshot);
+    CHECK(snapshot.checks.size() == 2);
+    CHECK(snapshot.checks[0].events[TELEMETRY_CALL] == 0 && snapshot.io[TELEMETRY_IO_SYSCALLS] == 0);
+}
+
+TEST(telemetryStoreDropsPastCapacity) {
+    std::unique_ptr<TelemetryStore> store(new TelemetryStore());
+    char name[16];
+    for (int i = 0; i < TELEMETRY_MAX_CHECKS + 3; i++) {
+        snprintf(name, sizeof(name), "check%d", i);
+        store->record(name, TELEMETRY_CALL, 5);
+    }
+    store->record(nullptr, TELEMETRY_CALL, 5);
+    TelemetrySnapshot snapshot;
+    store->snapshot(&snapshot);
+    CHECK((int)snapshot.checks.size() == TELEMETRY_MAX_CHECKS);
+    CHECK(snapshot.droppedEvents == 4);
+}
+
+TEST(telemetryJsonIsCompact) {
+    std::unique_ptr<TelemetryStore> store(new TelemetryStore());
+    store->record("nativeMaps", TELEMETRY_CALL, 3);
+    store->record("nativeMaps", TELEMETRY_CALL, 3);
+    store->record("nativeFd", TELEMETRY_CANCELLATION);
+    store->addRead(4096);
+    TelemetrySnapshot snapshot;
+    store->snapshot(&snapshot);
+    CHECK(telemetryToJson(snapshot) ==
+          "{\"v\":1,\"histogram\":\"log2x8\",\"io\":{\"procfsBytes\":4096,\"syscalls\":1},\"dropped\":0,"
+          "\"checks\":{\"nativeMaps\":{\"calls\":2,\"cacheHits\":0,\"timeouts\":0,\"cancellations\":0,"
+          "\"sumNs\":6,\"maxNs\":3,\"p50Ns\":3,\"p90Ns\":3,\"p99Ns\":3,\"buckets\":[[3,2]]},"
+          "\"nativeFd\":{\"calls\":0,\"cacheHits\":0,\"timeouts\":0,\"cancellations\":1,"
+          "\"sumNs\":0,\"maxNs\":0,\"p50Ns\":0,\"p90Ns\":0,\"p99Ns\":0,\"buckets\":[]}}}");
+}
+
+TEST(checkBreakerTripsAfterStreakAndProbesAfterCooldown) {
+    std::unique_ptr<CheckBreakers> breakers(new CheckBreakers());
+    const int64_t t0 = 1000000;
+    CHECK(breakers->admit("getprop", t0) == BREAKER_CLOSED);
+    for (uint32_t i = 0; i < BREAKER_TRIP_STREAK - 1; i++) {
+        breakers->record("getprop", 5e6, false, true, t0);
+    }
+    CHECK(breakers->admit("getprop", t0) == BREAKER_CLOSED);
+    breakers->record("getprop", 5e6, false, true, t0);
+    CHECK(breakers->admit("getprop", t0 + BREAKER_BASE_COOLDOWN_MS - 1) == BREAKER_OPEN);
+    CHECK(breakers->admit("getprop", t0 + BREAKER_BASE_COOLDOWN_MS) == BREAKER_HALF_OPEN);
+
+    // A failed probe re-opens with a doubled cooldown
+    int64_t t1 = t0 + BREAKER_BASE_COOLDOWN_MS;
+    breakers->record("getprop", 5e6, false, true, t1);
+    CHECK(breakers->admit("getprop", t1 + BREAKER_BASE_COOLDOWN_MS) == BREAKER_OPEN);
+    CHECK(breakers->admit("getprop", t1 + 2 * BREAKER_BASE_COOLDOWN_MS) == BREAKER_HALF_OPEN);
+    breakers->record("getprop", 1e6, false, false, t1);
+    CHECK(breakers->admit("getprop", t1) == BREAKER_CLOSED);
+}
+
+TEST(checkBreakerScoresCostPerHit) {
+    std::unique_ptr<CheckBreakers> breakers(new CheckBreakers());
+    CHECK(breakers->score("maps", 1000) == 2000);  // prior cost, 50% hit rate
+    breakers->record("maps", 3000, true, false, 0);
+    breakers->record("maps", 1000, true, false, 0);
+    // EWMA 3000 + 0.2 * (1000 - 3000) = 2600; hit rate (2 + 1) / (2 + 2)
+    CHECK(breakers->score("maps", 1000) > 3466 && breakers->score("maps", 1000) < 3467);
+}
+
+TEST(checkBreakerReportsTelemetryP99AndRoundTrips) {
+    std::unique_ptr<CheckBreakers> breakers(new CheckBreakers());
+    std::unique_ptr<TelemetryStore> store(new TelemetryStore());
+    for (uint32_t i = 0; i < BREAKER_TRIP_STREAK; i++) {
+        breakers->record("nativeFd", 2e6, i == 0, true, 5000);
+        store->record("nativeFd", TELEMETRY_CALL, 2000000);
+    }
+    breakers->record("nativeMaps", 10, false, false, 5000);
+    TelemetrySnapshot snapshot;
+    store->snapshot(&snapshot);
+    uint64_t p99 = snapshot.checks[0].latency.percentileNs(0.99);
+    CHECK(p99 >= 2000000 && p99 < 2000000 * 9 / 8);
+    std::ostringstream expected;
+    expected << "[{\"id\":\"nativeFd\",\"state\":\"open\",\"trips\":1,\"ewmaMs\":2,\"p99Ms\":"
+             << p99 / 1e6 << "}]";
+    CHECK(breakers->demotedJson(snapshot) == expected.str());
+
+    std::string text = breakers->exportText();
+    CHECK(text == "v2\nnativeFd 2000000 3 1 3 1 1 5000\nnativeMaps 10 1 0 0 0 0 0\n");
+    std::unique_ptr<CheckBreakers> restored(new CheckBreakers());
+    CHECK(restored->importText(text) == 2);
+    CHECK(restored->exportText() == text);
+
+    // v1 lines carried a latency histogram; it is dropped, the rest restored
+    restored->reset();
+    CHECK(restored->importText("v1\nnativeFd 2000000 3 1 3 1 1 5000 41:3\nbad line\n") == 1);
+    CHECK(restored->exportText() == "v2\nnativeFd 2000000 3 1 3 1 1 5000\n");
+    CHECK(restored->importText("v3\nnativeFd 1 1 1 0 0 0 0\n") == 0);
+}
+
+TEST(procfsReadsAreCounted) {
+    TelemetrySnapshot before;
+    TelemetrySnapshot after;
+    telemetry().snapshot(&before);
+    ProcfsBackend backend;
+    Deadline deadline(NO_BUDGET);
+    countRwxRegions(backend, deadline);
+    telemetry().snapshot(&after);
+    CHECK(after.io[TELEMETRY_IO_PROCFS_BYTES] > before.io[TELEMETRY_IO_PROCFS_BYTES]);
+    CHECK(after.io[TELEMETRY_IO_SYSCALLS] >= before.io[TELEMETRY_IO_SYSCALLS] + 3);  // open, read, close
+}
+
+// --- trace ---
+
+TEST(traceRingExportsChromeJson) {
+    std::unique_ptr<TraceRing> ring(new TraceRing());
+    CHECK(ring->toChromeJson() == "{\"traceEvents\":[],\"displayTimeUnit\":\"ns\"}");
+    ring->record("nativeMaps", 5000, 1500, 42);
+    ring->record("odd\"name", 7000, 0, 43);
+    std::string json = ring->toChromeJson();
+    CHECK(json.find("{\"name\":\"nativeMaps\",\"cat\":\"device_trust\",\"ph\":\"X\",\"ts\":5.000,"
+                    "\"dur\":1.500,\"pid\":") != std::string::npos);
+    CHECK(json.find("\"tid\":42}") != std::string::npos);
+    CHECK(json.find("odd\\\"name") != std::string::npos);
+    CHECK(json.find("nativeMaps") < json.find("odd"));  // oldest first
+
+    ring->clear();
+    CHECK(ring->toChromeJson().find("nativeMaps") == std::string::npos);
+}
+
+TEST(traceRingKeepsNewestSections) {
+    std::unique_ptr<TraceRing> ring(new TraceRing());
+    char name[16];
+    for (int i = 0; i < TRACE_RING_CAPACITY + 10; i++) {
+        snprintf(name, sizeof(name), "s%d", i);
+        ring->record(name, i, 1, 1);
+    }
+    std::string json = ring->toChromeJson();
+    CHECK(json.find("\"s9\"") == std::string::npos);
+    CHECK(json.find("\"s10\"") != std::string::npos);
+    snprintf(name, sizeof(name), "\"s%d\"", TRACE_RING_CAPACITY + 9);
+    CHECK(json.find(name) != std::string::npos);
+}
+
+TEST(traceSectionRecordsIntoSharedRing) {
+    traceRing().clear();
+    {
+        TraceSection section("coreTestSection");
+        usleep(100);
+    }
+    setTraceRecording(false);
+    { TraceSection section("notRecorded"); }
+    setTraceRecording(true);
+    std::string json = traceRing().toChromeJson();
+    CHECK(json.find("coreTestSection") != std::string::npos);
+    CHECK(json.find("notRecorded") == std::string::npos);
+    CHECK(json.find("\"dur\":0.") == std::string::npos);  // >= 100 us
+}
+
+int main() {
+    return device_trust_test::runAll();
+}
@@ -0,0 +1,89 @@
+// [DeviceTrust/Core] In-memory backend for tests and benchmarks
+// Regions come from /proc/<pid>/maps formatted lines; memory contents from
+// blocks placed at fixed addresses.
+
+#pragma once
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../core/platform.h"
+#include "../platform/procfs_backend.h"
+
+namespace device_trust_test {
+
+class FixtureBackend : public device_trust::PlatformBackend {
+public:
+    std::vector<std::string> mapsLines;
+    std::vector<std::string> images;
+    std::vector<std::string> openFiles;
+    std::string symbolImage;  // empty: address not in an image
+    std::vector<std::pair<uintptr_t, std::string>> memory;  // start address, contents
+    std::vector<uintptr_t> evictedPages;  // non-empty: residentPages reports these pages absent
+
+    bool forEachRegion(device_trust::RegionVisitor visit, void* context) override {
+        device_trust::MemoryRegion region;
+        for (const std::string& line : mapsLines) {
+            if (device_trust::parseMapsLine(line.data(), line.size(), &region) && !visit(region, context)) {
+                break;
+            }
+        }
+        return true;
+    }
+
+    bool forEachImage(device_trust::PathVisitor visit, void* context) override {
+        return forEachPath(images, visit, context);
+    }
+
+    bool forEachOpenFile(device_trust::PathVisitor visit, void* context) override {
+        return forEachPath(openFiles, visit, context);
+    }
+
+    bool imagePathForAddress(const void* /* address */, const char** path) override {
+        if (symbolImage.empty()) {
+            return false;
+        }
+        *path = symbolImage.c_str();
+        return true;
+    }
+
+    size_t readMemory(uintptr_t address, void* out, size_t size) override {
+        for (const auto& block : memory) {
+            if (address >= block.first && address < block.first + block.second.size()) {
+                size_t copied = std::min(size, (size_t)(block.first + block.second.size() - address));
+                memcpy(out, block.second.data() + (address - block.first), copied);
+                return copied;
+            }
+        }
+        return 0;
+    }
+
+    bool residentPages(uintptr_t address, size_t pages, uint8_t* resident) override {
+        if (evictedPages.empty()) {
+            return false;
+        }
+        uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+        for (size_t i = 0; i < pages; i++) {
+            uintptr_t page = address + i * pageSize;
+            resident[i] = std::find(evictedPages.begin(), evictedPages.end(), page) == evictedPages.end() ? 1 : 0;
+        }
+        return true;
+    }
+
+private:
+    static bool forEachPath(const std::vector<std::string>& paths, device_trust::PathVisitor visit, void* context) {
+        for (const std::string& path : paths) {
+            if (!visit(path.data(), path.size(), context)) {
+                break;
+            }
+        }
+        return true;
+    }
+};
+
+}  // namespace device_trust_test
@@ -0,0 +1,55 @@
+// [DeviceTrust/Core] Minimal test harness
+// TEST(name) registers a case; CHECK records a failure and continues.
+
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+namespace device_trust_test {
+
+struct TestCase {
+    const char* name;
+    void (*run)();
+};
+
+inline std::vector<TestCase>& registry() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+struct Registrar {
+    Registrar(const char* name, void (*run)()) {
+        registry().push_back({name, run});
+    }
+};
+
+inline int runAll() {
+    for (const TestCase& test : registry()) {
+        int before = failures();
+        test.run();
+        printf("[%s] %s\n", failures() == before ? " OK " : "FAIL", test.name);
+    }
+    printf("%zu tests, %d failed checks\n", registry().size(), failures());
+    return failures() == 0 ? 0 : 1;
+}
+
+}  // namespace device_trust_test
+
+#define TEST(name)                                                                \
+    static void name();                                                           \
+    static device_trust_test::Registrar name##_registrar(#name, name);            \
+    static void name()
+
+#define CHECK(condition)                                                          \
+    do {                                                                          \
+        if (!(condition)) {                                                       \
+            printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition);  \
+            device_trust_test::failures()++;                                      \
+        }                                                                         \
+    } while (0)
@@ -0,0 +1,122 @@
+// [DeviceTrust/Core] Signature pack builder
+//
+// Usage:
+//   device_trust_pack build <signatures.txt> <out.dtp>
+//   device_trust_pack dump <pack.dtp>
+//
+// build compiles a signature source (format: src/signatures/signatures.txt)
+// into a pack for DeviceTrust.loadSignaturePack(); dump validates a pack the
+// way the device does and prints its sections.
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "../core/signature_pack.h"
+#include "signature_source.h"
+
+using namespace device_trust;
+
+static int usage() {
+    fprintf(stderr,
+            "usage: device_trust_pack build <signatures.txt> <out.dtp>\n"
+            "       device_trust_pack dump <pack.dtp>\n");
+    return 2;
+}
+
+static bool readFile(const char* path, std::string* out) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    char chunk[65536];
+    size_t len;
+    out->clear();
+    while ((len = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        out->append(chunk, len);
+    }
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
+
+static bool writeFile(const char* path, const std::string& data) {
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+    return fclose(file) == 0 && ok;
+}
+
+static int build(const char* sourcePath, const char* outPath) {
+    std::string text;
+    if (!readFile(sourcePath, &text)) {
+        fprintf(stderr, "build: cannot read %s\n", sourcePath);
+        return 1;
+    }
+    SignaturePackSource source;
+    std::string error;
+    if (!parseSignatureSource(text, &source, &error)) {
+        fprintf(stderr, "build: %s:%s\n", sourcePath, error.c_str());
+        return 1;
+    }
+    std::string pack;
+    if (!encodeSignaturePack(source, &pack)) {
+        fprintf(stderr, "build: %s exceeds the pack limits (entries, entry length or size)\n", sourcePath);
+        return 1;
+    }
+    // Round trip through the device loader before publishing
+    SignaturePackStatus status;
+    if (SignaturePack::fromBytes(pack.data(), pack.size(), &status) == nullptr) {
+        fprintf(stderr, "build: pack rejected by the loader (status %d)\n", (int)status);
+        return 1;
+    }
+    if (!writeFile(outPath, pack)) {
+        fprintf(stderr, "build: cannot write %s\n", outPath);
+        return 1;
+    }
+    fprintf(stderr, "build: %s -> %s (version %u, %zu bytes)\n", sourcePath, outPath, source.version, pack.size());
+    return 0;
+}
+
+static int dump(const char* path) {
+    SignaturePackStatus status;
+    std::shared_ptr<const SignaturePack> pack = SignaturePack::open(path, &status);
+    if (pack == nullptr) {
+        fprintf(stderr, "dump: %s is not a valid pack (status %d)\n", path, (int)status);
+        return 1;
+    }
+    printf("version %u\n", pack->version());
+    for (int section = 1; section < SIGNATURE_SECTION_LIMIT; section++) {
+        if (section == SIGNATURE_FRIDA_PORTS) {
+            if (pack->hasPorts()) {
+                printf("\n[%s]\n", signatureSectionName(section));
+                for (uint16_t port : pack->fridaPorts()) {
+                    printf("%u\n", port);
+                }
+            }
+            continue;
+        }
+        const char* const* list = pack->list(static_cast<SignatureSection>(section));
+        if (list == nullptr) {
+            continue;
+        }
+        printf("\n[%s]\n", signatureSectionName(section));
+        for (size_t i = 0; list[i] != nullptr; i++) {
+            printf("%s\n", list[i]);
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc == 4 && strcmp(argv[1], "build") == 0) {
+        return build(argv[2], argv[3]);
+    }
+    if (argc == 3 && strcmp(argv[1], "dump") == 0) {
+        return dump(argv[2]);
+    }
+    return usage();
+}
@@ -0,0 +1,337 @@
+// [DeviceTrust/Core] Built-in signature table generator
+//
+// Usage:
+//   device_trust_signature_gen [--check] <signatures.txt> <builtin_signatures.inc>
+//                              <DeviceTrustSignatures.kt> <DeviceTrustSignatures.swift>
+//
+// Renders the default signature source into the built-in tables of every
+// layer: compile-time encoded keyword lists and automaton transition
+// tables for the core (included by keywords.cpp, so they are
+// constant-initialized .rodata with no startup work), and the list constants of the Kotlin and Swift
+// checks. The outputs are checked in because the NDK, CocoaPods and SwiftPM
+// builds cannot run a host tool; --check only compares them (ctest) and
+// the device_trust_signatures target rewrites them.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../core/keyword_automaton.h"
+#include "../core/signature_pack.h"
+#include "signature_source.h"
+
+using namespace device_trust;
+
+namespace {
+
+const char* const REGENERATE = "cmake --build <build dir> --target device_trust_signatures";
+
+int usage() {
+    fprintf(stderr,
+            "usage: device_trust_signature_gen [--check] <signatures.txt> <builtin_signatures.inc>\n"
+            "                                  <DeviceTrustSignatures.kt> <DeviceTrustSignatures.swift>\n");
+    return 2;
+}
+
+bool readFile(const char* path, std::string* out) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    char chunk[65536];
+    size_t len;
+    out->clear();
+    while ((len = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        out->append(chunk, len);
+    }
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
+
+bool writeFile(const char* path, const std::string& data) {
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+    return fclose(file) == 0 && ok;
+}
+
+const std::vector<std::string>* findList(const SignaturePackSource& source, SignatureSection section) {
+    for (const auto& list : source.lists) {
+        if (list.first == section) {
+            return &list.second;
+        }
+    }
+    return nullptr;
+}
+
+// Escapes for C++ (octal, so a following digit cannot extend the escape),
+// Kotlin and Swift string literals
+std::string cppLiteral(const std::string& text) {
+    std::string out = "\"";
+    for (unsigned char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += (char)c;
+        } else if (c < 0x20 || c >= 0x7F) {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\%03o", c);
+            out += escape;
+        } else {
+            out += (char)c;
+        }
+    }
+    return out + "\"";
+}
+
+std::string kotlinLiteral(const std::string& text) {
+    std::string out = "\"";
+    for (unsigned char c : text) {
+        if (c == '"' || c == '\\' || c == '$') {
+            out += '\\';
+            out += (char)c;
+        } else if (c < 0x20 || c == 0x7F) {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\u%04x", c);
+            out += escape;
+        } else {
+            out += (char)c;  // UTF-8 passes through
+        }
+    }
+    return out + "\"";
+}
+
+std::string swiftLiteral(const std::string& text) {
+    std::string out = "\"";
+    for (unsigned char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += (char)c;
+        } else if (c < 0x20 || c == 0x7F) {
+            char escape[12];
+            snprintf(escape, sizeof(escape), "\\u{%x}", c);
+            out += escape;
+        } else {
+            out += (char)c;
+        }
+    }
+    return out + "\"";
+}
+
+template <typename T>
+void appendTable(std::string& out, const char* type, const std::string& name, const T* values, size_t count,
+                 size_t perLine) {
+    out += "constexpr " + std::string(type) + " " + name + "[" + std::to_string(count) + "] = {\n";
+    for (size_t i = 0; i < count; i += perLine) {
+        out += "   ";
+        for (size_t j = i; j < count && j < i + perLine; j++) {
+            out += " " + std::to_string(values[j]) + ",";
+        }
+        out += "\n";
+    }
+    out += "};\n";
+}
+
+// Deterministic per entry, so regenerating an unchanged source is a no-op
+uint32_t obfuscationSeed(const std::string& text, size_t index) {
+    uint32_t hash = 2166136261u;  // FNV-1a
+    for (unsigned char c : text) {
+        hash = (hash ^ c) * 16777619u;
+    }
+    return hash ^ (uint32_t)(index * 0x27D4EB2Du);
+}
+
+void appendCppList(std::string& out, const std::string& name, const std::vector<std::string>& entries) {
+    for (size_t i = 0; i < entries.size(); i++) {
+        char seed[16];
+        snprintf(seed, sizeof(seed), "0x%08xu", obfuscationSeed(entries[i], i));
+        out += "constexpr ObfuscatedString<" + std::to_string(entries[i].size() + 1) + "> " + name + "_" +
+               std::to_string(i) + "(" + cppLiteral(entries[i]) + ", " + seed + ");\n";
+    }
+    out += "constexpr ObfuscatedText " + name + "_ENCODED[] = {\n";
+    for (size_t i = 0; i < entries.size(); i++) {
+        out += "    " + name + "_" + std::to_string(i) + ".text(),\n";
+    }
+    out += "    ObfuscatedText()\n};\n\n";
+}
+
+void appendCppAutomaton(std::string& out, const std::string& name, const char* automatonName,
+                        const std::vector<std::string>& entries) {
+    std::vector<const char*> keywords;
+    for (const std::string& entry : entries) {
+        keywords.push_back(entry.c_str());
+    }
+    keywords.push_back(nullptr);
+    KeywordAutomatonTables tables(keywords.data());
+    const KeywordAutomaton& automaton = tables.automaton();
+
+    out += "// " + std::to_string(automaton.states()) + " states x " + std::to_string(automaton.classes()) +
+           " byte classes\n";
+    appendTable(out, "uint8_t", name + "_FRIDA", automaton.frida(), entries.size(), 16);
+    appendTable(out, "uint8_t", name + "_CLASSES", automaton.classOf(), 256, 16);
+    appendTable(out, "uint16_t", name + "_NEXT", automaton.next(), automaton.states() * automaton.classes(),
+                automaton.classes());
+    appendTable(out, "uint16_t", name + "_MATCH", automaton.match(), automaton.states(), 16);
+    out += "constexpr KeywordAutomaton " + std::string(automatonName) + "(\n    " + name + "_FRIDA, " + name +
+           "_CLASSES, " + std::to_string(automaton.classes()) + ", " + std::to_string(automaton.states()) +
+           ",\n    " + name + "_NEXT, " + name + "_MATCH);\n\n";
+}
+
+std::string renderCpp(const SignaturePackSource& source) {
+    std::string out =
+        "// [DeviceTrust/Core] Built-in signature tables\n"
+        "// Generated by device_trust_signature_gen from src/signatures/signatures.txt\n"
+        "// (version " +
+        std::to_string(source.version) +
+        "); do not edit. Regenerate with\n"
+        "//   " +
+        REGENERATE +
+        "\n"
+        "//\n"
+        "// Included by keywords.cpp inside namespace device_trust. Every table is\n"
+        "// constexpr, so the automata are constant-initialized: no code runs at\n"
+        "// load time and the tables stay in read-only, shareable pages. The\n"
+        "// literals below are only read by the compiler; the library holds them\n"
+        "// encoded (obfuscated_string.h) and the automata hold no text.\n\n";
+    appendCppList(out, "MODULE_KEYWORDS", *findList(source, SIGNATURE_MODULE_KEYWORDS));
+    appendCppList(out, "FD_KEYWORDS", *findList(source, SIGNATURE_FD_KEYWORDS));
+    appendCppList(out, "IMAGE_KEYWORDS", *findList(source, SIGNATURE_IMAGE_KEYWORDS));
+    appendCppList(out, "MEMORY_SIGNATURES", *findList(source, SIGNATURE_MEMORY_SIGNATURES));
+    appendCppAutomaton(out, "MODULE_KEYWORDS", "MODULE_AUTOMATON_LINUX", *findList(source, SIGNATURE_MODULE_KEYWORDS));
+    appendCppAutomaton(out, "FD_KEYWORDS", "FD_AUTOMATON_LINUX", *findList(source, SIGNATURE_FD_KEYWORDS));
+    appendCppAutomaton(out, "IMAGE_KEYWORDS", "IMAGE_AUTOMATON_DARWIN", *findList(source, SIGNATURE_IMAGE_KEYWORDS));
+    out.resize(out.size() - 1);  // single trailing newline
+    return out;
+}
+
+void appendKotlinList(std::string& out, const char* name, const std::vector<std::string>& entries) {
+    out += "    val " + std::string(name) + ": List<String> = listOf(\n";
+    for (size_t i = 0; i < entries.size(); i++) {
+        out += "        " + kotlinLiteral(entries[i]) + (i + 1 < entries.size() ? ",\n" : "\n");
+    }
+    out += "    )\n";
+}
+
+std::string renderKotlin(const SignaturePackSource& source) {
+    std::string out =
+        "// [DeviceTrust/Android] Built-in signature lists\n"
+        "// Generated by device_trust_signature_gen from src/signatures/signatures.txt;\n"
+        "// do not edit. Regenerate with\n"
+        "//   " +
+        std::string(REGENERATE) +
+        "\n\n"
+        "package com.mikoloy.device_trust\n\n"
+        "/**\n"
+        " * Defaults of the Kotlin checks; a loaded signature pack replaces them\n"
+        " * section by section (see DeviceTrust.loadSignaturePack)\n"
+        " */\n"
+        "internal object DeviceTrustSignatures {\n"
+        "    const val VERSION = " +
+        std::to_string(source.version) + "\n\n";
+    appendKotlinList(out, "SU_PATHS", *findList(source, SIGNATURE_SU_PATHS));
+    out += "\n";
+    appendKotlinList(out, "ROOT_PACKAGES", *findList(source, SIGNATURE_ROOT_PACKAGES));
+    out += "\n";
+    appendKotlinList(out, "QEMU_FILES", *findList(source, SIGNATURE_QEMU_FILES));
+    out += "\n";
+    appendKotlinList(out, "MODULE_KEYWORDS", *findList(source, SIGNATURE_MODULE_KEYWORDS));
+    out += "\n    val FRIDA_PORTS: List<Int> = listOf(";
+    for (size_t i = 0; i < source.fridaPorts.size(); i++) {
+        out += (i > 0 ? ", " : "") + std::to_string(source.fridaPorts[i]);
+    }
+    out += ")\n}\n";
+    return out;
+}
+
+void appendSwiftList(std::string& out, const char* name, const std::vector<std::string>& entries) {
+    out += "    static let " + std::string(name) + ": [String] = [\n";
+    for (size_t i = 0; i < entries.size(); i++) {
+        out += "        " + swiftLiteral(entries[i]) + (i + 1 < entries.size() ? ",\n" : "\n");
+    }
+    out += "    ]\n";
+}
+
+std::string renderSwift(const SignaturePackSource& source) {
+    std::string out =
+        "// [DeviceTrust/iOS] Built-in signature lists\n"
+        "// Generated by device_trust_signature_gen from src/signatures/signatures.txt;\n"
+        "// do not edit. Regenerate with\n"
+        "//   " +
+        std::string(REGENERATE) +
+        "\n\n"
+        "/// Defaults of the Swift checks; a loaded signature pack replaces them\n"
+        "/// section by section (see DeviceTrust.loadSignaturePack)\n"
+        "enum DeviceTrustSignatures {\n"
+        "    static let version = " +
+        std::to_string(source.version) + "\n\n";
+    appendSwiftList(out, "jailbreakPaths", *findList(source, SIGNATURE_JAILBREAK_PATHS));
+    out += "\n";
+    appendSwiftList(out, "jailbreakSchemes", *findList(source, SIGNATURE_JAILBREAK_SCHEMES));
+    out += "}\n";
+    return out;
+}
+
+// Writes [content] to [path], or in check mode reports whether it differs
+bool emit(const char* path, const std::string& content, bool check) {
+    if (!check) {
+        if (!writeFile(path, content)) {
+            fprintf(stderr, "signature_gen: cannot write %s\n", path);
+            return false;
+        }
+        return true;
+    }
+    std::string current;
+    if (!readFile(path, &current) || current != content) {
+        fprintf(stderr, "signature_gen: %s is out of date with signatures.txt; run\n  %s\n", path, REGENERATE);
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bool check = argc > 1 && strcmp(argv[1], "--check") == 0;
+    int first = check ? 2 : 1;
+    if (argc != first + 4) {
+        return usage();
+    }
+    const char* sourcePath = argv[first];
+
+    std::string text;
+    if (!readFile(sourcePath, &text)) {
+        fprintf(stderr, "signature_gen: cannot read %s\n", sourcePath);
+        return 1;
+    }
+    SignaturePackSource source;
+    std::string error;
+    if (!parseSignatureSource(text, &source, &error)) {
+        fprintf(stderr, "signature_gen: %s:%s\n", sourcePath, error.c_str());
+        return 1;
+    }
+    // The built-in set must be complete and valid as a pack
+    for (int section = 1; section < SIGNATURE_SECTION_LIMIT; section++) {
+        bool present = section == SIGNATURE_FRIDA_PORTS
+                           ? source.hasPorts
+                           : findList(source, static_cast<SignatureSection>(section)) != nullptr;
+        if (!present) {
+            fprintf(stderr, "signature_gen: %s: missing section [%s]\n", sourcePath, signatureSectionName(section));
+            return 1;
+        }
+    }
+    std::string pack;
+    SignaturePackStatus status = SIGNATURE_PACK_LIMIT_EXCEEDED;
+    if (!encodeSignaturePack(source, &pack) || SignaturePack::fromBytes(pack.data(), pack.size(), &status) == nullptr) {
+        fprintf(stderr, "signature_gen: %s is not a valid signature set (status %d)\n", sourcePath, (int)status);
+        return 1;
+    }
+
+    bool ok = emit(argv[first + 1], renderCpp(source), check);
+    ok = emit(argv[first + 2], renderKotlin(source), check) && ok;
+    ok = emit(argv[first + 3], renderSwift(source), check) && ok;
+    return ok ? 0 : 1;
+}
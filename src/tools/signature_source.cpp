@@ -0,0 +1,121 @@
+// [DeviceTrust/Core] Signature source files (host tools)
+
+#include "signature_source.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace device_trust {
+
+namespace {
+
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return std::string();
+    }
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+bool fail(std::string* error, int line, const std::string& message) {
+    if (error != nullptr) {
+        *error = "line " + std::to_string(line) + ": " + message;
+    }
+    return false;
+}
+
+}  // namespace
+
+bool parseSignatureSource(const std::string& text, SignaturePackSource* out, std::string* error) {
+    *out = SignaturePackSource();
+    bool hasVersion = false;
+    int section = 0;
+    std::vector<std::string>* entries = nullptr;
+    int lineNumber = 0;
+    size_t begin = 0;
+    while (begin <= text.size()) {
+        size_t end = text.find('\n', begin);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::string line = trim(text.substr(begin, end - begin));
+        begin = end + 1;
+        lineNumber++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        if (line[0] == '[') {
+            if (line.back() != ']') {
+                return fail(error, lineNumber, "unterminated section header");
+            }
+            std::string name = line.substr(1, line.size() - 2);
+            section = 0;
+            for (int tag = 1; tag < SIGNATURE_SECTION_LIMIT; tag++) {
+                if (name == signatureSectionName(tag)) {
+                    section = tag;
+                }
+            }
+            if (section == 0) {
+                return fail(error, lineNumber, "unknown section [" + name + "]");
+            }
+            for (const auto& list : out->lists) {
+                if (list.first == section) {
+                    return fail(error, lineNumber, "duplicate section [" + name + "]");
+                }
+            }
+            if (section == SIGNATURE_FRIDA_PORTS) {
+                if (out->hasPorts) {
+                    return fail(error, lineNumber, "duplicate section [" + name + "]");
+                }
+                out->hasPorts = true;
+                entries = nullptr;
+            } else {
+                out->lists.emplace_back(static_cast<SignatureSection>(section), std::vector<std::string>());
+                entries = &out->lists.back().second;
+            }
+            continue;
+        }
+
+        if (section == 0) {
+            if (line.compare(0, 8, "version ") != 0 || hasVersion) {
+                return fail(error, lineNumber, "expected `version N` before the first section");
+            }
+            char* numberEnd = nullptr;
+            unsigned long version = strtoul(line.c_str() + 8, &numberEnd, 10);
+            if (*numberEnd != '\0' || version == 0 || version > UINT32_MAX) {
+                return fail(error, lineNumber, "version must be a positive 32-bit number");
+            }
+            out->version = (uint32_t)version;
+            hasVersion = true;
+            continue;
+        }
+
+        if (section == SIGNATURE_FRIDA_PORTS) {
+            char* numberEnd = nullptr;
+            unsigned long port = strtoul(line.c_str(), &numberEnd, 10);
+            if (*numberEnd != '\0' || port == 0 || port > 65535) {
+                return fail(error, lineNumber, "invalid port " + line);
+            }
+            out->fridaPorts.push_back((uint16_t)port);
+            continue;
+        }
+        if (section == SIGNATURE_MODULE_KEYWORDS || section == SIGNATURE_FD_KEYWORDS ||
+            section == SIGNATURE_IMAGE_KEYWORDS) {
+            for (char& c : line) {
+                c = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+            }
+        }
+        if (line.find('\0') != std::string::npos) {
+            return fail(error, lineNumber, "entries cannot contain NUL bytes");
+        }
+        entries->push_back(line);
+    }
+    if (!hasVersion) {
+        return fail(error, lineNumber, "missing `version N`");
+    }
+    return true;
+}
+
+}  // namespace device_trust
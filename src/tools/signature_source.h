@@ -0,0 +1,22 @@
+// [DeviceTrust/Core] Signature source files (host tools)
+// Parser for the text format of src/signatures/signatures.txt.
+
+#pragma once
+
+#include <string>
+
+#include "../core/signature_pack.h"
+
+namespace device_trust {
+
+/**
+ * Parses a signature source; see src/signatures/signatures.txt for the format
+ *
+ * Keyword sections are lowercased. Entries are checked against the pack
+ * limits by encodeSignaturePack, not here.
+ *
+ * @param error set to "line N: ..." when parsing fails
+ */
+bool parseSignatureSource(const std::string& text, SignaturePackSource* out, std::string* error);
+
+}  // namespace device_trust
@@ -0,0 +1,229 @@
+// [DeviceTrust/Core] Snapshot capture and offline replay
+//
+// Usage:
+//   device_trust_snapshot capture <pid | /proc-like dir> <out.dts>
+//   device_trust_snapshot replay [-j threads] <bundle.dts | dir>...
+//
+// replay runs every bundle through the detection core (same scanners and
+// limits as the Android STANDARD tier) on a pool of threads and prints one
+// JSON line per bundle, in argument order; a summary goes to stderr.
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../core/arena.h"
+#include "../core/json.h"
+#include "../core/keywords.h"
+#include "../core/scanners.h"
+#include "../core/signature_pack.h"
+#include "../core/snapshot.h"
+#include "../platform/procfs_backend.h"
+#include "../platform/procfs_snapshot.h"
+
+using namespace device_trust;
+
+// Same rule as applyNativeResult in DeviceTrust.kt
+static const int HOOK_SIGNAL_THRESHOLD = 2;
+
+static const long long NO_BUDGET = LLONG_MAX;
+
+static int usage() {
+    fprintf(stderr,
+            "usage: device_trust_snapshot capture <pid | dir> <out.dts>\n"
+            "       device_trust_snapshot replay [-j threads] <bundle.dts | dir>...\n");
+    return 2;
+}
+
+static bool readFile(const std::string& path, std::string* out) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    char chunk[65536];
+    size_t len;
+    out->clear();
+    while ((len = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        out->append(chunk, len);
+    }
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
+
+static bool writeFile(const std::string& path, const std::string& data) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+    return fclose(file) == 0 && ok;
+}
+
+static int capture(const char* target, const char* outPath) {
+    char* end = nullptr;
+    long pid = strtol(target, &end, 10);
+    ProcSource source = (*end == '\0' && pid > 0) ? ProcSource::forPid((int)pid) : ProcSource::snapshot(target);
+    ProcfsBackend backend(source);
+
+    Snapshot snapshot;
+    if (!captureSnapshot(backend, reinterpret_cast<void*>(getpid), &snapshot)) {
+        fprintf(stderr, "capture: cannot read %s/maps\n", source.root());
+        return 1;
+    }
+    std::string bundle;
+    if (!encodeSnapshot(snapshot, &bundle) || !writeFile(outPath, bundle)) {
+        fprintf(stderr, "capture: cannot write %s\n", outPath);
+        return 1;
+    }
+    fprintf(stderr, "capture: %s -> %s (%zu bytes, %zu maps bytes)\n", source.root(), outPath, bundle.size(),
+            snapshot.maps.size());
+    return 0;
+}
+
+/**
+ * Bundle paths of [arg]: the file itself, or the *.dts files of a directory
+ * (sorted, not recursive)
+ */
+static void expandArgument(const std::string& arg, std::vector<std::string>* out) {
+    struct stat info;
+    if (stat(arg.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)) {
+        out->push_back(arg);
+        return;
+    }
+    DIR* dir = opendir(arg.c_str());
+    if (dir == nullptr) {
+        out->push_back(arg);
+        return;
+    }
+    std::vector<std::string> files;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        size_t length = strlen(entry->d_name);
+        if (length > 4 && strcmp(entry->d_name + length - 4, ".dts") == 0) {
+            files.push_back(arg + "/" + entry->d_name);
+        }
+    }
+    closedir(dir);
+    std::sort(files.begin(), files.end());
+    out->insert(out->end(), files.begin(), files.end());
+}
+
+struct ReplayResult {
+    std::string line;
+    bool ok = false;
+    bool flagged = false;
+};
+
+static ReplayResult replayBundle(const std::string& path, ScanArena& arena) {
+    ReplayResult result;
+    std::string bytes;
+    Snapshot snapshot;
+    std::string file = "\"" + escapeJsonString(path) + "\"";
+    if (!readFile(path, &bytes) || !decodeSnapshot(bytes.data(), bytes.size(), &snapshot)) {
+        result.line = "{\"bundle\":" + file + ",\"ok\":false}";
+        return result;
+    }
+
+    arena.reset();
+    SnapshotBackend backend(snapshot);
+    Deadline deadline(NO_BUDGET);
+    std::shared_ptr<const SignaturePack> signatures = SignaturePack::builtin();
+    RegionAnalysis maps = analyzeRegions(backend, deadline, arena, signatures->keywords(SIGNATURE_MODULE_KEYWORDS));
+    bool fdFrida = scanOpenFiles(backend, deadline, signatures->keywords(SIGNATURE_FD_KEYWORDS)).found;
+    SymbolImageCheck libc = checkSymbolImage(backend, arena, nullptr, LIBC_IMAGE_FRAGMENTS_LINUX);
+    ProcStatus status = parseProcStatus(snapshot.status.c_str());
+
+    std::vector<std::string> signals;
+    if (maps.fridaLibLoaded) signals.push_back("fridaLibLoaded");
+    if (maps.hasRwx) signals.push_back("hasRwx");
+    if (fdFrida) signals.push_back("fdFrida");
+    if (libc.unexpected) signals.push_back("libcGetpidUnexpected");
+    bool fridaSuspected = (int)signals.size() >= HOOK_SIGNAL_THRESHOLD;
+
+    std::string line = "{\"bundle\":" + file + ",\"ok\":true";
+    line += std::string(",\"fridaSuspected\":") + (fridaSuspected ? "true" : "false");
+    line += std::string(",\"debuggerAttached\":") + (status.tracerPid > 0 ? "true" : "false");
+    line += ",\"signals\":" + vectorToJsonArray(signals);
+    line += ",\"rwxSegments\":" + std::to_string(maps.rwxSegments);
+    line += ",\"tracerPid\":" + std::to_string(status.tracerPid);
+    line += ",\"threads\":" + std::to_string(snapshot.threadNames.size());
+    line += ",\"openFiles\":" + std::to_string(snapshot.openFiles.size());
+    line += ",\"libcGetpidSo\":\"" + escapeJsonString(libc.imagePath) + "\"";
+    line += ",\"suspiciousModules\":" + vectorToJsonArray(maps.suspiciousModules);
+    line += ",\"capturedAtMs\":\"" + escapeJsonString(snapshot.metaValue("capturedAtMs")) + "\"}";
+
+    result.line = line;
+    result.ok = true;
+    result.flagged = fridaSuspected || status.tracerPid > 0;
+    return result;
+}
+
+static int replay(int argc, char** argv) {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::string> bundles;
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threads = (unsigned)std::max(1, atoi(argv[++i]));
+        } else {
+            expandArgument(argv[i], &bundles);
+        }
+    }
+    if (bundles.empty()) {
+        return usage();
+    }
+    threads = std::min<unsigned>(threads, (unsigned)bundles.size());
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ReplayResult> results(bundles.size());
+    std::atomic<size_t> next{0};
+    auto worker = [&] {
+        ScanArena arena;  // one per thread, reset per bundle
+        for (size_t i = next++; i < bundles.size(); i = next++) {
+            results[i] = replayBundle(bundles[i], arena);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; i++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    size_t failed = 0;
+    size_t flagged = 0;
+    for (const ReplayResult& result : results) {
+        puts(result.line.c_str());
+        failed += !result.ok;
+        flagged += result.flagged;
+    }
+    fprintf(stderr, "replay: %zu bundles, %zu flagged, %zu unreadable, %u threads, %.1f ms (%.0f bundles/s)\n",
+            bundles.size(), flagged, failed, threads, elapsedMs,
+            elapsedMs > 0 ? bundles.size() * 1000.0 / elapsedMs : 0.0);
+    return failed == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 4 && strcmp(argv[1], "capture") == 0) {
+        return capture(argv[2], argv[3]);
+    }
+    if (argc >= 3 && strcmp(argv[1], "replay") == 0) {
+        return replay(argc - 2, argv + 2);
+    }
+    return usage();
+}
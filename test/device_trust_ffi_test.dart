@@ -0,0 +1,275 @@
+import 'dart:convert';
+import 'dart:ffi';
+
+import 'package:device_trust/device_trust_ffi.dart';
+import 'package:ffi/ffi.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+// Writes u16 count + (u16 length + UTF-8 bytes)* lists into [result].
+void _writeLists(DtResult result, List<List<String>> lists) {
+  var pos = 0;
+  void u16(int value) {
+    result.lists[pos] = value & 0xFF;
+    result.lists[pos + 1] = value >> 8;
+    pos += 2;
+  }
+
+  for (final list in lists) {
+    u16(list.length);
+    for (final item in list) {
+      final bytes = utf8.encode(item);
+      u16(bytes.length);
+      for (final byte in bytes) {
+        result.lists[pos++] = byte;
+      }
+    }
+  }
+  result.listsLength = pos;
+}
+
+FfiNativeResult _native({
+  int flags = 0,
+  int tracerPid = 0,
+  int demotedStages = 0,
+  int skippedStages = 0,
+  Map<String, ({int ns, int items})> stages = const {},
+}) => FfiNativeResult(
+  scanLevel: 1,
+  tracerPid: tracerPid,
+  rwxSegments: 0,
+  flags: flags,
+  skippedStages: skippedStages,
+  demotedStages: demotedStages,
+  nativeTimeNs: 2000000,
+  stages: stages,
+  libcGetpidSo: '',
+  gotMismatch: const [],
+  textMismatch: const [],
+  suspiciousModules: const [],
+);
+
+Map<String, Object?> _channelReport(String transport) => {
+  'fridaSuspected': false,
+  'details': <Object?, Object?>{
+    'nativeTransport': transport,
+    'budgetExceeded': false,
+    'demotedSkipped': <Object?>['fridaPortsOpen'],
+  },
+};
+
+void main() {
+  test('struct layout matches device_trust_ffi.h', () {
+    expect(sizeOf<DtRequest>(), 24);
+    expect(sizeOf<DtResult>(), 160 + dtListsCapacity);
+  });
+
+  test('FfiNativeResult.fromStruct decodes fields and lists', () {
+    final result = calloc<DtResult>();
+    addTearDown(() => calloc.free(result));
+    result.ref
+      ..flags = 1 | 2
+      ..level = 2
+      ..tracerPid = 42
+      ..rwxSegments = 3
+      ..skippedStages = 1 << 1
+      ..nativeTimeNs = 1500;
+    _writeLists(result.ref, [
+      ['/apex/com.android.runtime/lib64/bionic/libc.so'],
+      [],
+      [],
+      ['open'],
+      [],
+      ['frida-agent-64.so', 'gum-js-loop'],
+    ]);
+
+    final native = FfiNativeResult.fromStruct(result.ref);
+    expect(native.scanLevel, 2);
+    expect(native.tracerPid, 42);
+    expect(native.rwxSegments, 3);
+    expect(native.hasRwx, isTrue);
+    expect(native.fridaLibLoaded, isTrue);
+    expect(native.fdFrida, isFalse);
+    expect(native.truncated, isFalse);
+    expect(native.libcGetpidSo, endsWith('libc.so'));
+    expect(native.gotMismatch, ['open']);
+    expect(native.textMismatch, isEmpty);
+    expect(native.suspiciousModules, ['frida-agent-64.so', 'gum-js-loop']);
+    expect(native.signals, ['fridaLibLoaded', 'hasRwx', 'gotMismatch']);
+    expect(FfiNativeResult.stageNamesOf(native.skippedStages), ['fd']);
+  });
+
+  test('FfiNativeResult.fromStruct decodes the stages that ran', () {
+    final result = calloc<DtResult>();
+    addTearDown(() => calloc.free(result));
+    result.ref
+      ..stagesRan = (1 << 0) | (1 << 5)
+      ..stageNs[0] = 750000
+      ..stageItems[0] = 312
+      ..stageNs[5] = 20000
+      ..stageNs[1] = 99;
+    _writeLists(result.ref, [[], [], [], [], [], []]);
+
+    final native = FfiNativeResult.fromStruct(result.ref);
+    expect(native.stages.keys, ['nativeMaps', 'nativeTracerPid']);
+    expect(native.stages['nativeMaps'], (ns: 750000, items: 312));
+    expect(native.stages['nativeTracerPid'], (ns: 20000, items: 0));
+  });
+
+  test('FfiNativeResult.fromStruct decodes the memory signature match', () {
+    final result = calloc<DtResult>();
+    addTearDown(() => calloc.free(result));
+    result.ref
+      ..flags = (1 << 6) | (1 << 7)
+      ..memoryRegionStart = 0x7f00000000
+      ..memoryMatchAddress = 0x7f00001068;
+    _writeLists(result.ref, [
+      [],
+      ['frida:rpc'],
+      [''],
+      [],
+      [],
+      [],
+    ]);
+
+    final native = FfiNativeResult.fromStruct(result.ref);
+    expect(native.truncated, isFalse);
+    expect(native.memorySampled, isTrue);
+    expect(native.signals, ['memorySignature']);
+
+    final details = <String, dynamic>{};
+    native.applyTo(details);
+    expect(details['memorySignature'], {
+      'signature': 'frida:rpc',
+      'regionStart': 0x7f00000000,
+      'regionPath': '',
+      'address': 0x7f00001068,
+      'sampled': true,
+    });
+  });
+
+  test('FfiNativeResult.fromStruct flags lists cut by listsLength', () {
+    final result = calloc<DtResult>();
+    addTearDown(() => calloc.free(result));
+    _writeLists(result.ref, [
+      [],
+      [],
+      [],
+      [],
+      [],
+      ['frida-agent-64.so'],
+    ]);
+    result.ref.listsLength -= 4;
+
+    final native = FfiNativeResult.fromStruct(result.ref);
+    expect(native.suspiciousModules, isEmpty);
+    expect(native.truncated, isTrue);
+  });
+
+  test('memory signature signal survives a truncated result', () {
+    final result = calloc<DtResult>();
+    addTearDown(() => calloc.free(result));
+    result.ref.flags = (1 << 5) | (1 << 7);
+    _writeLists(result.ref, [
+      [],
+      ['frida:rpc'],
+      [''],
+      [],
+      [],
+      List.filled(40, 'x' * 40),
+    ]);
+    // Nothing but the header fields is left
+    result.ref.listsLength = 0;
+
+    final native = FfiNativeResult.fromStruct(result.ref);
+    expect(native.truncated, isTrue);
+    expect(native.memorySignature, isEmpty);
+    expect(native.signals, ['memorySignature']);
+    final details = <String, dynamic>{};
+    native.applyTo(details);
+    expect((details['memorySignature'] as Map)['signature'], '');
+  });
+
+  test('mergeNativeResult applies the native hook verdict', () {
+    final merged = FfiDeviceTrust.mergeNativeResult(
+      _channelReport('ffi'),
+      _native(flags: 1 | 4, demotedStages: 1 << 2, skippedStages: 1 << 3),
+      signalMask: 8,
+    );
+    final details = merged['details']! as Map<String, dynamic>;
+    expect(merged['fridaSuspected'], isTrue);
+    expect(details['nativeSignals'], ['fdFrida', 'hasRwx']);
+    expect(details['nativeLibc'], 'skipped:demoted');
+    expect(details['nativeIntegrity'], 'skipped:decided');
+    expect(details['demotedSkipped'], ['fridaPortsOpen', 'nativeLibc']);
+    expect(details['incompleteSignals'], ['hook']);
+    expect(details['nativeScanTimeMs'], 2.0);
+  });
+
+  test('mergeNativeResult adds native stages to the time breakdown', () {
+    final report = _channelReport('ffi');
+    (report['details']! as Map)['timeBreakdownMs'] = {'fridaPortsOpen': 12.5};
+    final merged = FfiDeviceTrust.mergeNativeResult(
+      report,
+      _native(stages: const {'nativeFd': (ns: 1500000, items: 48)}),
+      signalMask: 8,
+    );
+    final details = merged['details']! as Map<String, dynamic>;
+    expect(details['nativeStages'], {
+      'nativeFd': {'ns': 1500000, 'items': 48},
+    });
+    expect(details['timeBreakdownMs'], {
+      'fridaPortsOpen': 12.5,
+      'nativeFd': 1.5,
+    });
+  });
+
+  test('mergeNativeResult flags hooks on hook evidence only', () {
+    final hooked = FfiDeviceTrust.mergeNativeResult(
+      _channelReport('ffi'),
+      _native(flags: 1 | 2),
+      signalMask: 8,
+    );
+    expect(hooked['fridaSuspected'], isTrue);
+
+    // A debugger next to RWX is not a hook
+    final traced = FfiDeviceTrust.mergeNativeResult(
+      _channelReport('ffi'),
+      _native(flags: 1, tracerPid: 7),
+      signalMask: 8 | 16,
+    );
+    expect(traced['fridaSuspected'], isFalse);
+
+    final debuggerOnly = FfiDeviceTrust.mergeNativeResult(
+      _channelReport('ffi'),
+      _native(flags: 1, tracerPid: 7),
+      signalMask: 16,
+    );
+    expect(debuggerOnly['fridaSuspected'], isFalse);
+    expect(
+      (debuggerOnly['details']! as Map<String, dynamic>)['nativeTracerPid'],
+      7,
+    );
+  });
+
+  test('mergeNativeResult keeps reports with JNI native signals', () {
+    final report = _channelReport('jni');
+    final merged = FfiDeviceTrust.mergeNativeResult(
+      report,
+      _native(flags: 1 | 2),
+      signalMask: 8,
+    );
+    expect(identical(merged, report), isTrue);
+  });
+
+  test('mergeNativeResult records a failed FFI call', () {
+    final merged = FfiDeviceTrust.mergeNativeResult(
+      _channelReport('ffi'),
+      null,
+      signalMask: 8,
+    );
+    final details = merged['details']! as Map<String, dynamic>;
+    expect(merged['fridaSuspected'], isFalse);
+    expect(details['nativeSignals'], isEmpty);
+    expect(details['nativeError'], isNotNull);
+  });
+}
@@ -1,5 +1,9 @@
+import 'dart:typed_data';
+
+import 'package:flutter/services.dart';
 import 'package:flutter_test/flutter_test.dart';
 import 'package:device_trust/device_trust.dart';
+import 'package:device_trust/device_trust_method_channel.dart';
 
 void main() {
   test('DeviceTrustReport.fromMap defaults', () {
@@ -29,4 +33,111 @@ void main() {
     expect(r.debuggerAttached, isTrue);
     expect(r.details['a'], 1);
   });
+
+  group('captureSnapshot', () {
+    TestWidgetsFlutterBinding.ensureInitialized();
+    const channel = MethodChannel('device_trust');
+    final messenger =
+        TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger;
+
+    tearDown(() => messenger.setMockMethodCallHandler(channel, null));
+
+    test('returns the bundle bytes', () async {
+      messenger.setMockMethodCallHandler(channel, (call) async {
+        expect(call.method, 'captureSnapshot');
+        return Uint8List.fromList([0x44, 0x54, 0x53, 0x31]);
+      });
+      expect(await MethodChannelDeviceTrust().captureSnapshot(), [
+        0x44,
+        0x54,
+        0x53,
+        0x31,
+      ]);
+    });
+
+    test('is null where the platform does not implement it', () async {
+      messenger.setMockMethodCallHandler(channel, (call) async {
+        throw MissingPluginException();
+      });
+      expect(await MethodChannelDeviceTrust().captureSnapshot(), isNull);
+    });
+  });
+
+  group('telemetry', () {
+    TestWidgetsFlutterBinding.ensureInitialized();
+    const channel = MethodChannel('device_trust');
+    final messenger =
+        TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger;
+
+    tearDown(() => messenger.setMockMethodCallHandler(channel, null));
+
+    test('decodes the compact snapshot', () async {
+      messenger.setMockMethodCallHandler(channel, (call) async {
+        expect(call.method, 'getStats');
+        return '{"v":1,"histogram":"log2x8",'
+            '"io":{"procfsBytes":4096,"syscalls":3},"dropped":0,'
+            '"checks":{"nativeMaps":{"calls":2,"cacheHits":0,"timeouts":1,'
+            '"cancellations":0,"sumNs":6,"maxNs":3,"p50Ns":3,"p90Ns":3,'
+            '"p99Ns":3,"buckets":[[3,2]]}}}';
+      });
+      final raw = await MethodChannelDeviceTrust().getStatsRaw();
+      final stats = DeviceTrustStats.fromMap(raw!);
+      expect(stats.procfsBytes, 4096);
+      expect(stats.syscalls, 3);
+      final maps = stats.checks['nativeMaps']!;
+      expect(maps.calls, 2);
+      expect(maps.timeouts, 1);
+      expect(maps.p99Ns, 3);
+      expect(maps.buckets, {3: 2});
+      expect(stats.toMap()['v'], 1);
+    });
+
+    test('is null where the platform does not implement it', () async {
+      messenger.setMockMethodCallHandler(channel, (call) async {
+        throw MissingPluginException();
+      });
+      expect(await MethodChannelDeviceTrust().getStatsRaw(), isNull);
+    });
+
+    test('dumpTrace returns the Chrome trace JSON', () async {
+      messenger.setMockMethodCallHandler(channel, (call) async {
+        expect(call.method, 'dumpTrace');
+        return '{"traceEvents":[],"displayTimeUnit":"ns"}';
+      });
+      expect(
+        await MethodChannelDeviceTrust().dumpTrace(),
+        '{"traceEvents":[],"displayTimeUnit":"ns"}',
+      );
+    });
+
+    test('loadSignaturePack passes the path and returns the version', () async {
+      messenger.setMockMethodCallHandler(channel, (call) async {
+        expect(call.method, 'loadSignaturePack');
+        expect(call.arguments, {'path': '/data/signatures.dtp'});
+        return 7;
+      });
+      expect(
+        await MethodChannelDeviceTrust().loadSignaturePack('/data/signatures.dtp'),
+        7,
+      );
+    });
+
+    test('loadSignaturePack surfaces rejected packs', () async {
+      messenger.setMockMethodCallHandler(channel, (call) async {
+        throw PlatformException(code: 'SIGNATURE_PACK_INVALID', details: -3);
+      });
+      expect(
+        MethodChannelDeviceTrust().loadSignaturePack('/data/signatures.dtp'),
+        throwsA(isA<PlatformException>()
+            .having((e) => e.details, 'details', -3)),
+      );
+    });
+
+    test('bucket bounds follow the native histogram', () {
+      expect(DeviceTrustCheckStats.bucketLowerNs(15), 15);
+      expect(DeviceTrustCheckStats.bucketLowerNs(16), 16);
+      expect(DeviceTrustCheckStats.bucketLowerNs(17), 18);
+      expect(DeviceTrustCheckStats.bucketLowerNs(24), 32);
+    });
+  });
 }
@@ -20,6 +20,91 @@ class _FakePlatform extends DeviceTrustPlatform {
   Future<bool> isSupported() async => true;
 }
 
+class _OptionsPlatform extends DeviceTrustPlatform {
+  Map<String, Object?>? lastOptions;
+
+  @override
+  Future<Map<String, Object?>> getReportRaw() async => {};
+
+  @override
+  Future<Map<String, Object?>> getReportRawWithOptions(
+    Map<String, Object?> options,
+  ) async {
+    lastOptions = options;
+    return {
+      'details': {'scanLevel': options['level']},
+    };
+  }
+
+  @override
+  Future<bool> isSupported() async => true;
+}
+
+class _StreamPlatform extends DeviceTrustPlatform {
+  Map<String, Object?>? lastOptions;
+
+  @override
+  Future<Map<String, Object?>> getReportRaw() async => {};
+
+  @override
+  Stream<Map<String, Object?>> getReportStreamRaw(
+    Map<String, Object?> options,
+  ) {
+    lastOptions = options;
+    return Stream.fromIterable([
+      {
+        'type': 'check',
+        'seq': 1,
+        'id': 'nativeTracerPid',
+        'result': 0,
+        'hit': false,
+        'elapsedUs': 40,
+      },
+      {
+        'type': 'check',
+        'seq': 2,
+        'id': 'suExists',
+        'result': true,
+        'hit': true,
+        'elapsedUs': 75,
+      },
+      {
+        'type': 'summary',
+        'seq': 3,
+        'report': {'rootedOrJailbroken': true},
+      },
+    ]);
+  }
+
+  @override
+  Future<bool> isSupported() async => true;
+}
+
+class _WatchPlatform extends DeviceTrustPlatform {
+  @override
+  Future<Map<String, Object?>> getReportRaw() async => {};
+
+  @override
+  Stream<Map<String, Object?>> watchRaw() => Stream.fromIterable([
+    {
+      'type': 'baseline',
+      'seq': 1,
+      'triggers': <Object?>[],
+      'changed': {'fridaSuspected': false, 'debuggerAttached': false},
+      'monitor': {'cpuPercent': 0.01},
+    },
+    {
+      'type': 'change',
+      'seq': 2,
+      'triggers': ['libraries', 'rwxSegments'],
+      'changed': {'fridaSuspected': true},
+    },
+  ]);
+
+  @override
+  Future<bool> isSupported() async => true;
+}
+
 void main() {
   test('DeviceTrust.getReport maps to typed model', () async {
     DeviceTrustPlatform.instance = _FakePlatform();
@@ -35,4 +120,130 @@ void main() {
     DeviceTrustPlatform.instance = _FakePlatform();
     expect(await DeviceTrust.isSupported(), isTrue);
   });
+
+  test('getReport forwards scan level and records it', () async {
+    final platform = _OptionsPlatform();
+    DeviceTrustPlatform.instance = platform;
+
+    final r = await DeviceTrust.getReport(level: ScanLevel.fast);
+    expect(platform.lastOptions?['level'], 'fast');
+    expect(r.scanLevel, ScanLevel.fast);
+
+    await DeviceTrust.getReport();
+    expect(platform.lastOptions?['level'], 'standard');
+  });
+
+  test('getReportRawWithOptions falls back to getReportRaw', () async {
+    DeviceTrustPlatform.instance = _FakePlatform();
+
+    final r = await DeviceTrust.getReport(level: ScanLevel.deep);
+    expect(r.details['unit'], 'test');
+    expect(r.scanLevel, isNull);
+  });
+
+  test('getReport forwards requested signal groups as a mask', () async {
+    final platform = _OptionsPlatform();
+    DeviceTrustPlatform.instance = platform;
+
+    await DeviceTrust.getReport(
+      signals: {SignalGroup.hook, SignalGroup.debugger},
+    );
+    expect(platform.lastOptions?['signalMask'], 8 | 16);
+
+    await DeviceTrust.getReport();
+    expect(platform.lastOptions?['signalMask'], 31);
+  });
+
+  test('getReport forwards verdictsOnly (default false)', () async {
+    final platform = _OptionsPlatform();
+    DeviceTrustPlatform.instance = platform;
+
+    await DeviceTrust.getReport();
+    expect(platform.lastOptions?['verdictsOnly'], isFalse);
+
+    await DeviceTrust.getReport(verdictsOnly: true);
+    expect(platform.lastOptions?['verdictsOnly'], isTrue);
+  });
+
+  test('watch maps baseline and delta events', () async {
+    DeviceTrustPlatform.instance = _WatchPlatform();
+
+    final events = await DeviceTrust.watch().toList();
+    expect(events, hasLength(2));
+    expect(events[0].isBaseline, isTrue);
+    expect(events[0].triggers, isEmpty);
+    expect(events[0].monitor['cpuPercent'], 0.01);
+    expect(events[1].isBaseline, isFalse);
+    expect(events[1].seq, 2);
+    expect(events[1].triggers, ['libraries', 'rwxSegments']);
+    expect(events[1].changed, {'fridaSuspected': true});
+    expect(events[1].monitor, isEmpty);
+  });
+
+  test('watchRaw is unimplemented by default', () {
+    DeviceTrustPlatform.instance = _FakePlatform();
+    expect(DeviceTrust.watch, throwsUnimplementedError);
+  });
+
+  test('getReportStream emits checks in order, then the summary', () async {
+    final platform = _StreamPlatform();
+    DeviceTrustPlatform.instance = platform;
+
+    final events = await DeviceTrust.getReportStream(
+      level: ScanLevel.fast,
+    ).toList();
+    expect(platform.lastOptions?['level'], 'fast');
+    expect(events.map((e) => e.seq), [1, 2, 3]);
+    expect(events[0].checkId, 'nativeTracerPid');
+    expect(events[0].isSummary, isFalse);
+    expect(events[1].hit, isTrue);
+    expect(events[1].elapsed, const Duration(microseconds: 75));
+    expect(events[2].isSummary, isTrue);
+    expect(events[2].report?.rootedOrJailbroken, isTrue);
+  });
+
+  test('getReportStream falls back to a single summary event', () async {
+    DeviceTrustPlatform.instance = _FakePlatform();
+
+    final events = await DeviceTrust.getReportStream().toList();
+    expect(events, hasLength(1));
+    expect(events.single.isSummary, isTrue);
+    expect(events.single.report?.fridaSuspected, isTrue);
+  });
+
+  test('currentVerdict is null without a published verdict', () {
+    DeviceTrustPlatform.instance = _FakePlatform();
+    expect(DeviceTrust.currentVerdict(), isNull);
+    expect(DeviceTrustVerdict.fromWord(0, 1000), isNull);
+  });
+
+  test('DeviceTrustVerdict decodes the packed word', () {
+    // frida + debugger flags, hook + debugger groups, seq 3, published at 1000 ms
+    const word = (16 | 32) | ((8 | 16) << 6) | (3 << 12) | (1000 << 26);
+    final verdict = DeviceTrustVerdict.fromWord(word, 1500)!;
+    expect(verdict.fridaSuspected, isTrue);
+    expect(verdict.debuggerAttached, isTrue);
+    expect(verdict.rootedOrJailbroken, isFalse);
+    expect(verdict.seq, 3);
+    expect(verdict.age, const Duration(milliseconds: 500));
+    expect(verdict.evaluated, {SignalGroup.hook, SignalGroup.debugger});
+    expect(verdict.covers(SignalGroup.root), isFalse);
+    expect(verdict.isStale(const Duration(seconds: 1)), isFalse);
+    expect(verdict.isStale(const Duration(milliseconds: 100)), isTrue);
+
+    final pending = DeviceTrustVerdict.fromWord(word | (1 << 11), 1500)!;
+    expect(pending.pending, isTrue);
+    expect(pending.isStale(const Duration(seconds: 1)), isTrue);
+  });
+
+  test('DeviceTrustVerdict.flagsOf packs report flags', () {
+    expect(
+      DeviceTrustVerdict.flagsOf({
+        'rootedOrJailbroken': true,
+        'fridaSuspected': true,
+        'adbEnabled': false,
+      }),
+      1 | 16,
+    );
+  });
 }